@@ -0,0 +1,386 @@
+/*
+ * numeric-bench: the standard benchmark suite of the library.
+ *
+ * Sweeps input sizes for the hot paths (matrix products, vector dot products, RREF on doubles and fractions, Gauss Jordan
+ * and the linear independence test) with numeric::benchmark::Benchmark, with fixed seeds, so that numbers from different
+ * machines and builds measure the same work.
+ *
+ * Usage: numeric-bench [--quick] [--filter <substring>] [--report-dir <dir>] [--baseline-dir <dir>]
+ *   --quick         Smaller sizes and fewer iterations, for a smoke test.
+ *   --filter        Only run the cases whose name contains the substring.
+ *   --report-dir    Write <case>.json and <case>.csv reports into the directory.
+ *   --baseline-dir  Compare against the <case>.csv reports in the directory; the exit status is 1 if any size of any
+ *                   case is significantly slower.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <numeric/benchmark/benchmark.hpp>
+#include <numeric/benchmark/instrumentation.hpp>
+#include <numeric/benchmark/report.hpp>
+#include <numeric/math/gaussjordan.hpp>
+#include <numeric/math/rref.hpp>
+#include <numeric/math/vectorspaces.hpp>
+#include <numeric/types/fraction.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/models.hpp>
+#include <numeric/types/vector.hpp>
+
+using numeric::benchmark::Benchmark;
+using numeric::benchmark::BenchmarkOptions;
+using numeric::benchmark::Comparison;
+using numeric::benchmark::ReportOptions;
+using numeric::types::Fraction;
+using numeric::types::Matrix;
+using numeric::types::RunInfo;
+using numeric::types::Vector;
+
+namespace {
+    struct Settings {
+        bool quick {false};
+        std::string filter {};
+        std::string reportDir {};
+        std::string baselineDir {};
+    };
+
+    // Matrices and vectors cannot be copied, and the DUT takes its input by value, so inputs are shared pointers.
+    struct MatrixPair {
+        Matrix<double> lhs;
+        Matrix<double> rhs;
+    };
+
+    struct MatrixAndVector {
+        Matrix<double> matrix;
+        Vector<double> vector;
+    };
+
+    struct VectorPair {
+        Vector<double> lhs;
+        Vector<double> rhs;
+    };
+
+    // Elimination works in place: every iteration first copies `source` into `work` (an n^2 copy, small next to the n^3
+    // elimination).
+    template <typename T> struct Elimination {
+        Matrix<T> source;
+        Matrix<T> work;
+
+        void reset() {
+            for (std::size_t i = 0; i < source.getRows(); i++) {
+                std::copy(source.rowPtr(i), source.rowPtr(i) + source.getCols(), work.rowPtr(i));
+            }
+        }
+    };
+
+    struct VectorSet {
+        std::vector<Vector<double>> vectors;
+    };
+
+    std::mt19937& generator() {
+        static std::mt19937 mt(20240601);
+        return mt;
+    }
+
+    void randomize(Matrix<double>& matrix) {
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        for (std::size_t i = 0; i < matrix.getRows(); i++) {
+            for (std::size_t j = 0; j < matrix.getCols(); j++) {
+                matrix.atUnchecked(i, j) = dist(generator());
+            }
+        }
+    }
+
+    void randomize(Matrix<Fraction>& matrix) {
+        std::uniform_int_distribution<int> dist(-9, 9);
+        for (std::size_t i = 0; i < matrix.getRows(); i++) {
+            for (std::size_t j = 0; j < matrix.getCols(); j++) {
+                matrix.atUnchecked(i, j) = Fraction {dist(generator())};
+            }
+        }
+    }
+
+    void randomize(Vector<double>& vec) {
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        for (std::size_t i = 0; i < vec.size(); i++) {
+            vec.atUnchecked(i) = dist(generator());
+        }
+    }
+
+    template <typename T> std::shared_ptr<Elimination<T>> makeElimination(const unsigned long& n) {
+        auto retval {std::make_shared<Elimination<T>>(Elimination<T> {Matrix<T> {n, n + 1}, Matrix<T> {n, n + 1}})};
+        randomize(retval->source);
+        return retval;
+    }
+
+    /**
+     * One case of the suite: the sizes, and a function running the benchmark over them.
+     */
+    struct Case {
+        std::string name;
+        std::vector<unsigned long> sizes;
+        std::vector<unsigned long> quickSizes;
+        std::function<double(const unsigned long&)> work;
+        std::string workUnit;
+        std::function<std::map<unsigned long, RunInfo>(std::vector<RunInfo>&, const BenchmarkOptions&)> run;
+    };
+
+    template <typename Input, typename Output> std::function<std::map<unsigned long, RunInfo>(std::vector<RunInfo>&, const BenchmarkOptions&)>
+    runner(std::function<Input(const unsigned long&)> gen, std::function<Output(Input)> dut) {
+        return [gen, dut](std::vector<RunInfo>& runs, const BenchmarkOptions& options) {
+            Benchmark<Input, Output, std::vector<RunInfo>::iterator> bm {gen, dut, runs.begin(), runs.end(), options};
+            bm.run();
+            return bm.get_run_infos();
+        };
+    }
+
+    std::vector<Case> suite() {
+        std::vector<Case> cases {};
+
+        cases.push_back(Case {
+            "matrix_matrix_double", {16, 32, 64, 128, 256, 512}, {16, 32, 64},
+            [](const unsigned long& n) {return 2.0*n*n*n;}, "FLOP",
+            runner<std::shared_ptr<MatrixPair>, double>(
+                [](const unsigned long& n) {
+                    auto retval {std::make_shared<MatrixPair>(MatrixPair {Matrix<double> {n, n}, Matrix<double> {n, n}})};
+                    randomize(retval->lhs);
+                    randomize(retval->rhs);
+                    return retval;
+                },
+                [](std::shared_ptr<MatrixPair> input) {
+                    const Matrix<double> product {input->lhs*input->rhs};
+                    return product.atUnchecked(0, 0);
+                }
+            )
+        });
+
+        cases.push_back(Case {
+            "matrix_vector_double", {64, 256, 1024, 4096}, {64, 256},
+            [](const unsigned long& n) {return 2.0*n*n;}, "FLOP",
+            runner<std::shared_ptr<MatrixAndVector>, double>(
+                [](const unsigned long& n) {
+                    auto retval {std::make_shared<MatrixAndVector>(MatrixAndVector {Matrix<double> {n, n}, Vector<double> {n}})};
+                    randomize(retval->matrix);
+                    randomize(retval->vector);
+                    return retval;
+                },
+                [](std::shared_ptr<MatrixAndVector> input) {
+                    const Vector<double> product {input->matrix*input->vector};
+                    return product.atUnchecked(0);
+                }
+            )
+        });
+
+        cases.push_back(Case {
+            "vector_dot_double", {1000, 10000, 100000, 1000000}, {1000, 10000},
+            [](const unsigned long& n) {return 2.0*n;}, "FLOP",
+            runner<std::shared_ptr<VectorPair>, double>(
+                [](const unsigned long& n) {
+                    auto retval {std::make_shared<VectorPair>(VectorPair {Vector<double> {n}, Vector<double> {n}})};
+                    randomize(retval->lhs);
+                    randomize(retval->rhs);
+                    return retval;
+                },
+                [](std::shared_ptr<VectorPair> input) {return input->lhs*input->rhs;}
+            )
+        });
+
+        cases.push_back(Case {
+            "vector_mod_double", {1000, 10000, 100000, 1000000}, {1000, 10000},
+            [](const unsigned long& n) {return 2.0*n;}, "FLOP",
+            runner<std::shared_ptr<VectorPair>, double>(
+                [](const unsigned long& n) {
+                    auto retval {std::make_shared<VectorPair>(VectorPair {Vector<double> {n}, Vector<double> {1}})};
+                    randomize(retval->lhs);
+                    return retval;
+                },
+                [](std::shared_ptr<VectorPair> input) {
+                    // mod() is cached until the vector changes, so drop the cache to time the reduction on every call.
+                    input->lhs.invalidate_mod();
+                    return input->lhs.mod();
+                }
+            )
+        });
+
+        cases.push_back(Case {
+            "rref_double", {16, 32, 64, 128, 256}, {16, 32},
+            [](const unsigned long& n) {return 2.0*n*n*n;}, "FLOP",
+            runner<std::shared_ptr<Elimination<double>>, bool>(
+                makeElimination<double>,
+                [](std::shared_ptr<Elimination<double>> input) {
+                    input->reset();
+                    return static_cast<bool>(numeric::functions::rref(input->work));
+                }
+            )
+        });
+
+        cases.push_back(Case {
+            "rref_fraction", {4, 8, 12, 16}, {4, 8},
+            [](const unsigned long& n) {return 2.0*n*n*n;}, "ops",
+            runner<std::shared_ptr<Elimination<Fraction>>, bool>(
+                makeElimination<Fraction>,
+                [](std::shared_ptr<Elimination<Fraction>> input) {
+                    input->reset();
+                    return static_cast<bool>(numeric::functions::rref(input->work));
+                }
+            )
+        });
+
+        cases.push_back(Case {
+            "gauss_jordan_double", {16, 32, 64, 128, 256}, {16, 32},
+            [](const unsigned long& n) {return 2.0*n*n*n;}, "FLOP",
+            runner<std::shared_ptr<Elimination<double>>, bool>(
+                makeElimination<double>,
+                [](std::shared_ptr<Elimination<double>> input) {
+                    input->reset();
+                    return static_cast<bool>(numeric::functions::gauss_jordan(input->work));
+                }
+            )
+        });
+
+        cases.push_back(Case {
+            "linear_independence_double", {4, 16, 64, 128}, {4, 16},
+            [](const unsigned long& n) {return 2.0*n*n*n;}, "FLOP",
+            runner<std::shared_ptr<VectorSet>, bool>(
+                [](const unsigned long& n) {
+                    auto retval {std::make_shared<VectorSet>()};
+                    for (unsigned long i = 0; i < n; i++) {
+                        retval->vectors.emplace_back(n);
+                        randomize(retval->vectors.back());
+                    }
+                    return retval;
+                },
+                [](std::shared_ptr<VectorSet> input) {
+                    std::vector<std::reference_wrapper<Vector<double>>> refs {};
+                    for (Vector<double>& vec : input->vectors) {
+                        refs.push_back(std::ref(vec));
+                    }
+                    auto result {numeric::functions::linear_independence_of_system(refs)};
+                    return result && result.unwrap();
+                }
+            )
+        });
+
+        return cases;
+    }
+
+    // Enough iterations for about 0.2 s per size (0.02 s with --quick), within [5, 100000]. The time of 1 iteration is
+    // measured first, with a single call per size.
+    std::vector<RunInfo> runInfos(const Case& benchCase, const Settings& settings) {
+        std::vector<RunInfo> calibration {};
+        for (const unsigned long& size : settings.quick? benchCase.quickSizes : benchCase.sizes) {
+            calibration.push_back(RunInfo {size, 1UL});
+        }
+        BenchmarkOptions options {};
+        options.samples = 1;
+        options.inputPoolSize = 1;
+        const double budget {settings.quick? 20.0 : 200.0};
+        std::vector<RunInfo> retval {};
+        for (const auto& [size, run] : benchCase.run(calibration, options)) {
+            const double iterations {std::clamp(std::ceil(budget/std::max(run.runTimeInMillis, 1e-6)), 5.0, 100000.0)};
+            retval.push_back(RunInfo {size, static_cast<unsigned long>(iterations)});
+        }
+        return retval;
+    }
+
+    bool parse(int argc, char** argv, Settings& settings) {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg {argv[i]};
+            const bool hasValue {i + 1 < argc};
+            if (arg == "--quick") {
+                settings.quick = true;
+            } else if (arg == "--filter" && hasValue) {
+                settings.filter = argv[++i];
+            } else if (arg == "--report-dir" && hasValue) {
+                settings.reportDir = argv[++i];
+            } else if (arg == "--baseline-dir" && hasValue) {
+                settings.baselineDir = argv[++i];
+            } else {
+                std::cerr << "Usage: " << argv[0]
+                    << " [--quick] [--filter <substring>] [--report-dir <dir>] [--baseline-dir <dir>]\n";
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    Settings settings {};
+    if (!parse(argc, argv, settings)) {
+        return 2;
+    }
+
+    const numeric::benchmark::BuildInfo build {numeric::benchmark::build_info()};
+    std::cout << build.compiler << ", C++ " << build.standard << (build.optimized? ", optimized" : ", NOT optimized")
+        << (build.assertions? ", assertions on" : "") << ", " << build.instructionSet << "\n\n";
+    std::cout << std::left << std::setw(28) << "case" << std::right << std::setw(10) << "size" << std::setw(14) << "median ns"
+        << std::setw(14) << "p99 ns" << std::setw(20) << "throughput" << "\n";
+
+    bool slowdown {false};
+    for (const Case& benchCase : suite()) {
+        if (benchCase.name.find(settings.filter) == std::string::npos) {
+            continue;
+        }
+        std::vector<RunInfo> runs {runInfos(benchCase, settings)};
+        numeric::benchmark::reset_instrumentation();
+        BenchmarkOptions options {};
+        options.samples = 10;
+        options.warmupIterations = 2;
+        const std::map<unsigned long, RunInfo> results {benchCase.run(runs, options)};
+
+        ReportOptions report {};
+        report.name = benchCase.name;
+        report.work = benchCase.work;
+        report.workUnit = benchCase.workUnit;
+        for (const auto& [size, run] : results) {
+            const double throughput {benchCase.work(size)/(run.runTimeInMillis*1e-3)};
+            std::cout << std::left << std::setw(28) << benchCase.name << std::right << std::setw(10) << size
+                << std::setw(14) << std::fixed << std::setprecision(0) << run.nanosPerIteration.median
+                << std::setw(14) << run.nanosPerIteration.p99
+                << std::setw(14) << std::setprecision(3) << throughput*1e-9 << " G" << benchCase.workUnit << "/s\n";
+        }
+
+        // With the instrumentation option, the counters of the case share its name.
+        if constexpr (numeric::benchmark::INSTRUMENTATION_ENABLED) {
+            const numeric::benchmark::InstrumentationStats stats {numeric::benchmark::instrumentation_stats()};
+            const numeric::benchmark::KernelStats* kernel {stats.find(benchCase.name)};
+            std::cout << "  " << (kernel ? kernel->calls : 0) << " calls, " << stats.allocations << " allocations ("
+                << stats.bytesAllocated << " bytes), " << stats.rowSwaps << " row swaps, " << stats.pivotFailures
+                << " pivot failures\n";
+        }
+
+        if (!settings.reportDir.empty()) {
+            std::ofstream json {settings.reportDir + "/" + benchCase.name + ".json"};
+            numeric::benchmark::write_json(json, results, report);
+            std::ofstream csv {settings.reportDir + "/" + benchCase.name + ".csv"};
+            numeric::benchmark::write_csv(csv, results, report);
+        }
+
+        if (!settings.baselineDir.empty()) {
+            std::ifstream csv {settings.baselineDir + "/" + benchCase.name + ".csv"};
+            if (!csv) {
+                std::cout << "  no baseline for " << benchCase.name << "\n";
+                continue;
+            }
+            for (const Comparison& comparison : numeric::benchmark::compare_to_baseline(numeric::benchmark::read_csv(csv), results)) {
+                if (comparison.slowdown) {
+                    slowdown = true;
+                    std::cout << "  SLOWER: " << benchCase.name << " size " << comparison.inputSize << ": "
+                        << std::setprecision(1) << comparison.relativeChange*100 << "% (t = " << comparison.tStatistic << ")\n";
+                }
+            }
+        }
+    }
+    return slowdown? 1 : 0;
+}
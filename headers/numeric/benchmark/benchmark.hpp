@@ -1,11 +1,22 @@
 #ifndef __SIGABRT_NUMERIC_BENCHMARK__
 #define __SIGABRT_NUMERIC_BENCHMARK__
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <functional>
 #include <iostream>
 #include <map>
+#include <optional>
+#include <type_traits>
+#include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include <numeric/benchmark/counters.hpp>
 #include <numeric/types/models.hpp>
 
 #include <thesoup/types/types.hpp>
@@ -22,7 +33,98 @@ namespace numeric {
      * \brief Sub namespace with all numeric classes and functions.
      * */
     namespace benchmark {
-        
+        /**
+         * \brief Make the compiler believe that `value` is read, so that the computation producing it cannot be optimized
+         * out. Costs nothing at run time (with GCC and Clang it is an empty inline assembly statement).
+         * */
+        template <typename T> inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+            __asm__ __volatile__("" : : "m"(value) : "memory");
+#else
+            const volatile char sink {*reinterpret_cast<const volatile char*>(&value)};
+            static_cast<void>(sink);
+#endif
+        }
+
+        /**
+         * \class BenchmarkOptions
+         *
+         * \brief How a `Benchmark` measures.
+         *
+         * \var warmupIterations Untimed calls of the DUT for each input size, before the measurement (to warm the caches
+         * and the branch predictors, and to page in the inputs).
+         *
+         * \var samples The iterations of each input size are split into this many samples (at most one per iteration),
+         * which are timed separately. The distribution is over the samples, so it only shows outliers as large as a sample.
+         *
+         * \var hardwareCounters Whether to read cycles, instructions and cache misses (see `HardwareCounters`).
+         *
+         * \var inputPoolSize The number of inputs generated for each input size; the iterations rotate through them. The
+         * default of 2 alternates between 2 inputs. To measure with cold caches, make the pool larger than the last level
+         * cache (see `inputs_exceeding_cache`), and use an `Input` that is cheap to copy (a pointer or a `shared_ptr`),
+         * since the DUT takes its input by value.
+         * */
+        struct BenchmarkOptions {
+            unsigned long warmupIterations {0};
+            unsigned long samples {10};
+            bool hardwareCounters {false};
+            unsigned long inputPoolSize {2};
+        };
+
+        /**
+         * \brief Size of the last level cache in bytes, as reported by the C library (32 MiB if it does not say).
+         * */
+        inline std::size_t last_level_cache_bytes() {
+#if defined(_SC_LEVEL3_CACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+            for (const int name : {_SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE}) {
+                const long size {sysconf(name)};
+                if (size > 0) {
+                    return static_cast<std::size_t>(size);
+                }
+            }
+#endif
+            return 32*1024*1024;
+        }
+
+        /**
+         * \brief The number of inputs of `bytesPerInput` bytes which together take `factor` times the last level cache.
+         *
+         * Use it as the `inputPoolSize`, so that every iteration finds its input evicted from the caches. Never less than 2.
+         * */
+        inline unsigned long inputs_exceeding_cache(const std::size_t& bytesPerInput, const double& factor=2.0) {
+            const double inputs {std::ceil(factor*static_cast<double>(last_level_cache_bytes())/static_cast<double>(std::max<std::size_t>(bytesPerInput, 1)))};
+            return std::max(2UL, static_cast<unsigned long>(inputs));
+        }
+
+        //! \cond NO_DOC
+        namespace detail {
+            inline numeric::types::TimingStatistics summarize(std::vector<double> samples) {
+                numeric::types::TimingStatistics retval {};
+                if (samples.empty()) {
+                    return retval;
+                }
+                std::sort(samples.begin(), samples.end());
+                const std::size_t n {samples.size()};
+                retval.samples = n;
+                retval.min = samples.front();
+                retval.median = n % 2 == 1? samples[n/2] : (samples[n/2 - 1] + samples[n/2])/2.0;
+                // Nearest rank percentile.
+                retval.p99 = samples[static_cast<std::size_t>(std::ceil(0.99*static_cast<double>(n))) - 1];
+                double sum {0.0};
+                for (const double& sample : samples) {
+                    sum += sample;
+                }
+                retval.mean = sum/static_cast<double>(n);
+                double squares {0.0};
+                for (const double& sample : samples) {
+                    squares += (sample - retval.mean)*(sample - retval.mean);
+                }
+                retval.stddev = n > 1? std::sqrt(squares/static_cast<double>(n - 1)) : 0.0;
+                return retval;
+            }
+        }
+        //! \endcond
+
         /**
          * \class Benchmark
          * 
@@ -46,7 +148,11 @@ namespace numeric {
          * To compensate for the difficulty in setup of the benchmarking framework, there are Range classes that implement
          * input size - iteration mappings of logarithmic, linear and constant types.
          * 
-         * The run times are saved in a map of input size vs run info.
+         * The run times are saved in a map of input size vs run info. For each input size, the DUT is first called
+         * `warmupIterations` times untimed, then the iterations are timed in `samples` batches with a steady clock. The
+         * run info gets the mean time per iteration in milliseconds, and the distribution (min, median, p99, mean and
+         * standard deviation) of the time per iteration over the samples, in nanoseconds. The output of every call goes
+         * through `do_not_optimize`, so the compiler cannot drop the work.
          * 
          * */
         template <typename Input, typename Output, typename It> class Benchmark {
@@ -59,6 +165,7 @@ namespace numeric {
             std::function<Output(Input)> dut;
             It start;
             It end;
+            BenchmarkOptions options;
             std::map<unsigned long, numeric::types::RunInfo> run_times {};
         
         public:
@@ -74,13 +181,16 @@ namespace numeric {
              * \param start (forward_iterator) start iterator of the input ranges.
              * 
              * \param end (forward_iterator) end iterator of input ranges.
+             * 
+             * \param options (BenchmarkOptions) Warmup, number of samples and hardware counters.
              * */
             Benchmark(
                 const std::function<Input(const unsigned long&)>& input_gen,
                 const std::function<Output(Input)>& dut,
                 const It& start,
-                const It& end
-            ) : input_gen {input_gen}, dut {dut}, start {start}, end {end} {}
+                const It& end,
+                const BenchmarkOptions& options=BenchmarkOptions {}
+            ) : input_gen {input_gen}, dut {dut}, start {start}, end {end}, options {options} {}
 
             
             /**
@@ -96,20 +206,54 @@ namespace numeric {
                 for (auto it = start; it < end; it++) {
                     numeric::types::RunInfo run {*it};
                     
-                    auto input1 {input_gen(run.inputSize)};
-                    auto input2 {input_gen(run.inputSize)};
+                    std::vector<Input> inputs {};
+                    inputs.reserve(std::max(options.inputPoolSize, 1UL));
+                    for (unsigned long i = 0; i < std::max(options.inputPoolSize, 1UL); i++) {
+                        inputs.push_back(input_gen(run.inputSize));
+                    }
+                    
+                    auto call {[&](const unsigned long& i) {
+                        if constexpr (std::is_void<Output>::value) {
+                            dut(inputs[i % inputs.size()]);
+                        } else {
+                            const auto output {dut(inputs[i % inputs.size()])};
+                            do_not_optimize(output);
+                        }
+                    }};
                     
-                    // Run all iterations for that input size.
-                    auto startTime {std::chrono::high_resolution_clock::now()};
-                    for (unsigned long i = 0; i < run.iterations; i++) {
-                        i%2 == 0? dut(input1) : dut(input2);
+                    for (unsigned long i = 0; i < options.warmupIterations; i++) {
+                        call(i);
                     }
-                    auto endTime {std::chrono::high_resolution_clock::now()};
                     
-                    auto start {std::chrono::time_point_cast<std::chrono::microseconds>(startTime).time_since_epoch()};
-                    auto end {std::chrono::time_point_cast<std::chrono::microseconds>(endTime).time_since_epoch()};
+                    // Run all iterations for that input size, in samples.
+                    const unsigned long numSamples {std::min(std::max(options.samples, 1UL), run.iterations)};
+                    std::vector<double> samples {};
+                    samples.reserve(numSamples);
+                    std::chrono::steady_clock::duration total {0};
+                    std::optional<HardwareCounters> counters {};
+                    if (options.hardwareCounters) {
+                        counters.emplace();
+                        counters->start();
+                    }
+                    unsigned long i {0};
+                    for (unsigned long sample = 0; sample < numSamples; sample++) {
+                        const unsigned long count {run.iterations/numSamples + (sample < run.iterations % numSamples? 1 : 0)};
+                        const auto startTime {std::chrono::steady_clock::now()};
+                        for (unsigned long j = 0; j < count; j++, i++) {
+                            call(i);
+                        }
+                        const auto elapsed {std::chrono::steady_clock::now() - startTime};
+                        total += elapsed;
+                        samples.push_back(std::chrono::duration<double, std::nano>(elapsed).count()/static_cast<double>(count));
+                    }
+                    if (counters) {
+                        run.counters = counters->stop(run.iterations);
+                    }
                     
-                    run.runTimeInMillis = static_cast<double>((end - start).count())/static_cast<double>(run.iterations);
+                    if (run.iterations > 0) {
+                        run.runTimeInMillis = std::chrono::duration<double, std::milli>(total).count()/static_cast<double>(run.iterations);
+                    }
+                    run.nanosPerIteration = detail::summarize(samples);
                     run_times[run.inputSize] = run;
                 }
                 return *this;
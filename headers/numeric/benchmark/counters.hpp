@@ -0,0 +1,145 @@
+#ifndef __SIGABRT_NUMERIC_COUNTERS__
+#define __SIGABRT_NUMERIC_COUNTERS__
+
+#include <cstdint>
+#include <cstring>
+
+#include <numeric/types/models.hpp>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::benchmark
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace benchmark {
+        /**
+         * \class HardwareCounters
+         *
+         * \brief Cycles, instructions and cache misses of the calling thread, through Linux perf events.
+         *
+         * The three counters are opened as one group, so they are always scheduled (and multiplexed) together. Only user
+         * space is counted, which is what an unprivileged process is allowed to count with the default
+         * `perf_event_paranoid` setting.
+         *
+         * If the counters cannot be opened (not Linux, no permission, or no PMU, as in many virtual machines), `available`
+         * is false, and `stop` returns a `CounterValues` with `available` unset: benchmarks still run, just without the
+         * counters.
+         * */
+        class HardwareCounters {
+        private:
+            enum {CYCLES, INSTRUCTIONS, CACHE_MISSES, NUM_COUNTERS};
+
+            int fds[NUM_COUNTERS] {-1, -1, -1};
+
+#if defined(__linux__)
+            static int open(const std::uint64_t& config, const int& groupFd) {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = config;
+                attr.disabled = groupFd == -1? 1 : 0;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP;
+                return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+            }
+#endif
+
+            void close() {
+                for (int& fd : fds) {
+#if defined(__linux__)
+                    if (fd != -1) {
+                        ::close(fd);
+                    }
+#endif
+                    fd = -1;
+                }
+            }
+
+        public:
+            HardwareCounters() {
+#if defined(__linux__)
+                const std::uint64_t configs[NUM_COUNTERS] {
+                    PERF_COUNT_HW_CPU_CYCLES,
+                    PERF_COUNT_HW_INSTRUCTIONS,
+                    PERF_COUNT_HW_CACHE_MISSES
+                };
+                for (int i = 0; i < NUM_COUNTERS; i++) {
+                    fds[i] = open(configs[i], fds[CYCLES]);
+                    if (fds[i] == -1) {
+                        close();
+                        return;
+                    }
+                }
+#endif
+            }
+
+            HardwareCounters(const HardwareCounters& other)=delete;
+            void operator=(const HardwareCounters& other)=delete;
+
+            ~HardwareCounters() {
+                close();
+            }
+
+            bool available() const {
+                return fds[CYCLES] != -1;
+            }
+
+            /**
+             * \brief Reset the counters to 0, and start counting.
+             * */
+            void start() {
+#if defined(__linux__)
+                if (available()) {
+                    ioctl(fds[CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                    ioctl(fds[CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+                }
+#endif
+            }
+
+            /**
+             * \brief Stop counting.
+             *
+             * \param iterations The counts are divided by this, to give the counts per iteration.
+             *
+             * \return The counts since `start`, per iteration.
+             * */
+            numeric::types::CounterValues stop(const unsigned long& iterations) {
+                numeric::types::CounterValues retval {};
+#if defined(__linux__)
+                if (available()) {
+                    ioctl(fds[CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+                    // With PERF_FORMAT_GROUP, a read gives the number of counters followed by their values.
+                    std::uint64_t values[1 + NUM_COUNTERS] {};
+                    if (read(fds[CYCLES], values, sizeof(values)) == static_cast<ssize_t>(sizeof(values)) && values[0] == NUM_COUNTERS) {
+                        const double divisor {static_cast<double>(iterations == 0? 1 : iterations)};
+                        retval.available = true;
+                        retval.cycles = static_cast<double>(values[1 + CYCLES])/divisor;
+                        retval.instructions = static_cast<double>(values[1 + INSTRUCTIONS])/divisor;
+                        retval.cacheMisses = static_cast<double>(values[1 + CACHE_MISSES])/divisor;
+                    }
+                }
+#else
+                static_cast<void>(iterations);
+#endif
+                return retval;
+            }
+        };
+    }
+}
+
+#endif
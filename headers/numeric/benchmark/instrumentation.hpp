@@ -0,0 +1,281 @@
+#ifndef __SIGABRT_NUMERIC_INSTRUMENTATION__
+#define __SIGABRT_NUMERIC_INSTRUMENTATION__
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    namespace types {
+        struct Fraction;
+        class Rational;
+    }
+
+    /**
+     * \namespace numeric::benchmark
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace benchmark {
+        /**
+         * \brief Whether the library was built with `NUMERIC_INSTRUMENTATION` defined (the `instrumentation` meson
+         * option).
+         *
+         * Without it, the hooks below are empty inline functions and an empty `ScopedTimer`, which compile to nothing,
+         * and `instrumentation_stats` reports zeros. Every translation unit of a program has to agree on the macro.
+         * */
+#if defined(NUMERIC_INSTRUMENTATION)
+        constexpr bool INSTRUMENTATION_ENABLED {true};
+#else
+        constexpr bool INSTRUMENTATION_ENABLED {false};
+#endif
+
+        /**
+         * \enum Kernel
+         *
+         * The instrumented kernels. With the element type, they make the ids of `KernelStats`, which are the case names
+         * of numeric-bench: `rref` on doubles is `rref_double`, `operator*` on two double matrices is
+         * `matrix_matrix_double`.
+         *   - `MATRIX_MATRIX`: `Matrix * Matrix`, views included.
+         *   - `MATRIX_VECTOR`: `Matrix * Vector` and `Vector * Matrix`, views included.
+         *   - `VECTOR_DOT`: `Vector * Vector`.
+         *   - `VECTOR_MOD`: `Vector::mod`, cached calls included.
+         *   - `RREF`: `rref`, every overload, and `parallel_rref` on matrices large enough to be blocked.
+         *   - `GAUSS_JORDAN`: `gauss_jordan`.
+         *   - `LINEAR_INDEPENDENCE`: `linear_independence_of_system`.
+         * */
+        enum class Kernel {
+            MATRIX_MATRIX,
+            MATRIX_VECTOR,
+            VECTOR_DOT,
+            VECTOR_MOD,
+            RREF,
+            GAUSS_JORDAN,
+            LINEAR_INDEPENDENCE
+        };
+
+        /**
+         * \class KernelStats
+         *
+         * \brief What one kernel did on one element type.
+         *
+         * \var id The benchmark id, like `rref_double`.
+         * \var calls The number of calls.
+         * \var nanoseconds The total time in the calls. Kernels calling other kernels (`gauss_jordan` runs `rref`) count
+         * the time in both.
+         * */
+        struct KernelStats {
+            std::string id;
+            std::uint64_t calls;
+            std::uint64_t nanoseconds;
+        };
+
+        /**
+         * \class InstrumentationStats
+         *
+         * \brief A snapshot of the instrumentation counters, from `instrumentation_stats`.
+         *
+         * \var kernels The kernels that were called, on every element type they were called on.
+         * \var allocations The number of arrays allocated by `make_buffer`, which holds the elements (and the row tables)
+         * of `Matrix`, `Vector` and the other containers.
+         * \var bytesAllocated The size of these arrays.
+         * \var rowSwaps The number of `exchangeRows` calls on matrices and views, including the ones of the eliminations.
+         * \var pivotFailures The number of columns `rref`, `parallel_rref` and `LUDecomposition` found no pivot for.
+         * */
+        struct InstrumentationStats {
+            std::vector<KernelStats> kernels;
+            std::uint64_t allocations;
+            std::uint64_t bytesAllocated;
+            std::uint64_t rowSwaps;
+            std::uint64_t pivotFailures;
+
+            /**
+             * \brief The stats of a kernel by its benchmark id, or null if it was not called.
+             * */
+            const KernelStats* find(const std::string& id) const {
+                for (const KernelStats& stats : kernels) {
+                    if (stats.id == id) {
+                        return &stats;
+                    }
+                }
+                return nullptr;
+            }
+        };
+
+        //! \cond NO_DOC
+        namespace detail {
+            constexpr std::size_t NUM_KERNELS {7};
+            constexpr std::size_t NUM_ELEMENT_TYPES {7};
+
+            constexpr const char* KERNEL_NAMES[NUM_KERNELS] {
+                "matrix_matrix", "matrix_vector", "vector_dot", "vector_mod", "rref", "gauss_jordan", "linear_independence"
+            };
+            constexpr const char* ELEMENT_TYPE_NAMES[NUM_ELEMENT_TYPES] {
+                "float", "double", "int", "long", "fraction", "rational", "other"
+            };
+
+            // The column of the counters of an element type.
+            template <typename T> struct ElementTypeIndex {
+                static constexpr std::size_t value {6};
+            };
+            template <> struct ElementTypeIndex<float> {
+                static constexpr std::size_t value {0};
+            };
+            template <> struct ElementTypeIndex<double> {
+                static constexpr std::size_t value {1};
+            };
+            template <> struct ElementTypeIndex<int> {
+                static constexpr std::size_t value {2};
+            };
+            template <> struct ElementTypeIndex<long> {
+                static constexpr std::size_t value {3};
+            };
+            template <> struct ElementTypeIndex<numeric::types::Fraction> {
+                static constexpr std::size_t value {4};
+            };
+            template <> struct ElementTypeIndex<numeric::types::Rational> {
+                static constexpr std::size_t value {5};
+            };
+
+            struct Counters {
+                std::atomic<std::uint64_t> calls[NUM_KERNELS][NUM_ELEMENT_TYPES] {};
+                std::atomic<std::uint64_t> nanoseconds[NUM_KERNELS][NUM_ELEMENT_TYPES] {};
+                std::atomic<std::uint64_t> allocations {0};
+                std::atomic<std::uint64_t> bytesAllocated {0};
+                std::atomic<std::uint64_t> rowSwaps {0};
+                std::atomic<std::uint64_t> pivotFailures {0};
+            };
+
+            // One set for the program. The counters are only ever added to, so relaxed atomics are enough.
+            inline Counters& counters() {
+                static Counters instance {};
+                return instance;
+            }
+        }
+        //! \endcond
+
+        /**
+         * \class ScopedTimer
+         *
+         * \tparam T The element type the kernel runs on.
+         *
+         * \brief Counts a call of a kernel, and adds the time until the end of the scope to it.
+         *
+         * The library puts one at the top of every instrumented kernel. Wrap other code in one to see it next to them.
+         * Without `NUMERIC_INSTRUMENTATION`, this is an empty object.
+         * */
+        template <typename T> class ScopedTimer {
+#if defined(NUMERIC_INSTRUMENTATION)
+        private:
+            std::size_t kernel;
+            std::chrono::steady_clock::time_point start;
+
+        public:
+            explicit ScopedTimer(const Kernel& kernel):
+                kernel {static_cast<std::size_t>(kernel)}, start {std::chrono::steady_clock::now()} {}
+
+            ~ScopedTimer() {
+                const auto elapsed {std::chrono::steady_clock::now() - start};
+                constexpr std::size_t type {detail::ElementTypeIndex<T>::value};
+                detail::counters().calls[kernel][type].fetch_add(1, std::memory_order_relaxed);
+                detail::counters().nanoseconds[kernel][type].fetch_add(
+                    static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                    std::memory_order_relaxed);
+            }
+#else
+        public:
+            explicit ScopedTimer(const Kernel&) {}
+#endif
+
+            ScopedTimer(const ScopedTimer<T>& other)=delete;
+            void operator=(const ScopedTimer<T>& other)=delete;
+        };
+
+        /**
+         * \brief Hook for an allocation of `bytes` bytes.
+         * */
+        inline void record_allocation([[maybe_unused]] const std::size_t& bytes) {
+#if defined(NUMERIC_INSTRUMENTATION)
+            detail::counters().allocations.fetch_add(1, std::memory_order_relaxed);
+            detail::counters().bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+#endif
+        }
+
+        /**
+         * \brief Hook for a row exchange.
+         * */
+        inline void record_row_swap() {
+#if defined(NUMERIC_INSTRUMENTATION)
+            detail::counters().rowSwaps.fetch_add(1, std::memory_order_relaxed);
+#endif
+        }
+
+        /**
+         * \brief Hook for a column without a usable pivot.
+         * */
+        inline void record_pivot_failure() {
+#if defined(NUMERIC_INSTRUMENTATION)
+            detail::counters().pivotFailures.fetch_add(1, std::memory_order_relaxed);
+#endif
+        }
+
+        /**
+         * \brief A snapshot of the counters since the start of the program, or the last `reset_instrumentation`.
+         *
+         * The counters are read one by one while other threads may be adding to them, so take the snapshot when the
+         * work of interest is done.
+         * */
+        inline InstrumentationStats instrumentation_stats() {
+            InstrumentationStats retval {{}, 0, 0, 0, 0};
+            if constexpr (INSTRUMENTATION_ENABLED) {
+                detail::Counters& counters {detail::counters()};
+                for (std::size_t k = 0; k < detail::NUM_KERNELS; k++) {
+                    for (std::size_t t = 0; t < detail::NUM_ELEMENT_TYPES; t++) {
+                        const std::uint64_t calls {counters.calls[k][t].load(std::memory_order_relaxed)};
+                        if (calls > 0) {
+                            retval.kernels.push_back(KernelStats {
+                                std::string {detail::KERNEL_NAMES[k]} + "_" + detail::ELEMENT_TYPE_NAMES[t],
+                                calls,
+                                counters.nanoseconds[k][t].load(std::memory_order_relaxed)
+                            });
+                        }
+                    }
+                }
+                retval.allocations = counters.allocations.load(std::memory_order_relaxed);
+                retval.bytesAllocated = counters.bytesAllocated.load(std::memory_order_relaxed);
+                retval.rowSwaps = counters.rowSwaps.load(std::memory_order_relaxed);
+                retval.pivotFailures = counters.pivotFailures.load(std::memory_order_relaxed);
+            }
+            return retval;
+        }
+
+        /**
+         * \brief Set every counter back to 0.
+         * */
+        inline void reset_instrumentation() {
+            if constexpr (INSTRUMENTATION_ENABLED) {
+                detail::Counters& counters {detail::counters()};
+                for (std::size_t k = 0; k < detail::NUM_KERNELS; k++) {
+                    for (std::size_t t = 0; t < detail::NUM_ELEMENT_TYPES; t++) {
+                        counters.calls[k][t].store(0, std::memory_order_relaxed);
+                        counters.nanoseconds[k][t].store(0, std::memory_order_relaxed);
+                    }
+                }
+                counters.allocations.store(0, std::memory_order_relaxed);
+                counters.bytesAllocated.store(0, std::memory_order_relaxed);
+                counters.rowSwaps.store(0, std::memory_order_relaxed);
+                counters.pivotFailures.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+#endif
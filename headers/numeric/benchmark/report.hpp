@@ -0,0 +1,372 @@
+#ifndef __SIGABRT_NUMERIC_REPORT__
+#define __SIGABRT_NUMERIC_REPORT__
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <locale>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <numeric/kernels/simd.hpp>
+#include <numeric/types/models.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::benchmark
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace benchmark {
+        /**
+         * \class BuildInfo
+         *
+         * \brief The build and the machine a report was made with, so that reports are only compared like for like.
+         * */
+        struct BuildInfo {
+            std::string compiler;
+            long standard;
+            bool optimized;
+            bool assertions;
+            std::string instructionSet;
+        };
+
+        /**
+         * \brief The `BuildInfo` of the calling code (compiler, flags) and of the CPU it runs on (best SIMD instruction set).
+         * */
+        inline BuildInfo build_info() {
+            BuildInfo retval {};
+#if defined(__clang__)
+            retval.compiler = std::string {"clang "} + __clang_version__;
+#elif defined(__GNUC__)
+            retval.compiler = std::string {"gcc "} + __VERSION__;
+#elif defined(_MSC_VER)
+            retval.compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+            retval.compiler = "unknown";
+#endif
+            retval.standard = __cplusplus;
+#if defined(__OPTIMIZE__)
+            retval.optimized = true;
+#else
+            retval.optimized = false;
+#endif
+#if defined(NDEBUG)
+            retval.assertions = false;
+#else
+            retval.assertions = true;
+#endif
+            switch (numeric::kernels::detected_instruction_set()) {
+                case numeric::kernels::InstructionSet::SSE2:
+                    retval.instructionSet = "SSE2";
+                    break;
+                case numeric::kernels::InstructionSet::AVX2:
+                    retval.instructionSet = "AVX2";
+                    break;
+                case numeric::kernels::InstructionSet::AVX512:
+                    retval.instructionSet = "AVX512";
+                    break;
+                case numeric::kernels::InstructionSet::NEON:
+                    retval.instructionSet = "NEON";
+                    break;
+                default:
+                    retval.instructionSet = "SCALAR";
+            }
+            return retval;
+        }
+
+        /**
+         * \class ReportOptions
+         *
+         * \brief What goes into a report, besides the run infos.
+         *
+         * \var name Name of the benchmark.
+         *
+         * \var work The work done by 1 iteration for an input size, in `workUnit`s (for example 2n^3 FLOP for an n x n
+         * matrix product). If this is not set, there is no throughput in the report.
+         *
+         * \var workUnit The unit of `work`. The throughput is reported in `workUnit`/s.
+         * */
+        struct ReportOptions {
+            std::string name {};
+            std::function<double(const unsigned long&)> work {};
+            std::string workUnit {"elements"};
+        };
+
+        //! \cond NO_DOC
+        namespace detail {
+            inline std::string jsonString(const std::string& value) {
+                std::string retval {"\""};
+                for (const char& c : value) {
+                    switch (c) {
+                        case '"':
+                            retval += "\\\"";
+                            break;
+                        case '\\':
+                            retval += "\\\\";
+                            break;
+                        case '\n':
+                            retval += "\\n";
+                            break;
+                        default:
+                            if (static_cast<unsigned char>(c) < 0x20) {
+                                static const char hex[] {"0123456789abcdef"};
+                                retval += "\\u00";
+                                retval += hex[(c >> 4) & 0xF];
+                                retval += hex[c & 0xF];
+                            } else {
+                                retval += c;
+                            }
+                    }
+                }
+                return retval + "\"";
+            }
+
+            // Numbers are written with the classic locale, and enough digits to read back the same double.
+            inline std::string number(const double& value) {
+                if (!std::isfinite(value)) {
+                    return "null";
+                }
+                std::ostringstream stream;
+                stream.imbue(std::locale::classic());
+                stream.precision(std::numeric_limits<double>::max_digits10);
+                stream << value;
+                return stream.str();
+            }
+
+            inline double throughput(const numeric::types::RunInfo& run, const ReportOptions& options) {
+                if (!options.work || run.runTimeInMillis <= 0) {
+                    return std::numeric_limits<double>::quiet_NaN();
+                }
+                return options.work(run.inputSize)/(run.runTimeInMillis*1e-3);
+            }
+        }
+        //! \endcond
+
+        /**
+         * \brief Write the results of a benchmark (`Benchmark::get_run_infos`) as a JSON document.
+         *
+         * The document has the name, the `build_info()`, the throughput unit if there is one, and a `runs` array with, for
+         * every input size, the iterations, the mean time in milliseconds, the distribution of the time per iteration in
+         * nanoseconds, the throughput and the hardware counters (when available). Throughputs which were not computed are
+         * `null`.
+         * */
+        inline void write_json(
+            std::ostream& stream,
+            const std::map<unsigned long, numeric::types::RunInfo>& runs,
+            const ReportOptions& options=ReportOptions {}
+        ) {
+            const BuildInfo build {build_info()};
+            stream << "{\n";
+            stream << "  \"name\": " << detail::jsonString(options.name) << ",\n";
+            stream << "  \"build\": {\n";
+            stream << "    \"compiler\": " << detail::jsonString(build.compiler) << ",\n";
+            stream << "    \"standard\": " << build.standard << ",\n";
+            stream << "    \"optimized\": " << (build.optimized? "true" : "false") << ",\n";
+            stream << "    \"assertions\": " << (build.assertions? "true" : "false") << ",\n";
+            stream << "    \"instructionSet\": " << detail::jsonString(build.instructionSet) << "\n";
+            stream << "  },\n";
+            stream << "  \"throughputUnit\": " << (options.work? detail::jsonString(options.workUnit + "/s") : "null") << ",\n";
+            stream << "  \"runs\": [";
+            bool first {true};
+            for (const auto& [inputSize, run] : runs) {
+                stream << (first? "\n" : ",\n");
+                first = false;
+                stream << "    {\n";
+                stream << "      \"inputSize\": " << inputSize << ",\n";
+                stream << "      \"iterations\": " << run.iterations << ",\n";
+                stream << "      \"meanMillis\": " << detail::number(run.runTimeInMillis) << ",\n";
+                stream << "      \"nanosPerIteration\": {";
+                stream << "\"min\": " << detail::number(run.nanosPerIteration.min);
+                stream << ", \"median\": " << detail::number(run.nanosPerIteration.median);
+                stream << ", \"p99\": " << detail::number(run.nanosPerIteration.p99);
+                stream << ", \"mean\": " << detail::number(run.nanosPerIteration.mean);
+                stream << ", \"stddev\": " << detail::number(run.nanosPerIteration.stddev);
+                stream << ", \"samples\": " << run.nanosPerIteration.samples << "},\n";
+                stream << "      \"throughput\": " << detail::number(detail::throughput(run, options));
+                if (run.counters.available) {
+                    stream << ",\n      \"counters\": {";
+                    stream << "\"cycles\": " << detail::number(run.counters.cycles);
+                    stream << ", \"instructions\": " << detail::number(run.counters.instructions);
+                    stream << ", \"cacheMisses\": " << detail::number(run.counters.cacheMisses) << "}";
+                }
+                stream << "\n    }";
+            }
+            stream << (first? "]\n" : "\n  ]\n");
+            stream << "}\n";
+        }
+
+        /**
+         * \brief Write the results of a benchmark as CSV, one row per input size, with a header row.
+         *
+         * The columns are `inputSize, iterations, meanMillis, minNanos, medianNanos, p99Nanos, meanNanos, stddevNanos,
+         * samples, throughput, cycles, instructions, cacheMisses`. Cells without a value (throughput not computed, counters
+         * unavailable) are empty. `read_csv` reads this back, which is how baselines are saved and loaded.
+         * */
+        inline void write_csv(
+            std::ostream& stream,
+            const std::map<unsigned long, numeric::types::RunInfo>& runs,
+            const ReportOptions& options=ReportOptions {}
+        ) {
+            auto cell {[](const double& value) {return std::isfinite(value)? detail::number(value) : std::string {};}};
+            stream << "inputSize,iterations,meanMillis,minNanos,medianNanos,p99Nanos,meanNanos,stddevNanos,samples,"
+                << "throughput,cycles,instructions,cacheMisses\n";
+            for (const auto& [inputSize, run] : runs) {
+                stream << inputSize << ',' << run.iterations << ',' << cell(run.runTimeInMillis) << ','
+                    << cell(run.nanosPerIteration.min) << ',' << cell(run.nanosPerIteration.median) << ','
+                    << cell(run.nanosPerIteration.p99) << ',' << cell(run.nanosPerIteration.mean) << ','
+                    << cell(run.nanosPerIteration.stddev) << ',' << run.nanosPerIteration.samples << ','
+                    << cell(detail::throughput(run, options));
+                if (run.counters.available) {
+                    stream << ',' << cell(run.counters.cycles) << ',' << cell(run.counters.instructions) << ','
+                        << cell(run.counters.cacheMisses) << '\n';
+                } else {
+                    stream << ",,,\n";
+                }
+            }
+        }
+
+        /**
+         * \brief Read run infos written by `write_csv`, for example a saved baseline.
+         *
+         * \throw e std::invalid_argument if the header or a row is malformed.
+         * */
+        inline std::map<unsigned long, numeric::types::RunInfo> read_csv(std::istream& stream) {
+            std::map<unsigned long, numeric::types::RunInfo> retval {};
+            std::string line;
+            if (!std::getline(stream, line) || line.rfind("inputSize,iterations,meanMillis,", 0) != 0) {
+                throw std::invalid_argument("Not a benchmark CSV report.");
+            }
+            while (std::getline(stream, line)) {
+                if (line.empty()) {
+                    continue;
+                }
+                std::vector<std::string> cells;
+                std::istringstream row {line};
+                std::string cell;
+                while (std::getline(row, cell, ',')) {
+                    cells.push_back(cell);
+                }
+                if (line.back() == ',') {
+                    cells.push_back("");
+                }
+                if (cells.size() != 13) {
+                    throw std::invalid_argument("Malformed benchmark CSV row: \"" + line + "\".");
+                }
+                auto value {[&](const std::size_t& i, const double& missing) {
+                    if (cells[i].empty()) {
+                        return missing;
+                    }
+                    std::istringstream cellStream {cells[i]};
+                    cellStream.imbue(std::locale::classic());
+                    double retval;
+                    if (!(cellStream >> retval)) {
+                        throw std::invalid_argument("Malformed benchmark CSV cell: \"" + cells[i] + "\".");
+                    }
+                    return retval;
+                }};
+                numeric::types::RunInfo run {};
+                run.inputSize = static_cast<unsigned long>(value(0, 0.0));
+                run.iterations = static_cast<unsigned long>(value(1, 0.0));
+                run.runTimeInMillis = value(2, -1.0);
+                run.nanosPerIteration.min = value(3, -1.0);
+                run.nanosPerIteration.median = value(4, -1.0);
+                run.nanosPerIteration.p99 = value(5, -1.0);
+                run.nanosPerIteration.mean = value(6, -1.0);
+                run.nanosPerIteration.stddev = value(7, -1.0);
+                run.nanosPerIteration.samples = static_cast<unsigned long>(value(8, 0.0));
+                run.counters.available = !cells[10].empty();
+                run.counters.cycles = value(10, 0.0);
+                run.counters.instructions = value(11, 0.0);
+                run.counters.cacheMisses = value(12, 0.0);
+                retval[run.inputSize] = run;
+            }
+            return retval;
+        }
+
+        /**
+         * \class ComparisonOptions
+         *
+         * \brief When a difference from the baseline counts as a slowdown.
+         *
+         * \var minRelativeSlowdown Slowdowns smaller than this fraction of the baseline (0.05 is 5%) are ignored, however
+         * consistent they are.
+         *
+         * \var minSignificance The Welch t statistic the difference of the mean times must exceed. The default of 3 is well
+         * beyond the one sided 99% quantile for the usual 10 or more samples per run.
+         * */
+        struct ComparisonOptions {
+            double minRelativeSlowdown {0.05};
+            double minSignificance {3.0};
+        };
+
+        /**
+         * \class Comparison
+         *
+         * \brief The comparison of 1 input size against the baseline. Times are the mean nanoseconds per iteration.
+         * */
+        struct Comparison {
+            unsigned long inputSize;
+            double baselineNanos;
+            double currentNanos;
+            double relativeChange;
+            double tStatistic;
+            bool slowdown;
+        };
+
+        /**
+         * \brief Compare benchmark results with a baseline, per input size.
+         *
+         * Only input sizes present in both are compared. A size is flagged as a `slowdown` when the mean time per iteration
+         * grew by more than `minRelativeSlowdown`, and the growth is statistically significant: Welch's t statistic over the
+         * samples of both runs exceeds `minSignificance`. Runs with a single sample (stddev 0) are judged on the relative
+         * change alone.
+         *
+         * \return One `Comparison` per common input size, in increasing input size order.
+         * */
+        inline std::vector<Comparison> compare_to_baseline(
+            const std::map<unsigned long, numeric::types::RunInfo>& baseline,
+            const std::map<unsigned long, numeric::types::RunInfo>& current,
+            const ComparisonOptions& options=ComparisonOptions {}
+        ) {
+            std::vector<Comparison> retval {};
+            for (const auto& [inputSize, run] : current) {
+                const auto it {baseline.find(inputSize)};
+                if (it == baseline.end() || it->second.nanosPerIteration.mean <= 0 || run.nanosPerIteration.mean <= 0) {
+                    continue;
+                }
+                const numeric::types::TimingStatistics& before {it->second.nanosPerIteration};
+                const numeric::types::TimingStatistics& after {run.nanosPerIteration};
+                Comparison comparison {};
+                comparison.inputSize = inputSize;
+                comparison.baselineNanos = before.mean;
+                comparison.currentNanos = after.mean;
+                comparison.relativeChange = (after.mean - before.mean)/before.mean;
+
+                const double variance {
+                    before.stddev*before.stddev/static_cast<double>(std::max<unsigned long>(before.samples, 1)) +
+                    after.stddev*after.stddev/static_cast<double>(std::max<unsigned long>(after.samples, 1))
+                };
+                comparison.tStatistic = variance > 0?
+                    (after.mean - before.mean)/std::sqrt(variance) :
+                    (after.mean > before.mean? std::numeric_limits<double>::infinity() : 0.0);
+                comparison.slowdown = comparison.relativeChange > options.minRelativeSlowdown &&
+                    comparison.tStatistic > options.minSignificance;
+                retval.push_back(comparison);
+            }
+            return retval;
+        }
+    }
+}
+
+#endif
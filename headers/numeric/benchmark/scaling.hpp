@@ -0,0 +1,324 @@
+#ifndef __SIGABRT_NUMERIC_SCALING__
+#define __SIGABRT_NUMERIC_SCALING__
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <numeric/benchmark/benchmark.hpp>
+#include <numeric/types/models.hpp>
+
+#include <thesoup/types/types.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::benchmark
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace benchmark {
+        /**
+         * \enum ScalingMode
+         *
+         * - `STRONG`: the iterations of an input size are split between the threads, so the total work is the same for
+         *   every thread count. Ideally the wall time halves as the threads double.
+         * - `WEAK`: every thread runs all the iterations, so the work grows with the threads. Ideally the wall time stays
+         *   the same.
+         * */
+        enum class ScalingMode {
+            STRONG,
+            WEAK
+        };
+
+        /**
+         * \class ScalingOptions
+         *
+         * \brief How a `ScalingBenchmark` measures.
+         *
+         * \var threadCounts The thread counts to measure, for example 1, 2, 4, 8 (the default: powers of 2 up to the
+         * hardware concurrency). Speedups are relative to the smallest one.
+         *
+         * \var mode Strong or weak scaling.
+         *
+         * \var pinThreads Pin thread i to the i-th CPU the process may run on (Linux only; ignored elsewhere), so that the
+         * scheduler does not migrate threads, or stack two of them on one core, while some cores idle.
+         *
+         * \var warmupIterations Untimed calls of the DUT on every thread, before the measurement.
+         *
+         * \var inputPoolSize The number of inputs generated for every thread; its iterations rotate through them. See
+         * `BenchmarkOptions::inputPoolSize` and `inputs_exceeding_cache` for cold cache measurements.
+         * */
+        struct ScalingOptions {
+            std::vector<std::size_t> threadCounts {defaultThreadCounts()};
+            ScalingMode mode {ScalingMode::STRONG};
+            bool pinThreads {true};
+            unsigned long warmupIterations {0};
+            unsigned long inputPoolSize {2};
+
+            //! \cond NO_DOC
+            static std::vector<std::size_t> defaultThreadCounts() {
+                const std::size_t hardware {std::max<std::size_t>(1, std::thread::hardware_concurrency())};
+                std::vector<std::size_t> retval {};
+                for (std::size_t threads = 1; threads < hardware; threads *= 2) {
+                    retval.push_back(threads);
+                }
+                retval.push_back(hardware);
+                return retval;
+            }
+            //! \endcond
+        };
+
+        /**
+         * \class ScalingPoint
+         *
+         * \brief The measurement of 1 thread count.
+         *
+         * \var threads The number of threads.
+         *
+         * \var wallMillis Wall clock time from the release of the threads until the last one finished, in milliseconds.
+         *
+         * \var speedup Strong scaling: how many times faster than 1 thread (extrapolated from the smallest thread count).
+         * Weak scaling: how many times the throughput of 1 thread.
+         *
+         * \var efficiency `speedup/threads`; 1 is perfect scaling.
+         *
+         * \var nanosPerIteration The distribution of the mean time per iteration of the threads. A wide spread means that
+         * the threads did not get the same share of the machine.
+         * */
+        struct ScalingPoint {
+            std::size_t threads {0};
+            double wallMillis {-1.0};
+            double speedup {0.0};
+            double efficiency {0.0};
+            numeric::types::TimingStatistics nanosPerIteration {};
+        };
+
+        //! \cond NO_DOC
+        namespace detail {
+            inline void pinToCpu(std::thread& thread, const std::size_t& index) {
+#if defined(__linux__)
+                cpu_set_t allowed;
+                CPU_ZERO(&allowed);
+                if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0) {
+                    return;
+                }
+                std::size_t target {index % static_cast<std::size_t>(CPU_COUNT(&allowed))};
+                for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                    if (CPU_ISSET(cpu, &allowed)) {
+                        if (target == 0) {
+                            cpu_set_t set;
+                            CPU_ZERO(&set);
+                            CPU_SET(cpu, &set);
+                            pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+                            return;
+                        }
+                        target--;
+                    }
+                }
+#else
+                static_cast<void>(thread);
+                static_cast<void>(index);
+#endif
+            }
+        }
+        //! \endcond
+
+        /**
+         * \class ScalingBenchmark
+         *
+         * \tparam Input The input type of your candidate function.
+         *
+         * \tparam Output The output type of your candidate function.
+         *
+         * \tparam It The iterator type for the inputs (a forward iterator of `RunInfo`).
+         *
+         * \brief Runs the DUT on several threads at once, for a range of thread counts, and reports the scaling curves.
+         *
+         * This is the multithreaded counterpart of `Benchmark`, with the same input generator, DUT and run infos. For every
+         * input size and every thread count, each thread gets its own inputs (generated before the clock starts), the
+         * threads are started together, and the wall time until the last one finishes is measured. This shows how a
+         * kernel behaves under concurrent load: memory bandwidth, shared caches and allocator contention all show up as
+         * an efficiency below 1.
+         *
+         * To measure the scaling of an internally parallel kernel (like `parallel_rref`), use 1 thread here and sweep the
+         * size of its `ThreadPool` instead.
+         * */
+        template <typename Input, typename Output, typename It> class ScalingBenchmark {
+            static_assert(
+                thesoup::types::IsForwardIteratorOfType<It, numeric::types::RunInfo>::value,
+                "The inputs argument has to be a forward iterator of type RunInfo."
+            );
+        private:
+            std::function<Input(const unsigned long&)> input_gen;
+            std::function<Output(Input)> dut;
+            It start;
+            It end;
+            ScalingOptions options;
+            std::map<unsigned long, std::vector<ScalingPoint>> curves {};
+
+            ScalingPoint measure(const numeric::types::RunInfo& run, const std::size_t& threads) {
+                std::vector<std::vector<Input>> inputs(threads);
+                for (std::vector<Input>& threadInputs : inputs) {
+                    for (unsigned long i = 0; i < std::max(options.inputPoolSize, 1UL); i++) {
+                        threadInputs.push_back(input_gen(run.inputSize));
+                    }
+                }
+
+                std::vector<unsigned long> iterations(threads, run.iterations);
+                if (options.mode == ScalingMode::STRONG) {
+                    for (std::size_t t = 0; t < threads; t++) {
+                        iterations[t] = run.iterations/threads + (t < run.iterations % threads? 1 : 0);
+                    }
+                }
+
+                std::atomic<std::size_t> ready {0};
+                std::atomic<bool> go {false};
+                std::vector<double> samples(threads, 0.0);
+                std::mutex errorMutex;
+                std::exception_ptr error;
+                std::vector<std::thread> workers;
+                workers.reserve(threads);
+                for (std::size_t t = 0; t < threads; t++) {
+                    workers.emplace_back([&, t]() {
+                        bool counted {false};
+                        try {
+                            auto call {[&](const unsigned long& i) {
+                                const std::vector<Input>& threadInputs {inputs[t]};
+                                if constexpr (std::is_void<Output>::value) {
+                                    dut(threadInputs[i % threadInputs.size()]);
+                                } else {
+                                    const auto output {dut(threadInputs[i % threadInputs.size()])};
+                                    do_not_optimize(output);
+                                }
+                            }};
+                            for (unsigned long i = 0; i < options.warmupIterations; i++) {
+                                call(i);
+                            }
+                            ready.fetch_add(1);
+                            counted = true;
+                            while (!go.load(std::memory_order_acquire)) {
+                                std::this_thread::yield();
+                            }
+                            const auto startTime {std::chrono::steady_clock::now()};
+                            for (unsigned long i = 0; i < iterations[t]; i++) {
+                                call(i);
+                            }
+                            const auto elapsed {std::chrono::steady_clock::now() - startTime};
+                            if (iterations[t] > 0) {
+                                samples[t] = std::chrono::duration<double, std::nano>(elapsed).count()/static_cast<double>(iterations[t]);
+                            }
+                        } catch (...) {
+                            if (!counted) {
+                                ready.fetch_add(1);
+                            }
+                            std::lock_guard<std::mutex> lock {errorMutex};
+                            if (!error) {
+                                error = std::current_exception();
+                            }
+                        }
+                    });
+                    if (options.pinThreads) {
+                        detail::pinToCpu(workers.back(), t);
+                    }
+                }
+
+                while (ready.load() < threads) {
+                    std::this_thread::yield();
+                }
+                const auto startTime {std::chrono::steady_clock::now()};
+                go.store(true, std::memory_order_release);
+                for (std::thread& worker : workers) {
+                    worker.join();
+                }
+                const auto elapsed {std::chrono::steady_clock::now() - startTime};
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+
+                ScalingPoint point {};
+                point.threads = threads;
+                point.wallMillis = std::chrono::duration<double, std::milli>(elapsed).count();
+                // Threads without iterations (more threads than iterations) are not part of the distribution.
+                samples.erase(
+                    std::remove_if(samples.begin(), samples.end(), [](const double& sample) {return sample <= 0.0;}),
+                    samples.end()
+                );
+                point.nanosPerIteration = detail::summarize(samples);
+                return point;
+            }
+
+        public:
+            /**
+             * \brief Constructor. The arguments are the same as for `Benchmark`.
+             * */
+            ScalingBenchmark(
+                const std::function<Input(const unsigned long&)>& input_gen,
+                const std::function<Output(Input)>& dut,
+                const It& start,
+                const It& end,
+                const ScalingOptions& options=ScalingOptions {}
+            ) : input_gen {input_gen}, dut {dut}, start {start}, end {end}, options {options} {}
+
+            /**
+             * \brief Run the benchmark for every input size and thread count, and populate the scaling curves.
+             *
+             * \throw e Whatever the DUT throws, after all threads have finished.
+             *
+             * \return A reference to self.
+             * */
+            const ScalingBenchmark<Input, Output, It>& run() {
+                std::vector<std::size_t> threadCounts {options.threadCounts};
+                threadCounts.erase(std::remove(threadCounts.begin(), threadCounts.end(), 0), threadCounts.end());
+                std::sort(threadCounts.begin(), threadCounts.end());
+                threadCounts.erase(std::unique(threadCounts.begin(), threadCounts.end()), threadCounts.end());
+
+                for (auto it = start; it < end; it++) {
+                    const numeric::types::RunInfo run {*it};
+                    std::vector<ScalingPoint> curve {};
+                    for (const std::size_t& threads : threadCounts) {
+                        curve.push_back(measure(run, threads));
+                    }
+                    if (!curve.empty() && curve.front().wallMillis > 0) {
+                        const ScalingPoint& base {curve.front()};
+                        for (ScalingPoint& point : curve) {
+                            const double ratio {base.wallMillis/point.wallMillis};
+                            point.speedup = options.mode == ScalingMode::STRONG?
+                                ratio*static_cast<double>(base.threads) :
+                                ratio*static_cast<double>(point.threads);
+                            point.efficiency = point.speedup/static_cast<double>(point.threads);
+                        }
+                    }
+                    curves[run.inputSize] = curve;
+                }
+                return *this;
+            }
+
+            /**
+             * \brief The scaling curves: input size vs the points for the thread counts, in increasing thread count order.
+             * */
+            const std::map<unsigned long, std::vector<ScalingPoint>>& get_curves() const {
+                return curves;
+            }
+        };
+    }
+}
+
+#endif
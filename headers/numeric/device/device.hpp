@@ -0,0 +1,409 @@
+#ifndef __SIGABRT_NUMERIC_DEVICE__
+#define __SIGABRT_NUMERIC_DEVICE__
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+
+#include <numeric/math/errors.hpp>
+#include <numeric/math/lu.hpp>
+#include <numeric/math/parallelrref.hpp>
+#include <numeric/parallel/execution.hpp>
+#include <numeric/parallel/threadpool.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/vector.hpp>
+
+#include <thesoup/types/types.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::device
+     *
+     * \brief Sub namespace with the offload device, and the matrices and vectors that live on it.
+     * */
+    namespace device {
+        /**
+         * \class Device
+         *
+         * \brief The compute device the `Device*` types live on, and the operations on them run on.
+         *
+         * Data moves to a device only through `to_device`, and back only through `to_host`. Between the two, products,
+         * LU solves and reductions take device operands and return device results, so a chain of operations does not go
+         * through the host. The device counts the bytes copied each way, which is how to check that a chain stays
+         * resident.
+         *
+         * This is the host backend: device memory comes from a `std::pmr::memory_resource`, and the kernels are the
+         * parallel ones of this library (`ParallelPolicy` products, `LUDecomposition` and `parallel_rref`) running on a
+         * `ThreadPool`. An accelerator backend provides the same class, with device allocations, copies and kernels; the
+         * `DeviceMatrix`/`DeviceVector` API does not change.
+         *
+         * Like `ThreadPool`, a device is neither copyable nor movable, and has to outlive the data on it. Operations on
+         * the same device must not run concurrently from different threads.
+         * */
+        class Device {
+        private:
+            numeric::parallel::ThreadPool* pool;
+            std::pmr::memory_resource* memory;
+            std::size_t bytesToDevice {0};
+            std::size_t bytesToHost {0};
+
+        public:
+            /**
+             * \brief Constructs a device running on the threads of a pool.
+             *
+             * \param pool The pool the kernels run on. It has to outlive the device.
+             * \param memory The memory resource the device data is allocated from.
+             * */
+            explicit Device(
+                numeric::parallel::ThreadPool& pool,
+                std::pmr::memory_resource* memory=std::pmr::get_default_resource()
+            ): pool {&pool}, memory {memory} {}
+
+            Device(const Device& other)=delete;
+            void operator=(const Device& other)=delete;
+
+            /**
+             * \brief The memory resource of the device data.
+             * */
+            std::pmr::memory_resource* get_resource() const {
+                return memory;
+            }
+
+            /**
+             * \brief The execution policy of the device kernels.
+             * */
+            numeric::parallel::ParallelPolicy get_policy() const {
+                return numeric::parallel::ParallelPolicy {*pool};
+            }
+
+            /**
+             * \brief The pool the device kernels run on.
+             * */
+            numeric::parallel::ThreadPool& get_pool() const {
+                return *pool;
+            }
+
+            /**
+             * \brief The number of bytes copied from the host to the device so far.
+             * */
+            std::size_t get_bytes_to_device() const {
+                return bytesToDevice;
+            }
+
+            /**
+             * \brief The number of bytes copied from the device to the host so far.
+             * */
+            std::size_t get_bytes_to_host() const {
+                return bytesToHost;
+            }
+
+            //! \cond NO_DOC
+            template <typename T> void upload(const T* src, T* dest, const std::size_t& count) {
+                std::copy(src, src + count, dest);
+                bytesToDevice += count*sizeof(T);
+            }
+
+            template <typename T> void download(const T* src, T* dest, const std::size_t& count) {
+                std::copy(src, src + count, dest);
+                bytesToHost += count*sizeof(T);
+            }
+            //! \endcond
+        };
+
+        /**
+         * \class DeviceMatrix
+         *
+         * \tparam T Element type.
+         *
+         * \brief A matrix in device memory.
+         *
+         * The elements are not accessible from the host: use `to_host` to read them. Like `Matrix`, this is not copyable.
+         * */
+        template <typename T> class DeviceMatrix {
+        private:
+            Device* device;
+            numeric::types::Matrix<T> storage;
+
+        public:
+            using value_type = T;
+
+            /**
+             * \brief Allocates a rows x cols matrix on a device.
+             * */
+            DeviceMatrix(Device& device, const std::size_t& rows, const std::size_t& cols):
+                device {&device}, storage {rows, cols, device.get_resource()} {}
+
+            //! \cond NO_DOC
+            // Adopts the result of a host backend kernel.
+            DeviceMatrix(Device& device, numeric::types::Matrix<T>&& storage): device {&device}, storage {std::move(storage)} {}
+
+            // The backend view of the data.
+            numeric::types::Matrix<T>& native() {
+                return storage;
+            }
+
+            const numeric::types::Matrix<T>& native() const {
+                return storage;
+            }
+            //! \endcond
+
+            DeviceMatrix(DeviceMatrix<T>&& other)=default;
+
+            /**
+             * \brief The device the matrix lives on.
+             * */
+            Device& get_device() const {
+                return *device;
+            }
+
+            std::size_t getRows() const {
+                return storage.getRows();
+            }
+
+            std::size_t getCols() const {
+                return storage.getCols();
+            }
+        };
+
+        /**
+         * \class DeviceVector
+         *
+         * \tparam T Element type.
+         *
+         * \brief A vector in device memory.
+         *
+         * The elements are not accessible from the host: use `to_host` to read them. Like `Vector`, this is not copyable.
+         * */
+        template <typename T> class DeviceVector {
+        private:
+            Device* device;
+            numeric::types::Vector<T> storage;
+
+        public:
+            using value_type = T;
+
+            /**
+             * \brief Allocates a vector of `length` elements on a device.
+             * */
+            DeviceVector(Device& device, const std::size_t& length):
+                device {&device}, storage {length, device.get_resource()} {}
+
+            //! \cond NO_DOC
+            DeviceVector(Device& device, numeric::types::Vector<T>&& storage): device {&device}, storage {std::move(storage)} {}
+
+            numeric::types::Vector<T>& native() {
+                return storage;
+            }
+
+            const numeric::types::Vector<T>& native() const {
+                return storage;
+            }
+            //! \endcond
+
+            DeviceVector(DeviceVector<T>&& other)=default;
+
+            /**
+             * \brief The device the vector lives on.
+             * */
+            Device& get_device() const {
+                return *device;
+            }
+
+            std::size_t size() const {
+                return storage.size();
+            }
+        };
+
+        /**
+         * \brief Copy a matrix to a device.
+         * */
+        template <typename T> DeviceMatrix<T> to_device(Device& device, const numeric::types::Matrix<T>& matrix) {
+            DeviceMatrix<T> retval {device, matrix.getRows(), matrix.getCols()};
+            for (std::size_t i = 0; i < matrix.getRows(); i++) {
+                device.upload(matrix.rowPtr(i), retval.native().rowPtr(i), matrix.getCols());
+            }
+            return retval;
+        }
+
+        /**
+         * \brief Copy a vector to a device.
+         * */
+        template <typename T> DeviceVector<T> to_device(Device& device, const numeric::types::Vector<T>& vec) {
+            DeviceVector<T> retval {device, vec.size()};
+            device.upload(vec.data(), retval.native().data(), vec.size());
+            return retval;
+        }
+
+        /**
+         * \brief Copy a matrix back from its device.
+         *
+         * \param matrix The matrix on the device.
+         * \param resource The memory resource of the host matrix.
+         * */
+        template <typename T> numeric::types::Matrix<T> to_host(
+            const DeviceMatrix<T>& matrix,
+            std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+        ) {
+            numeric::types::Matrix<T> retval {matrix.getRows(), matrix.getCols(), resource};
+            for (std::size_t i = 0; i < matrix.getRows(); i++) {
+                matrix.get_device().download(matrix.native().rowPtr(i), retval.rowPtr(i), matrix.getCols());
+            }
+            return retval;
+        }
+
+        /**
+         * \brief Copy a vector back from its device.
+         *
+         * \param vec The vector on the device.
+         * \param resource The memory resource of the host vector.
+         * */
+        template <typename T> numeric::types::Vector<T> to_host(
+            const DeviceVector<T>& vec,
+            std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+        ) {
+            numeric::types::Vector<T> retval {vec.size(), resource};
+            vec.get_device().download(vec.native().data(), retval.data(), vec.size());
+            return retval;
+        }
+
+        //! \cond NO_DOC
+        namespace detail {
+            inline Device& commonDevice(Device& lhs, Device& rhs) {
+                if (&lhs != &rhs) {
+                    throw std::invalid_argument("Cannot combine data on different devices.");
+                }
+                return lhs;
+            }
+        }
+        //! \endcond
+    }
+
+    /**
+     * \namespace numeric::functions
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace functions {
+        /**
+         * \brief Matrix product on a device. The result stays on the device.
+         *
+         * \throw e std::invalid_argument if the dimensions do not match, or the operands are on different devices.
+         * */
+        template <typename T> numeric::device::DeviceMatrix<T> multiply(
+            const numeric::device::DeviceMatrix<T>& lhs,
+            const numeric::device::DeviceMatrix<T>& rhs
+        ) {
+            numeric::device::Device& device {numeric::device::detail::commonDevice(lhs.get_device(), rhs.get_device())};
+            return numeric::device::DeviceMatrix<T> {device, multiply(device.get_policy(), lhs.native(), rhs.native())};
+        }
+
+        /**
+         * \brief Matrix * vector product on a device. The result stays on the device.
+         *
+         * \throw e std::invalid_argument if the dimensions do not match, or the operands are on different devices.
+         * */
+        template <typename T> numeric::device::DeviceVector<T> multiply(
+            const numeric::device::DeviceMatrix<T>& lhs,
+            const numeric::device::DeviceVector<T>& rhs
+        ) {
+            numeric::device::Device& device {numeric::device::detail::commonDevice(lhs.get_device(), rhs.get_device())};
+            return numeric::device::DeviceVector<T> {device, multiply(device.get_policy(), lhs.native(), rhs.native())};
+        }
+
+        /**
+         * \brief RREF of a matrix on a device, in place. See `parallel_rref`: only floating point matrices are reduced by
+         * the blocked elimination on the pool, integral and exact ones by the serial `rref`.
+         *
+         * \return result:
+         *   Result<Unit, ErrorCode>
+         *
+         *   Possible error codes:
+         *   - `FREE_COLUMNS_RREF`: If free columns are detected during reduction.
+         * */
+        template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+        rref(numeric::device::DeviceMatrix<T>& matrix) {
+            return parallel_rref(matrix.native(), matrix.get_device().get_pool());
+        }
+
+        /**
+         * \brief RREF of a matrix on a device, in place, rounding small numbers off to zero. See `parallel_rref`.
+         * */
+        template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+        rref(numeric::device::DeviceMatrix<T>& matrix, const double& zero_precision) {
+            return parallel_rref(matrix.native(), matrix.get_device().get_pool(), zero_precision);
+        }
+
+        /**
+         * \class DeviceLUDecomposition
+         *
+         * \tparam T Element type.
+         *
+         * \brief `LUDecomposition` of a matrix on a device. The factors stay on the device, and so do the solutions.
+         * */
+        template <typename T> class DeviceLUDecomposition {
+        private:
+            numeric::device::Device* device;
+            LUDecomposition<T> factors;
+
+            DeviceLUDecomposition(numeric::device::Device& device, LUDecomposition<T>&& factors):
+                device {&device}, factors {std::move(factors)} {}
+
+        public:
+            DeviceLUDecomposition(const DeviceLUDecomposition<T>& other)=delete;
+            void operator=(const DeviceLUDecomposition<T>& other)=delete;
+            DeviceLUDecomposition(DeviceLUDecomposition<T>&& other)=default;
+
+            /**
+             * \brief Factor a matrix on a device. See `LUDecomposition::factor`.
+             *
+             * \return result:
+             *   Result<DeviceLUDecomposition<T>, ErrorCode>, with the error codes of `LUDecomposition::factor`.
+             * */
+            static thesoup::types::Result<DeviceLUDecomposition<T>, numeric::ErrorCode> factor(
+                const numeric::device::DeviceMatrix<T>& matrix,
+                const Pivoting& pivoting=Pivoting::PARTIAL,
+                const double& zero_precision=0.0
+            ) {
+                using ResultType = thesoup::types::Result<DeviceLUDecomposition<T>, numeric::ErrorCode>;
+                auto lu {LUDecomposition<T>::factor(matrix.native(), pivoting, zero_precision)};
+                if (!lu) {
+                    return ResultType::failure(lu.error());
+                }
+                return ResultType::success(DeviceLUDecomposition<T> {matrix.get_device(), std::move(lu.unwrap())});
+            }
+
+            /**
+             * \brief Solve A*x = b for a right hand side on the same device.
+             *
+             * \return result:
+             *   Result<DeviceVector<T>, ErrorCode>
+             *
+             *   Possible error codes:
+             *   - `INCOMPATIBLE_VECTORS`: If the size of b does not match the matrix.
+             *
+             * \throw e std::invalid_argument if b is on a different device.
+             * */
+            thesoup::types::Result<numeric::device::DeviceVector<T>, numeric::ErrorCode> solve(
+                const numeric::device::DeviceVector<T>& b
+            ) const {
+                using ResultType = thesoup::types::Result<numeric::device::DeviceVector<T>, numeric::ErrorCode>;
+                numeric::device::detail::commonDevice(*device, b.get_device());
+                auto x {factors.solve(b.native())};
+                if (!x) {
+                    return ResultType::failure(x.error());
+                }
+                return ResultType::success(numeric::device::DeviceVector<T> {*device, std::move(x.unwrap())});
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,574 @@
+#ifndef __SIGABRT_NUMERIC_MATRIXIO__
+#define __SIGABRT_NUMERIC_MATRIXIO__
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/matrixview.hpp>
+#include <numeric/types/vector.hpp>
+
+#include <thesoup/types/types.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::io
+     *
+     * \brief Sub namespace with the on disk formats of the types.
+     * */
+    namespace io {
+        /**
+         * \class MatrixFileHeader
+         *
+         * \brief The 64 byte header of the binary matrix format.
+         *
+         * A matrix file is this header followed by `rows*cols` elements in row major order, with no padding. The elements
+         * are stored in the byte order of the machine that wrote them, which `byteOrder` records; a file from a machine
+         * with the other byte order is rejected rather than converted. As the header is 64 bytes, the data of a mapped
+         * file is aligned for any arithmetic type.
+         *
+         * Only arithmetic element types can be stored. `elementKind` (unsigned integer, signed integer or floating
+         * point) and `elementSize` have to match the type a file is read as.
+         * */
+        struct MatrixFileHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byteOrder;
+            std::uint32_t elementKind;
+            std::uint32_t elementSize;
+            std::uint64_t rows;
+            std::uint64_t cols;
+            std::uint8_t reserved[24];
+        };
+
+        static_assert(sizeof(MatrixFileHeader) == 64, "The matrix file header has to be 64 bytes.");
+
+        //! \cond NO_DOC
+        namespace detail {
+            constexpr char FILE_MAGIC[8] {'N', 'U', 'M', 'M', 'A', 'T', 'R', 'X'};
+            constexpr std::uint32_t FILE_VERSION {1};
+            constexpr std::uint32_t BYTE_ORDER_MARK {0x01020304};
+
+            template <typename T> constexpr std::uint32_t elementKind() {
+                static_assert(std::is_arithmetic<T>::value, "Only matrices of arithmetic types can be stored.");
+                return std::is_floating_point<T>::value? 2 : (std::is_signed<T>::value? 1 : 0);
+            }
+
+            template <typename T> MatrixFileHeader makeHeader(const std::size_t& rows, const std::size_t& cols) {
+                MatrixFileHeader header {};
+                std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+                header.version = FILE_VERSION;
+                header.byteOrder = BYTE_ORDER_MARK;
+                header.elementKind = elementKind<T>();
+                header.elementSize = static_cast<std::uint32_t>(sizeof(T));
+                header.rows = rows;
+                header.cols = cols;
+                return header;
+            }
+
+            // Checks a header against T, and returns the size of the data in bytes.
+            template <typename T> std::uint64_t checkHeader(const MatrixFileHeader& header) {
+                if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+                    throw std::invalid_argument("Not a matrix file.");
+                }
+                if (header.version != FILE_VERSION) {
+                    throw std::invalid_argument("Unsupported matrix file version " + std::to_string(header.version) + ".");
+                }
+                if (header.byteOrder != BYTE_ORDER_MARK) {
+                    throw std::invalid_argument("The matrix file was written with a different byte order.");
+                }
+                if (header.elementKind != elementKind<T>() || header.elementSize != sizeof(T)) {
+                    throw std::invalid_argument("The matrix file holds a different element type.");
+                }
+                const std::uint64_t maxElements {std::numeric_limits<std::uint64_t>::max()/sizeof(T)};
+                if (header.cols != 0 && header.rows > maxElements/header.cols) {
+                    throw std::invalid_argument("The matrix file dimensions are too large.");
+                }
+                return header.rows*header.cols*sizeof(T);
+            }
+
+            inline MatrixFileHeader readHeader(std::istream& stream) {
+                MatrixFileHeader header {};
+                if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+                    throw std::invalid_argument("Not a matrix file: the header is truncated.");
+                }
+                return header;
+            }
+
+            inline void writeBytes(std::ostream& stream, const void* data, const std::size_t& bytes) {
+                if (!stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes))) {
+                    throw std::runtime_error("Could not write the matrix file.");
+                }
+            }
+
+            inline void readBytes(std::istream& stream, void* data, const std::size_t& bytes) {
+                if (!stream.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes))) {
+                    throw std::invalid_argument("The matrix file is truncated.");
+                }
+            }
+
+            // Rows of a transposed view are strided, so they are gathered into a row buffer first.
+            template <typename T> void writeRows(std::ostream& stream, const numeric::types::ConstMatrixView<T>& block) {
+                if (!block.isTransposed()) {
+                    for (std::size_t i = 0; i < block.getRows(); i++) {
+                        writeBytes(stream, block.rowSlice(i).start, block.getCols()*sizeof(T));
+                    }
+                } else {
+                    std::vector<T> row(block.getCols());
+                    for (std::size_t i = 0; i < block.getRows(); i++) {
+                        for (std::size_t j = 0; j < block.getCols(); j++) {
+                            row[j] = block.atUnchecked(i, j);
+                        }
+                        writeBytes(stream, row.data(), row.size()*sizeof(T));
+                    }
+                }
+            }
+        }
+        //! \endcond
+
+        /**
+         * \brief Write a matrix (or a view on one) to a binary stream, in the format of `MatrixFileHeader`.
+         *
+         * \param stream The destination. Open files with `std::ios::binary`.
+         *
+         * \param matrix The matrix.
+         *
+         * \throw e std::runtime_error if the stream fails.
+         * */
+        template <typename T> void write_matrix(std::ostream& stream, const numeric::types::ConstMatrixView<T>& matrix) {
+            const MatrixFileHeader header {detail::makeHeader<T>(matrix.getRows(), matrix.getCols())};
+            detail::writeBytes(stream, &header, sizeof(header));
+            detail::writeRows(stream, matrix);
+        }
+
+        //! \cond NO_DOC
+        template <typename T> void write_matrix(std::ostream& stream, const numeric::types::Matrix<T>& matrix) {
+            write_matrix(stream, matrix.view());
+        }
+        //! \endcond
+
+        /**
+         * \brief Read a matrix written by `write_matrix`.
+         *
+         * The elements are read straight into the rows of the new matrix, with no intermediate copy. To use a file
+         * without reading it at all, see `MappedMatrix`.
+         *
+         * \param stream The source. Open files with `std::ios::binary`.
+         *
+         * \param resource The memory resource to allocate the matrix from.
+         *
+         * \throw e std::invalid_argument if the stream does not hold a matrix of T, or is truncated.
+         *
+         * \return Matrix<T>
+         * */
+        template <typename T> numeric::types::Matrix<T> read_matrix(
+            std::istream& stream,
+            std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+        ) {
+            const MatrixFileHeader header {detail::readHeader(stream)};
+            detail::checkHeader<T>(header);
+            numeric::types::Matrix<T> retval {
+                static_cast<std::size_t>(header.rows),
+                static_cast<std::size_t>(header.cols),
+                resource
+            };
+            for (std::size_t i = 0; i < retval.getRows(); i++) {
+                detail::readBytes(stream, retval.rowPtr(i), retval.getCols()*sizeof(T));
+            }
+            return retval;
+        }
+
+        /**
+         * \brief Write a vector to a binary stream, as a 1 x n matrix.
+         *
+         * \throw e std::runtime_error if the stream fails.
+         * */
+        template <typename T> void write_vector(std::ostream& stream, const numeric::types::Vector<T>& vec) {
+            const MatrixFileHeader header {detail::makeHeader<T>(1, vec.size())};
+            detail::writeBytes(stream, &header, sizeof(header));
+            detail::writeBytes(stream, vec.data(), vec.size()*sizeof(T));
+        }
+
+        /**
+         * \brief Read a vector written by `write_vector` (any 1 x n matrix).
+         *
+         * \throw e std::invalid_argument if the stream does not hold a 1 x n matrix of T, or is truncated.
+         *
+         * \return Vector<T>
+         * */
+        template <typename T> numeric::types::Vector<T> read_vector(
+            std::istream& stream,
+            std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+        ) {
+            const MatrixFileHeader header {detail::readHeader(stream)};
+            detail::checkHeader<T>(header);
+            if (header.rows != 1) {
+                throw std::invalid_argument("The matrix file does not hold a vector.");
+            }
+            numeric::types::Vector<T> retval(static_cast<std::size_t>(header.cols), resource);
+            detail::readBytes(stream, retval.data(), retval.size()*sizeof(T));
+            return retval;
+        }
+
+        /**
+         * \class MatrixFileWriter
+         *
+         * \tparam T An arithmetic type.
+         *
+         * \brief Writes a matrix file block of rows by block of rows, for matrices that do not fit in memory.
+         *
+         * The dimensions are fixed up front (they go in the header), and then the rows are appended with `write`, in
+         * blocks of any height. The stream has to outlive the writer.
+         *
+         * ```
+         * std::ofstream file {"big.mat", std::ios::binary};
+         * MatrixFileWriter<double> writer {file, 1000000, 1000};
+         * Matrix<double> block {1000, 1000};
+         * while (!writer.finished()) {
+         *     // ... fill the block ...
+         *     writer.write(block.view());
+         * }
+         * ```
+         * */
+        template <typename T> class MatrixFileWriter {
+        private:
+            std::ostream& stream;
+            std::size_t nrows;
+            std::size_t ncols;
+            std::size_t written {0};
+
+        public:
+            /**
+             * \brief Constructor. Writes the header.
+             *
+             * \throw e std::runtime_error if the stream fails.
+             * */
+            MatrixFileWriter(std::ostream& stream, const std::size_t& nrows, const std::size_t& ncols):
+                stream {stream}, nrows {nrows}, ncols {ncols} {
+                const MatrixFileHeader header {detail::makeHeader<T>(nrows, ncols)};
+                detail::writeBytes(stream, &header, sizeof(header));
+            }
+
+            MatrixFileWriter(const MatrixFileWriter<T>& other)=delete;
+            void operator=(const MatrixFileWriter<T>& other)=delete;
+
+            /**
+             * \brief Append the rows of a block.
+             *
+             * \throw e std::invalid_argument if the block has the wrong number of columns, or more rows than are left.
+             *
+             * \throw e std::runtime_error if the stream fails.
+             * */
+            MatrixFileWriter<T>& write(const numeric::types::ConstMatrixView<T>& block) {
+                if (block.getCols() != ncols) {
+                    throw std::invalid_argument("The block has a different number of columns than the matrix file.");
+                }
+                if (block.getRows() > nrows - written) {
+                    throw std::invalid_argument("The block has more rows than are left in the matrix file.");
+                }
+                detail::writeRows(stream, block);
+                written += block.getRows();
+                return *this;
+            }
+
+            /**
+             * \brief The number of rows written so far.
+             * */
+            std::size_t rowsWritten() const {
+                return written;
+            }
+
+            /**
+             * \brief Whether all the rows have been written.
+             * */
+            bool finished() const {
+                return written == nrows;
+            }
+        };
+
+        /**
+         * \class MatrixFileReader
+         *
+         * \tparam T An arithmetic type.
+         *
+         * \brief Reads a matrix file block of rows by block of rows, for matrices that do not fit in memory.
+         *
+         * The header is read and checked on construction. `read` then fills a block (any `MatrixView`, so one buffer
+         * matrix can be reused for the whole file) with the next rows. The stream has to outlive the reader.
+         *
+         * ```
+         * std::ifstream file {"big.mat", std::ios::binary};
+         * MatrixFileReader<double> reader {file};
+         * Matrix<double> block {1000, reader.getCols()};
+         * while (std::size_t rows = reader.read(block.view())) {
+         *     // ... use block.rowRange(0, rows) ...
+         * }
+         * ```
+         * */
+        template <typename T> class MatrixFileReader {
+        private:
+            std::istream& stream;
+            std::size_t nrows {0};
+            std::size_t ncols {0};
+            std::size_t consumed {0};
+
+        public:
+            /**
+             * \brief Constructor. Reads the header.
+             *
+             * \throw e std::invalid_argument if the stream does not hold a matrix of T.
+             * */
+            MatrixFileReader(std::istream& stream): stream {stream} {
+                const MatrixFileHeader header {detail::readHeader(stream)};
+                detail::checkHeader<T>(header);
+                nrows = static_cast<std::size_t>(header.rows);
+                ncols = static_cast<std::size_t>(header.cols);
+            }
+
+            MatrixFileReader(const MatrixFileReader<T>& other)=delete;
+            void operator=(const MatrixFileReader<T>& other)=delete;
+
+            /**
+             * \brief The rows of the matrix in the file.
+             * */
+            std::size_t getRows() const {
+                return nrows;
+            }
+
+            /**
+             * \brief The columns of the matrix in the file.
+             * */
+            std::size_t getCols() const {
+                return ncols;
+            }
+
+            /**
+             * \brief The number of rows not read yet.
+             * */
+            std::size_t remaining() const {
+                return nrows - consumed;
+            }
+
+            /**
+             * \brief Read the next rows into the top of a block.
+             *
+             * \param block The destination, with `getCols()` columns.
+             *
+             * \throw e std::invalid_argument if the block has the wrong number of columns, or the file is truncated.
+             *
+             * \return The number of rows read: the rows of the block, or fewer at the end of the file (0 when done).
+             * */
+            std::size_t read(const numeric::types::MatrixView<T>& block) {
+                if (block.getCols() != ncols) {
+                    throw std::invalid_argument("The block has a different number of columns than the matrix file.");
+                }
+                const std::size_t rows {std::min(block.getRows(), remaining())};
+                if (!block.isTransposed()) {
+                    for (std::size_t i = 0; i < rows; i++) {
+                        detail::readBytes(stream, block.rowSlice(i).start, ncols*sizeof(T));
+                    }
+                } else {
+                    std::vector<T> row(ncols);
+                    for (std::size_t i = 0; i < rows; i++) {
+                        detail::readBytes(stream, row.data(), ncols*sizeof(T));
+                        for (std::size_t j = 0; j < ncols; j++) {
+                            block.atUnchecked(i, j) = row[j];
+                        }
+                    }
+                }
+                consumed += rows;
+                return rows;
+            }
+        };
+
+        /**
+         * \enum MapMode
+         *
+         * - `READ_ONLY`: the mapping can only be read.
+         * - `READ_WRITE`: writes through the mapping go to the file.
+         * */
+        enum class MapMode {
+            READ_ONLY,
+            READ_WRITE
+        };
+
+        /**
+         * \class MappedMatrix
+         *
+         * \tparam T An arithmetic type.
+         *
+         * \brief A matrix file mapped into memory, used in place through matrix views.
+         *
+         * Opening a mapped matrix reads nothing but the header: the pages of the file are loaded by the OS when they are
+         * first touched, and can be dropped again under memory pressure, so matrices larger than the memory work too.
+         * The only allocation is the row table (one `Slice` per row) that the views go through.
+         *
+         * `view` gives a `ConstMatrixView`, and `mutableView` a `MatrixView` in `READ_WRITE` mode, so everything that takes
+         * views works on the file directly: products, expressions, `rref`, and `Matrix<T> {mapped.view()}` for an in memory copy.
+         *
+         * The mapping is released on destruction; views must not outlive the mapped matrix. This needs POSIX `mmap`, and
+         * throws `std::runtime_error` on other platforms.
+         * */
+        template <typename T> class MappedMatrix {
+            static_assert(std::is_arithmetic<T>::value, "Only matrices of arithmetic types can be mapped.");
+        private:
+            void* mapping {nullptr};
+            std::size_t mappedBytes {0};
+            std::size_t nrows {0};
+            std::size_t ncols {0};
+            MapMode mode;
+            std::vector<thesoup::types::Slice<T>> rows {};
+
+            void unmap() {
+#if defined(__unix__) || defined(__APPLE__)
+                if (mapping != nullptr) {
+                    munmap(mapping, mappedBytes);
+                }
+#endif
+                mapping = nullptr;
+            }
+
+        public:
+            /**
+             * \brief Map a matrix file.
+             *
+             * \param path The file.
+             *
+             * \param mode Read only, or read write.
+             *
+             * \throw e std::runtime_error if the file cannot be opened or mapped.
+             *
+             * \throw e std::invalid_argument if the file does not hold a matrix of T, or is truncated.
+             * */
+            MappedMatrix(const std::string& path, const MapMode& mode=MapMode::READ_ONLY): mode {mode} {
+#if defined(__unix__) || defined(__APPLE__)
+                const int fd {::open(path.c_str(), mode == MapMode::READ_WRITE? O_RDWR : O_RDONLY)};
+                if (fd == -1) {
+                    throw std::runtime_error("Could not open the matrix file " + path + ": " + std::strerror(errno));
+                }
+                struct stat status;
+                if (fstat(fd, &status) != 0) {
+                    ::close(fd);
+                    throw std::runtime_error("Could not stat the matrix file " + path + ".");
+                }
+                const std::uint64_t fileBytes {static_cast<std::uint64_t>(status.st_size)};
+                MatrixFileHeader header {};
+                if (fileBytes < sizeof(header) || pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+                    ::close(fd);
+                    throw std::invalid_argument("Not a matrix file: the header is truncated.");
+                }
+                std::uint64_t dataBytes {0};
+                try {
+                    dataBytes = detail::checkHeader<T>(header);
+                } catch (...) {
+                    ::close(fd);
+                    throw;
+                }
+                if (fileBytes - sizeof(header) < dataBytes) {
+                    ::close(fd);
+                    throw std::invalid_argument("The matrix file is truncated.");
+                }
+                mappedBytes = static_cast<std::size_t>(sizeof(header) + dataBytes);
+                const int protection {mode == MapMode::READ_WRITE? PROT_READ | PROT_WRITE : PROT_READ};
+                mapping = mmap(nullptr, mappedBytes, protection, MAP_SHARED, fd, 0);
+                // Saved before close, which may overwrite it.
+                const int mapError {errno};
+                // The mapping keeps the file alive.
+                ::close(fd);
+                if (mapping == MAP_FAILED) {
+                    mapping = nullptr;
+                    throw std::runtime_error("Could not map the matrix file " + path + ": " + std::strerror(mapError));
+                }
+                nrows = static_cast<std::size_t>(header.rows);
+                ncols = static_cast<std::size_t>(header.cols);
+                T* data {reinterpret_cast<T*>(static_cast<char*>(mapping) + sizeof(header))};
+                rows.resize(nrows);
+                for (std::size_t i = 0; i < nrows; i++) {
+                    rows[i] = thesoup::types::Slice<T> {data + i*ncols, ncols};
+                }
+#else
+                static_cast<void>(path);
+                throw std::runtime_error("Mapped matrices need mmap.");
+#endif
+            }
+
+            MappedMatrix(const MappedMatrix<T>& other)=delete;
+            void operator=(const MappedMatrix<T>& other)=delete;
+
+            ~MappedMatrix() {
+                unmap();
+            }
+
+            /**
+             * \brief Get the number of rows in the matrix.
+             * */
+            std::size_t getRows() const {
+                return nrows;
+            }
+
+            /**
+             * \brief Get the number of columns in the matrix.
+             * */
+            std::size_t getCols() const {
+                return ncols;
+            }
+
+            /**
+             * \brief A read only view on the mapped elements.
+             * */
+            numeric::types::ConstMatrixView<T> view() const {
+                return numeric::types::ConstMatrixView<T> {rows.data(), nrows, ncols};
+            }
+
+            /**
+             * \brief A mutable view on the mapped elements. Writes go to the file.
+             *
+             * \throw e std::logic_error if the file was mapped read only.
+             * */
+            numeric::types::MatrixView<T> mutableView() {
+                if (mode != MapMode::READ_WRITE) {
+                    throw std::logic_error("The matrix file was mapped read only.");
+                }
+                return numeric::types::MatrixView<T> {rows.data(), nrows, ncols};
+            }
+
+            /**
+             * \brief Flush the writes to the file.
+             *
+             * \throw e std::runtime_error if the flush fails.
+             * */
+            void sync() {
+#if defined(__unix__) || defined(__APPLE__)
+                if (mapping != nullptr && mode == MapMode::READ_WRITE && msync(mapping, mappedBytes, MS_SYNC) != 0) {
+                    throw std::runtime_error("Could not flush the matrix file.");
+                }
+#endif
+            }
+        };
+    }
+}
+
+#endif
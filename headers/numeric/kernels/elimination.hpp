@@ -0,0 +1,192 @@
+#ifndef __SIGABRT_NUMERIC_ELIMINATION__
+#define __SIGABRT_NUMERIC_ELIMINATION__
+
+#include <cstddef>
+#include <numeric>
+#include <type_traits>
+
+#include <numeric/kernels/simd.hpp>
+#include <numeric/types/fraction.hpp>
+#include <numeric/types/models.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::kernels
+     *
+     * \brief Sub namespace with the low level compute kernels used by the types and functions.
+     * */
+    namespace kernels {
+        /**
+         * \brief The reciprocal of a non zero scalar.
+         *
+         * A `Fraction` is kept reduced, so its reciprocal is its numerator and denominator swapped, without the gcd that
+         * `1/f` pays for.
+         * */
+        template <typename T> T reciprocal(const T& value) {
+            if constexpr (std::is_same<numeric::types::Fraction, T>::value) {
+                numeric::types::Fraction retval {};
+                retval.num = value.den;
+                retval.den = value.num;
+                return retval;
+            } else {
+                return static_cast<T>(1)/value;
+            }
+        }
+
+        /**
+         * \brief The row update of the eliminations: `dest -= factor*src`, over `n` contiguous elements.
+         *
+         * `EXACT` types skip the elements where `src` is zero, as each one saves two reductions. The others take the plain
+         * loop, which the compiler vectorizes for arithmetic types. The product is rounded before the subtraction, so the
+         * cancellations eliminations without a zero precision rely on (a row minus a multiple of itself) stay exact; see
+         * `subtract_multiple_round_off` for the fused version.
+         * */
+        template <typename T> void subtract_multiple(T* dest, const T* src, const T& factor, const std::size_t& n) {
+            if constexpr (numeric::types::ScalarFamilyOf<T>::value == numeric::types::ScalarFamily::EXACT) {
+                const T zero {static_cast<T>(0)};
+                for (std::size_t j = 0; j < n; j++) {
+                    if (src[j] != zero) {
+                        dest[j] -= factor*src[j];
+                    }
+                }
+            } else {
+                for (std::size_t j = 0; j < n; j++) {
+                    dest[j] = dest[j] - factor*src[j];
+                }
+            }
+        }
+
+        /**
+         * \brief The row update of the eliminations with a zero precision: `dest -= factor*src`, rounding off results
+         * within `zeroPrecision` of zero to zero, over `n` contiguous elements.
+         *
+         * `float` and `double` go through the `axpy` vector kernel, which fuses the multiply and the subtraction (one
+         * rounding) where the instruction set has FMA. The row is updated and rounded off in blocks small enough to stay
+         * in L1, so it is still read from memory once. The other types take the element by element loop.
+         * */
+        template <typename T> void subtract_multiple_round_off(
+            T* dest,
+            const T* src,
+            const T& factor,
+            const double& zeroPrecision,
+            const std::size_t& n
+        ) {
+            if constexpr (HasSimdKernel<T>::value) {
+                constexpr std::size_t BLOCK {1024};
+                const auto& kernels {vector_kernels<T>()};
+                for (std::size_t start = 0; start < n; start += BLOCK) {
+                    const std::size_t end {start + BLOCK < n? start + BLOCK : n};
+                    kernels.axpy(src + start, -factor, dest + start, end - start);
+                    for (std::size_t j = start; j < end; j++) {
+                        const double value {static_cast<double>(dest[j])};
+                        if (value > -zeroPrecision && value < zeroPrecision) {
+                            dest[j] = static_cast<T>(0);
+                        }
+                    }
+                }
+            } else {
+                for (std::size_t j = 0; j < n; j++) {
+                    const T elem {dest[j] - factor*src[j]};
+                    const double value {static_cast<double>(elem)};
+                    dest[j] = value > -zeroPrecision && value < zeroPrecision? static_cast<T>(0) : elem;
+                }
+            }
+        }
+
+        /**
+         * \brief Scale `n` contiguous elements by the reciprocal of a non zero `pivot`, in place. This makes the pivot
+         * row of the eliminations.
+         *
+         * The reciprocal is computed once, with `reciprocal`. `EXACT` types skip the zeros.
+         * */
+        template <typename T> void normalize_row(T* row, const T& pivot, const std::size_t& n) {
+            const T factor {reciprocal(pivot)};
+            if constexpr (numeric::types::ScalarFamilyOf<T>::value == numeric::types::ScalarFamily::EXACT) {
+                const T zero {static_cast<T>(0)};
+                for (std::size_t j = 0; j < n; j++) {
+                    if (row[j] != zero) {
+                        row[j] *= factor;
+                    }
+                }
+            } else {
+                for (std::size_t j = 0; j < n; j++) {
+                    row[j] = row[j]*factor;
+                }
+            }
+        }
+
+        /**
+         * \brief The row update of fraction free eliminations: `dest = (pivot*dest - factor*src)/divisor`, over `n`
+         * contiguous elements.
+         *
+         * This is the update of Bareiss' algorithm (see `bareiss`), where `divisor` is the previous pivot, so the caller
+         * guarantees the division is exact. The first step divides by 1, which is skipped, so that loop vectorizes for
+         * the built in integers. A zero `factor` only scales `dest`, which saves the products of the exact types.
+         * */
+        template <typename T> void cross_eliminate(
+            T* dest,
+            const T* src,
+            const T& pivot,
+            const T& factor,
+            const T& divisor,
+            const std::size_t& n
+        ) {
+            if (factor == static_cast<T>(0)) {
+                for (std::size_t j = 0; j < n; j++) {
+                    if (dest[j] != static_cast<T>(0)) {
+                        dest[j] = divisor == static_cast<T>(1)? pivot*dest[j] : (pivot*dest[j])/divisor;
+                    }
+                }
+            } else if (divisor == static_cast<T>(1)) {
+                for (std::size_t j = 0; j < n; j++) {
+                    dest[j] = pivot*dest[j] - factor*src[j];
+                }
+            } else {
+                for (std::size_t j = 0; j < n; j++) {
+                    dest[j] = (pivot*dest[j] - factor*src[j])/divisor;
+                }
+            }
+        }
+
+        /**
+         * \brief Divide `n` contiguous integers by their gcd, and flip their signs if the first non zero one is negative.
+         *
+         * For `INTEGER` types: `std::gcd` for the built in ones, and the `gcd` of bigint.hpp for `BigInt`. A row of zeros
+         * is left alone.
+         * */
+        template <typename T> void make_primitive(T* row, const std::size_t& n) {
+            static_assert(
+                numeric::types::ScalarFamilyOf<T>::value == numeric::types::ScalarFamily::INTEGER,
+                "Primitive rows are for integral types."
+            );
+            T divisor {0};
+            T sign {0};
+            for (std::size_t j = 0; j < n; j++) {
+                if (sign == static_cast<T>(0) && row[j] != static_cast<T>(0)) {
+                    sign = row[j] < static_cast<T>(0) ? static_cast<T>(-1) : static_cast<T>(1);
+                }
+                if constexpr (std::is_integral<T>::value) {
+                    divisor = std::gcd(divisor, row[j]);
+                } else {
+                    divisor = numeric::types::gcd(divisor, row[j]);
+                }
+            }
+            if (divisor == static_cast<T>(0)) {
+                return;
+            }
+            divisor *= sign;
+            if (divisor != static_cast<T>(1)) {
+                for (std::size_t j = 0; j < n; j++) {
+                    row[j] /= divisor;
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef __SIGABRT_NUMERIC_GEMM__
+#define __SIGABRT_NUMERIC_GEMM__
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <thesoup/types/types.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::kernels
+     *
+     * \brief Sub namespace with the low level compute kernels used by the types and functions.
+     * */
+    namespace kernels {
+        /**
+         * \class GemmBlocking
+         *
+         * \tparam T Element type.
+         *
+         * \brief Blocking parameters of the GEMM engine.
+         *
+         * `MR x NR` is the register tile computed by the micro kernel. `KC` is the depth of a packed panel, chosen such that
+         * a `KC x NR` sliver of B stays in L1. `MC x KC` of packed A is sized for L2 and `KC x NC` of packed B for L3.
+         *
+         * Only types that specialize this struct get the blocked engine. See `HasGemmKernel`.
+         * */
+        template <typename T> struct GemmBlocking;
+
+        //! \cond NO_DOC
+        template <> struct GemmBlocking<double> {
+            static constexpr std::size_t MR {4};
+            static constexpr std::size_t NR {8};
+            static constexpr std::size_t MC {96};
+            static constexpr std::size_t KC {256};
+            static constexpr std::size_t NC {2048};
+        };
+
+        template <> struct GemmBlocking<float> {
+            static constexpr std::size_t MR {4};
+            static constexpr std::size_t NR {16};
+            static constexpr std::size_t MC {128};
+            static constexpr std::size_t KC {256};
+            static constexpr std::size_t NC {4096};
+        };
+        //! \endcond
+
+        /**
+         * \class HasGemmKernel
+         *
+         * \brief Trait indicating whether the blocked GEMM engine is available for type `T`.
+         * */
+        template <typename T> struct HasGemmKernel {
+            static constexpr bool value {
+                std::is_same<float, typename std::remove_cv<T>::type>::value ||
+                std::is_same<double, typename std::remove_cv<T>::type>::value
+            };
+        };
+
+        namespace {
+            // Products with fewer multiply-adds than this skip the packing and go through the simple loop.
+            constexpr std::size_t GEMM_SMALL_THRESHOLD {32*32*32};
+
+            // Pack a mc x kc block of A, starting at (i0, p0) into MR high slivers. Each sliver is stored column
+            // by column, so that the micro kernel reads it sequentially. Rows past mc are padded with 0.
+            template <typename T> void packA(
+                const std::size_t& mc,
+                const std::size_t& kc,
+                const thesoup::types::Slice<T>* a,
+                const std::size_t& i0,
+                const std::size_t& p0,
+                T* buffer) {
+                constexpr std::size_t MR {GemmBlocking<T>::MR};
+                for (std::size_t ir = 0; ir < mc; ir += MR) {
+                    const std::size_t rows {std::min(MR, mc - ir)};
+                    for (std::size_t p = 0; p < kc; p++) {
+                        for (std::size_t r = 0; r < MR; r++) {
+                            buffer[p*MR + r] = r < rows? a[i0 + ir + r].start[p0 + p] : static_cast<T>(0);
+                        }
+                    }
+                    buffer += kc*MR;
+                }
+            }
+
+            // Pack a kc x nc block of B, starting at (p0, j0) into NR wide slivers. Each sliver is stored row by row.
+            // Columns past nc are padded with 0.
+            template <typename T> void packB(
+                const std::size_t& kc,
+                const std::size_t& nc,
+                const thesoup::types::Slice<T>* b,
+                const std::size_t& p0,
+                const std::size_t& j0,
+                T* buffer) {
+                constexpr std::size_t NR {GemmBlocking<T>::NR};
+                for (std::size_t jr = 0; jr < nc; jr += NR) {
+                    const std::size_t cols {std::min(NR, nc - jr)};
+                    for (std::size_t p = 0; p < kc; p++) {
+                        const T* row {b[p0 + p].start + j0 + jr};
+                        for (std::size_t c = 0; c < NR; c++) {
+                            buffer[p*NR + c] = c < cols? row[c] : static_cast<T>(0);
+                        }
+                    }
+                    buffer += kc*NR;
+                }
+            }
+
+            // The micro kernel. Computes an MR x NR tile of packed A * packed B in registers, and accumulates the
+            // valid (rows x cols) part of it into C at (i, j). The loops have compile time trip counts, so the
+            // compiler fully unrolls and vectorizes the tile.
+            template <typename T> void microKernel(
+                const std::size_t& kc,
+                const T* __restrict__ a,
+                const T* __restrict__ b,
+                thesoup::types::Slice<T>* c,
+                const std::size_t& i,
+                const std::size_t& j,
+                const std::size_t& rows,
+                const std::size_t& cols) {
+                constexpr std::size_t MR {GemmBlocking<T>::MR};
+                constexpr std::size_t NR {GemmBlocking<T>::NR};
+
+                T acc[MR][NR] {};
+                for (std::size_t p = 0; p < kc; p++) {
+                    for (std::size_t r = 0; r < MR; r++) {
+                        const T aElem {a[p*MR + r]};
+                        for (std::size_t col = 0; col < NR; col++) {
+                            acc[r][col] += aElem*b[p*NR + col];
+                        }
+                    }
+                }
+
+                for (std::size_t r = 0; r < rows; r++) {
+                    T* dest {c[i + r].start + j};
+                    for (std::size_t col = 0; col < cols; col++) {
+                        dest[col] += acc[r][col];
+                    }
+                }
+            }
+
+            // Simple i-k-j product for small inputs. Walks B and C along rows instead of down columns.
+            template <typename T> void gemmSmall(
+                const std::size_t& m,
+                const std::size_t& n,
+                const std::size_t& k,
+                const thesoup::types::Slice<T>* a,
+                const thesoup::types::Slice<T>* b,
+                thesoup::types::Slice<T>* c) {
+                for (std::size_t i = 0; i < m; i++) {
+                    T* dest {c[i].start};
+                    for (std::size_t p = 0; p < k; p++) {
+                        const T aElem {a[i].start[p]};
+                        const T* src {b[p].start};
+                        for (std::size_t j = 0; j < n; j++) {
+                            dest[j] += aElem*src[j];
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * \brief Blocked general matrix multiply.
+         *
+         * \tparam T Element type. Has to specialize `GemmBlocking`.
+         *
+         * This function computes C += A*B, where A is m x k, B is k x n and C is m x n. The matrices are passed as their
+         * row tables, so rows do not have to be contiguous in memory (which is the case after row exchanges).
+         *
+         * For large inputs, B is packed into KC x NC panels and A into MC x KC blocks, and the product is computed by a
+         * register tiled micro kernel running over the packed data. Small inputs skip the packing.
+         *
+         * NOTE: No dimension checks are done here. The caller is responsible for passing compatible row tables.
+         *
+         * \param m Rows in A and C.
+         *
+         * \param n Columns in B and C.
+         *
+         * \param k Columns in A and rows in B.
+         *
+         * \param a Row table of A.
+         *
+         * \param b Row table of B.
+         *
+         * \param c Row table of C. This has to be initialized (usualy to 0) by the caller.
+         * */
+        template <typename T> void gemm(
+            const std::size_t& m,
+            const std::size_t& n,
+            const std::size_t& k,
+            const thesoup::types::Slice<T>* a,
+            const thesoup::types::Slice<T>* b,
+            thesoup::types::Slice<T>* c) {
+            static_assert(HasGemmKernel<T>::value, "There is no blocked GEMM kernel for this type.");
+            constexpr std::size_t MR {GemmBlocking<T>::MR};
+            constexpr std::size_t NR {GemmBlocking<T>::NR};
+            constexpr std::size_t MC {GemmBlocking<T>::MC};
+            constexpr std::size_t KC {GemmBlocking<T>::KC};
+            constexpr std::size_t NC {GemmBlocking<T>::NC};
+
+            if (m == 0 || n == 0 || k == 0) {
+                return;
+            }
+            if (m*n*k < GEMM_SMALL_THRESHOLD) {
+                gemmSmall(m, n, k, a, b, c);
+                return;
+            }
+
+            // Buffers are rounded up to whole slivers, as the packing routines pad the edge slivers.
+            const std::size_t ncMax {std::min(NC, (n + NR - 1)/NR*NR)};
+            const std::size_t mcMax {std::min(MC, (m + MR - 1)/MR*MR)};
+            std::vector<T> packedB(KC*ncMax);
+            std::vector<T> packedA(mcMax*KC);
+
+            for (std::size_t jc = 0; jc < n; jc += NC) {
+                const std::size_t nc {std::min(NC, n - jc)};
+
+                for (std::size_t pc = 0; pc < k; pc += KC) {
+                    const std::size_t kc {std::min(KC, k - pc)};
+                    packB(kc, nc, b, pc, jc, packedB.data());
+
+                    for (std::size_t ic = 0; ic < m; ic += MC) {
+                        const std::size_t mc {std::min(MC, m - ic)};
+                        packA(mc, kc, a, ic, pc, packedA.data());
+
+                        for (std::size_t jr = 0; jr < nc; jr += NR) {
+                            const std::size_t cols {std::min(NR, nc - jr)};
+                            const T* bSliver {packedB.data() + jr*kc};
+
+                            for (std::size_t ir = 0; ir < mc; ir += MR) {
+                                const std::size_t rows {std::min(MR, mc - ir)};
+                                microKernel(kc, packedA.data() + ir*kc, bSliver, c, ic + ir, jc + jr, rows, cols);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif
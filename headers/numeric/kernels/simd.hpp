@@ -0,0 +1,844 @@
+#ifndef __SIGABRT_NUMERIC_SIMD__
+#define __SIGABRT_NUMERIC_SIMD__
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define __SIGABRT_NUMERIC_SIMD_X86__
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define __SIGABRT_NUMERIC_SIMD_NEON__
+#include <arm_neon.h>
+#endif
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::kernels
+     *
+     * \brief Sub namespace with the low level compute kernels used by the types and functions.
+     * */
+    namespace kernels {
+        /**
+         * \enum InstructionSet
+         *
+         * The instruction sets the vector kernels have implementations for. `SCALAR` is always available.
+         * */
+        enum class InstructionSet {
+            SCALAR,
+            SSE2,
+            AVX2,
+            AVX512,
+            NEON
+        };
+
+        /**
+         * \class HasSimdKernel
+         *
+         * \brief Trait indicating whether the dispatched SIMD vector kernels are available for type `T`.
+         * */
+        template <typename T> struct HasSimdKernel {
+            static constexpr bool value {
+                std::is_same<float, typename std::remove_cv<T>::type>::value ||
+                std::is_same<double, typename std::remove_cv<T>::type>::value
+            };
+        };
+
+        /**
+         * \namespace numeric::kernels::scalar
+         *
+         * \brief Portable loops over raw pointers. These are the fallback for every type, and the `SCALAR` instruction set.
+         * */
+        namespace scalar {
+            template <typename T, typename U> T dot(const T* a, const U* b, const std::size_t& n) {
+                T acc {static_cast<T>(0)};
+                for (std::size_t i = 0; i < n; i++) {
+                    acc += a[i]*b[i];
+                }
+                return acc;
+            }
+
+            template <typename T> void scale(const T* a, const T& factor, T* out, const std::size_t& n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    out[i] = a[i]*factor;
+                }
+            }
+
+            template <typename T> void add(const T* a, const T* b, T* out, const std::size_t& n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    out[i] = a[i] + b[i];
+                }
+            }
+
+            template <typename T> void sub(const T* a, const T* b, T* out, const std::size_t& n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    out[i] = a[i] - b[i];
+                }
+            }
+
+            template <typename T> void neg(const T* a, T* out, const std::size_t& n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    out[i] = -a[i];
+                }
+            }
+
+            template <typename T> void axpy(const T* a, const T& factor, T* out, const std::size_t& n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    out[i] += a[i]*factor;
+                }
+            }
+        }
+
+#ifdef __SIGABRT_NUMERIC_SIMD_X86__
+        //! \cond NO_DOC
+        namespace sse2 {
+            __attribute__((target("sse2"))) inline double dot(const double* a, const double* b, const std::size_t& n) {
+                __m128d acc0 {_mm_setzero_pd()};
+                __m128d acc1 {_mm_setzero_pd()};
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+                    acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+                }
+                double lanes[2];
+                _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+                double acc {lanes[0] + lanes[1]};
+                for (; i < n; i++) {
+                    acc += a[i]*b[i];
+                }
+                return acc;
+            }
+
+            __attribute__((target("sse2"))) inline float dot(const float* a, const float* b, const std::size_t& n) {
+                __m128 acc0 {_mm_setzero_ps()};
+                __m128 acc1 {_mm_setzero_ps()};
+                std::size_t i {0};
+                for (; i + 8 <= n; i += 8) {
+                    acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                    acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+                }
+                float lanes[4];
+                _mm_storeu_ps(lanes, _mm_add_ps(acc0, acc1));
+                float acc {(lanes[0] + lanes[1]) + (lanes[2] + lanes[3])};
+                for (; i < n; i++) {
+                    acc += a[i]*b[i];
+                }
+                return acc;
+            }
+
+            __attribute__((target("sse2"))) inline void scale(const double* a, const double& factor, double* out, const std::size_t& n) {
+                const __m128d f {_mm_set1_pd(factor)};
+                std::size_t i {0};
+                for (; i + 2 <= n; i += 2) {
+                    _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(a + i), f));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i]*factor;
+                }
+            }
+
+            __attribute__((target("sse2"))) inline void scale(const float* a, const float& factor, float* out, const std::size_t& n) {
+                const __m128 f {_mm_set1_ps(factor)};
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), f));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i]*factor;
+                }
+            }
+
+            __attribute__((target("sse2"))) inline void add(const double* a, const double* b, double* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 2 <= n; i += 2) {
+                    _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] + b[i];
+                }
+            }
+
+            __attribute__((target("sse2"))) inline void add(const float* a, const float* b, float* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] + b[i];
+                }
+            }
+
+            __attribute__((target("sse2"))) inline void sub(const double* a, const double* b, double* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 2 <= n; i += 2) {
+                    _mm_storeu_pd(out + i, _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] - b[i];
+                }
+            }
+
+            __attribute__((target("sse2"))) inline void sub(const float* a, const float* b, float* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    _mm_storeu_ps(out + i, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] - b[i];
+                }
+            }
+
+            __attribute__((target("sse2"))) inline void neg(const double* a, double* out, const std::size_t& n) {
+                const __m128d sign {_mm_set1_pd(-0.0)};
+                std::size_t i {0};
+                for (; i + 2 <= n; i += 2) {
+                    _mm_storeu_pd(out + i, _mm_xor_pd(_mm_loadu_pd(a + i), sign));
+                }
+                for (; i < n; i++) {
+                    out[i] = -a[i];
+                }
+            }
+
+            __attribute__((target("sse2"))) inline void neg(const float* a, float* out, const std::size_t& n) {
+                const __m128 sign {_mm_set1_ps(-0.0f)};
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    _mm_storeu_ps(out + i, _mm_xor_ps(_mm_loadu_ps(a + i), sign));
+                }
+                for (; i < n; i++) {
+                    out[i] = -a[i];
+                }
+            }
+
+            __attribute__((target("sse2"))) inline void axpy(const double* a, const double& factor, double* out, const std::size_t& n) {
+                const __m128d f {_mm_set1_pd(factor)};
+                std::size_t i {0};
+                for (; i + 2 <= n; i += 2) {
+                    _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(out + i), _mm_mul_pd(_mm_loadu_pd(a + i), f)));
+                }
+                for (; i < n; i++) {
+                    out[i] += a[i]*factor;
+                }
+            }
+
+            __attribute__((target("sse2"))) inline void axpy(const float* a, const float& factor, float* out, const std::size_t& n) {
+                const __m128 f {_mm_set1_ps(factor)};
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(a + i), f)));
+                }
+                for (; i < n; i++) {
+                    out[i] += a[i]*factor;
+                }
+            }
+        }
+
+        namespace avx2 {
+            __attribute__((target("avx2,fma"))) inline double dot(const double* a, const double* b, const std::size_t& n) {
+                __m256d acc0 {_mm256_setzero_pd()};
+                __m256d acc1 {_mm256_setzero_pd()};
+                __m256d acc2 {_mm256_setzero_pd()};
+                __m256d acc3 {_mm256_setzero_pd()};
+                std::size_t i {0};
+                for (; i + 16 <= n; i += 16) {
+                    acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+                    acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), acc1);
+                    acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), acc2);
+                    acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), acc3);
+                }
+                for (; i + 4 <= n; i += 4) {
+                    acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+                }
+                double lanes[4];
+                _mm256_storeu_pd(lanes, _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+                double acc {(lanes[0] + lanes[1]) + (lanes[2] + lanes[3])};
+                for (; i < n; i++) {
+                    acc += a[i]*b[i];
+                }
+                return acc;
+            }
+
+            __attribute__((target("avx2,fma"))) inline float dot(const float* a, const float* b, const std::size_t& n) {
+                __m256 acc0 {_mm256_setzero_ps()};
+                __m256 acc1 {_mm256_setzero_ps()};
+                __m256 acc2 {_mm256_setzero_ps()};
+                __m256 acc3 {_mm256_setzero_ps()};
+                std::size_t i {0};
+                for (; i + 32 <= n; i += 32) {
+                    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+                    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+                    acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), acc2);
+                    acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), acc3);
+                }
+                for (; i + 8 <= n; i += 8) {
+                    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+                }
+                float lanes[8];
+                _mm256_storeu_ps(lanes, _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+                float acc {((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]))};
+                for (; i < n; i++) {
+                    acc += a[i]*b[i];
+                }
+                return acc;
+            }
+
+            __attribute__((target("avx2,fma"))) inline void scale(const double* a, const double& factor, double* out, const std::size_t& n) {
+                const __m256d f {_mm256_set1_pd(factor)};
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), f));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i]*factor;
+                }
+            }
+
+            __attribute__((target("avx2,fma"))) inline void scale(const float* a, const float& factor, float* out, const std::size_t& n) {
+                const __m256 f {_mm256_set1_ps(factor)};
+                std::size_t i {0};
+                for (; i + 8 <= n; i += 8) {
+                    _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), f));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i]*factor;
+                }
+            }
+
+            __attribute__((target("avx2,fma"))) inline void add(const double* a, const double* b, double* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] + b[i];
+                }
+            }
+
+            __attribute__((target("avx2,fma"))) inline void add(const float* a, const float* b, float* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 8 <= n; i += 8) {
+                    _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] + b[i];
+                }
+            }
+
+            __attribute__((target("avx2,fma"))) inline void sub(const double* a, const double* b, double* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] - b[i];
+                }
+            }
+
+            __attribute__((target("avx2,fma"))) inline void sub(const float* a, const float* b, float* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 8 <= n; i += 8) {
+                    _mm256_storeu_ps(out + i, _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] - b[i];
+                }
+            }
+
+            __attribute__((target("avx2,fma"))) inline void neg(const double* a, double* out, const std::size_t& n) {
+                const __m256d sign {_mm256_set1_pd(-0.0)};
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    _mm256_storeu_pd(out + i, _mm256_xor_pd(_mm256_loadu_pd(a + i), sign));
+                }
+                for (; i < n; i++) {
+                    out[i] = -a[i];
+                }
+            }
+
+            __attribute__((target("avx2,fma"))) inline void neg(const float* a, float* out, const std::size_t& n) {
+                const __m256 sign {_mm256_set1_ps(-0.0f)};
+                std::size_t i {0};
+                for (; i + 8 <= n; i += 8) {
+                    _mm256_storeu_ps(out + i, _mm256_xor_ps(_mm256_loadu_ps(a + i), sign));
+                }
+                for (; i < n; i++) {
+                    out[i] = -a[i];
+                }
+            }
+
+            __attribute__((target("avx2,fma"))) inline void axpy(const double* a, const double& factor, double* out, const std::size_t& n) {
+                const __m256d f {_mm256_set1_pd(factor)};
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    _mm256_storeu_pd(out + i, _mm256_fmadd_pd(_mm256_loadu_pd(a + i), f, _mm256_loadu_pd(out + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = std::fma(a[i], factor, out[i]);
+                }
+            }
+
+            __attribute__((target("avx2,fma"))) inline void axpy(const float* a, const float& factor, float* out, const std::size_t& n) {
+                const __m256 f {_mm256_set1_ps(factor)};
+                std::size_t i {0};
+                for (; i + 8 <= n; i += 8) {
+                    _mm256_storeu_ps(out + i, _mm256_fmadd_ps(_mm256_loadu_ps(a + i), f, _mm256_loadu_ps(out + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = std::fma(a[i], factor, out[i]);
+                }
+            }
+        }
+
+        namespace avx512 {
+            __attribute__((target("avx512f"))) inline double dot(const double* a, const double* b, const std::size_t& n) {
+                __m512d acc0 {_mm512_setzero_pd()};
+                __m512d acc1 {_mm512_setzero_pd()};
+                std::size_t i {0};
+                for (; i + 16 <= n; i += 16) {
+                    acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), acc0);
+                    acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8), acc1);
+                }
+                for (; i + 8 <= n; i += 8) {
+                    acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), acc0);
+                }
+                // The horizontal add runs through memory, _mm512_reduce_add_pd trips -Wuninitialized in some GCC headers.
+                double lanes[8];
+                _mm512_storeu_pd(lanes, _mm512_add_pd(acc0, acc1));
+                double acc {((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]))};
+                for (; i < n; i++) {
+                    acc += a[i]*b[i];
+                }
+                return acc;
+            }
+
+            __attribute__((target("avx512f"))) inline float dot(const float* a, const float* b, const std::size_t& n) {
+                __m512 acc0 {_mm512_setzero_ps()};
+                __m512 acc1 {_mm512_setzero_ps()};
+                std::size_t i {0};
+                for (; i + 32 <= n; i += 32) {
+                    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+                    acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+                }
+                for (; i + 16 <= n; i += 16) {
+                    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+                }
+                float lanes[16];
+                _mm512_storeu_ps(lanes, _mm512_add_ps(acc0, acc1));
+                float acc {static_cast<float>(0)};
+                for (const float& lane : lanes) {
+                    acc += lane;
+                }
+                for (; i < n; i++) {
+                    acc += a[i]*b[i];
+                }
+                return acc;
+            }
+
+            __attribute__((target("avx512f"))) inline void scale(const double* a, const double& factor, double* out, const std::size_t& n) {
+                const __m512d f {_mm512_set1_pd(factor)};
+                std::size_t i {0};
+                for (; i + 8 <= n; i += 8) {
+                    _mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(a + i), f));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i]*factor;
+                }
+            }
+
+            __attribute__((target("avx512f"))) inline void scale(const float* a, const float& factor, float* out, const std::size_t& n) {
+                const __m512 f {_mm512_set1_ps(factor)};
+                std::size_t i {0};
+                for (; i + 16 <= n; i += 16) {
+                    _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_loadu_ps(a + i), f));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i]*factor;
+                }
+            }
+
+            __attribute__((target("avx512f"))) inline void add(const double* a, const double* b, double* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 8 <= n; i += 8) {
+                    _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] + b[i];
+                }
+            }
+
+            __attribute__((target("avx512f"))) inline void add(const float* a, const float* b, float* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 16 <= n; i += 16) {
+                    _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] + b[i];
+                }
+            }
+
+            __attribute__((target("avx512f"))) inline void sub(const double* a, const double* b, double* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 8 <= n; i += 8) {
+                    _mm512_storeu_pd(out + i, _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] - b[i];
+                }
+            }
+
+            __attribute__((target("avx512f"))) inline void sub(const float* a, const float* b, float* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 16 <= n; i += 16) {
+                    _mm512_storeu_ps(out + i, _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] - b[i];
+                }
+            }
+
+            __attribute__((target("avx512f"))) inline void neg(const double* a, double* out, const std::size_t& n) {
+                const __m512i sign {_mm512_castpd_si512(_mm512_set1_pd(-0.0))};
+                std::size_t i {0};
+                for (; i + 8 <= n; i += 8) {
+                    _mm512_storeu_pd(out + i, _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(_mm512_loadu_pd(a + i)), sign)));
+                }
+                for (; i < n; i++) {
+                    out[i] = -a[i];
+                }
+            }
+
+            __attribute__((target("avx512f"))) inline void neg(const float* a, float* out, const std::size_t& n) {
+                const __m512i sign {_mm512_castps_si512(_mm512_set1_ps(-0.0f))};
+                std::size_t i {0};
+                for (; i + 16 <= n; i += 16) {
+                    _mm512_storeu_ps(out + i, _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(_mm512_loadu_ps(a + i)), sign)));
+                }
+                for (; i < n; i++) {
+                    out[i] = -a[i];
+                }
+            }
+
+            __attribute__((target("avx512f"))) inline void axpy(const double* a, const double& factor, double* out, const std::size_t& n) {
+                const __m512d f {_mm512_set1_pd(factor)};
+                std::size_t i {0};
+                for (; i + 8 <= n; i += 8) {
+                    _mm512_storeu_pd(out + i, _mm512_fmadd_pd(_mm512_loadu_pd(a + i), f, _mm512_loadu_pd(out + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = std::fma(a[i], factor, out[i]);
+                }
+            }
+
+            __attribute__((target("avx512f"))) inline void axpy(const float* a, const float& factor, float* out, const std::size_t& n) {
+                const __m512 f {_mm512_set1_ps(factor)};
+                std::size_t i {0};
+                for (; i + 16 <= n; i += 16) {
+                    _mm512_storeu_ps(out + i, _mm512_fmadd_ps(_mm512_loadu_ps(a + i), f, _mm512_loadu_ps(out + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = std::fma(a[i], factor, out[i]);
+                }
+            }
+        }
+        //! \endcond
+#endif
+
+#ifdef __SIGABRT_NUMERIC_SIMD_NEON__
+        //! \cond NO_DOC
+        namespace neon {
+            inline double dot(const double* a, const double* b, const std::size_t& n) {
+                float64x2_t acc0 {vdupq_n_f64(0.0)};
+                float64x2_t acc1 {vdupq_n_f64(0.0)};
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    acc0 = vfmaq_f64(acc0, vld1q_f64(a + i), vld1q_f64(b + i));
+                    acc1 = vfmaq_f64(acc1, vld1q_f64(a + i + 2), vld1q_f64(b + i + 2));
+                }
+                double acc {vaddvq_f64(vaddq_f64(acc0, acc1))};
+                for (; i < n; i++) {
+                    acc += a[i]*b[i];
+                }
+                return acc;
+            }
+
+            inline float dot(const float* a, const float* b, const std::size_t& n) {
+                float32x4_t acc0 {vdupq_n_f32(0.0f)};
+                float32x4_t acc1 {vdupq_n_f32(0.0f)};
+                std::size_t i {0};
+                for (; i + 8 <= n; i += 8) {
+                    acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+                    acc1 = vfmaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+                }
+                float acc {vaddvq_f32(vaddq_f32(acc0, acc1))};
+                for (; i < n; i++) {
+                    acc += a[i]*b[i];
+                }
+                return acc;
+            }
+
+            inline void scale(const double* a, const double& factor, double* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 2 <= n; i += 2) {
+                    vst1q_f64(out + i, vmulq_n_f64(vld1q_f64(a + i), factor));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i]*factor;
+                }
+            }
+
+            inline void scale(const float* a, const float& factor, float* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    vst1q_f32(out + i, vmulq_n_f32(vld1q_f32(a + i), factor));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i]*factor;
+                }
+            }
+
+            inline void add(const double* a, const double* b, double* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 2 <= n; i += 2) {
+                    vst1q_f64(out + i, vaddq_f64(vld1q_f64(a + i), vld1q_f64(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] + b[i];
+                }
+            }
+
+            inline void add(const float* a, const float* b, float* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    vst1q_f32(out + i, vaddq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] + b[i];
+                }
+            }
+
+            inline void sub(const double* a, const double* b, double* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 2 <= n; i += 2) {
+                    vst1q_f64(out + i, vsubq_f64(vld1q_f64(a + i), vld1q_f64(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] - b[i];
+                }
+            }
+
+            inline void sub(const float* a, const float* b, float* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    vst1q_f32(out + i, vsubq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = a[i] - b[i];
+                }
+            }
+
+            inline void neg(const double* a, double* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 2 <= n; i += 2) {
+                    vst1q_f64(out + i, vnegq_f64(vld1q_f64(a + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = -a[i];
+                }
+            }
+
+            inline void neg(const float* a, float* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    vst1q_f32(out + i, vnegq_f32(vld1q_f32(a + i)));
+                }
+                for (; i < n; i++) {
+                    out[i] = -a[i];
+                }
+            }
+
+            inline void axpy(const double* a, const double& factor, double* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 2 <= n; i += 2) {
+                    vst1q_f64(out + i, vfmaq_n_f64(vld1q_f64(out + i), vld1q_f64(a + i), factor));
+                }
+                for (; i < n; i++) {
+                    out[i] = std::fma(a[i], factor, out[i]);
+                }
+            }
+
+            inline void axpy(const float* a, const float& factor, float* out, const std::size_t& n) {
+                std::size_t i {0};
+                for (; i + 4 <= n; i += 4) {
+                    vst1q_f32(out + i, vfmaq_n_f32(vld1q_f32(out + i), vld1q_f32(a + i), factor));
+                }
+                for (; i < n; i++) {
+                    out[i] = std::fma(a[i], factor, out[i]);
+                }
+            }
+        }
+        //! \endcond
+#endif
+
+        /**
+         * \class VectorKernels
+         *
+         * \tparam T `float` or `double`.
+         *
+         * \brief A dispatch table of vector kernels for one instruction set.
+         *
+         *   - `dot`: Returns the dot product of `a` and `b`.
+         *   - `scale`: Writes `a*factor` into `out`. `out` may be the same as `a`.
+         *   - `add`: Writes `a + b` into `out`. `out` may be the same as `a` or `b`.
+         *   - `sub`: Writes `a - b` into `out`. `out` may be the same as `a` or `b`.
+         *   - `neg`: Writes `-a` into `out` by flipping the sign bits, so signed zeros and NaNs are negated too. `out` may
+         *     be the same as `a`.
+         *   - `axpy`: Adds `a*factor` to `out`. AVX2, AVX-512 and NEON fuse the multiply and the add, with one rounding;
+         *     SCALAR and SSE2 round the product first. This is the row update of the eliminations.
+         * */
+        template <typename T> struct VectorKernels {
+            InstructionSet instructionSet;
+            T (*dot)(const T*, const T*, const std::size_t&);
+            void (*scale)(const T*, const T&, T*, const std::size_t&);
+            void (*add)(const T*, const T*, T*, const std::size_t&);
+            void (*sub)(const T*, const T*, T*, const std::size_t&);
+            void (*neg)(const T*, T*, const std::size_t&);
+            void (*axpy)(const T*, const T&, T*, const std::size_t&);
+        };
+
+        //! \cond NO_DOC
+        namespace detail {
+            template <typename T> inline const VectorKernels<T>* kernelsFor(const InstructionSet& instructionSet) {
+                static const VectorKernels<T> scalarKernels {
+                    InstructionSet::SCALAR,
+                    &scalar::dot<T, T>, &scalar::scale<T>, &scalar::add<T>, &scalar::sub<T>, &scalar::neg<T>,
+                    &scalar::axpy<T>
+                };
+#ifdef __SIGABRT_NUMERIC_SIMD_X86__
+                static const VectorKernels<T> sse2Kernels {
+                    InstructionSet::SSE2, &sse2::dot, &sse2::scale, &sse2::add, &sse2::sub, &sse2::neg, &sse2::axpy
+                };
+                static const VectorKernels<T> avx2Kernels {
+                    InstructionSet::AVX2, &avx2::dot, &avx2::scale, &avx2::add, &avx2::sub, &avx2::neg, &avx2::axpy
+                };
+                static const VectorKernels<T> avx512Kernels {
+                    InstructionSet::AVX512, &avx512::dot, &avx512::scale, &avx512::add, &avx512::sub, &avx512::neg, &avx512::axpy
+                };
+#endif
+#ifdef __SIGABRT_NUMERIC_SIMD_NEON__
+                static const VectorKernels<T> neonKernels {
+                    InstructionSet::NEON, &neon::dot, &neon::scale, &neon::add, &neon::sub, &neon::neg, &neon::axpy
+                };
+#endif
+                switch (instructionSet) {
+#ifdef __SIGABRT_NUMERIC_SIMD_X86__
+                    case InstructionSet::SSE2: return &sse2Kernels;
+                    case InstructionSet::AVX2: return &avx2Kernels;
+                    case InstructionSet::AVX512: return &avx512Kernels;
+#endif
+#ifdef __SIGABRT_NUMERIC_SIMD_NEON__
+                    case InstructionSet::NEON: return &neonKernels;
+#endif
+                    default: return &scalarKernels;
+                }
+            }
+        }
+        //! \endcond
+
+        /**
+         * \brief Check if the CPU we are running on supports an instruction set.
+         *
+         * \param instructionSet The instruction set to check.
+         *
+         * \return bool
+         * */
+        inline bool is_supported(const InstructionSet& instructionSet) {
+            switch (instructionSet) {
+                case InstructionSet::SCALAR:
+                    return true;
+#ifdef __SIGABRT_NUMERIC_SIMD_X86__
+                case InstructionSet::SSE2:
+                    return __builtin_cpu_supports("sse2");
+                case InstructionSet::AVX2:
+                    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+                case InstructionSet::AVX512:
+                    return __builtin_cpu_supports("avx512f");
+#endif
+#ifdef __SIGABRT_NUMERIC_SIMD_NEON__
+                case InstructionSet::NEON:
+                    return true;
+#endif
+                default:
+                    return false;
+            }
+        }
+
+        /**
+         * \brief The best instruction set supported by the CPU we are running on.
+         *
+         * This is detected once and cached.
+         *
+         * \return InstructionSet
+         * */
+        inline InstructionSet detected_instruction_set() {
+            static const InstructionSet detected {[]() {
+                for (const auto& candidate : {InstructionSet::AVX512, InstructionSet::AVX2, InstructionSet::SSE2, InstructionSet::NEON}) {
+                    if (is_supported(candidate)) {
+                        return candidate;
+                    }
+                }
+                return InstructionSet::SCALAR;
+            }()};
+            return detected;
+        }
+
+        //! \cond NO_DOC
+        template <typename T> std::atomic<const VectorKernels<T>*>& activeKernelsSlot() {
+            static std::atomic<const VectorKernels<T>*> slot {detail::kernelsFor<T>(detected_instruction_set())};
+            return slot;
+        }
+        //! \endcond
+
+        /**
+         * \brief Get the dispatch table in use for type `T`.
+         *
+         * On first use, this picks the kernels for the best instruction set the CPU supports.
+         *
+         * \tparam T `float` or `double`.
+         *
+         * \return const VectorKernels<T>&
+         * */
+        template <typename T> const VectorKernels<T>& vector_kernels() {
+            static_assert(HasSimdKernel<T>::value, "There are no SIMD vector kernels for this type.");
+            return *activeKernelsSlot<typename std::remove_cv<T>::type>().load(std::memory_order_relaxed);
+        }
+
+        /**
+         * \brief Override the instruction set used by the vector kernels.
+         *
+         * This is mostly useful for testing and benchmarking the individual code paths. Requests for instruction sets that
+         * the CPU does not support are ignored.
+         *
+         * \param instructionSet The instruction set to use.
+         *
+         * \return bool indicating whether the override took effect.
+         * */
+        inline bool set_instruction_set(const InstructionSet& instructionSet) {
+            if (!is_supported(instructionSet)) {
+                return false;
+            }
+            activeKernelsSlot<float>().store(detail::kernelsFor<float>(instructionSet), std::memory_order_relaxed);
+            activeKernelsSlot<double>().store(detail::kernelsFor<double>(instructionSet), std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+#endif
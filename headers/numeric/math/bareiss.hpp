@@ -0,0 +1,183 @@
+#ifndef __SIGABRT_NUMERIC_BAREISS__
+#define __SIGABRT_NUMERIC_BAREISS__
+
+#include <cstddef>
+#include <utility>
+
+#include <numeric/benchmark/instrumentation.hpp>
+#include <numeric/kernels/elimination.hpp>
+#include <numeric/types/models.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/matrixview.hpp>
+#include <numeric/types/permutation.hpp>
+#include <numeric/math/errors.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::functions
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace functions {
+        //! \cond NO_DOC
+        namespace detail {
+            // The elements of a row from column first on, if they are contiguous: the rows of a matrix, and of a view that
+            // is not transposed. Null for the strided rows of a transposed view, which take the element by element loops.
+            template <typename T> T* contiguousRow(numeric::types::Matrix<T>& matrix, const std::size_t& row, const std::size_t& first) {
+                return matrix.rowPtr(row) + first;
+            }
+
+            template <typename T> T* contiguousRow(const numeric::types::MatrixView<T>& view, const std::size_t& row, const std::size_t& first) {
+                return view.isTransposed()? nullptr : view.rowSlice(row).start + first;
+            }
+
+            // bareiss, for a Matrix<T> or a MatrixView<T>. Row exchanges are recorded in permutation, if there is one.
+            template <typename M> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+            bareissInPlace(M& matrix, numeric::types::Permutation* permutation) {
+                using T = typename M::value_type;
+                const T zero {static_cast<T>(0)};
+                const std::size_t nrows {matrix.getRows()};
+                const std::size_t ncols {matrix.getCols()};
+                const std::size_t smallerDim {nrows < ncols? nrows: ncols};
+                bool freeElements {false};
+                bool skippedColumns {false};
+                T previous {static_cast<T>(1)};
+                std::size_t pivotRow {0};
+                for (std::size_t col = 0; col < ncols && pivotRow < nrows; col++) {
+                    if (matrix.atUnchecked(pivotRow, col) == zero) {
+                        std::size_t next {pivotRow + 1};
+                        while (next < nrows && matrix.atUnchecked(next, col) == zero) {
+                            next++;
+                        }
+                        if (next == nrows) {
+                            if (col < smallerDim) {
+                                numeric::benchmark::record_pivot_failure();
+                                freeElements = true;
+                            }
+                            skippedColumns = true;
+                            continue;
+                        }
+                        matrix.exchangeRows(pivotRow, next);
+                        if (permutation) {
+                            permutation->swap(pivotRow, next);
+                        }
+                    }
+
+                    // The pivot row is 0 left of col. Until a column is skipped, the pivots are on the diagonal, and they
+                    // are the only non zero elements of the other rows left of col: they all become the new pivot. After
+                    // that, the elements of the skipped columns have to be scaled too, so the whole rows are updated.
+                    const std::size_t firstCol {skippedColumns? 0 : col};
+                    const T pivot {matrix.atUnchecked(pivotRow, col)};
+                    for (std::size_t otherRow = 0; otherRow < nrows; otherRow++) {
+                        if (otherRow == pivotRow) {
+                            continue;
+                        }
+                        const T factor {matrix.atUnchecked(otherRow, col)};
+                        T* dest {contiguousRow(matrix, otherRow, firstCol)};
+                        if (dest) {
+                            numeric::kernels::cross_eliminate(
+                                dest, contiguousRow(matrix, pivotRow, firstCol), pivot, factor, previous, ncols - firstCol);
+                        } else {
+                            for (std::size_t j = firstCol; j < ncols; j++) {
+                                T& elem {matrix.atUnchecked(otherRow, j)};
+                                elem = (pivot*elem - factor*matrix.atUnchecked(pivotRow, j))/previous;
+                            }
+                        }
+                        if (!skippedColumns && otherRow < pivotRow) {
+                            matrix.atUnchecked(otherRow, otherRow) = pivot;
+                        }
+                    }
+                    previous = pivot;
+                    pivotRow++;
+                }
+
+                if (freeElements) {
+                    return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::failure(numeric::ErrorCode::FREE_COLUMNS_RREF);
+                } else {
+                    return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::success(thesoup::types::Unit::unit);
+                }
+            }
+        }
+        //! \endcond
+
+        /**
+         * \brief Fraction free (Bareiss) Gauss Jordan elimination.
+         *
+         * \tparam T The element type. Needs `+`, `-`, `*`, and a `/` which is exact when the remainder is 0: the integers
+         * (`BigInt`, or built in ones if they do not overflow) as well as the field types.
+         *
+         * Every step updates all the other rows with `a[i][j] = (p*a[i][j] - a[i][c]*a[r][j])/prev`, where `p` is the
+         * current pivot and `prev` the previous one (`cross_eliminate`). By Sylvester's identity the division is always
+         * exact, and every entry is a minor of the input, so on an integer matrix the entries stay integers, and grow only
+         * linearly with the number of steps (instead of exponentially, as with naive fraction free elimination, or as the
+         * denominators of rationals do without reduction).
+         *
+         * On return the matrix is in reduced row echelon form, scaled by a common factor: every pivot is equal to the last
+         * pivot (the determinant of the pivot rows and columns, up to sign, which is the determinant for a square,
+         * non singular matrix with no row exchanges), and the entries above and below the pivots are 0. Divide the rows by
+         * the pivots (see `bareiss_rref`) to get the RREF itself. `rref` on integral types is this, with every row divided
+         * by the gcd of its elements.
+         *
+         * Unlike `rref` on the other types, pivots move right past free columns (the result is a proper echelon form), so
+         * when there are free columns the layout differs from theirs.
+         *
+         * \param matrix The **non const** reference to the input matrix.
+         *
+         * \return result:
+         *   Result<Unit, ErrorCode> Result to indicate the operation status.
+         *
+         *   Possible error codes:
+         *   - `FREE_COLUMNS_RREF`: If one of the first min(rows, cols) columns has no pivot.
+         * */
+        template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+        bareiss(numeric::types::Matrix<T>& matrix) {
+            return detail::bareissInPlace(matrix, nullptr);
+        }
+
+        /**
+         * \brief RREF through fraction free elimination.
+         *
+         * \tparam T A field type (`Rational`, `Fraction`, `LazyFraction`, floating point).
+         *
+         * This is `bareiss` followed by a division of every pivot row by its pivot, so the result is the reduced row echelon
+         * form. It computes the same result as `rref` when there are no free columns, but for rationals with integer
+         * input, all the elimination runs on integers (denominator 1), which skips nearly all of the gcd work `rref` does to
+         * keep the fractions reduced.
+         *
+         * \param matrix The **non const** reference to the input matrix.
+         *
+         * \return result:
+         *   Result<Unit, ErrorCode> Result to indicate the operation status.
+         *
+         *   Possible error codes:
+         *   - `FREE_COLUMNS_RREF`: If one of the first min(rows, cols) columns has no pivot.
+         * */
+        template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+        bareiss_rref(numeric::types::Matrix<T>& matrix) {
+            auto result {bareiss(matrix)};
+            const T zero {static_cast<T>(0)};
+            for (std::size_t i = 0; i < matrix.getRows(); i++) {
+                T* row {matrix.rowPtr(i)};
+                std::size_t col {0};
+                while (col < matrix.getCols() && row[col] == zero) {
+                    col++;
+                }
+                if (col == matrix.getCols()) {
+                    continue;
+                }
+                const T pivot {row[col]};
+                for (std::size_t j = col; j < matrix.getCols(); j++) {
+                    row[j] = row[j]/pivot;
+                }
+            }
+            return result;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef __SIGABRT_NUMERIC_BATCHED__
+#define __SIGABRT_NUMERIC_BATCHED__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <numeric/types/systembatch.hpp>
+#include <numeric/math/errors.hpp>
+#include <numeric/parallel/threadpool.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::functions
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace functions {
+        /**
+         * \brief The number of systems `batched_gauss_jordan` eliminates together. A tile of 64 4x5 double systems is
+         * 10 KiB, so it stays in the L1 cache for the whole elimination.
+         * */
+        constexpr std::size_t BATCH_TILE {64};
+
+        namespace {
+            // Scratch space for the elimination of one tile. Row indices are stored as T (-1 for none), so that every
+            // loop over the lanes of a tile compares and selects values of a single type, and compiles to SIMD blends.
+            template <typename T> struct BatchWorkspace {
+                std::vector<T> used;
+                std::vector<T> pivotOf;
+                std::vector<T> pivotRow;
+                T best[BATCH_TILE];
+                T bestRow[BATCH_TILE];
+                T inverse[BATCH_TILE];
+                T factor[BATCH_TILE];
+
+                BatchWorkspace(const std::size_t& rows, const std::size_t& cols):
+                    used(rows*BATCH_TILE), pivotOf((cols - 1)*BATCH_TILE), pivotRow(cols*BATCH_TILE) {}
+            };
+
+            // Gauss Jordan elimination of the systems [first, first + width), width <= BATCH_TILE, with partial pivoting.
+            // Rows are not exchanged: every lane remembers which row is the pivot of each column, and which rows are used.
+            // All the branches are per lane selects, so every system runs the same instructions.
+            template <typename T> void eliminateTile(
+                numeric::types::SystemBatch<T>& batch,
+                const std::size_t& first,
+                const std::size_t& width,
+                const T& zeroPrecision,
+                BatchWorkspace<T>& ws,
+                std::optional<numeric::ErrorCode>* status
+            ) {
+                const std::size_t rows {batch.getRows()};
+                const std::size_t cols {batch.getCols()};
+                const std::size_t vars {cols - 1};
+                std::fill(ws.used.begin(), ws.used.end(), static_cast<T>(0));
+
+                for (std::size_t k = 0; k < vars; k++) {
+                    // The largest unused element of the column.
+                    T* best {ws.best};
+                    T* bestRow {ws.bestRow};
+                    for (std::size_t l = 0; l < width; l++) {
+                        best[l] = zeroPrecision;
+                        bestRow[l] = static_cast<T>(-1);
+                    }
+                    for (std::size_t r = 0; r < rows; r++) {
+                        const T* a {batch.lanes(r, k) + first};
+                        const T* used {ws.used.data() + r*BATCH_TILE};
+                        const T row {static_cast<T>(r)};
+                        for (std::size_t l = 0; l < width; l++) {
+                            const T size {std::fabs(a[l])};
+                            const bool take {used[l] == static_cast<T>(0) && size > best[l]};
+                            best[l] = take? size : best[l];
+                            bestRow[l] = take? row : bestRow[l];
+                        }
+                    }
+
+                    // Gather the pivot rows, and mark them used. Lanes without a pivot gather zeros.
+                    T* pivotOf {ws.pivotOf.data() + k*BATCH_TILE};
+                    for (std::size_t l = 0; l < width; l++) {
+                        pivotOf[l] = bestRow[l];
+                    }
+                    for (std::size_t j = k; j < cols; j++) {
+                        T* pivot {ws.pivotRow.data() + j*BATCH_TILE};
+                        std::fill(pivot, pivot + width, static_cast<T>(0));
+                        for (std::size_t r = 0; r < rows; r++) {
+                            const T* a {batch.lanes(r, j) + first};
+                            const T row {static_cast<T>(r)};
+                            for (std::size_t l = 0; l < width; l++) {
+                                pivot[l] = bestRow[l] == row? a[l] : pivot[l];
+                            }
+                        }
+                    }
+                    for (std::size_t r = 0; r < rows; r++) {
+                        T* used {ws.used.data() + r*BATCH_TILE};
+                        const T row {static_cast<T>(r)};
+                        for (std::size_t l = 0; l < width; l++) {
+                            used[l] = bestRow[l] == row? static_cast<T>(1) : used[l];
+                        }
+                    }
+                    const T* pivotElem {ws.pivotRow.data() + k*BATCH_TILE};
+                    for (std::size_t l = 0; l < width; l++) {
+                        const bool found {bestRow[l] >= static_cast<T>(0)};
+                        const T inverse {static_cast<T>(1)/(found? pivotElem[l] : static_cast<T>(1))};
+                        ws.inverse[l] = found? inverse : static_cast<T>(0);
+                    }
+
+                    // Normalize the pivot rows and eliminate the column from the other rows. The elements left of k are 0
+                    // in the pivot rows, so only the columns from k on change.
+                    for (std::size_t r = 0; r < rows; r++) {
+                        const T row {static_cast<T>(r)};
+                        const T* elem {batch.lanes(r, k) + first};
+                        for (std::size_t l = 0; l < width; l++) {
+                            ws.factor[l] = bestRow[l] == row? static_cast<T>(0) : elem[l]*ws.inverse[l];
+                        }
+                        for (std::size_t j = k; j < cols; j++) {
+                            T* a {batch.lanes(r, j) + first};
+                            const T* pivot {ws.pivotRow.data() + j*BATCH_TILE};
+                            for (std::size_t l = 0; l < width; l++) {
+                                a[l] = bestRow[l] == row? pivot[l]*ws.inverse[l] : a[l] - ws.factor[l]*pivot[l];
+                            }
+                        }
+                    }
+                }
+
+                // Unused rows are now 0 = rhs. A non zero rhs there means no solutions; a column without a pivot, that
+                // there are infinitely many.
+                for (std::size_t l = 0; l < width; l++) {
+                    bool inconsistent {false};
+                    for (std::size_t r = 0; r < rows; r++) {
+                        inconsistent = inconsistent ||
+                            (ws.used[r*BATCH_TILE + l] == static_cast<T>(0) && std::fabs(batch.lanes(r, vars)[first + l]) > zeroPrecision);
+                    }
+                    bool freeColumns {false};
+                    for (std::size_t k = 0; k < vars; k++) {
+                        freeColumns = freeColumns || ws.pivotOf[k*BATCH_TILE + l] < static_cast<T>(0);
+                    }
+                    if (inconsistent) {
+                        status[first + l] = numeric::ErrorCode::NO_SOLUTIONS;
+                    } else if (freeColumns) {
+                        status[first + l] = numeric::ErrorCode::INFINITE_SOLUTIONS;
+                    }
+                }
+
+                // The value of variable k is the rhs of its pivot row.
+                for (std::size_t k = 0; k < vars; k++) {
+                    T* x {batch.solutionLanes(k) + first};
+                    const T* pivotOf {ws.pivotOf.data() + k*BATCH_TILE};
+                    std::fill(x, x + width, static_cast<T>(0));
+                    for (std::size_t r = 0; r < rows; r++) {
+                        const T* rhs {batch.lanes(r, vars) + first};
+                        const T row {static_cast<T>(r)};
+                        for (std::size_t l = 0; l < width; l++) {
+                            x[l] = pivotOf[l] == row? rhs[l] : x[l];
+                        }
+                    }
+                }
+            }
+
+            template <typename T> void eliminateTiles(
+                numeric::types::SystemBatch<T>& batch,
+                const std::size_t& firstTile,
+                const std::size_t& lastTile,
+                const T& zeroPrecision,
+                std::optional<numeric::ErrorCode>* status
+            ) {
+                BatchWorkspace<T> ws {batch.getRows(), batch.getCols()};
+                for (std::size_t tile = firstTile; tile < lastTile; tile++) {
+                    const std::size_t first {tile*BATCH_TILE};
+                    eliminateTile(batch, first, std::min(BATCH_TILE, batch.getCount() - first), zeroPrecision, ws, status);
+                }
+            }
+        }
+
+        /**
+         * \brief Solve many independent systems of linear equations of the same shape.
+         *
+         * This is `gauss_jordan` for a `SystemBatch`. The systems are eliminated in tiles of `BATCH_TILE`, and within a
+         * tile every step runs over the systems in the innermost loop, on contiguous arrays, with the pivoting done by
+         * selects instead of branches and row exchanges. The compiler turns these loops into SIMD code across the
+         * systems, which is what makes millions of 3x4 or 4x5 systems cheap: there are no allocations, calls or
+         * unpredictable branches per system.
+         *
+         * Pivoting is partial (the largest element of the column), so the solutions match `LUDecomposition` more closely
+         * than `gauss_jordan`'s first non zero pivot. The augmented systems are reduced in place (without exchanging rows)
+         * and the solutions are written to `batch.solutionLanes`.
+         *
+         * \param batch The systems. They are overwritten.
+         *
+         * \param zero_precision Pivots and right hand sides with an absolute value less than or equal to this are treated
+         * as 0. The default only treats exact zeros as zero.
+         *
+         * \return std::vector<std::optional<ErrorCode>> One entry per system, empty if the system was solved. Otherwise
+         * the same error codes as `gauss_jordan`:
+         *   - `UNDERDETERMINED_SYSTEM`: If the systems have less equations than variables (then every entry has it).
+         *   - `NO_SOLUTIONS`: If the equations of the system are inconsistent.
+         *   - `INFINITE_SOLUTIONS`: If the equations are consistent, but some variables are free.
+         * */
+        template <typename T> std::vector<std::optional<numeric::ErrorCode>> batched_gauss_jordan(
+            numeric::types::SystemBatch<T>& batch,
+            const double& zero_precision=0.0
+        ) {
+            std::vector<std::optional<numeric::ErrorCode>> status(batch.getCount());
+            if (batch.getRows() < batch.getCols() - 1) {
+                std::fill(status.begin(), status.end(), numeric::ErrorCode::UNDERDETERMINED_SYSTEM);
+                return status;
+            }
+            const std::size_t tiles {(batch.getCount() + BATCH_TILE - 1)/BATCH_TILE};
+            eliminateTiles(batch, 0, tiles, static_cast<T>(zero_precision), status.data());
+            return status;
+        }
+
+        /**
+         * \brief Solve many independent systems of linear equations of the same shape, using a thread pool.
+         *
+         * Same as `batched_gauss_jordan` above, with the tiles split between the threads of the pool. The systems are
+         * independent, so the results are exactly the same.
+         * */
+        template <typename T> std::vector<std::optional<numeric::ErrorCode>> batched_gauss_jordan(
+            numeric::types::SystemBatch<T>& batch,
+            numeric::parallel::ThreadPool& pool,
+            const double& zero_precision=0.0
+        ) {
+            std::vector<std::optional<numeric::ErrorCode>> status(batch.getCount());
+            if (batch.getRows() < batch.getCols() - 1) {
+                std::fill(status.begin(), status.end(), numeric::ErrorCode::UNDERDETERMINED_SYSTEM);
+                return status;
+            }
+            const std::size_t tiles {(batch.getCount() + BATCH_TILE - 1)/BATCH_TILE};
+            pool.parallel_for(0, tiles, [&](const std::size_t& begin, const std::size_t& end) {
+                eliminateTiles(batch, begin, end, static_cast<T>(zero_precision), status.data());
+            });
+            return status;
+        }
+    }
+}
+
+#endif
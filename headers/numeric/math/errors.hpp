@@ -19,7 +19,11 @@ namespace numeric {
         FREE_COLUMNS_RREF,
         INFINITE_SOLUTIONS,
         NO_SOLUTIONS,
-        INCOMPATIBLE_VECTORS
+        INCOMPATIBLE_VECTORS,
+        NON_SQUARE_MATRIX,
+        SINGULAR_MATRIX,
+        NOT_CONVERGED,
+        NON_INTEGRAL_SOLUTION
     };
 }
 
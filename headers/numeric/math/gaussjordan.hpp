@@ -4,9 +4,11 @@
 #include <optional>
 #include <vector>
 
+#include <numeric/benchmark/instrumentation.hpp>
 #include <numeric/types/models.hpp>
 #include <numeric/types/matrix.hpp>
 #include <numeric/math/errors.hpp>
+#include <numeric/math/rref.hpp>
 
 #include <thesoup/types/types.hpp>
 
@@ -34,6 +36,11 @@ namespace numeric {
          * parsing the last column to construct the solution. It however does return a `Result<Unit, ErrorCode>` to 
          * indicate the status of the computation.
          * 
+         * For integral types, `rref` reduces without division, and leaves each row as the smallest integer multiple of
+         * the reduced row: row i reads `matrix[i][i] * x_i = matrix[i][cols - 1]`, with a positive pivot that is not
+         * always 1. The caller has to divide the last column by the pivots then, and that division is only exact if the
+         * solution is integral.
+         * 
          * The reduction is done in place to avoid copies.
          * 
          * \param matrix: 
@@ -49,13 +56,14 @@ namespace numeric {
          * */
         template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
         gauss_jordan(numeric::types::Matrix<T>& matrix) {
+            const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::GAUSS_JORDAN};
             // Step 0: Validate matrix in augmented form
             if (matrix.getRows() < matrix.getCols()-1) {
                 return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::failure(numeric::ErrorCode::UNDERDETERMINED_SYSTEM);
             }
             
             auto retval = rref(matrix);
-            if (retval) {
+            if (!retval) {
                 if (retval.error() == numeric::ErrorCode::FREE_COLUMNS_RREF) {
                     // We have free columns. We need to check for the case where we have NO solutions.
                     // If we cannot find one, then there will be infinitely many solutions.
@@ -110,6 +118,7 @@ namespace numeric {
          * */
         template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
         gauss_jordan(numeric::types::Matrix<T>& matrix, const double& zero_precision) {
+            const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::GAUSS_JORDAN};
             // Step 0: Validate matrix in augmented form
             if (matrix.getRows() < matrix.getCols()-1) {
                 return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::failure(numeric::ErrorCode::UNDERDETERMINED_SYSTEM);
@@ -0,0 +1,551 @@
+#ifndef __SIGABRT_NUMERIC_ITERATIVE__
+#define __SIGABRT_NUMERIC_ITERATIVE__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/matrixview.hpp>
+#include <numeric/types/sparsematrix.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/math/errors.hpp>
+
+#include <thesoup/types/types.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::functions
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace functions {
+        /**
+         * \class IterativeOptions
+         *
+         * \brief When an iterative solver stops.
+         *
+         * \var maxIterations The maximum number of matrix*vector products. The solver gives up with `NOT_CONVERGED` after
+         * this many.
+         *
+         * \var tolerance The solver stops when the residual |b - A*x| is at most `tolerance*|b|`.
+         *
+         * \var restart The number of GMRES iterations between restarts, which is also the number of basis vectors kept
+         * in memory. Ignored by conjugate gradient.
+         * */
+        struct IterativeOptions {
+            std::size_t maxIterations {1000};
+            double tolerance {1e-10};
+            std::size_t restart {30};
+        };
+
+        /**
+         * \class IterativeSolution
+         *
+         * \brief The result of an iterative solver that converged.
+         *
+         * \var solution The solution x.
+         *
+         * \var iterations The number of iterations (matrix*vector products) it took.
+         *
+         * \var residual The relative residual |b - A*x|/|b| the solver reached, as tracked by the iteration.
+         * */
+        template <typename T> struct IterativeSolution {
+            numeric::types::Vector<T> solution;
+            std::size_t iterations;
+            double residual;
+        };
+
+        /**
+         * \class IdentityPreconditioner
+         *
+         * \brief The preconditioner that does nothing. This is the default of the solvers.
+         *
+         * A preconditioner is any class with a `size()`, and an `apply(r)` that returns an approximation of A^-1*r as a
+         * `Vector<T>`. The better the approximation, the fewer iterations the solvers need; `apply` is called once per
+         * iteration, so it has to be cheap.
+         * */
+        template <typename T> class IdentityPreconditioner {
+        private:
+            std::size_t n;
+
+        public:
+            explicit IdentityPreconditioner(const std::size_t& n): n {n} {}
+
+            std::size_t size() const {
+                return n;
+            }
+
+            numeric::types::Vector<T> apply(const numeric::types::Vector<T>& r) const {
+                numeric::types::Vector<T> retval(r.size(), r.get_resource());
+                std::copy(r.begin(), r.end(), retval.begin());
+                return retval;
+            }
+        };
+
+        /**
+         * \class JacobiPreconditioner
+         *
+         * \brief Divides by the diagonal of the matrix. Cheap, and effective for diagonally dominant matrices.
+         *
+         * Instances are created through `create`, which returns a `Result<JacobiPreconditioner<T>, ErrorCode>`.
+         * */
+        template <typename T> class JacobiPreconditioner {
+        private:
+            std::vector<T> inverseDiagonal;
+
+            explicit JacobiPreconditioner(std::vector<T>&& inverseDiagonal): inverseDiagonal {std::move(inverseDiagonal)} {}
+
+            static T diagonal(const numeric::types::Matrix<T>& matrix, const std::size_t& i) {
+                return matrix.atUnchecked(i, i);
+            }
+
+            static T diagonal(const numeric::types::ConstMatrixView<T>& matrix, const std::size_t& i) {
+                return matrix.atUnchecked(i, i);
+            }
+
+            static T diagonal(const numeric::types::SparseMatrix<T>& matrix, const std::size_t& i) {
+                return matrix.at(i, i);
+            }
+
+        public:
+            /**
+             * \brief Build the preconditioner from the diagonal of a square `Matrix`, `ConstMatrixView` or `SparseMatrix`.
+             *
+             * \return result:
+             *   Result<JacobiPreconditioner<T>, ErrorCode>
+             *
+             *   Possible error codes:
+             *   - `NON_SQUARE_MATRIX`: If the matrix is not square.
+             *   - `SINGULAR_MATRIX`: If an element of the diagonal is 0.
+             * */
+            template <typename M> static thesoup::types::Result<JacobiPreconditioner<T>, numeric::ErrorCode> create(const M& matrix) {
+                if (matrix.getRows() != matrix.getCols()) {
+                    return thesoup::types::Result<JacobiPreconditioner<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::NON_SQUARE_MATRIX);
+                }
+                std::vector<T> inverse(matrix.getRows());
+                for (std::size_t i = 0; i < inverse.size(); i++) {
+                    const T elem {diagonal(matrix, i)};
+                    if (elem == static_cast<T>(0)) {
+                        return thesoup::types::Result<JacobiPreconditioner<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::SINGULAR_MATRIX);
+                    }
+                    inverse[i] = static_cast<T>(1)/elem;
+                }
+                return thesoup::types::Result<JacobiPreconditioner<T>, numeric::ErrorCode>::success(JacobiPreconditioner<T> {std::move(inverse)});
+            }
+
+            std::size_t size() const {
+                return inverseDiagonal.size();
+            }
+
+            numeric::types::Vector<T> apply(const numeric::types::Vector<T>& r) const {
+                numeric::types::Vector<T> retval(r.size(), r.get_resource());
+                const T* src {r.data()};
+                T* dest {retval.data()};
+                for (std::size_t i = 0; i < r.size(); i++) {
+                    dest[i] = src[i]*inverseDiagonal[i];
+                }
+                return retval;
+            }
+        };
+
+        /**
+         * \class ILU0Preconditioner
+         *
+         * \brief Incomplete LU factorization with no fill in: L*U ~ A, where L and U only have elements where A has.
+         *
+         * `apply` is a forward and a backward substitution, O(non zeros). This is much stronger than Jacobi for matrices
+         * that come from discretized equations, at the cost of a factorization of about the price of a few matrix*vector
+         * products. There is no pivoting, so the diagonal must be non zero, and stay so during the factorization (which is
+         * guaranteed for M-matrices and diagonally dominant ones).
+         *
+         * Instances are created through `factor`, which returns a `Result<ILU0Preconditioner<T>, ErrorCode>`.
+         * */
+        template <typename T> class ILU0Preconditioner {
+        private:
+            // L (without its unit diagonal) and U packed in one CSR matrix with the pattern of A.
+            std::vector<std::size_t> offsets;
+            std::vector<std::size_t> indices;
+            std::vector<T> values;
+            std::vector<std::size_t> diagonal;
+
+            ILU0Preconditioner(
+                std::vector<std::size_t>&& offsets,
+                std::vector<std::size_t>&& indices,
+                std::vector<T>&& values,
+                std::vector<std::size_t>&& diagonal
+            ): offsets {std::move(offsets)},
+                indices {std::move(indices)},
+                values {std::move(values)},
+                diagonal {std::move(diagonal)} {}
+
+        public:
+            /**
+             * \brief Factor a square sparse matrix.
+             *
+             * \return result:
+             *   Result<ILU0Preconditioner<T>, ErrorCode>
+             *
+             *   Possible error codes:
+             *   - `NON_SQUARE_MATRIX`: If the matrix is not square.
+             *   - `SINGULAR_MATRIX`: If a diagonal element is missing, or becomes 0 during the factorization.
+             * */
+            static thesoup::types::Result<ILU0Preconditioner<T>, numeric::ErrorCode> factor(const numeric::types::SparseMatrix<T>& matrix) {
+                if (matrix.getRows() != matrix.getCols()) {
+                    return thesoup::types::Result<ILU0Preconditioner<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::NON_SQUARE_MATRIX);
+                }
+                const std::size_t n {matrix.getRows()};
+                const numeric::types::SparseMatrix<T> csr {matrix.with_layout(numeric::types::SparseLayout::CSR)};
+                std::vector<std::size_t> offsets {csr.get_offsets()};
+                std::vector<std::size_t> indices {csr.get_indices()};
+                std::vector<T> values {csr.get_values()};
+                std::vector<std::size_t> diagonal(n);
+                for (std::size_t i = 0; i < n; i++) {
+                    const auto first {indices.begin() + static_cast<std::ptrdiff_t>(offsets[i])};
+                    const auto last {indices.begin() + static_cast<std::ptrdiff_t>(offsets[i + 1])};
+                    const auto it {std::lower_bound(first, last, i)};
+                    if (it == last || *it != i) {
+                        return thesoup::types::Result<ILU0Preconditioner<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::SINGULAR_MATRIX);
+                    }
+                    diagonal[i] = static_cast<std::size_t>(it - indices.begin());
+                }
+
+                // Row by row (IKJ order). position[j] is where column j is stored in the current row, if it is.
+                constexpr std::size_t absent {std::numeric_limits<std::size_t>::max()};
+                std::vector<std::size_t> position(n, absent);
+                for (std::size_t i = 0; i < n; i++) {
+                    for (std::size_t p = offsets[i]; p < offsets[i + 1]; p++) {
+                        position[indices[p]] = p;
+                    }
+                    for (std::size_t p = offsets[i]; p < diagonal[i]; p++) {
+                        const std::size_t k {indices[p]};
+                        if (values[diagonal[k]] == static_cast<T>(0)) {
+                            return thesoup::types::Result<ILU0Preconditioner<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::SINGULAR_MATRIX);
+                        }
+                        values[p] = values[p]/values[diagonal[k]];
+                        for (std::size_t q = diagonal[k] + 1; q < offsets[k + 1]; q++) {
+                            if (position[indices[q]] != absent) {
+                                values[position[indices[q]]] = values[position[indices[q]]] - values[p]*values[q];
+                            }
+                        }
+                    }
+                    for (std::size_t p = offsets[i]; p < offsets[i + 1]; p++) {
+                        position[indices[p]] = absent;
+                    }
+                }
+                for (std::size_t i = 0; i < n; i++) {
+                    if (values[diagonal[i]] == static_cast<T>(0)) {
+                        return thesoup::types::Result<ILU0Preconditioner<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::SINGULAR_MATRIX);
+                    }
+                }
+                return thesoup::types::Result<ILU0Preconditioner<T>, numeric::ErrorCode>::success(
+                    ILU0Preconditioner<T> {std::move(offsets), std::move(indices), std::move(values), std::move(diagonal)}
+                );
+            }
+
+            /**
+             * \brief Factor a square dense matrix. Only its non zero elements are kept (see `SparseMatrix`).
+             * */
+            static thesoup::types::Result<ILU0Preconditioner<T>, numeric::ErrorCode> factor(const numeric::types::ConstMatrixView<T>& matrix) {
+                return factor(numeric::types::SparseMatrix<T> {matrix});
+            }
+
+            //! \cond NO_DOC
+            static thesoup::types::Result<ILU0Preconditioner<T>, numeric::ErrorCode> factor(const numeric::types::Matrix<T>& matrix) {
+                return factor(matrix.view());
+            }
+            //! \endcond
+
+            std::size_t size() const {
+                return diagonal.size();
+            }
+
+            numeric::types::Vector<T> apply(const numeric::types::Vector<T>& r) const {
+                const std::size_t n {size()};
+                numeric::types::Vector<T> retval(n, r.get_resource());
+                const T* src {r.data()};
+                T* y {retval.data()};
+                for (std::size_t i = 0; i < n; i++) {
+                    T acc {src[i]};
+                    for (std::size_t p = offsets[i]; p < diagonal[i]; p++) {
+                        acc = acc - values[p]*y[indices[p]];
+                    }
+                    y[i] = acc;
+                }
+                for (std::size_t i = n; i-- > 0;) {
+                    T acc {y[i]};
+                    for (std::size_t p = diagonal[i] + 1; p < offsets[i + 1]; p++) {
+                        acc = acc - values[p]*y[indices[p]];
+                    }
+                    y[i] = acc/values[diagonal[i]];
+                }
+                return retval;
+            }
+        };
+
+        namespace {
+            // Euclidean norm. Vector<T>::mod() is the squared length, cached until the vector is assigned again.
+            template <typename T> double euclideanNorm(const numeric::types::Vector<T>& vec) {
+                return std::sqrt(vec.mod());
+            }
+
+            template <typename T, typename M, typename P> thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode> checkIterativeArguments(
+                const M& matrix,
+                const numeric::types::Vector<T>& rhs,
+                const P& preconditioner
+            ) {
+                if (matrix.getRows() != matrix.getCols()) {
+                    return thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::NON_SQUARE_MATRIX);
+                }
+                if (rhs.size() != matrix.getRows() || preconditioner.size() != matrix.getRows()) {
+                    return thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::INCOMPATIBLE_VECTORS);
+                }
+                numeric::types::Vector<T> zero(rhs.size(), rhs.get_resource());
+                std::fill(zero.begin(), zero.end(), static_cast<T>(0));
+                return thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode>::success(IterativeSolution<T> {std::move(zero), 0, 0.0});
+            }
+        }
+
+        /**
+         * \brief Solve A*x = b with the preconditioned conjugate gradient method.
+         *
+         * A must be symmetric and positive definite. Each iteration costs one matrix*vector product (the `operator*` of
+         * the matrix type), one `apply` of the preconditioner and a few vector operations, so this is far cheaper than
+         * `gauss_jordan` for large sparse systems. The preconditioner must be symmetric and positive definite too (Jacobi
+         * is; ILU0 is only approximately, but usually works).
+         *
+         * \tparam M `Matrix<T>`, `ConstMatrixView<T>`, `SparseMatrix<T>`, or anything with `getRows`, `getCols` and a
+         * `M*Vector<T>` product.
+         *
+         * \tparam P The preconditioner type (see `IdentityPreconditioner`).
+         *
+         * \param matrix The matrix A.
+         *
+         * \param rhs The right hand side b.
+         *
+         * \param preconditioner The preconditioner.
+         *
+         * \param options The stopping criteria.
+         *
+         * \return result:
+         *   Result<IterativeSolution<T>, ErrorCode> with the solution, the iterations and the residual reached.
+         *
+         *   Possible error codes:
+         *   - `NON_SQUARE_MATRIX`: If A is not square.
+         *   - `INCOMPATIBLE_VECTORS`: If b or the preconditioner do not match the size of A.
+         *   - `NOT_CONVERGED`: If the tolerance was not reached in `maxIterations`, or if A turned out not to be positive
+         *     definite.
+         * */
+        template <typename T, typename M, typename P> thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode> conjugate_gradient(
+            const M& matrix,
+            const numeric::types::Vector<T>& rhs,
+            const P& preconditioner,
+            const IterativeOptions& options=IterativeOptions {}
+        ) {
+            static_assert(std::is_floating_point<T>::value, "Iterative solvers need a floating point type.");
+            thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode> result {checkIterativeArguments(matrix, rhs, preconditioner)};
+            if (!result) {
+                return result;
+            }
+            numeric::types::Vector<T>& x {result.unwrap().solution};
+            const double bNorm {euclideanNorm(rhs)};
+            if (bNorm == 0.0) {
+                return result;
+            }
+
+            numeric::types::Vector<T> r(rhs.size(), rhs.get_resource());
+            std::copy(rhs.begin(), rhs.end(), r.begin());
+            numeric::types::Vector<T> z {preconditioner.apply(r)};
+            numeric::types::Vector<T> p(z.size(), rhs.get_resource());
+            std::copy(z.begin(), z.end(), p.begin());
+            T rz {r*z};
+            for (std::size_t iteration = 1; iteration <= options.maxIterations; iteration++) {
+                const numeric::types::Vector<T> ap {matrix*p};
+                const T pap {p*ap};
+                if (!(pap > static_cast<T>(0))) {
+                    break;
+                }
+                const T alpha {rz/pap};
+                x = x + alpha*p;
+                r = r - alpha*ap;
+                const double residual {euclideanNorm(r)/bNorm};
+                if (residual <= options.tolerance) {
+                    result.unwrap().iterations = iteration;
+                    result.unwrap().residual = residual;
+                    return result;
+                }
+                z = preconditioner.apply(r);
+                const T rzNext {r*z};
+                const T beta {rzNext/rz};
+                p = z + beta*p;
+                rz = rzNext;
+            }
+            return thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::NOT_CONVERGED);
+        }
+
+        /**
+         * \brief Solve A*x = b with the unpreconditioned conjugate gradient method.
+         * */
+        template <typename T, typename M> thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode> conjugate_gradient(
+            const M& matrix,
+            const numeric::types::Vector<T>& rhs,
+            const IterativeOptions& options=IterativeOptions {}
+        ) {
+            return conjugate_gradient(matrix, rhs, IdentityPreconditioner<T> {matrix.getRows()}, options);
+        }
+
+        /**
+         * \brief Solve A*x = b with the restarted GMRES method, GMRES(m).
+         *
+         * This works for any non singular A. Every iteration multiplies once by A and applies the preconditioner once, and
+         * orthogonalizes against the basis built since the last restart, so memory and work grow with `options.restart`.
+         * The preconditioner is applied on the right (A*M^-1*y = b, x = M^-1*y), so the residual that is checked against
+         * the tolerance is the one of the original system.
+         *
+         * \tparam M `Matrix<T>`, `ConstMatrixView<T>`, `SparseMatrix<T>`, or anything with `getRows`, `getCols` and a
+         * `M*Vector<T>` product.
+         *
+         * \tparam P The preconditioner type (see `IdentityPreconditioner`).
+         *
+         * \param matrix The matrix A.
+         *
+         * \param rhs The right hand side b.
+         *
+         * \param preconditioner The preconditioner.
+         *
+         * \param options The stopping criteria and the restart length.
+         *
+         * \return result:
+         *   Result<IterativeSolution<T>, ErrorCode> with the solution, the iterations and the residual reached.
+         *
+         *   Possible error codes:
+         *   - `NON_SQUARE_MATRIX`: If A is not square.
+         *   - `INCOMPATIBLE_VECTORS`: If b or the preconditioner do not match the size of A.
+         *   - `NOT_CONVERGED`: If the tolerance was not reached in `maxIterations`.
+         * */
+        template <typename T, typename M, typename P> thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode> gmres(
+            const M& matrix,
+            const numeric::types::Vector<T>& rhs,
+            const P& preconditioner,
+            const IterativeOptions& options=IterativeOptions {}
+        ) {
+            static_assert(std::is_floating_point<T>::value, "Iterative solvers need a floating point type.");
+            thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode> result {checkIterativeArguments(matrix, rhs, preconditioner)};
+            if (!result) {
+                return result;
+            }
+            numeric::types::Vector<T>& x {result.unwrap().solution};
+            const double bNorm {euclideanNorm(rhs)};
+            if (bNorm == 0.0) {
+                return result;
+            }
+            const std::size_t m {std::max<std::size_t>(options.restart, 1)};
+
+            // hessenberg[j] is column j of the Hessenberg matrix, rotated into upper triangular form as it is built.
+            std::vector<numeric::types::Vector<T>> basis {};
+            basis.reserve(m + 1);
+            std::vector<std::vector<T>> hessenberg(m, std::vector<T>(m + 1));
+            std::vector<T> cosines(m);
+            std::vector<T> sines(m);
+            std::vector<T> g(m + 1);
+
+            std::size_t iteration {0};
+            numeric::types::Vector<T> r(rhs.size(), rhs.get_resource());
+            std::copy(rhs.begin(), rhs.end(), r.begin());
+            double residual {1.0};
+            while (iteration < options.maxIterations) {
+                const T beta {static_cast<T>(euclideanNorm(r))};
+                basis.clear();
+                basis.push_back(numeric::types::Vector<T> {(static_cast<T>(1)/beta)*r});
+                std::fill(g.begin(), g.end(), static_cast<T>(0));
+                g[0] = beta;
+
+                std::size_t k {0};
+                bool happyBreakdown {false};
+                while (k < m && iteration < options.maxIterations) {
+                    iteration++;
+                    numeric::types::Vector<T> w {matrix*preconditioner.apply(basis[k])};
+                    std::vector<T>& h {hessenberg[k]};
+                    for (std::size_t i = 0; i <= k; i++) {
+                        h[i] = w*basis[i];
+                        w = w - h[i]*basis[i];
+                    }
+                    h[k + 1] = static_cast<T>(euclideanNorm(w));
+
+                    for (std::size_t i = 0; i < k; i++) {
+                        const T upper {cosines[i]*h[i] + sines[i]*h[i + 1]};
+                        h[i + 1] = -sines[i]*h[i] + cosines[i]*h[i + 1];
+                        h[i] = upper;
+                    }
+                    const T norm {std::hypot(h[k], h[k + 1])};
+                    if (norm == static_cast<T>(0)) {
+                        return thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::NOT_CONVERGED);
+                    }
+                    cosines[k] = h[k]/norm;
+                    sines[k] = h[k + 1]/norm;
+                    happyBreakdown = h[k + 1] == static_cast<T>(0);
+                    if (!happyBreakdown) {
+                        basis.push_back(numeric::types::Vector<T> {(static_cast<T>(1)/h[k + 1])*w});
+                    }
+                    h[k] = norm;
+                    h[k + 1] = static_cast<T>(0);
+                    g[k + 1] = -sines[k]*g[k];
+                    g[k] = cosines[k]*g[k];
+                    k++;
+
+                    residual = std::fabs(static_cast<double>(g[k]))/bNorm;
+                    if (residual <= options.tolerance || happyBreakdown) {
+                        break;
+                    }
+                }
+
+                // Solve the k x k triangular system for the coefficients of the basis, and update x.
+                std::vector<T> y(k);
+                for (std::size_t i = k; i-- > 0;) {
+                    T acc {g[i]};
+                    for (std::size_t j = i + 1; j < k; j++) {
+                        acc = acc - hessenberg[j][i]*y[j];
+                    }
+                    y[i] = acc/hessenberg[i][i];
+                }
+                numeric::types::Vector<T> update(rhs.size(), rhs.get_resource());
+                std::fill(update.begin(), update.end(), static_cast<T>(0));
+                for (std::size_t j = 0; j < k; j++) {
+                    update = update + y[j]*basis[j];
+                }
+                x = x + preconditioner.apply(update);
+
+                r = rhs - matrix*x;
+                residual = euclideanNorm(r)/bNorm;
+                if (residual <= options.tolerance) {
+                    result.unwrap().iterations = iteration;
+                    result.unwrap().residual = residual;
+                    return result;
+                }
+            }
+            return thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::NOT_CONVERGED);
+        }
+
+        /**
+         * \brief Solve A*x = b with the unpreconditioned restarted GMRES method.
+         * */
+        template <typename T, typename M> thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode> gmres(
+            const M& matrix,
+            const numeric::types::Vector<T>& rhs,
+            const IterativeOptions& options=IterativeOptions {}
+        ) {
+            return gmres(matrix, rhs, IdentityPreconditioner<T> {matrix.getRows()}, options);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,374 @@
+#ifndef __SIGABRT_NUMERIC_LU__
+#define __SIGABRT_NUMERIC_LU__
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <numeric/benchmark/instrumentation.hpp>
+#include <numeric/types/models.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/math/errors.hpp>
+
+#include <thesoup/types/types.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::functions
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace functions {
+        /**
+         * \enum Pivoting
+         *
+         * The pivoting strategy used by `LUDecomposition`.
+         *   - `PARTIAL`: Pick the largest element (by magnitude) of the current column. This is what you want most of the time.
+         *   - `COMPLETE`: Pick the largest element of the whole trailing sub matrix. This costs an O(n^2) search per pivot, but
+         *     is more robust for badly scaled matrices.
+         * */
+        enum class Pivoting {
+            PARTIAL,
+            COMPLETE
+        };
+
+        /**
+         * \class LUDecomposition
+         *
+         * \tparam T Some numeric type. It has to support conversion to double, for pivot selection.
+         *
+         * \brief LU factorization of a square matrix, for solving many systems that share the same matrix.
+         *
+         * The matrix A is factored once (O(n^3)) into P*A*Q = L*U, where P and Q are row and column permutations, L is
+         * unit lower triangular and U is upper triangular. After that every right hand side is solved with a forward and
+         * a backward substitution, which is O(n^2) per vector.
+         *
+         * L and U are stored packed in a single matrix (the unit diagonal of L is implicit). Q is the identity unless
+         * `Pivoting::COMPLETE` is used.
+         *
+         * Unlike `rref` or `gauss_jordan`, this is a class rather than a free function: the point of the factorization
+         * is the state it leaves behind, which is reused across many calls to `solve`, and a free function would have to
+         * redo the O(n^3) work for every right hand side. The pivoting strategy is an enum since it only changes how the
+         * factorization is computed, not what can be done with it.
+         *
+         * Instances are created through `factor`, which returns a `Result<LUDecomposition<T>, ErrorCode>`, like the other
+         * functions in this library. Like `Matrix`, this is not copyable.
+         * */
+        template <typename T> class LUDecomposition {
+        private:
+            numeric::types::Matrix<T> lu;
+            std::vector<std::size_t> rowPermutation;
+            std::vector<std::size_t> colPermutation;
+            int permutationSign;
+
+            LUDecomposition(
+                numeric::types::Matrix<T>&& lu,
+                std::vector<std::size_t>&& rowPermutation,
+                std::vector<std::size_t>&& colPermutation,
+                const int& permutationSign
+            ): lu {std::move(lu)},
+                rowPermutation {std::move(rowPermutation)},
+                colPermutation {std::move(colPermutation)},
+                permutationSign {permutationSign} {}
+
+            static double magnitude(const T& val) {
+                return std::fabs(static_cast<double>(val));
+            }
+
+            // Solves in place L*U*y = y, where y already holds the row permuted right hand side.
+            void substitute(T* y) const {
+                const std::size_t n {lu.getRows()};
+                for (std::size_t i = 0; i < n; i++) {
+                    const T* row {lu.rowPtr(i)};
+                    T acc {y[i]};
+                    for (std::size_t k = 0; k < i; k++) {
+                        acc = acc - row[k]*y[k];
+                    }
+                    y[i] = acc;
+                }
+                for (std::size_t i = n; i-- > 0;) {
+                    const T* row {lu.rowPtr(i)};
+                    T acc {y[i]};
+                    for (std::size_t k = i + 1; k < n; k++) {
+                        acc = acc - row[k]*y[k];
+                    }
+                    y[i] = acc/row[i];
+                }
+            }
+
+        public:
+            LUDecomposition(LUDecomposition<T>&& other)=default;
+            LUDecomposition(const LUDecomposition<T>& other)=delete;
+            void operator=(const LUDecomposition<T>& other)=delete;
+
+            /**
+             * \brief Factor a square matrix.
+             *
+             * The input matrix is left untouched; the factors are stored in the returned object.
+             *
+             * \param matrix The square matrix to factor.
+             *
+             * \param pivoting The pivoting strategy. Defaults to partial pivoting.
+             *
+             * \param zero_precision Pivots with an absolute value less than or equal to this are treated as 0. Defaults to 0.0,
+             * which means only exact zeros are rejected.
+             *
+             * \return result:
+             *   Result<LUDecomposition<T>, ErrorCode>
+             *
+             *   Possible error codes:
+             *   - `NON_SQUARE_MATRIX`: If the matrix is not square.
+             *   - `SINGULAR_MATRIX`: If no non zero pivot could be found for some column. The system then has either no or
+             *     infinitely many solutions, depending on the right hand side. Use `gauss_jordan` to find out which.
+             * */
+            static thesoup::types::Result<LUDecomposition<T>, numeric::ErrorCode> factor(
+                const numeric::types::Matrix<T>& matrix,
+                const Pivoting& pivoting=Pivoting::PARTIAL,
+                const double& zero_precision=0.0
+            ) {
+                if (matrix.getRows() != matrix.getCols()) {
+                    return thesoup::types::Result<LUDecomposition<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::NON_SQUARE_MATRIX);
+                }
+                const std::size_t n {matrix.getRows()};
+
+                numeric::types::Matrix<T> lu {n, n};
+                for (std::size_t i = 0; i < n; i++) {
+                    const T* src {matrix.rowPtr(i)};
+                    T* dest {lu.rowPtr(i)};
+                    for (std::size_t j = 0; j < n; j++) {
+                        dest[j] = src[j];
+                    }
+                }
+
+                std::vector<std::size_t> rowPermutation(n);
+                std::vector<std::size_t> colPermutation(n);
+                for (std::size_t i = 0; i < n; i++) {
+                    rowPermutation[i] = i;
+                    colPermutation[i] = i;
+                }
+                int sign {1};
+
+                for (std::size_t k = 0; k < n; k++) {
+                    // Find the pivot.
+                    std::size_t pivotRow {k};
+                    std::size_t pivotCol {k};
+                    double best {magnitude(lu.atUnchecked(k, k))};
+                    const std::size_t lastCol {pivoting == Pivoting::COMPLETE? n : k + 1};
+                    for (std::size_t i = k; i < n; i++) {
+                        const T* row {lu.rowPtr(i)};
+                        for (std::size_t j = k; j < lastCol; j++) {
+                            const double candidate {magnitude(row[j])};
+                            if (candidate > best) {
+                                best = candidate;
+                                pivotRow = i;
+                                pivotCol = j;
+                            }
+                        }
+                    }
+                    if (best <= zero_precision) {
+                        numeric::benchmark::record_pivot_failure();
+                        return thesoup::types::Result<LUDecomposition<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::SINGULAR_MATRIX);
+                    }
+
+                    // Move it into place. Row exchanges only swap row pointers, column exchanges have to touch every row.
+                    if (pivotRow != k) {
+                        lu.exchangeRows(k, pivotRow);
+                        std::swap(rowPermutation[k], rowPermutation[pivotRow]);
+                        sign = -sign;
+                    }
+                    if (pivotCol != k) {
+                        for (std::size_t i = 0; i < n; i++) {
+                            T* row {lu.rowPtr(i)};
+                            std::swap(row[k], row[pivotCol]);
+                        }
+                        std::swap(colPermutation[k], colPermutation[pivotCol]);
+                        sign = -sign;
+                    }
+
+                    // Eliminate below the pivot, storing the multipliers in place of the eliminated elements.
+                    const T* pivotElems {lu.rowPtr(k)};
+                    const T pivot {pivotElems[k]};
+                    for (std::size_t i = k + 1; i < n; i++) {
+                        T* row {lu.rowPtr(i)};
+                        if (row[k] == static_cast<T>(0)) {
+                            continue;
+                        }
+                        const T multiplier {row[k]/pivot};
+                        row[k] = multiplier;
+                        for (std::size_t j = k + 1; j < n; j++) {
+                            row[j] = row[j] - multiplier*pivotElems[j];
+                        }
+                    }
+                }
+
+                return thesoup::types::Result<LUDecomposition<T>, numeric::ErrorCode>::success(
+                    LUDecomposition<T> {std::move(lu), std::move(rowPermutation), std::move(colPermutation), sign}
+                );
+            }
+
+            /**
+             * \brief Solve A*x = b.
+             *
+             * \param b The right hand side.
+             *
+             * \return result:
+             *   Result<Vector<T>, ErrorCode> with the solution x.
+             *
+             *   Possible error codes:
+             *   - `INCOMPATIBLE_VECTORS`: If the dimension of b does not match the size of the system.
+             * */
+            thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode> solve(const numeric::types::Vector<T>& b) const {
+                const std::size_t n {lu.getRows()};
+                if (b.size() != n) {
+                    return thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::INCOMPATIBLE_VECTORS);
+                }
+
+                std::vector<T> y(n);
+                const T* src {b.data()};
+                for (std::size_t i = 0; i < n; i++) {
+                    y[i] = src[rowPermutation[i]];
+                }
+                substitute(y.data());
+
+                numeric::types::Vector<T> x {n};
+                T* dest {x.data()};
+                for (std::size_t i = 0; i < n; i++) {
+                    dest[colPermutation[i]] = y[i];
+                }
+                return thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode>::success(std::move(x));
+            }
+
+            /**
+             * \brief Solve A*X = B for many right hand sides at once.
+             *
+             * Each column of B is a right hand side, and the corresponding column of the result is its solution. The
+             * substitutions run over whole rows of B, so the right hand sides are read and written row by row.
+             *
+             * \param b The right hand sides, as a n x m matrix.
+             *
+             * \return result:
+             *   Result<Matrix<T>, ErrorCode> with the n x m solution matrix X.
+             *
+             *   Possible error codes:
+             *   - `INCOMPATIBLE_VECTORS`: If the number of rows of B does not match the size of the system.
+             * */
+            thesoup::types::Result<numeric::types::Matrix<T>, numeric::ErrorCode> solve(const numeric::types::Matrix<T>& b) const {
+                const std::size_t n {lu.getRows()};
+                const std::size_t m {b.getCols()};
+                if (b.getRows() != n) {
+                    return thesoup::types::Result<numeric::types::Matrix<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::INCOMPATIBLE_VECTORS);
+                }
+
+                numeric::types::Matrix<T> y {n, m};
+                for (std::size_t i = 0; i < n; i++) {
+                    const T* src {b.rowPtr(rowPermutation[i])};
+                    T* dest {y.rowPtr(i)};
+                    for (std::size_t j = 0; j < m; j++) {
+                        dest[j] = src[j];
+                    }
+                }
+
+                // Forward substitution with L.
+                for (std::size_t i = 0; i < n; i++) {
+                    const T* luRow {lu.rowPtr(i)};
+                    T* dest {y.rowPtr(i)};
+                    for (std::size_t k = 0; k < i; k++) {
+                        const T factor {luRow[k]};
+                        if (factor == static_cast<T>(0)) {
+                            continue;
+                        }
+                        const T* src {y.rowPtr(k)};
+                        for (std::size_t j = 0; j < m; j++) {
+                            dest[j] = dest[j] - factor*src[j];
+                        }
+                    }
+                }
+
+                // Backward substitution with U.
+                for (std::size_t i = n; i-- > 0;) {
+                    const T* luRow {lu.rowPtr(i)};
+                    T* dest {y.rowPtr(i)};
+                    for (std::size_t k = i + 1; k < n; k++) {
+                        const T factor {luRow[k]};
+                        if (factor == static_cast<T>(0)) {
+                            continue;
+                        }
+                        const T* src {y.rowPtr(k)};
+                        for (std::size_t j = 0; j < m; j++) {
+                            dest[j] = dest[j] - factor*src[j];
+                        }
+                    }
+                    const T pivot {luRow[i]};
+                    for (std::size_t j = 0; j < m; j++) {
+                        dest[j] = dest[j]/pivot;
+                    }
+                }
+
+                // Undo the column permutation.
+                numeric::types::Matrix<T> x {n, m};
+                for (std::size_t i = 0; i < n; i++) {
+                    const T* src {y.rowPtr(i)};
+                    T* dest {x.rowPtr(colPermutation[i])};
+                    for (std::size_t j = 0; j < m; j++) {
+                        dest[j] = src[j];
+                    }
+                }
+                return thesoup::types::Result<numeric::types::Matrix<T>, numeric::ErrorCode>::success(std::move(x));
+            }
+
+            /**
+             * \brief Determinant of the factored matrix.
+             *
+             * This is the product of the diagonal of U, with the sign of the permutations.
+             *
+             * \return T
+             * */
+            T determinant() const {
+                T det {static_cast<T>(permutationSign)};
+                for (std::size_t i = 0; i < lu.getRows(); i++) {
+                    det = det*lu.atUnchecked(i, i);
+                }
+                return det;
+            }
+
+            /**
+             * \brief Size (n) of the factored n x n system.
+             * */
+            std::size_t size() const {
+                return lu.getRows();
+            }
+
+            /**
+             * \brief The packed L and U factors.
+             *
+             * The strict lower triangle holds L (its unit diagonal is implicit), the rest holds U.
+             * */
+            const numeric::types::Matrix<T>& get_lu() const {
+                return lu;
+            }
+
+            /**
+             * \brief Row permutation P. Row i of P*A is row `get_row_permutation()[i]` of A.
+             * */
+            const std::vector<std::size_t>& get_row_permutation() const {
+                return rowPermutation;
+            }
+
+            /**
+             * \brief Column permutation Q. Column j of A*Q is column `get_col_permutation()[j]` of A.
+             * */
+            const std::vector<std::size_t>& get_col_permutation() const {
+                return colPermutation;
+            }
+        };
+    }
+}
+
+#endif
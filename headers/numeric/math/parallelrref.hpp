@@ -0,0 +1,333 @@
+#ifndef __SIGABRT_NUMERIC_PARALLEL_RREF__
+#define __SIGABRT_NUMERIC_PARALLEL_RREF__
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <numeric/benchmark/instrumentation.hpp>
+#include <numeric/types/models.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/math/errors.hpp>
+#include <numeric/math/rref.hpp>
+#include <numeric/parallel/threadpool.hpp>
+
+#include <thesoup/types/types.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::functions
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace functions {
+        /**
+         * \brief Number of pivots processed per panel by `parallel_rref`.
+         * */
+        constexpr std::size_t PARALLEL_RREF_BLOCK {64};
+
+        /**
+         * \brief Matrices with fewer elements than this are reduced by the serial `rref`; the threading overhead would
+         * dominate otherwise.
+         * */
+        constexpr std::size_t PARALLEL_RREF_THRESHOLD {128*128};
+
+        namespace {
+            constexpr std::size_t PARALLEL_RREF_ROW_GRAIN {32};
+            constexpr std::size_t PARALLEL_RREF_COL_GRAIN {256};
+            constexpr std::size_t PARALLEL_RREF_COL_TILE {512};
+
+            template <typename T> class BlockedRref {
+            private:
+                numeric::types::Matrix<T>& matrix;
+                numeric::parallel::ThreadPool& pool;
+                const std::optional<double> zeroPrecision;
+                const std::size_t nrows;
+                const std::size_t ncols;
+
+                // multipliers[r*PARALLEL_RREF_BLOCK + p] is the multiple of pivot row (k + p) subtracted from row r in the
+                // current panel. pivotRows[p*ncols + c] is that pivot row, at the time it was used, for the columns whose
+                // update was deferred.
+                std::vector<T> multipliers;
+                std::vector<T> pivotRows;
+                std::vector<T> pivots;
+                std::vector<char> pivoted;
+                std::vector<std::size_t> freeColumns;
+                bool freeElements {false};
+
+                T round(const T& val) const {
+                    return zeroPrecision? roundOffToZero(val, *zeroPrecision) : val;
+                }
+
+                // Eliminate column i from every other row, touching only the panel columns [k, kEnd).
+                void eliminatePanelColumn(const std::size_t& k, const std::size_t& kEnd, const std::size_t& i) {
+                    const std::size_t p {i - k};
+                    // The panel columns are up to date, so column i can be searched for the pivot, like rref does.
+                    std::optional<std::size_t> nextPivot {i};
+                    if (zeroPrecision) {
+                        nextPivot = findLargestPivot(matrix, i, i, *zeroPrecision);
+                    } else if (matrix.atUnchecked(i, i) == static_cast<T>(0)) {
+                        nextPivot = findNextPivot(matrix, i, i);
+                    }
+                    if (nextPivot == std::nullopt) {
+                        numeric::benchmark::record_pivot_failure();
+                        freeElements = true;
+                        pivoted[p] = 0;
+                        return;
+                    }
+                    if (*nextPivot != i) {
+                        // The deferred columns travel with the row pointers, the multipliers have to follow them.
+                        matrix.exchangeRows(i, *nextPivot);
+                        std::swap_ranges(
+                            multipliers.begin() + i*PARALLEL_RREF_BLOCK,
+                            multipliers.begin() + (i + 1)*PARALLEL_RREF_BLOCK,
+                            multipliers.begin() + (*nextPivot)*PARALLEL_RREF_BLOCK);
+                    }
+                    pivoted[p] = 1;
+
+                    const T pivot {matrix.atUnchecked(i, i)};
+                    pivots[p] = pivot;
+                    const T* pivotRow {matrix.rowPtr(i)};
+                    pool.parallel_for(0, nrows, [&](const std::size_t& begin, const std::size_t& end) {
+                        for (std::size_t r = begin; r < end; r++) {
+                            T* row {matrix.rowPtr(r)};
+                            if (r == i || row[i] == static_cast<T>(0)) {
+                                continue;
+                            }
+                            const T multiplier {row[i]/pivot};
+                            multipliers[r*PARALLEL_RREF_BLOCK + p] = multiplier;
+                            for (std::size_t j = k; j < kEnd; j++) {
+                                if (j != i) {
+                                    row[j] = round(row[j] - multiplier*pivotRow[j]);
+                                }
+                            }
+                            row[i] = static_cast<T>(0);
+                        }
+                    }, PARALLEL_RREF_ROW_GRAIN);
+
+                    const T inverse {static_cast<T>(1)/pivot};
+                    T* normalized {matrix.rowPtr(i)};
+                    for (std::size_t j = k; j < kEnd; j++) {
+                        normalized[j] = round(normalized[j]*inverse);
+                    }
+                }
+
+                // Reconstruct the pivot rows of the panel, as they were when they were used, for columns [c0, c1).
+                void buildPivotRows(const std::size_t& k, const std::size_t& nb, const std::size_t& c0, const std::size_t& c1) {
+                    for (std::size_t p = 0; p < nb; p++) {
+                        if (!pivoted[p]) {
+                            continue;
+                        }
+                        T* dest {pivotRows.data() + p*ncols};
+                        const T* src {matrix.rowPtr(k + p)};
+                        for (std::size_t c = c0; c < c1; c++) {
+                            dest[c] = src[c];
+                        }
+                        const T* rowMultipliers {multipliers.data() + (k + p)*PARALLEL_RREF_BLOCK};
+                        for (std::size_t q = 0; q < p; q++) {
+                            const T multiplier {rowMultipliers[q]};
+                            if (!pivoted[q] || multiplier == static_cast<T>(0)) {
+                                continue;
+                            }
+                            const T* earlier {pivotRows.data() + q*ncols};
+                            for (std::size_t c = c0; c < c1; c++) {
+                                dest[c] = dest[c] - multiplier*earlier[c];
+                            }
+                        }
+                    }
+                }
+
+                // Apply the deferred rank-nb update of the panel to row r, for columns [c0, c1).
+                void updateRow(const std::size_t& k, const std::size_t& nb, const std::size_t& r, const std::size_t& c0, const std::size_t& c1) {
+                    T* row {matrix.rowPtr(r)};
+                    const T* rowMultipliers {multipliers.data() + r*PARALLEL_RREF_BLOCK};
+                    std::size_t firstPivot {0};
+                    if (r >= k && r < k + nb && pivoted[r - k]) {
+                        // A pivot row is normalized, then only sees the pivots after it.
+                        const std::size_t p {r - k};
+                        const T inverse {static_cast<T>(1)/pivots[p]};
+                        const T* own {pivotRows.data() + p*ncols};
+                        for (std::size_t c = c0; c < c1; c++) {
+                            row[c] = own[c]*inverse;
+                        }
+                        firstPivot = p + 1;
+                    }
+                    for (std::size_t q = firstPivot; q < nb; q++) {
+                        const T multiplier {rowMultipliers[q]};
+                        if (!pivoted[q] || multiplier == static_cast<T>(0)) {
+                            continue;
+                        }
+                        const T* pivotRow {pivotRows.data() + q*ncols};
+                        for (std::size_t c = c0; c < c1; c++) {
+                            row[c] = row[c] - multiplier*pivotRow[c];
+                        }
+                    }
+                    if (zeroPrecision) {
+                        for (std::size_t c = c0; c < c1; c++) {
+                            row[c] = round(row[c]);
+                        }
+                    }
+                }
+
+                void updateTrailing(const std::size_t& k, const std::size_t& kEnd) {
+                    const std::size_t nb {kEnd - k};
+
+                    // Free columns of earlier panels are not in echelon form, so they take the update too.
+                    for (const std::size_t& c : freeColumns) {
+                        buildPivotRows(k, nb, c, c + 1);
+                    }
+                    pool.parallel_for(kEnd, ncols, [&](const std::size_t& begin, const std::size_t& end) {
+                        buildPivotRows(k, nb, begin, end);
+                    }, PARALLEL_RREF_COL_GRAIN);
+
+                    pool.parallel_for(0, nrows, [&](const std::size_t& begin, const std::size_t& end) {
+                        for (std::size_t c0 = kEnd; c0 < ncols; c0 += PARALLEL_RREF_COL_TILE) {
+                            const std::size_t c1 {std::min(ncols, c0 + PARALLEL_RREF_COL_TILE)};
+                            for (std::size_t r = begin; r < end; r++) {
+                                updateRow(k, nb, r, c0, c1);
+                            }
+                        }
+                        for (const std::size_t& c : freeColumns) {
+                            for (std::size_t r = begin; r < end; r++) {
+                                updateRow(k, nb, r, c, c + 1);
+                            }
+                        }
+                    }, PARALLEL_RREF_ROW_GRAIN);
+                }
+
+            public:
+                BlockedRref(
+                    numeric::types::Matrix<T>& matrix,
+                    numeric::parallel::ThreadPool& pool,
+                    const std::optional<double>& zeroPrecision
+                ): matrix {matrix},
+                    pool {pool},
+                    zeroPrecision {zeroPrecision},
+                    nrows {matrix.getRows()},
+                    ncols {matrix.getCols()},
+                    multipliers(matrix.getRows()*PARALLEL_RREF_BLOCK),
+                    pivotRows(matrix.getCols()*PARALLEL_RREF_BLOCK),
+                    pivots(PARALLEL_RREF_BLOCK),
+                    pivoted(PARALLEL_RREF_BLOCK) {}
+
+                thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode> run() {
+                    const std::size_t smallerDim {nrows < ncols? nrows : ncols};
+                    for (std::size_t k = 0; k < smallerDim; k += PARALLEL_RREF_BLOCK) {
+                        const std::size_t kEnd {std::min(smallerDim, k + PARALLEL_RREF_BLOCK)};
+                        std::fill(multipliers.begin(), multipliers.end(), static_cast<T>(0));
+
+                        for (std::size_t i = k; i < kEnd; i++) {
+                            eliminatePanelColumn(k, kEnd, i);
+                        }
+                        updateTrailing(k, kEnd);
+
+                        for (std::size_t i = k; i < kEnd; i++) {
+                            if (!pivoted[i - k]) {
+                                freeColumns.push_back(i);
+                            }
+                        }
+                    }
+
+                    if (freeElements) {
+                        return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::failure(numeric::ErrorCode::FREE_COLUMNS_RREF);
+                    } else {
+                        return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::success(thesoup::types::Unit::unit);
+                    }
+                }
+            };
+        }
+
+        /**
+         * \brief Function to perform RREF on a matrix, using a thread pool.
+         *
+         * This is a blocked, right looking variant of `rref`, meant for large matrices. Pivots are processed in panels of
+         * `PARALLEL_RREF_BLOCK` columns. Within a panel, each pivot eliminates its column from every row, but only the panel
+         * columns are touched; the row updates are spread across the pool. The rest of the matrix then receives the whole
+         * panel as a single rank-`PARALLEL_RREF_BLOCK` update, again split by rows across the pool. Most of the work is
+         * therefore done in large, cache friendly, independent chunks.
+         *
+         * Pivot selection and the result are the same as `rref`: the diagonal element is the pivot, a zero pivot is replaced
+         * by exchanging with the next row below with a non zero element in that column, and if there is none the column is
+         * left free and a `FREE_COLUMNS_RREF` error is returned. The blocking only defers updates: every element goes
+         * through the same operations, in the same order, as in `rref`, so the result is bit identical for floating point
+         * types too.
+         *
+         * The blocked elimination divides by the pivots, so it is only run on floating point (and other) types. Integral
+         * and exact types (see `ScalarFamily`) are handed to `rref`, which reduces them without division, or with as few
+         * reductions as possible. So are matrices with fewer than `PARALLEL_RREF_THRESHOLD` elements.
+         *
+         * \param matrix:
+         *   Matrix<T> The **non const** reference to the input matrix.
+         *
+         * \param pool:
+         *   The thread pool to run on. Its size is the number of threads used.
+         *
+         * \return result:
+         *   Result<Unit, ErrorCode> Result to indicate the operation status.
+         *
+         *   Possible error codes:
+         *   - `FREE_COLUMNS_RREF`: If free columns are detected during reduction. This indicates a lack of a unique solution.
+         * */
+        template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+        parallel_rref(numeric::types::Matrix<T>& matrix, numeric::parallel::ThreadPool& pool) {
+            constexpr numeric::types::ScalarFamily family {numeric::types::ScalarFamilyOf<T>::value};
+            if constexpr (family == numeric::types::ScalarFamily::INTEGER || family == numeric::types::ScalarFamily::EXACT) {
+                return rref(matrix);
+            } else {
+                if (matrix.getRows()*matrix.getCols() < PARALLEL_RREF_THRESHOLD) {
+                    return rref(matrix);
+                }
+                const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::RREF};
+                return BlockedRref<T> {matrix, pool, std::nullopt}.run();
+            }
+        }
+
+        /**
+         * \brief Function to perform RREF on a matrix, using a thread pool.
+         *
+         * Same as the above, but small numbers (with an absolute value less than the `zero_precision` parameter) are
+         * rounded off to zero, and pivoting is partial, like the corresponding `rref` overload does. Elements of the panel
+         * columns are rounded after every operation, the rest after every panel update, and the updates are not fused. So
+         * unlike the version without a `zero_precision`, the result agrees with `rref(matrix, zero_precision)`, which
+         * fuses its updates and rounds off after every pivot, only up to rounding.
+         *
+         * NOTE: In this version of the function, if you are using a non primitive type, it has to support conversion to double.
+         *
+         * \param matrix:
+         *   Matrix<T> The **non const** reference to the input matrix.
+         *
+         * \param pool:
+         *   The thread pool to run on. Its size is the number of threads used.
+         *
+         * \param zero_precision:
+         *   The double value which is considered to be the threshold to be 0.
+         *
+         * \return result:
+         *   Result<Unit, ErrorCode> Result to indicate the operation status.
+         *
+         *   Possible error codes:
+         *   - `FREE_COLUMNS_RREF`: If free columns are detected during reduction. This indicates a lack of a unique solution.
+         * */
+        template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+        parallel_rref(numeric::types::Matrix<T>& matrix, numeric::parallel::ThreadPool& pool, const double& zero_precision) {
+            constexpr numeric::types::ScalarFamily family {numeric::types::ScalarFamilyOf<T>::value};
+            if constexpr (family == numeric::types::ScalarFamily::INTEGER || family == numeric::types::ScalarFamily::EXACT) {
+                return rref(matrix, zero_precision);
+            } else {
+                if (matrix.getRows()*matrix.getCols() < PARALLEL_RREF_THRESHOLD) {
+                    return rref(matrix, zero_precision);
+                }
+                const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::RREF};
+                return BlockedRref<T> {matrix, pool, zero_precision}.run();
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,287 @@
+#ifndef __SIGABRT_NUMERIC_PLANES__
+#define __SIGABRT_NUMERIC_PLANES__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include <numeric/types/planeset.hpp>
+#include <numeric/parallel/threadpool.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::functions
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace functions {
+        /**
+         * \brief The number of points the plane queries process together. A block of 1024 double points is 24 KiB, so it
+         * stays in the L1 cache while every plane of the set is tested against it.
+         * */
+        constexpr std::size_t PLANE_POINT_BLOCK {1024};
+
+        namespace {
+            // Calls blockFn(first, last) for the point blocks [firstBlock, lastBlock).
+            template <typename F> void forPointBlocks(
+                const std::size_t& count,
+                const std::size_t& firstBlock,
+                const std::size_t& lastBlock,
+                const F& blockFn
+            ) {
+                for (std::size_t block = firstBlock; block < lastBlock; block++) {
+                    const std::size_t first {block*PLANE_POINT_BLOCK};
+                    blockFn(first, std::min(count, first + PLANE_POINT_BLOCK));
+                }
+            }
+
+            template <typename F> void forPointBlocks(const std::size_t& count, const F& blockFn) {
+                forPointBlocks(count, 0, (count + PLANE_POINT_BLOCK - 1)/PLANE_POINT_BLOCK, blockFn);
+            }
+
+            template <typename F> void forPointBlocks(const std::size_t& count, numeric::parallel::ThreadPool& pool, const F& blockFn) {
+                pool.parallel_for(0, (count + PLANE_POINT_BLOCK - 1)/PLANE_POINT_BLOCK, [&](const std::size_t& begin, const std::size_t& end) {
+                    forPointBlocks(count, begin, end, blockFn);
+                });
+            }
+
+            // The loops below have the points innermost, with the plane coefficients in registers, so they compile to
+            // SIMD code across the points. The results of plane p are out[p*count, (p + 1)*count).
+            template <typename T> struct DistanceKernel {
+                const numeric::types::PlaneSet<T>& planes;
+                const T* x;
+                const T* y;
+                const T* z;
+                std::size_t count;
+                T* out;
+
+                void operator()(const std::size_t& first, const std::size_t& last) const {
+                    for (std::size_t p = 0; p < planes.getCount(); p++) {
+                        const T a {planes.a()[p]};
+                        const T b {planes.b()[p]};
+                        const T c {planes.c()[p]};
+                        const T k {planes.k()[p]};
+                        const T scale {planes.inverse_norms()[p]};
+                        T* dest {out + p*count};
+                        for (std::size_t i = first; i < last; i++) {
+                            dest[i] = (a*x[i] + b*y[i] + c*z[i] - k)*scale;
+                        }
+                    }
+                }
+            };
+
+            template <typename T> struct ClassifyKernel {
+                const numeric::types::PlaneSet<T>& planes;
+                const T* x;
+                const T* y;
+                const T* z;
+                std::size_t count;
+                signed char* out;
+                T tolerance;
+
+                void operator()(const std::size_t& first, const std::size_t& last) const {
+                    for (std::size_t p = 0; p < planes.getCount(); p++) {
+                        const T a {planes.a()[p]};
+                        const T b {planes.b()[p]};
+                        const T c {planes.c()[p]};
+                        const T k {planes.k()[p]};
+                        const T scale {planes.inverse_norms()[p]};
+                        signed char* dest {out + p*count};
+                        for (std::size_t i = first; i < last; i++) {
+                            const T distance {(a*x[i] + b*y[i] + c*z[i] - k)*scale};
+                            dest[i] = static_cast<signed char>((distance > tolerance) - (distance < -tolerance));
+                        }
+                    }
+                }
+            };
+
+            // Fills cosines[p*count + i] for the block, or tests them against the threshold when aligned is not null.
+            template <typename T> struct CosineKernel {
+                const numeric::types::PlaneSet<T>& planes;
+                const T* x;
+                const T* y;
+                const T* z;
+                std::size_t count;
+                T* cosines;
+                bool* aligned;
+                T threshold;
+
+                void operator()(const std::size_t& first, const std::size_t& last) const {
+                    // The inverse lengths of the vectors of the block, computed once for all the planes.
+                    T inverseLengths[PLANE_POINT_BLOCK];
+                    for (std::size_t i = first; i < last; i++) {
+                        inverseLengths[i - first] = static_cast<T>(1)/std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+                    }
+                    for (std::size_t p = 0; p < planes.getCount(); p++) {
+                        const T scale {planes.inverse_norms()[p]};
+                        const T a {planes.a()[p]*scale};
+                        const T b {planes.b()[p]*scale};
+                        const T c {planes.c()[p]*scale};
+                        if (aligned) {
+                            bool* dest {aligned + p*count};
+                            for (std::size_t i = first; i < last; i++) {
+                                dest[i] = (a*x[i] + b*y[i] + c*z[i])*inverseLengths[i - first] >= threshold;
+                            }
+                        } else {
+                            T* dest {cosines + p*count};
+                            for (std::size_t i = first; i < last; i++) {
+                                dest[i] = (a*x[i] + b*y[i] + c*z[i])*inverseLengths[i - first];
+                            }
+                        }
+                    }
+                }
+            };
+        }
+
+        /**
+         * \brief Signed distances of a block of points from every plane of a set.
+         *
+         * The points are passed as a structure of arrays, `(x[i], y[i], z[i])` for point i, so that consecutive points
+         * fill SIMD registers. The distance is positive on the side the normal points to.
+         *
+         * \param planes The planes.
+         * \param x, y, z The coordinates of the points, `count` each.
+         * \param count The number of points.
+         * \param out The distances, `planes.getCount()*count` of them: the distance of point i from plane p is
+         * `out[p*count + i]`.
+         * */
+        template <typename T> void signed_distances(
+            const numeric::types::PlaneSet<T>& planes,
+            const T* x,
+            const T* y,
+            const T* z,
+            const std::size_t& count,
+            T* out
+        ) {
+            forPointBlocks(count, DistanceKernel<T> {planes, x, y, z, count, out});
+        }
+
+        /**
+         * \brief Signed distances of a block of points from every plane of a set, using a thread pool.
+         *
+         * Same as the above, with the point blocks split between the threads of the pool.
+         * */
+        template <typename T> void signed_distances(
+            const numeric::types::PlaneSet<T>& planes,
+            numeric::parallel::ThreadPool& pool,
+            const T* x,
+            const T* y,
+            const T* z,
+            const std::size_t& count,
+            T* out
+        ) {
+            forPointBlocks(count, pool, DistanceKernel<T> {planes, x, y, z, count, out});
+        }
+
+        /**
+         * \brief Which side of every plane of a set each point of a block is on.
+         *
+         * The result for point i and plane p, `out[p*count + i]`, is 1 if the point is in front of the plane (on the side
+         * the normal points to), -1 if it is behind it, and 0 if its distance from the plane is at most `tolerance`.
+         * See `signed_distances` for the layout of the points.
+         * */
+        template <typename T> void classify_points(
+            const numeric::types::PlaneSet<T>& planes,
+            const T* x,
+            const T* y,
+            const T* z,
+            const std::size_t& count,
+            signed char* out,
+            const T& tolerance=static_cast<T>(0)
+        ) {
+            forPointBlocks(count, ClassifyKernel<T> {planes, x, y, z, count, out, tolerance});
+        }
+
+        /**
+         * \brief Which side of every plane of a set each point of a block is on, using a thread pool.
+         * */
+        template <typename T> void classify_points(
+            const numeric::types::PlaneSet<T>& planes,
+            numeric::parallel::ThreadPool& pool,
+            const T* x,
+            const T* y,
+            const T* z,
+            const std::size_t& count,
+            signed char* out,
+            const T& tolerance=static_cast<T>(0)
+        ) {
+            forPointBlocks(count, pool, ClassifyKernel<T> {planes, x, y, z, count, out, tolerance});
+        }
+
+        /**
+         * \brief Cosines of the angles between a block of vectors and the normals of every plane of a set.
+         *
+         * The batch version of `cosine_angle`. The cosine for vector i and plane p is `out[p*count + i]`. See
+         * `signed_distances` for the layout of the vectors.
+         * */
+        template <typename T> void cosine_angle(
+            const numeric::types::PlaneSet<T>& planes,
+            const T* x,
+            const T* y,
+            const T* z,
+            const std::size_t& count,
+            T* out
+        ) {
+            forPointBlocks(count, CosineKernel<T> {planes, x, y, z, count, out, nullptr, static_cast<T>(0)});
+        }
+
+        /**
+         * \brief Cosines of the angles between a block of vectors and the normals of every plane of a set, using a
+         * thread pool.
+         * */
+        template <typename T> void cosine_angle(
+            const numeric::types::PlaneSet<T>& planes,
+            numeric::parallel::ThreadPool& pool,
+            const T* x,
+            const T* y,
+            const T* z,
+            const std::size_t& count,
+            T* out
+        ) {
+            forPointBlocks(count, pool, CosineKernel<T> {planes, x, y, z, count, out, nullptr, static_cast<T>(0)});
+        }
+
+        /**
+         * \brief Whether each vector of a block is normal to every plane of a set.
+         *
+         * The batch version of `is_normal_to_plane`: vector i is normal to plane p (`out[p*count + i]`) if it points the
+         * same way as the normal, that is, the cosine of the angle between them is at least `1 - tolerance`. Like
+         * `is_normal_to_plane`, the default tolerance only accepts a cosine of exactly 1, which rounding may miss; pass a
+         * small tolerance for floating point data.
+         * */
+        template <typename T> void is_normal_to_plane(
+            const numeric::types::PlaneSet<T>& planes,
+            const T* x,
+            const T* y,
+            const T* z,
+            const std::size_t& count,
+            bool* out,
+            const T& tolerance=static_cast<T>(0)
+        ) {
+            forPointBlocks(count, CosineKernel<T> {planes, x, y, z, count, nullptr, out, static_cast<T>(1) - tolerance});
+        }
+
+        /**
+         * \brief Whether each vector of a block is normal to every plane of a set, using a thread pool.
+         * */
+        template <typename T> void is_normal_to_plane(
+            const numeric::types::PlaneSet<T>& planes,
+            numeric::parallel::ThreadPool& pool,
+            const T* x,
+            const T* y,
+            const T* z,
+            const std::size_t& count,
+            bool* out,
+            const T& tolerance=static_cast<T>(0)
+        ) {
+            forPointBlocks(count, pool, CosineKernel<T> {planes, x, y, z, count, nullptr, out, static_cast<T>(1) - tolerance});
+        }
+    }
+}
+
+#endif
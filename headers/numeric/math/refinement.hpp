@@ -0,0 +1,205 @@
+#ifndef __SIGABRT_NUMERIC_REFINEMENT__
+#define __SIGABRT_NUMERIC_REFINEMENT__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
+
+#include <numeric/types/bigint.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/math/errors.hpp>
+#include <numeric/math/iterative.hpp>
+#include <numeric/math/lu.hpp>
+
+#include <thesoup/types/types.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::functions
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace functions {
+        /**
+         * \class RefinementOptions
+         *
+         * \brief When `mixed_precision_solve` stops.
+         *
+         * \var maxIterations The maximum number of refinement steps (corrections) after the first solve. The solver gives
+         * up with `NOT_CONVERGED` after this many.
+         *
+         * \var tolerance The solver stops when the residual |b - A*x|, computed in the working precision, is at most
+         * `tolerance*|b|`. This has to be above the rounding error of the working precision (about 1e-16 relative to
+         * |A|*|x| for double); with `Rational` it can be as small as you like.
+         *
+         * \var pivoting The pivoting of the low precision LU factorization.
+         * */
+        struct RefinementOptions {
+            std::size_t maxIterations {30};
+            double tolerance {1e-12};
+            Pivoting pivoting {Pivoting::PARTIAL};
+        };
+
+        namespace {
+            // Converts a double exactly to the working type: a cast for floating point types, and the exact binary
+            // fraction for rationals.
+            template <typename T> T fromDouble(const double& value) {
+                if constexpr (std::is_floating_point<T>::value) {
+                    return static_cast<T>(value);
+                } else {
+                    static_assert(
+                        std::is_constructible<T, numeric::types::BigInt, numeric::types::BigInt>::value,
+                        "The working type has to be floating point, or a rational built from BigInts.");
+                    if (value == 0.0) {
+                        return T {numeric::types::BigInt {0}, numeric::types::BigInt {1}};
+                    }
+                    // value = scaled * 2^exponent exactly, with an integral scaled.
+                    int exponent {0};
+                    const double mantissa {std::frexp(value, &exponent)};
+                    const long long scaled {static_cast<long long>(std::ldexp(mantissa, 53))};
+                    exponent -= 53;
+                    numeric::types::BigInt power {1};
+                    const numeric::types::BigInt two {2};
+                    for (int i = 0; i < std::abs(exponent); i++) {
+                        power = power*two;
+                    }
+                    if (exponent >= 0) {
+                        return T {numeric::types::BigInt {scaled}*power, numeric::types::BigInt {1}};
+                    }
+                    return T {numeric::types::BigInt {scaled}, power};
+                }
+            }
+
+            template <typename T> double euclideanNormOf(const numeric::types::Vector<T>& vec) {
+                double sum {0.0};
+                for (const T& elem : vec) {
+                    const double val {static_cast<double>(elem)};
+                    sum += val*val;
+                }
+                return std::sqrt(sum);
+            }
+        }
+
+        /**
+         * \brief Solve A*x = b by factoring A in a low precision, and refining the solution in the working precision.
+         *
+         * The O(n^3) LU factorization runs on a copy of A in `L` (float by default), which moves half the bytes of a
+         * double factorization. The solution is then corrected with the classic iterative refinement: the residual
+         * r = b - A*x is computed in the working precision `T`, the correction A*d = r is solved with the low precision
+         * factors (O(n^2)), and x += d. Every step gains about as many digits as `L` carries, divided by the condition
+         * number, so a well conditioned system reaches double accuracy in a handful of steps.
+         *
+         * `T` is the type of the system and the solution. For a floating point `T`, like double, the residual is rounded
+         * like any double computation. With `Rational`, the residual is exact, so the tolerance can go below double
+         * precision. `Fraction` is not supported: its 64 bit numerators overflow within a few corrections.
+         *
+         * The residual is scaled to a maximum element of 1 before it is handed to the low precision solve, so that it
+         * does not underflow in float as it shrinks.
+         *
+         * \tparam L The low precision type, float or double.
+         *
+         * \param matrix The square matrix A.
+         *
+         * \param b The right hand side.
+         *
+         * \param options When to stop, and the pivoting of the factorization.
+         *
+         * \return result:
+         *   Result<IterativeSolution<T>, ErrorCode> with the solution, the number of refinement steps, and the final
+         *   relative residual |b - A*x|/|b|.
+         *
+         *   Possible error codes:
+         *   - `NON_SQUARE_MATRIX`: If the matrix is not square.
+         *   - `INCOMPATIBLE_VECTORS`: If the size of b does not match the matrix.
+         *   - `SINGULAR_MATRIX`: If the matrix is singular in the low precision.
+         *   - `NOT_CONVERGED`: If the tolerance was not met in `maxIterations` steps, or a correction overflowed. This
+         *     happens when the matrix is too ill conditioned for `L`; factor in the working precision instead.
+         * */
+        template <typename L=float, typename T> thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode>
+        mixed_precision_solve(
+            const numeric::types::Matrix<T>& matrix,
+            const numeric::types::Vector<T>& b,
+            const RefinementOptions& options=RefinementOptions {}
+        ) {
+            static_assert(std::is_floating_point<L>::value, "The low precision type has to be floating point.");
+            using ResultType = thesoup::types::Result<IterativeSolution<T>, numeric::ErrorCode>;
+            if (matrix.getRows() != matrix.getCols()) {
+                return ResultType::failure(numeric::ErrorCode::NON_SQUARE_MATRIX);
+            }
+            const std::size_t n {matrix.getRows()};
+            if (b.size() != n) {
+                return ResultType::failure(numeric::ErrorCode::INCOMPATIBLE_VECTORS);
+            }
+
+            numeric::types::Matrix<L> low {n, n};
+            for (std::size_t i = 0; i < n; i++) {
+                const T* src {matrix.rowPtr(i)};
+                L* dest {low.rowPtr(i)};
+                for (std::size_t j = 0; j < n; j++) {
+                    dest[j] = static_cast<L>(static_cast<double>(src[j]));
+                }
+            }
+            auto lu {LUDecomposition<L>::factor(low, options.pivoting)};
+            if (!lu) {
+                return ResultType::failure(lu.error());
+            }
+            const LUDecomposition<L>& factors {lu.unwrap()};
+
+            const double bNorm {euclideanNormOf(b)};
+            numeric::types::Vector<T> x {n};
+            std::fill(x.begin(), x.end(), fromDouble<T>(0.0));
+            if (bNorm == 0.0) {
+                return ResultType::success(IterativeSolution<T> {std::move(x), 0, 0.0});
+            }
+
+            numeric::types::Vector<L> lowResidual {n};
+            // Step 0 is the first solve, and steps 1 to maxIterations apply a correction each. The last pass only checks
+            // the residual.
+            for (std::size_t step = 0; step <= options.maxIterations + 1; step++) {
+                numeric::types::Vector<T> residual {b - matrix*x};
+                const double residualNorm {euclideanNormOf(residual)};
+                if (!std::isfinite(residualNorm)) {
+                    return ResultType::failure(numeric::ErrorCode::NOT_CONVERGED);
+                }
+                // The first pass is the plain low precision solve, it is not counted as a refinement step.
+                if (step > 0 && residualNorm <= options.tolerance*bNorm) {
+                    return ResultType::success(IterativeSolution<T> {std::move(x), step - 1, residualNorm/bNorm});
+                }
+                if (step == options.maxIterations + 1) {
+                    break;
+                }
+
+                double scale {0.0};
+                for (const T& elem : residual) {
+                    scale = std::max(scale, std::fabs(static_cast<double>(elem)));
+                }
+                for (std::size_t i = 0; i < n; i++) {
+                    lowResidual[i] = static_cast<L>(static_cast<double>(residual[i])/scale);
+                }
+                auto solved {factors.solve(lowResidual)};
+                const numeric::types::Vector<L>& correction {solved.unwrap()};
+                // A near singular factorization can overflow L. fromDouble can not convert that to a rational.
+                for (std::size_t i = 0; i < n; i++) {
+                    if (!std::isfinite(static_cast<double>(correction[i])*scale)) {
+                        return ResultType::failure(numeric::ErrorCode::NOT_CONVERGED);
+                    }
+                }
+                for (std::size_t i = 0; i < n; i++) {
+                    x[i] = x[i] + fromDouble<T>(static_cast<double>(correction[i])*scale);
+                }
+            }
+            return ResultType::failure(numeric::ErrorCode::NOT_CONVERGED);
+        }
+    }
+}
+
+#endif
@@ -1,11 +1,17 @@
 #ifndef __SIGABRT_NUMERIC_RREF__
 #define __SIGABRT_NUMERIC_RREF__
 
+#include <cmath>
 #include <optional>
 #include <vector>
 
+#include <numeric/benchmark/instrumentation.hpp>
+#include <numeric/kernels/elimination.hpp>
+#include <numeric/math/bareiss.hpp>
 #include <numeric/types/models.hpp>
 #include <numeric/types/matrix.hpp>
+#include <numeric/types/matrixview.hpp>
+#include <numeric/types/permutation.hpp>
 #include <numeric/math/errors.hpp>
 
 /**
@@ -21,19 +27,44 @@ namespace numeric {
      * */
     namespace functions {
         namespace {
-            template <typename T>
+            // M is a Matrix<T> or a MatrixView<T>.
+            template <typename M>
             std::optional<std::size_t> findNextPivot(
-                const numeric::types::Matrix<T>& matrix,
+                const M& matrix,
                 const std::size_t& startRow, 
                 const std::size_t& startCol) {
+                using T = typename M::value_type;
                 for (std::size_t i = startRow+1; i < matrix.getRows(); i++) {
-                    if  (matrix[i][startCol] != 0) {
+                    if  (matrix.atUnchecked(i, startCol) != static_cast<T>(0)) {
                         return i;
                     }
                 }
                 return std::nullopt;
             }
             
+            // The row at or below startRow with the largest element in column col, by magnitude. Nothing if that element
+            // rounds off to zero.
+            template <typename M>
+            std::optional<std::size_t> findLargestPivot(
+                const M& matrix,
+                const std::size_t& startRow,
+                const std::size_t& col,
+                const double& zeroPrecision) {
+                std::size_t bestRow {startRow};
+                double best {0.0};
+                for (std::size_t i = startRow; i < matrix.getRows(); i++) {
+                    const double size {std::fabs(static_cast<double>(matrix.atUnchecked(i, col)))};
+                    if (size > best) {
+                        best = size;
+                        bestRow = i;
+                    }
+                }
+                if (best == 0.0 || best < zeroPrecision) {
+                    return std::nullopt;
+                }
+                return bestRow;
+            }
+            
             template<typename T> T roundOffToZero(const T& val, const double& zeroPrecision) {
                 if (static_cast<double>(val) > -zeroPrecision && static_cast<double>(val) < zeroPrecision) {
                     return static_cast<T>(0.0);
@@ -41,6 +72,212 @@ namespace numeric {
                     return val;
                 }
             }
+
+            // row -= factor*pivotRow, from column first on.
+            template <typename M, typename T> void subtractMultiple(
+                M& matrix,
+                const std::size_t& row,
+                const std::size_t& pivotRow,
+                const T& factor,
+                const std::size_t& first) {
+                T* dest {detail::contiguousRow(matrix, row, first)};
+                if (dest) {
+                    numeric::kernels::subtract_multiple(dest, detail::contiguousRow(matrix, pivotRow, first), factor, matrix.getCols() - first);
+                } else {
+                    for (std::size_t j = first; j < matrix.getCols(); j++) {
+                        T& elem {matrix.atUnchecked(row, j)};
+                        elem = elem - factor*matrix.atUnchecked(pivotRow, j);
+                    }
+                }
+            }
+
+            // row -= factor*pivotRow, from column first on, rounding off to zero.
+            template <typename M, typename T> void subtractMultipleRoundOff(
+                M& matrix,
+                const std::size_t& row,
+                const std::size_t& pivotRow,
+                const T& factor,
+                const double& zeroPrecision,
+                const std::size_t& first) {
+                T* dest {detail::contiguousRow(matrix, row, first)};
+                if (dest) {
+                    numeric::kernels::subtract_multiple_round_off(
+                        dest, detail::contiguousRow(matrix, pivotRow, first), factor, zeroPrecision, matrix.getCols() - first);
+                } else {
+                    for (std::size_t j = first; j < matrix.getCols(); j++) {
+                        T& elem {matrix.atUnchecked(row, j)};
+                        elem = roundOffToZero(elem - factor*matrix.atUnchecked(pivotRow, j), zeroPrecision);
+                    }
+                }
+            }
+
+            // row *= 1/pivot, from column first on.
+            template <typename M, typename T> void normalizeFrom(M& matrix, const std::size_t& row, const T& pivot, const std::size_t& first) {
+                T* elems {detail::contiguousRow(matrix, row, first)};
+                if (elems) {
+                    numeric::kernels::normalize_row(elems, pivot, matrix.getCols() - first);
+                } else {
+                    const T factor {numeric::kernels::reciprocal(pivot)};
+                    for (std::size_t j = first; j < matrix.getCols(); j++) {
+                        T& elem {matrix.atUnchecked(row, j)};
+                        elem = elem*factor;
+                    }
+                }
+            }
+
+            // rref for integral types: bareiss, which leaves every pivot row a multiple of the row of the reduced form,
+            // and then every row divided by the gcd of its elements.
+            template <typename M> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+            rrefFractionFree(M& matrix, numeric::types::Permutation* permutation) {
+                using T = typename M::value_type;
+                auto result {detail::bareissInPlace(matrix, permutation)};
+                const std::size_t ncols {matrix.getCols()};
+                for (std::size_t row = 0; row < matrix.getRows(); row++) {
+                    T* elems {detail::contiguousRow(matrix, row, 0)};
+                    if (elems) {
+                        numeric::kernels::make_primitive(elems, ncols);
+                    } else {
+                        std::vector<T> copy(ncols);
+                        for (std::size_t j = 0; j < ncols; j++) {
+                            copy[j] = matrix.atUnchecked(row, j);
+                        }
+                        numeric::kernels::make_primitive(copy.data(), ncols);
+                        for (std::size_t j = 0; j < ncols; j++) {
+                            matrix.atUnchecked(row, j) = copy[j];
+                        }
+                    }
+                }
+                return result;
+            }
+
+            // The eliminations behind rref, for a Matrix<T> or a MatrixView<T>. Row exchanges are recorded in permutation,
+            // if there is one. The updates depend on the scalar family of T:
+            //   - Integers take the fraction free elimination above, so when there are free columns, their pivots are not
+            //     on the diagonal (see bareiss).
+            //   - Exact types normalize the pivot row first, with one reciprocal, so the multiplier of every other row is
+            //     its element in the pivot column, without a division, and the update skips zeros.
+            //   - Floating point (and other) types divide once per row for the multiplier, and normalize the pivot row
+            //     last. The updates are not fused: without a zero precision, rows that are multiples of each other have
+            //     to cancel exactly. See the version with a zero precision for the fused updates.
+            // Columns left of the diagonal are skipped, as they are zero in the pivot row, unless a column was left free.
+            template <typename M> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+            rrefInPlace(M& matrix, numeric::types::Permutation* permutation=nullptr) {
+                using T = typename M::value_type;
+                const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::RREF};
+                if constexpr (numeric::types::ScalarFamilyOf<T>::value == numeric::types::ScalarFamily::INTEGER) {
+                    return rrefFractionFree(matrix, permutation);
+                } else {
+                    bool freeElements {false};
+                    std::size_t smallerDim {matrix.getRows() < matrix.getCols()? matrix.getRows(): matrix.getCols()};
+                    for (std::size_t i = 0; i < smallerDim; i++) {
+                        // If pivot element is zero, we need to make it non zero
+                        if (matrix.atUnchecked(i, i) == static_cast<T>(0)) {
+                            std::optional<std::size_t> nextPivot = findNextPivot(matrix, i, i);
+                            if (nextPivot == std::nullopt) {
+                                numeric::benchmark::record_pivot_failure();
+                                freeElements = true;
+                                continue;
+                            } else {
+                                matrix.exchangeRows(i, *nextPivot);
+                                if (permutation) {
+                                    permutation->swap(i, *nextPivot);
+                                }
+                            }
+                        }
+
+                        constexpr bool exact {numeric::types::ScalarFamilyOf<T>::value == numeric::types::ScalarFamily::EXACT};
+                        const std::size_t firstCol {freeElements? 0 : i};
+                        const T pivot {matrix.atUnchecked(i, i)};
+                        if constexpr (exact) {
+                            normalizeFrom(matrix, i, pivot, firstCol);
+                            matrix.atUnchecked(i, i) = static_cast<T>(1);
+                        }
+
+                        // Operate on the other rows.
+                        // See parallel_rref for the multithreaded version.
+                        for (std::size_t otherRow = 0; otherRow < matrix.getRows(); otherRow++) {
+                            const T elem {matrix.atUnchecked(otherRow, i)};
+                            if (elem == static_cast<T>(0) || otherRow == i) {
+                                continue;
+                            }
+                            subtractMultiple(matrix, otherRow, i, exact? elem : elem/pivot, firstCol);
+                            matrix.atUnchecked(otherRow, i) = static_cast<T>(0);
+                        }
+
+                        // Normalize pivot element
+                        if constexpr (!exact) {
+                            normalizeFrom(matrix, i, pivot, firstCol);
+                        }
+
+                    }
+
+                    if (freeElements) {
+                        return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::failure(numeric::ErrorCode::FREE_COLUMNS_RREF) ;
+                    } else {
+                        return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::success(thesoup::types::Unit::unit);
+                    }
+                }
+            }
+
+            template <typename M> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+            rrefInPlace(M& matrix, const double& zero_precision, numeric::types::Permutation* permutation=nullptr) {
+                using T = typename M::value_type;
+                if constexpr (numeric::types::ScalarFamilyOf<T>::value == numeric::types::ScalarFamily::INTEGER) {
+                    // Integers are exact, there is nothing to round off.
+                    return rrefInPlace(matrix, permutation);
+                } else {
+                    const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::RREF};
+                    bool freeElements {false};
+                    const std::size_t ncols {matrix.getCols()};
+                    std::size_t smallerDim {matrix.getRows() < ncols? matrix.getRows(): ncols};
+                    for (std::size_t i = 0; i < smallerDim; i++) {
+                        // Partial pivoting: the largest element on or below the diagonal. If even that rounds off to zero,
+                        // the column is free.
+                        std::optional<std::size_t> pivotRow = findLargestPivot(matrix, i, i, zero_precision);
+                        if (pivotRow == std::nullopt) {
+                            numeric::benchmark::record_pivot_failure();
+                            freeElements = true;
+                            continue;
+                        } else if (*pivotRow != i) {
+                            matrix.exchangeRows(i, *pivotRow);
+                            if (permutation) {
+                                permutation->swap(i, *pivotRow);
+                            }
+                        }
+
+                        // Every earlier pivot column was eliminated from the pivot row, so it is zero left of the diagonal,
+                        // unless a column was left free.
+                        const std::size_t firstCol {freeElements? 0 : i};
+
+                        // Operate on subsequent rows, rounding off in the same pass, with fused updates for floating point types.
+                        // See parallel_rref for the multithreaded version.
+                        const T pivot {matrix.atUnchecked(i, i)};
+                        for (std::size_t otherRow = 0; otherRow < matrix.getRows(); otherRow++) {
+                            if (matrix.atUnchecked(otherRow, i) == static_cast<T>(0) || otherRow == i) {
+                                continue;
+                            }
+                            const T multiplier {matrix.atUnchecked(otherRow, i)/pivot};
+                            subtractMultipleRoundOff(matrix, otherRow, i, multiplier, zero_precision, firstCol);
+                            matrix.atUnchecked(otherRow, i) = static_cast<T>(0);
+                        }
+
+                        // Normalize pivot row, and round off.
+                        const T inverse {static_cast<T>(1)/pivot};
+                        for (std::size_t j = firstCol; j < ncols; j++) {
+                            T& elem {matrix.atUnchecked(i, j)};
+                            elem = roundOffToZero(elem*inverse, zero_precision);
+                        }
+                        matrix.atUnchecked(i, i) = static_cast<T>(1);
+
+                    }
+
+                    if (freeElements) {
+                        return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::failure(numeric::ErrorCode::FREE_COLUMNS_RREF);
+                    } else {
+                        return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::success(thesoup::types::Unit::unit);
+                    }
+                }
+            }
         }
         
         /**
@@ -57,12 +294,12 @@ namespace numeric {
          * \return bool indicating whether the row is a false ID or not.
          * */
         template <typename T> bool false_identity_row(const thesoup::types::Slice<T>& row) {
-            const T& rightMost {row[row.size-1]};
-            if (rightMost == 0) {
+            const T& rightMost {row.start[row.size-1]};
+            if (rightMost == static_cast<T>(0)) {
                 return false;
             } else {
                 for (std::size_t i = 0; i < row.size-1; i++) {
-                    const T& elem {row[i]};
+                    const T& elem {row.start[i]};
                     if (elem != static_cast<T>(0)) {
                         return false;
                     }
@@ -85,7 +322,7 @@ namespace numeric {
          * \return bool indicating whether the row is a false ID or not.
          * */
         template <typename T> bool identity_row(const thesoup::types::Slice<T>& row) {
-            const T& first {row[0]};
+            const T& first {row.start[0]};
             for (const auto& elem : row) {
                 if (elem != first) {
                     return false;
@@ -101,6 +338,12 @@ namespace numeric {
          * Existence of free elements after the computation is complete will restult in a `FREE_COLUMNS_RREF` error. Note,
          * that this function does not throw exceptions. It returns a `Result<T,E>` to indicate the results of computation.
          * 
+         * The kernels are picked at compile time by the `ScalarFamily` of `T`. Integral types are reduced without division
+         * (`bareiss`), so each row ends up as the smallest integer multiple of the row of the reduced form, with a positive
+         * pivot. That is the reduced row itself whenever its elements are integers. The intermediate elements are minors of
+         * the input, so they can overflow the built in integers for large matrices; use `BigInt`, `Fraction` or `Rational`
+         * then. With free columns, the pivots of integral types move right past them, as in `bareiss`.
+         * 
          * \param matrix: 
          *   Matrix<T> The **non const** reference to the input matrix.
          * 
@@ -112,42 +355,25 @@ namespace numeric {
          * */
         template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
         rref(numeric::types::Matrix<T>& matrix) {
-            bool freeElements {false};
-            std::size_t smallerDim {matrix.getRows() < matrix.getCols()? matrix.getRows(): matrix.getCols()};
-            for (std::size_t i = 0; i < smallerDim; i++) {
-                // If pivot element is zero, we need to make it non zero
-                if (matrix[i][i] == static_cast<T>(0)) {
-                    std::optional<T> nextPivot = findNextPivot(matrix, i, i);
-                    if (nextPivot == std::nullopt) {
-                        freeElements = true;
-                        continue;
-                    } else {
-                        matrix.exchangeRows(i, *nextPivot);
-                    }
-                }
-                
-                // Operate on subsequent rows.
-                // TODO: Parallelize this
-                for (std::size_t other_rows = 0; other_rows < matrix.getRows(); other_rows++) {
-                    if (matrix[other_rows][i] == static_cast<T>(0) || other_rows == i) {
-                        continue;
-                    }
-                    T div = -(matrix[other_rows][i]/matrix[i][i]);
-                    matrix.linearCombRows(other_rows, static_cast<T>(1), i,  div);
-                    matrix[other_rows][i] = static_cast<T>(0);
-                }
-                
-                // Normalize pivot element
-                matrix.scaleRow(i, static_cast<T>(1)/matrix[i][i]);
-                
-            }
-            
-            if (freeElements) {
-                return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::failure(numeric::ErrorCode::FREE_COLUMNS_RREF) ;
-            } else {
-                return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::success(thesoup::types::Unit::unit);
-            }
-            
+            return rrefInPlace(matrix);
+        }
+
+        /**
+         * \brief Function to perform RREF on a view, in place.
+         * 
+         * Same as the above, on a block (or a transpose) of a matrix. Only the elements in the view are touched, and row
+         * exchanges swap the elements in the view, not the rows of the matrix. For example, `rref(m.submatrix(0, 0, 3, 4))`
+         * reduces the top left 3x4 block of `m`.
+         * 
+         * \param matrix: 
+         *   MatrixView<T> The view to reduce.
+         * 
+         * \return result: 
+         *   Result<Unit, ErrorCode> Result to indicate the operation status.
+         * */
+        template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+        rref(numeric::types::MatrixView<T> matrix) {
+            return rrefInPlace(matrix);
         }
         
         /**
@@ -158,7 +384,12 @@ namespace numeric {
          * that this function does not throw exceptions. It returns a `Result<T,E>` to indicate the results of computation.
          * 
          * During computation, this function handles precision errors by rounding off very small numbers (with an absolute 
-         * value less than the `zero_precision` parameter), to zero.
+         * value less than the `zero_precision` parameter), to zero. The round off is done as the rows are updated, so every
+         * row is read and written once per pivot. Pivoting is partial, unlike the version without a `zero_precision`: the
+         * pivot of each column is its largest element (by magnitude) on or below the diagonal, and the column is free if
+         * that rounds off to zero. This keeps the multipliers at most 1, which is what you want for floating point data.
+         * 
+         * Integral types have nothing to round off, and are reduced without division, as by `rref(Matrix<T>&)`.
          * 
          * NOTE: In this version of the function, if you are using a non primitive type, it has to support conversion to double.
          * 
@@ -177,50 +408,85 @@ namespace numeric {
          * */
         template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
         rref(numeric::types::Matrix<T>& matrix, const double& zero_precision) {
-            bool freeElements {false};
-            std::size_t smallerDim {matrix.getRows() < matrix.getCols()? matrix.getRows(): matrix.getCols()};
-            for (std::size_t i = 0; i < smallerDim; i++) {
-                // If pivot element is zero, we need to make it non zero
-                if (matrix[i][i] == static_cast<T>(0)) {
-                    std::optional<T> nextPivot = findNextPivot(matrix, i, i);
-                    if (nextPivot == std::nullopt) {
-                        freeElements = true;
-                        continue;
-                    } else {
-                        matrix.exchangeRows(i, *nextPivot);
-                    }
-                }
-                
-                // Operate on subsequent rows.
-                // TODO: Parallelize this.
-                for (std::size_t otherRow = 0; otherRow < matrix.getRows(); otherRow++) {
-                    if (matrix[otherRow][i] == static_cast<T>(0) || otherRow == i) {
-                        continue;
-                    }
-                    T div = -(matrix[otherRow][i]/matrix[i][i]);
-                    // Operate on the row
-                    matrix.linearCombRows(otherRow, static_cast<T>(1), i,  div);
-                    
-                    // Round off the row
-                    for (auto& elem : matrix[otherRow]) {
-                        elem = roundOffToZero(elem, zero_precision);
-                    }
-                }
-                
-                // Normalize pivot row, and round off.
-                matrix.scaleRow(i, static_cast<T>(1)/matrix[i][i]);
-                for (auto& elem : matrix[i]) {
-                    elem = roundOffToZero(elem, zero_precision);
-                }
-                
-            }
-            
-            if (freeElements) {
-                return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::failure(numeric::ErrorCode::FREE_COLUMNS_RREF);
-            } else {
-                return thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>::success(thesoup::types::Unit::unit);
-            }
-            
+            return rrefInPlace(matrix, zero_precision);
+        }
+
+        /**
+         * \brief Function to perform RREF on a view, in place, rounding off small numbers to zero.
+         * 
+         * Same as the above, on a block (or a transpose) of a matrix. See `rref(MatrixView<T>)`.
+         * 
+         * \param matrix: 
+         *   MatrixView<T> The view to reduce.
+         * 
+         * \param zero_precision:
+         *   The double value which is considered to be the threshold to be 0.
+         * 
+         * \return result: 
+         *   Result<Unit, ErrorCode> Result to indicate the operation status.
+         * */
+        template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+        rref(numeric::types::MatrixView<T> matrix, const double& zero_precision) {
+            return rrefInPlace(matrix, zero_precision);
+        }
+
+        /**
+         * \brief Function to perform RREF on a matrix, recording the row exchanges.
+         * 
+         * Same as `rref(Matrix<T>&)`, and on return `permutation` holds the row exchanges the reduction made: row i of the
+         * result was reduced from row `permutation[i]` of the input. Its sign is the sign the exchanges contribute to the
+         * determinant, and `permutation.apply(b)` (or `Matrix::permuteRows`) puts a new right hand side in the same row
+         * order. The exchanges only swap row pointers; call `matrix.compact()` afterwards if the elements have to be in
+         * row major order again.
+         * 
+         * \param matrix: 
+         *   Matrix<T> The **non const** reference to the input matrix.
+         * 
+         * \param permutation:
+         *   Permutation The exchanges are recorded here. It is reset to the identity first.
+         * 
+         * \return result: 
+         *   Result<Unit, ErrorCode> Result to indicate the operation status, as for `rref(Matrix<T>&)`.
+         * */
+        template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+        rref(numeric::types::Matrix<T>& matrix, numeric::types::Permutation& permutation) {
+            permutation = numeric::types::Permutation {matrix.getRows()};
+            return rrefInPlace(matrix, &permutation);
+        }
+
+        /**
+         * \brief Function to perform RREF on a view, in place, recording the row exchanges.
+         * 
+         * See `rref(MatrixView<T>)` and `rref(Matrix<T>&, Permutation&)`. The exchanges swap elements in a view, so the
+         * view stays in its row order, and the permutation is the only record of them.
+         * */
+        template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+        rref(numeric::types::MatrixView<T> matrix, numeric::types::Permutation& permutation) {
+            permutation = numeric::types::Permutation {matrix.getRows()};
+            return rrefInPlace(matrix, &permutation);
+        }
+
+        /**
+         * \brief Function to perform RREF on a matrix, rounding off small numbers to zero and recording the row exchanges.
+         * 
+         * See `rref(Matrix<T>&, const double&)` and `rref(Matrix<T>&, Permutation&)`.
+         * */
+        template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+        rref(numeric::types::Matrix<T>& matrix, const double& zero_precision, numeric::types::Permutation& permutation) {
+            permutation = numeric::types::Permutation {matrix.getRows()};
+            return rrefInPlace(matrix, zero_precision, &permutation);
+        }
+
+        /**
+         * \brief Function to perform RREF on a view, in place, rounding off small numbers to zero and recording the row
+         * exchanges.
+         * 
+         * See `rref(MatrixView<T>, const double&)` and `rref(MatrixView<T>, Permutation&)`.
+         * */
+        template <typename T> thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode>
+        rref(numeric::types::MatrixView<T> matrix, const double& zero_precision, numeric::types::Permutation& permutation) {
+            permutation = numeric::types::Permutation {matrix.getRows()};
+            return rrefInPlace(matrix, zero_precision, &permutation);
         }
     }
 }
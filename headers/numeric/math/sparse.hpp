@@ -0,0 +1,533 @@
+#ifndef __SIGABRT_NUMERIC_SPARSE__
+#define __SIGABRT_NUMERIC_SPARSE__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <numeric/types/models.hpp>
+#include <numeric/types/sparsematrix.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/math/errors.hpp>
+#include <numeric/parallel/threadpool.hpp>
+
+#include <thesoup/types/types.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::functions
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace functions {
+        /**
+         * \brief Relative threshold of the sparse pivot choice. Among the candidates of a column whose magnitude is at least
+         * this fraction of the largest one, the sparsest row is the pivot.
+         * */
+        constexpr double SPARSE_PIVOT_THRESHOLD {0.1};
+
+        namespace {
+            // Splits the major indices of a sparse matrix into `parts` contiguous ranges with about the same number of
+            // non zeros. Returns parts + 1 boundaries.
+            inline std::vector<std::size_t> balancedRanges(const std::vector<std::size_t>& offsets, const std::size_t& parts) {
+                const std::size_t majorDim {offsets.size() - 1};
+                const std::size_t nonZeros {offsets.back()};
+                std::vector<std::size_t> bounds(parts + 1, majorDim);
+                bounds[0] = 0;
+                for (std::size_t t = 1; t < parts; t++) {
+                    const std::size_t target {nonZeros/parts*t + nonZeros % parts*t/parts};
+                    const auto it {std::lower_bound(offsets.begin(), offsets.end(), target)};
+                    bounds[t] = std::max(bounds[t - 1], std::min(majorDim, static_cast<std::size_t>(it - offsets.begin())));
+                }
+                return bounds;
+            }
+
+            // Forward elimination of a sparse system, row by row. Every row is a list of (column, value) sorted by column.
+            // For every column in turn, the pivot is picked among the remaining rows with an element in that column
+            // (threshold partial pivoting, preferring sparse rows to limit the fill in), and eliminated from the others.
+            template <typename T> class SparseElimination {
+            private:
+                using Row = std::vector<std::pair<std::size_t, T>>;
+
+                std::size_t ncols;
+                double zeroPrecision;
+                std::vector<Row> rows;
+                // The rows that may have an element in each column. Entries are not removed when an element cancels
+                // out, so a row can be listed twice, or have no element left there. They are checked on use.
+                std::vector<std::vector<std::size_t>> columnRows;
+                std::vector<char> pivoted;
+                Row scratch {};
+
+                static double magnitude(const T& val) {
+                    return std::fabs(static_cast<double>(val));
+                }
+
+                // row = row - factor*pivotRow, without the leading (eliminated) element of either.
+                void subtract(const std::size_t& target, const T& factor, const Row& pivotRow) {
+                    Row& row {rows[target]};
+                    scratch.clear();
+                    std::size_t a {1};
+                    std::size_t b {1};
+                    while (a < row.size() || b < pivotRow.size()) {
+                        if (b == pivotRow.size() || (a < row.size() && row[a].first < pivotRow[b].first)) {
+                            scratch.push_back(row[a]);
+                            a++;
+                        } else {
+                            const std::size_t c {pivotRow[b].first};
+                            T value {-(factor*pivotRow[b].second)};
+                            const bool fill {a == row.size() || row[a].first != c};
+                            if (!fill) {
+                                value = row[a].second + value;
+                                a++;
+                            }
+                            b++;
+                            if (magnitude(value) > zeroPrecision && value != static_cast<T>(0)) {
+                                scratch.push_back(std::make_pair(c, value));
+                                if (fill) {
+                                    columnRows[c].push_back(target);
+                                }
+                            }
+                        }
+                    }
+                    std::swap(row, scratch);
+                }
+
+            public:
+                // Multipliers of the eliminations: (eliminated row, pivot step, multiplier).
+                std::vector<std::pair<std::size_t, std::pair<std::size_t, T>>> multipliers {};
+                // pivotRows[k] is the row that was the pivot of step k, pivotCols[k] its column.
+                std::vector<std::size_t> pivotRows {};
+                std::vector<std::size_t> pivotCols {};
+                std::vector<std::size_t> freeColumns {};
+
+                SparseElimination(const numeric::types::SparseMatrix<T>& matrix, const double& zeroPrecision):
+                    ncols {matrix.getCols()},
+                    zeroPrecision {zeroPrecision},
+                    rows(matrix.getRows()),
+                    columnRows(matrix.getCols()),
+                    pivoted(matrix.getRows(), 0) {
+                    const numeric::types::SparseMatrix<T> csr {matrix.with_layout(numeric::types::SparseLayout::CSR)};
+                    const std::vector<std::size_t>& offsets {csr.get_offsets()};
+                    for (std::size_t i = 0; i < rows.size(); i++) {
+                        for (std::size_t p = offsets[i]; p < offsets[i + 1]; p++) {
+                            if (magnitude(csr.get_values()[p]) > zeroPrecision) {
+                                rows[i].push_back(std::make_pair(csr.get_indices()[p], csr.get_values()[p]));
+                                columnRows[csr.get_indices()[p]].push_back(i);
+                            }
+                        }
+                    }
+                }
+
+                // Eliminate column by column. rhs (if not null) gets the same row operations.
+                void run(T* rhs) {
+                    for (std::size_t col = 0; col < ncols; col++) {
+                        // The remaining rows have no elements left of col, so their element in col is their first.
+                        std::vector<std::size_t>& listed {columnRows[col]};
+                        std::sort(listed.begin(), listed.end());
+                        listed.erase(std::unique(listed.begin(), listed.end()), listed.end());
+                        std::vector<std::size_t> candidates {};
+                        double best {0.0};
+                        for (const std::size_t& row : listed) {
+                            if (!pivoted[row] && !rows[row].empty() && rows[row].front().first == col) {
+                                candidates.push_back(row);
+                                best = std::max(best, magnitude(rows[row].front().second));
+                            }
+                        }
+                        columnRows[col].clear();
+                        columnRows[col].shrink_to_fit();
+                        if (candidates.empty() || best <= zeroPrecision) {
+                            freeColumns.push_back(col);
+                            continue;
+                        }
+                        std::size_t pivot {candidates.front()};
+                        bool chosen {false};
+                        for (const std::size_t& row : candidates) {
+                            const double size {magnitude(rows[row].front().second)};
+                            if (size < SPARSE_PIVOT_THRESHOLD*best) {
+                                continue;
+                            }
+                            if (!chosen || rows[row].size() < rows[pivot].size() ||
+                                (rows[row].size() == rows[pivot].size() && size > magnitude(rows[pivot].front().second))) {
+                                pivot = row;
+                                chosen = true;
+                            }
+                        }
+
+                        const std::size_t step {pivotRows.size()};
+                        pivoted[pivot] = 1;
+                        pivotRows.push_back(pivot);
+                        pivotCols.push_back(col);
+                        const Row& pivotRow {rows[pivot]};
+                        const T pivotValue {pivotRow.front().second};
+                        for (const std::size_t& row : candidates) {
+                            if (row == pivot) {
+                                continue;
+                            }
+                            const T factor {rows[row].front().second/pivotValue};
+                            subtract(row, factor, pivotRow);
+                            if (rhs != nullptr) {
+                                rhs[row] = rhs[row] - factor*rhs[pivot];
+                            }
+                            multipliers.push_back(std::make_pair(row, std::make_pair(step, factor)));
+                        }
+                    }
+                }
+
+                const std::vector<Row>& get_rows() const {
+                    return rows;
+                }
+
+                const std::vector<char>& get_pivoted() const {
+                    return pivoted;
+                }
+            };
+        }
+
+        /**
+         * \brief Multithreaded sparse matrix * vector product.
+         *
+         * The rows (CSR) or columns (CSC) are split between the threads of the pool in ranges with about the same number
+         * of non zeros. CSR rows are independent, so the threads write disjoint parts of the result. CSC columns scatter
+         * into the whole result, so every thread accumulates into its own vector, and these are summed in parallel at the
+         * end.
+         *
+         * \param matrix The sparse matrix.
+         *
+         * \param vec The vector.
+         *
+         * \param pool The thread pool.
+         *
+         * \throw e std::invalid_argument if the dimensions do not match.
+         *
+         * \return Vector<T> The product.
+         * */
+        template <typename T> numeric::types::Vector<T> parallel_multiply(
+            const numeric::types::SparseMatrix<T>& matrix,
+            const numeric::types::Vector<T>& vec,
+            numeric::parallel::ThreadPool& pool
+        ) {
+            if (matrix.getCols() != vec.size()) {
+                throw std::invalid_argument("Incompatible matrix and vector for multiplication.");
+            }
+            numeric::types::Vector<T> retval(matrix.getRows(), vec.get_resource());
+            const T* src {vec.data()};
+            T* dest {retval.data()};
+            const std::vector<std::size_t>& offsets {matrix.get_offsets()};
+            const std::vector<std::size_t>& indices {matrix.get_indices()};
+            const std::vector<T>& values {matrix.get_values()};
+            const std::size_t parts {pool.get_num_threads()};
+            const std::vector<std::size_t> bounds {balancedRanges(offsets, parts)};
+
+            if (matrix.get_layout() == numeric::types::SparseLayout::CSR) {
+                pool.parallel_for(0, parts, [&](const std::size_t& begin, const std::size_t& end) {
+                    for (std::size_t part = begin; part < end; part++) {
+                        for (std::size_t i = bounds[part]; i < bounds[part + 1]; i++) {
+                            T sum = static_cast<T>(0);
+                            for (std::size_t p = offsets[i]; p < offsets[i + 1]; p++) {
+                                sum += values[p] * src[indices[p]];
+                            }
+                            dest[i] = sum;
+                        }
+                    }
+                });
+            } else {
+                const std::size_t nrows {matrix.getRows()};
+                std::vector<T> partials(parts*nrows, static_cast<T>(0));
+                pool.parallel_for(0, parts, [&](const std::size_t& begin, const std::size_t& end) {
+                    for (std::size_t part = begin; part < end; part++) {
+                        T* acc {partials.data() + part*nrows};
+                        for (std::size_t j = bounds[part]; j < bounds[part + 1]; j++) {
+                            const T factor {src[j]};
+                            for (std::size_t p = offsets[j]; p < offsets[j + 1]; p++) {
+                                acc[indices[p]] += values[p] * factor;
+                            }
+                        }
+                    }
+                });
+                pool.parallel_for(0, nrows, [&](const std::size_t& begin, const std::size_t& end) {
+                    for (std::size_t i = begin; i < end; i++) {
+                        T sum {partials[i]};
+                        for (std::size_t part = 1; part < parts; part++) {
+                            sum += partials[part*nrows + i];
+                        }
+                        dest[i] = sum;
+                    }
+                }, 4096);
+            }
+            return retval;
+        }
+
+        /**
+         * \class SparseLUDecomposition
+         *
+         * \tparam T Some numeric type. It has to support conversion to double, for pivot selection.
+         *
+         * \brief LU factorization of a square sparse matrix, P*A = L*U, with L and U sparse.
+         *
+         * This is the sparse counterpart of `LUDecomposition`. Only the non zero elements are visited: for every column,
+         * the candidate pivots are the remaining rows with an element in that column, and only those rows are updated.
+         * The pivot is the sparsest candidate whose magnitude is at least `SPARSE_PIVOT_THRESHOLD` times the largest one,
+         * which keeps the fill in (new non zeros in L and U) low while staying numerically stable.
+         *
+         * Instances are created through `factor`, which returns a `Result<SparseLUDecomposition<T>, ErrorCode>`. Like
+         * `SparseMatrix`, this is not copyable.
+         * */
+        template <typename T> class SparseLUDecomposition {
+        private:
+            numeric::types::SparseMatrix<T> lower;
+            numeric::types::SparseMatrix<T> upper;
+            std::vector<std::size_t> rowPermutation;
+            int permutationSign;
+
+            SparseLUDecomposition(
+                numeric::types::SparseMatrix<T>&& lower,
+                numeric::types::SparseMatrix<T>&& upper,
+                std::vector<std::size_t>&& rowPermutation,
+                const int& permutationSign
+            ): lower {std::move(lower)},
+                upper {std::move(upper)},
+                rowPermutation {std::move(rowPermutation)},
+                permutationSign {permutationSign} {}
+
+        public:
+            SparseLUDecomposition(SparseLUDecomposition<T>&& other)=default;
+            SparseLUDecomposition(const SparseLUDecomposition<T>& other)=delete;
+            void operator=(const SparseLUDecomposition<T>& other)=delete;
+
+            /**
+             * \brief Factor a square sparse matrix.
+             *
+             * \param matrix The square matrix to factor. It is left untouched.
+             *
+             * \param zero_precision Elements with an absolute value less than or equal to this are treated as 0. Defaults
+             * to 0.0, which means only exact zeros are dropped.
+             *
+             * \return result:
+             *   Result<SparseLUDecomposition<T>, ErrorCode>
+             *
+             *   Possible error codes:
+             *   - `NON_SQUARE_MATRIX`: If the matrix is not square.
+             *   - `SINGULAR_MATRIX`: If no non zero pivot could be found for some column.
+             * */
+            static thesoup::types::Result<SparseLUDecomposition<T>, numeric::ErrorCode> factor(
+                const numeric::types::SparseMatrix<T>& matrix,
+                const double& zero_precision=0.0
+            ) {
+                if (matrix.getRows() != matrix.getCols()) {
+                    return thesoup::types::Result<SparseLUDecomposition<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::NON_SQUARE_MATRIX);
+                }
+                const std::size_t n {matrix.getRows()};
+                SparseElimination<T> elimination {matrix, zero_precision};
+                elimination.run(nullptr);
+                if (!elimination.freeColumns.empty()) {
+                    return thesoup::types::Result<SparseLUDecomposition<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::SINGULAR_MATRIX);
+                }
+
+                // Step k pivoted on column k, so row k of U is what is left of row pivotRows[k], and row k of P*A is
+                // pivotRows[k] of A.
+                std::vector<std::size_t> position(n);
+                for (std::size_t k = 0; k < n; k++) {
+                    position[elimination.pivotRows[k]] = k;
+                }
+                std::vector<numeric::types::Triplet<T>> lowerTriplets {};
+                lowerTriplets.reserve(elimination.multipliers.size() + n);
+                for (const auto& entry : elimination.multipliers) {
+                    lowerTriplets.push_back(numeric::types::Triplet<T> {position[entry.first], entry.second.first, entry.second.second});
+                }
+                for (std::size_t k = 0; k < n; k++) {
+                    lowerTriplets.push_back(numeric::types::Triplet<T> {k, k, static_cast<T>(1)});
+                }
+                std::vector<numeric::types::Triplet<T>> upperTriplets {};
+                for (std::size_t k = 0; k < n; k++) {
+                    for (const auto& elem : elimination.get_rows()[elimination.pivotRows[k]]) {
+                        upperTriplets.push_back(numeric::types::Triplet<T> {k, elem.first, elem.second});
+                    }
+                }
+
+                // The sign of the permutation, from its cycles.
+                std::vector<std::size_t> rowPermutation {elimination.pivotRows};
+                int sign {1};
+                std::vector<char> visited(n, 0);
+                for (std::size_t i = 0; i < n; i++) {
+                    std::size_t length {0};
+                    for (std::size_t j = i; !visited[j]; j = rowPermutation[j]) {
+                        visited[j] = 1;
+                        length++;
+                    }
+                    if (length > 0 && length % 2 == 0) {
+                        sign = -sign;
+                    }
+                }
+
+                return thesoup::types::Result<SparseLUDecomposition<T>, numeric::ErrorCode>::success(
+                    SparseLUDecomposition<T> {
+                        numeric::types::SparseMatrix<T> {n, n, std::move(lowerTriplets)},
+                        numeric::types::SparseMatrix<T> {n, n, std::move(upperTriplets)},
+                        std::move(rowPermutation),
+                        sign
+                    }
+                );
+            }
+
+            /**
+             * \brief Solve A*x = b.
+             *
+             * \param b The right hand side.
+             *
+             * \return result:
+             *   Result<Vector<T>, ErrorCode> with the solution x.
+             *
+             *   Possible error codes:
+             *   - `INCOMPATIBLE_VECTORS`: If the dimension of b does not match the size of the system.
+             * */
+            thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode> solve(const numeric::types::Vector<T>& b) const {
+                const std::size_t n {size()};
+                if (b.size() != n) {
+                    return thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::INCOMPATIBLE_VECTORS);
+                }
+                numeric::types::Vector<T> x {n};
+                T* y {x.data()};
+                const T* src {b.data()};
+                for (std::size_t i = 0; i < n; i++) {
+                    y[i] = src[rowPermutation[i]];
+                }
+
+                // The rows of L and U are sorted by column, so the diagonal is the last element of a row of L, and the
+                // first of a row of U.
+                const std::vector<std::size_t>& lOffsets {lower.get_offsets()};
+                for (std::size_t i = 0; i < n; i++) {
+                    T acc {y[i]};
+                    for (std::size_t p = lOffsets[i]; p + 1 < lOffsets[i + 1]; p++) {
+                        acc = acc - lower.get_values()[p]*y[lower.get_indices()[p]];
+                    }
+                    y[i] = acc;
+                }
+                const std::vector<std::size_t>& uOffsets {upper.get_offsets()};
+                for (std::size_t i = n; i-- > 0;) {
+                    T acc {y[i]};
+                    for (std::size_t p = uOffsets[i] + 1; p < uOffsets[i + 1]; p++) {
+                        acc = acc - upper.get_values()[p]*y[upper.get_indices()[p]];
+                    }
+                    y[i] = acc/upper.get_values()[uOffsets[i]];
+                }
+                return thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode>::success(std::move(x));
+            }
+
+            /**
+             * \brief Determinant of the factored matrix.
+             * */
+            T determinant() const {
+                T det {static_cast<T>(permutationSign)};
+                for (std::size_t i = 0; i < size(); i++) {
+                    det = det*upper.get_values()[upper.get_offsets()[i]];
+                }
+                return det;
+            }
+
+            /**
+             * \brief Size (n) of the factored n x n system.
+             * */
+            std::size_t size() const {
+                return upper.getRows();
+            }
+
+            /**
+             * \brief The unit lower triangular factor L, with its diagonal.
+             * */
+            const numeric::types::SparseMatrix<T>& get_l() const {
+                return lower;
+            }
+
+            /**
+             * \brief The upper triangular factor U.
+             * */
+            const numeric::types::SparseMatrix<T>& get_u() const {
+                return upper;
+            }
+
+            /**
+             * \brief Row permutation P. Row i of P*A is row `get_row_permutation()[i]` of A.
+             * */
+            const std::vector<std::size_t>& get_row_permutation() const {
+                return rowPermutation;
+            }
+        };
+
+        /**
+         * \brief Function to solve a sparse system of linear equations.
+         *
+         * This is the sparse counterpart of `gauss_jordan`. The system A*x = b is given as the sparse matrix A and the
+         * right hand side b, rather than as an augmented matrix, and the solution is returned. The elimination is the one
+         * of `SparseLUDecomposition` (only the non zero elements are visited), followed by a sparse back substitution,
+         * which gives the same solution as reducing to RREF, with less work.
+         *
+         * The matrix needs at least as many rows (equations) as columns (variables). Equations that are combinations of
+         * the others are fine, as long as they are consistent.
+         *
+         * \param matrix The matrix A. It is left untouched.
+         *
+         * \param rhs The right hand side b.
+         *
+         * \param zero_precision Elements with an absolute value less than or equal to this are treated as 0.
+         *
+         * \return result:
+         *   Result<Vector<T>, ErrorCode> with the solution x.
+         *
+         *   Possible error codes:
+         *   - `INCOMPATIBLE_VECTORS`: If the dimension of b does not match the rows of A.
+         *   - `UNDERDETERMINED_SYSTEM`: If A has less equations than variables.
+         *   - `NO_SOLUTIONS`: If the equations are inconsistent.
+         *   - `INFINITE_SOLUTIONS`: If the equations are consistent, but some variables are free.
+         * */
+        template <typename T> thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode> sparse_gauss_jordan(
+            const numeric::types::SparseMatrix<T>& matrix,
+            const numeric::types::Vector<T>& rhs,
+            const double& zero_precision=0.0
+        ) {
+            if (rhs.size() != matrix.getRows()) {
+                return thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::INCOMPATIBLE_VECTORS);
+            }
+            if (matrix.getRows() < matrix.getCols()) {
+                return thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::UNDERDETERMINED_SYSTEM);
+            }
+            std::vector<T> b(rhs.data(), rhs.data() + rhs.size());
+            SparseElimination<T> elimination {matrix, zero_precision};
+            elimination.run(b.data());
+
+            // Rows that were never a pivot are now all zeros on the left. A non zero right hand side there is 0 = 1.
+            for (std::size_t i = 0; i < matrix.getRows(); i++) {
+                if (!elimination.get_pivoted()[i] && std::fabs(static_cast<double>(b[i])) > zero_precision && b[i] != static_cast<T>(0)) {
+                    return thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::NO_SOLUTIONS);
+                }
+            }
+            if (!elimination.freeColumns.empty()) {
+                return thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::INFINITE_SOLUTIONS);
+            }
+
+            // Back substitution, from the last pivot. Pivot k is in column k, as there are no free columns.
+            const std::size_t n {matrix.getCols()};
+            numeric::types::Vector<T> x {n};
+            T* dest {x.data()};
+            for (std::size_t k = n; k-- > 0;) {
+                const auto& row {elimination.get_rows()[elimination.pivotRows[k]]};
+                T acc {b[elimination.pivotRows[k]]};
+                for (std::size_t p = 1; p < row.size(); p++) {
+                    acc = acc - row[p].second*dest[row[p].first];
+                }
+                dest[k] = acc/row.front().second;
+            }
+            return thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode>::success(std::move(x));
+        }
+    }
+}
+
+#endif
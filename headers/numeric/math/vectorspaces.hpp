@@ -2,13 +2,18 @@
 #define __SIGABRT_NUMERIC_VECTORSPACES__
 
 #include <cmath>
+#include <cstddef>
 #include <functional>
+#include <type_traits>
 #include <vector>
 
+#include <numeric/benchmark/instrumentation.hpp>
 #include <numeric/types/vector.hpp>
+#include <numeric/types/smallvector.hpp>
 #include <numeric/types/plane.hpp>
 #include <numeric/types/models.hpp>
 #include <numeric/types/matrix.hpp>
+#include <numeric/types/matrixview.hpp>
 
 #include <numeric/math/rref.hpp>
 #include <numeric/math/errors.hpp>
@@ -84,6 +89,23 @@ namespace numeric {
                     numeric::ErrorCode::INCOMPATIBLE_VECTORS);
         }
 
+        /**
+         * \brief Function to compute cosine of angle between 2 small vectors.
+         * 
+         * Same as the above, but for `SmallVector`s. The dimensions are checked at compile time, so the cosine is returned
+         * directly.
+         * 
+         * \param v1 One of the vectors.
+         * 
+         * \param v2 The other vector.
+         * 
+         * \return double
+         * */
+        template<typename T, typename U, std::size_t N>
+        double cosine_angle(const numeric::types::SmallVector<T, N> &v1, const numeric::types::SmallVector<U, N> &v2) {
+            return static_cast<double>(v1 * v2) / std::sqrt(v1.mod() * v2.mod());
+        }
+
         /**
          * \brief Function to check if vector is normal to plane.
          * 
@@ -116,6 +138,25 @@ namespace numeric {
             return thesoup::types::Result<bool, numeric::ErrorCode>::failure(numeric::ErrorCode::INCOMPATIBLE_VECTORS);
         }
 
+        /**
+         * \brief Function to check if a small vector is normal to plane.
+         * 
+         * Same as the above, but for a `SmallVector<U, 3>`. The dimension is checked at compile time, so this returns the
+         * answer directly, and does not allocate.
+         * 
+         * \param plane The plane.
+         * 
+         * \param vec The vector.
+         * 
+         * \return bool
+         * */
+        template<typename T, typename U>
+        bool is_normal_to_plane(const numeric::types::Plane<T> &plane, const numeric::types::SmallVector<U, 3> &vec) {
+            const auto &normal = plane.get_small_normal();
+            double dot{static_cast<double>(normal * vec)};
+            return dot / std::sqrt(normal.mod() * vec.mod()) == 1.0;
+        }
+
         /**
          * \brief Function to compute cross product.
          * 
@@ -140,18 +181,18 @@ namespace numeric {
                 const numeric::types::Vector<U> &v2
         ) {
             if (v1.size() == 3 && v2.size() == 3) {
-                const T &a1{v1[0]};
-                const T &a2{v1[1]};
-                const T &a3{v1[2]};
+                const T &a1{v1.atUnchecked(0)};
+                const T &a2{v1.atUnchecked(1)};
+                const T &a3{v1.atUnchecked(2)};
 
-                const T &b1{v2[0]};
-                const T &b2{v2[1]};
-                const T &b3{v2[2]};
+                const T &b1{v2.atUnchecked(0)};
+                const T &b2{v2.atUnchecked(1)};
+                const T &b3{v2.atUnchecked(2)};
 
                 numeric::types::Vector<T> retval{3};
-                retval[0] = static_cast<T>(a2 * b3 - a3 * b2);
-                retval[1] = static_cast<T>(a3 * b1 - a1 * b3);
-                retval[2] = static_cast<T>(a1 * b2 - a2 * b1);
+                retval.atUnchecked(0) = static_cast<T>(a2 * b3 - a3 * b2);
+                retval.atUnchecked(1) = static_cast<T>(a3 * b1 - a1 * b3);
+                retval.atUnchecked(2) = static_cast<T>(a1 * b2 - a2 * b1);
 
                 return thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode>::success(
                         std::move(retval));
@@ -160,6 +201,29 @@ namespace numeric {
                     numeric::ErrorCode::INCOMPATIBLE_VECTORS);
         }
 
+        /**
+         * \brief Function to compute cross product of small vectors.
+         * 
+         * Same as the above, but for `SmallVector<T, 3>`. The dimensions are checked at compile time, so the product is
+         * returned directly, and does not allocate.
+         * 
+         * \param v1 One of the vectors.
+         * 
+         * \param v2 The other vector.
+         * 
+         * \return numeric::types::SmallVector<T, 3>
+         * */
+        template<typename T, typename U>
+        constexpr numeric::types::SmallVector<T, 3> cross(
+                const numeric::types::SmallVector<T, 3> &v1,
+                const numeric::types::SmallVector<U, 3> &v2
+        ) {
+            return numeric::types::SmallVector<T, 3> {
+                static_cast<T>(v1.atUnchecked(1) * v2.atUnchecked(2) - v1.atUnchecked(2) * v2.atUnchecked(1)),
+                static_cast<T>(v1.atUnchecked(2) * v2.atUnchecked(0) - v1.atUnchecked(0) * v2.atUnchecked(2)),
+                static_cast<T>(v1.atUnchecked(0) * v2.atUnchecked(1) - v1.atUnchecked(1) * v2.atUnchecked(0))
+            };
+        }
 
         /**
          * \brief Function to test linear indenendence of a ser of vectors.
@@ -175,6 +239,9 @@ namespace numeric {
          *   - The vectors are of different dimensions. (ErrorCode = `Sigabrt::Types::INCOMPATIBLE_VECTORS`)
          *   - If some other error happend (ErrorCode = `Sigabrt::Types::UNKNOWN_ERROR`)
          * 
+         * This reduces the whole system every time. To test vectors one at a time against a growing set, use
+         * `IncrementalBasis`.
+         * 
          * \param vectors A `std::vector` of `Sigabrt::Types::vector<T>`s
          * 
          * \return Sigabrt::Types::Result<bool, Sigabrt::Numeric::ErrorCode>
@@ -183,6 +250,7 @@ namespace numeric {
         template<typename T>
         thesoup::types::Result<bool, numeric::ErrorCode>
         linear_independence_of_system(const std::vector<std::reference_wrapper<numeric::types::Vector<T>>> &vectors) {
+            const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::LINEAR_INDEPENDENCE};
             // Linear independence of just one vector does not make any sense
             if (vectors.size() == 1) {
                 return thesoup::types::Result<bool, numeric::ErrorCode>::failure(
@@ -203,13 +271,13 @@ namespace numeric {
                 return thesoup::types::Result<bool, numeric::ErrorCode>::success(false);
             }
 
-            // Initialize the matrix
-            numeric::types::Matrix<T> mat{len, vectors.size()};
-            for (std::size_t i = 0; i < len; i++) {
-                for (std::size_t j = 0; j < vectors.size(); j++) {
-                    mat[i][j] = vectors[j].get()[i];
-                }
+            // The vectors are the rows of a view over their own storage, and the columns of the matrix to reduce. rref
+            // works in place, so the transpose is copied once, in a single pass.
+            std::vector<thesoup::types::Slice<T>> rows(vectors.size());
+            for (std::size_t j = 0; j < vectors.size(); j++) {
+                rows[j] = thesoup::types::Slice<T> {vectors[j].get().data(), len};
             }
+            numeric::types::Matrix<T> mat {numeric::types::ConstMatrixView<T> {rows.data(), vectors.size(), len}.transpose()};
 
             // Run it through RREF
             thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode> res{numeric::functions::rref(mat)};
@@ -229,6 +297,245 @@ namespace numeric {
                 return thesoup::types::Result<bool, numeric::ErrorCode>::success(true);
             }
         }
+
+
+        /**
+         * \class IncrementalBasis
+         *
+         * \tparam T The type of the vectors. Use a floating point type with a `zero_precision`, or an exact type like
+         * `Fraction` or `Rational`; with integers the eliminations truncate.
+         *
+         * \brief A growing set of linearly independent vectors, for testing new vectors against it one at a time.
+         *
+         * `linear_independence_of_system` reduces the whole system from scratch, which is O(k*n^2) for every vector
+         * tested against k others. This keeps the span of the vectors inserted so far as k rows in reduced echelon form
+         * instead: every row has a 1 in its pivot column and every other row a 0 there. The component of a new vector
+         * along row i is then just its element in the pivot column of row i, so testing it costs one pass over the rows,
+         * O(k*n), and so does inserting it (which eliminates its pivot column from the other rows).
+         *
+         * Next to the rows, the basis keeps how every row combines the inserted vectors (a k x k matrix), so a dependent
+         * vector is reported with its coefficients: `v = sum(coefficients[j] * (j-th inserted vector))`, where only the
+         * vectors that were accepted are counted. That costs another O(k^2) <= O(k*n) per vector.
+         *
+         * The new pivot is the largest element of the residual for floating point types, and the first non zero one
+         * otherwise, like `rref`.
+         * */
+        template <typename T> class IncrementalBasis {
+        private:
+            std::size_t dimension;
+            double zeroPrecision;
+            std::size_t nvectors;
+            // Reduced rows and their coefficients, both with a stride of `dimension` (rank <= dimension).
+            std::vector<T> rows;
+            std::vector<T> coefficients;
+            std::vector<std::size_t> pivots;
+            std::vector<T> lastCoefficients;
+
+            bool negligible(const T& val) const {
+                if (val == static_cast<T>(0)) {
+                    return true;
+                }
+                if constexpr (std::is_constructible<double, T>::value) {
+                    return zeroPrecision > 0.0 && std::fabs(static_cast<double>(val)) < zeroPrecision;
+                } else {
+                    return false;
+                }
+            }
+
+            // The residual of v after removing its components along the rows (the weights), in place.
+            void reduce(std::vector<T>& residual, std::vector<T>& weights) const {
+                const std::size_t k {pivots.size()};
+                weights.resize(k);
+                for (std::size_t i = 0; i < k; i++) {
+                    weights[i] = residual[pivots[i]];
+                }
+                for (std::size_t i = 0; i < k; i++) {
+                    const T& w {weights[i]};
+                    if (w == static_cast<T>(0)) {
+                        continue;
+                    }
+                    const T* row {rows.data() + i*dimension};
+                    for (std::size_t j = 0; j < dimension; j++) {
+                        residual[j] = residual[j] - w*row[j];
+                    }
+                }
+            }
+
+            // sum(weights[i] * coefficients of row i): the inserted vectors combined in the span part of v.
+            std::vector<T> combine(const std::vector<T>& weights) const {
+                std::vector<T> retval(nvectors, static_cast<T>(0));
+                for (std::size_t i = 0; i < weights.size(); i++) {
+                    const T& w {weights[i]};
+                    if (w == static_cast<T>(0)) {
+                        continue;
+                    }
+                    const T* coeff {coefficients.data() + i*dimension};
+                    for (std::size_t j = 0; j < nvectors; j++) {
+                        retval[j] = retval[j] + w*coeff[j];
+                    }
+                }
+                return retval;
+            }
+
+            std::size_t findPivot(const std::vector<T>& residual) const {
+                std::size_t retval {dimension};
+                for (std::size_t j = 0; j < dimension; j++) {
+                    if (negligible(residual[j])) {
+                        continue;
+                    }
+                    if constexpr (std::is_floating_point<T>::value) {
+                        if (retval == dimension || std::fabs(residual[j]) > std::fabs(residual[retval])) {
+                            retval = j;
+                        }
+                    } else {
+                        return j;
+                    }
+                }
+                return retval;
+            }
+
+        public:
+            /**
+             * \brief An empty basis for vectors of the given dimension.
+             *
+             * \param dimension The size of the vectors.
+             *
+             * \param zero_precision Elements of a residual with an absolute value less than this are treated as 0, as in
+             * `rref(matrix, zero_precision)`. The default only treats exact zeros as zero.
+             * */
+            explicit IncrementalBasis(const std::size_t& dimension, const double& zero_precision=0.0):
+                dimension {dimension}, zeroPrecision {zero_precision}, nvectors {0} {}
+
+            /**
+             * \brief The size of the vectors.
+             * */
+            std::size_t getDimension() const {
+                return dimension;
+            }
+
+            /**
+             * \brief The number of independent vectors inserted so far, which is the rank of the set.
+             * */
+            std::size_t rank() const {
+                return nvectors;
+            }
+
+            /**
+             * \brief The pivot column of every reduced row, in insertion order.
+             * */
+            const std::vector<std::size_t>& get_pivots() const {
+                return pivots;
+            }
+
+            /**
+             * \brief The coefficients of the last vector `insert` rejected as dependent, empty if the last one was added.
+             * */
+            const std::vector<T>& get_coefficients() const {
+                return lastCoefficients;
+            }
+
+            /**
+             * \brief Test a vector against the basis, without inserting it.
+             *
+             * \param vec The vector.
+             *
+             * \return Result<bool, ErrorCode> true if the vector is independent of the basis. Fails with
+             * `INCOMPATIBLE_VECTORS` if the vector has the wrong size.
+             * */
+            thesoup::types::Result<bool, numeric::ErrorCode> is_independent(const numeric::types::Vector<T>& vec) const {
+                if (vec.size() != dimension) {
+                    return thesoup::types::Result<bool, numeric::ErrorCode>::failure(numeric::ErrorCode::INCOMPATIBLE_VECTORS);
+                }
+                std::vector<T> residual(vec.begin(), vec.end());
+                std::vector<T> weights {};
+                reduce(residual, weights);
+                return thesoup::types::Result<bool, numeric::ErrorCode>::success(findPivot(residual) != dimension);
+            }
+
+            /**
+             * \brief Express a vector as a combination of the inserted vectors.
+             *
+             * \param vec The vector.
+             *
+             * \return Result<std::vector<T>, ErrorCode> One coefficient per accepted vector, in insertion order. Fails with
+             *   - `INCOMPATIBLE_VECTORS`: If the vector has the wrong size.
+             *   - `NO_SOLUTIONS`: If the vector is independent of the basis.
+             * */
+            thesoup::types::Result<std::vector<T>, numeric::ErrorCode> dependency(const numeric::types::Vector<T>& vec) const {
+                if (vec.size() != dimension) {
+                    return thesoup::types::Result<std::vector<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::INCOMPATIBLE_VECTORS);
+                }
+                std::vector<T> residual(vec.begin(), vec.end());
+                std::vector<T> weights {};
+                reduce(residual, weights);
+                if (findPivot(residual) != dimension) {
+                    return thesoup::types::Result<std::vector<T>, numeric::ErrorCode>::failure(numeric::ErrorCode::NO_SOLUTIONS);
+                }
+                return thesoup::types::Result<std::vector<T>, numeric::ErrorCode>::success(combine(weights));
+            }
+
+            /**
+             * \brief Insert a vector if it is independent of the basis.
+             *
+             * If it is dependent, it is not inserted, and `get_coefficients()` holds its coefficients, as returned by
+             * `dependency`.
+             *
+             * \param vec The vector.
+             *
+             * \return Result<bool, ErrorCode> true if the vector was independent, and is now part of the basis. Fails with
+             * `INCOMPATIBLE_VECTORS` if the vector has the wrong size.
+             * */
+            thesoup::types::Result<bool, numeric::ErrorCode> insert(const numeric::types::Vector<T>& vec) {
+                if (vec.size() != dimension) {
+                    return thesoup::types::Result<bool, numeric::ErrorCode>::failure(numeric::ErrorCode::INCOMPATIBLE_VECTORS);
+                }
+                std::vector<T> residual(vec.begin(), vec.end());
+                std::vector<T> weights {};
+                reduce(residual, weights);
+                const std::size_t pivot {findPivot(residual)};
+                if (pivot == dimension) {
+                    lastCoefficients = combine(weights);
+                    return thesoup::types::Result<bool, numeric::ErrorCode>::success(false);
+                }
+                lastCoefficients.clear();
+
+                // The new row is the normalized residual: vec minus the weighted rows, over the pivot.
+                const T inverse {static_cast<T>(1)/residual[pivot]};
+                for (std::size_t j = 0; j < dimension; j++) {
+                    residual[j] = negligible(residual[j])? static_cast<T>(0) : residual[j]*inverse;
+                }
+                residual[pivot] = static_cast<T>(1);
+                std::vector<T> coeff {combine(weights)};
+                coeff.resize(dimension, static_cast<T>(0));
+                for (std::size_t j = 0; j < nvectors; j++) {
+                    coeff[j] = -coeff[j]*inverse;
+                }
+                coeff[nvectors] = inverse;
+
+                // Eliminate the new pivot column from the other rows.
+                for (std::size_t i = 0; i < pivots.size(); i++) {
+                    T* row {rows.data() + i*dimension};
+                    const T factor {row[pivot]};
+                    if (factor == static_cast<T>(0)) {
+                        continue;
+                    }
+                    for (std::size_t j = 0; j < dimension; j++) {
+                        row[j] = row[j] - factor*residual[j];
+                    }
+                    row[pivot] = static_cast<T>(0);
+                    T* rowCoeff {coefficients.data() + i*dimension};
+                    for (std::size_t j = 0; j <= nvectors; j++) {
+                        rowCoeff[j] = rowCoeff[j] - factor*coeff[j];
+                    }
+                }
+
+                rows.insert(rows.end(), residual.begin(), residual.end());
+                coefficients.insert(coefficients.end(), coeff.begin(), coeff.end());
+                pivots.push_back(pivot);
+                nvectors++;
+                return thesoup::types::Result<bool, numeric::ErrorCode>::success(true);
+            }
+        };
     }
 }
 
@@ -0,0 +1,178 @@
+#ifndef __SIGABRT_NUMERIC_ARENA__
+#define __SIGABRT_NUMERIC_ARENA__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::memory
+     *
+     * \brief Sub namespace with the memory management used by the types.
+     * */
+    namespace memory {
+        /**
+         * \class Arena
+         *
+         * \brief A bump allocating `std::pmr::memory_resource`.
+         *
+         * Allocation moves a cursor forward inside a chunk of memory obtained from an upstream resource; when the chunk is
+         * full, a new chunk twice the size of the last one is obtained. Deallocation does nothing (except for the most recent
+         * allocation, which is rolled back, so that stack like temporaries do not pile up). All memory is given back at once,
+         * with `reset` or `release`, or when the arena is destroyed.
+         *
+         * The intended use is one arena per request (or per computation): pass it to the `Matrix` and `Vector` constructors,
+         * and `reset` it when the request is done. `reset` keeps the chunks, so after the first few requests no more calls
+         * reach the upstream resource at all.
+         *
+         * Every object allocated from the arena must be destroyed before `reset`, `release` or the destructor. The arena is
+         * not thread safe; use one per thread. If you need memory to be reused while the computation is still running, use a
+         * `std::pmr::unsynchronized_pool_resource` instead; it plugs into the same constructors.
+         * */
+        class Arena: public std::pmr::memory_resource {
+        private:
+            struct Chunk {
+                std::byte* start;
+                std::size_t size;
+            };
+
+            std::pmr::memory_resource* upstream;
+            std::size_t nextChunkSize;
+            std::vector<Chunk> chunks;
+            std::size_t current {0};
+            std::byte* cursor {nullptr};
+            std::byte* limit {nullptr};
+            std::byte* lastAllocation {nullptr};
+            std::size_t used {0};
+
+            static std::byte* alignUp(std::byte* ptr, const std::size_t& alignment) {
+                const std::uintptr_t value {reinterpret_cast<std::uintptr_t>(ptr)};
+                const std::uintptr_t aligned {(value + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1)};
+                return ptr + (aligned - value);
+            }
+
+            void useChunk(const std::size_t& index) {
+                current = index;
+                cursor = chunks[index].start;
+                limit = chunks[index].start + chunks[index].size;
+            }
+
+            bool fits(const std::size_t& bytes, const std::size_t& alignment) const {
+                if (cursor == nullptr) {
+                    return false;
+                }
+                std::byte* aligned {alignUp(cursor, alignment)};
+                return aligned <= limit && static_cast<std::size_t>(limit - aligned) >= bytes;
+            }
+
+        protected:
+            void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+                if (!fits(bytes, alignment)) {
+                    // Reuse the chunks kept by an earlier reset before going upstream.
+                    std::size_t next {cursor == nullptr? 0 : current + 1};
+                    while (next < chunks.size() && chunks[next].size < bytes + alignment) {
+                        next++;
+                    }
+                    if (next < chunks.size()) {
+                        useChunk(next);
+                    } else {
+                        const std::size_t size {std::max(nextChunkSize, bytes + alignment)};
+                        chunks.push_back(Chunk {static_cast<std::byte*>(upstream->allocate(size, alignof(std::max_align_t))), size});
+                        nextChunkSize = 2*size;
+                        useChunk(chunks.size() - 1);
+                    }
+                }
+                std::byte* ptr {alignUp(cursor, alignment)};
+                cursor = ptr + bytes;
+                used += bytes;
+                lastAllocation = ptr;
+                return ptr;
+            }
+
+            void do_deallocate(void* ptr, std::size_t bytes, std::size_t) override {
+                if (ptr == lastAllocation && static_cast<std::byte*>(ptr) + bytes == cursor) {
+                    cursor = lastAllocation;
+                    used -= bytes;
+                    lastAllocation = nullptr;
+                }
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+                return this == &other;
+            }
+
+        public:
+            /**
+             * \brief Constructor.
+             *
+             * \param initialChunkSize Size in bytes of the first chunk. No memory is obtained until the first allocation.
+             *
+             * \param upstream The resource chunks are obtained from. Defaults to plain new / delete.
+             * */
+            explicit Arena(
+                const std::size_t& initialChunkSize=64*1024,
+                std::pmr::memory_resource* upstream=std::pmr::new_delete_resource()
+            ): upstream {upstream}, nextChunkSize {std::max<std::size_t>(initialChunkSize, 64)} {}
+
+            Arena(const Arena& other)=delete;
+            void operator=(const Arena& other)=delete;
+
+            ~Arena() {
+                release();
+            }
+
+            /**
+             * \brief Free everything allocated so far, but keep the chunks for the following allocations.
+             * */
+            void reset() {
+                used = 0;
+                lastAllocation = nullptr;
+                if (chunks.empty()) {
+                    cursor = nullptr;
+                    limit = nullptr;
+                } else {
+                    useChunk(0);
+                }
+            }
+
+            /**
+             * \brief Free everything allocated so far, and give all chunks back to the upstream resource.
+             * */
+            void release() {
+                for (const Chunk& chunk : chunks) {
+                    upstream->deallocate(chunk.start, chunk.size, alignof(std::max_align_t));
+                }
+                chunks.clear();
+                reset();
+            }
+
+            /**
+             * \brief Bytes handed out since the last reset (excluding alignment padding).
+             * */
+            std::size_t bytes_used() const {
+                return used;
+            }
+
+            /**
+             * \brief Bytes currently held from the upstream resource.
+             * */
+            std::size_t bytes_reserved() const {
+                std::size_t total {0};
+                for (const Chunk& chunk : chunks) {
+                    total += chunk.size;
+                }
+                return total;
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef __SIGABRT_NUMERIC_BUFFER__
+#define __SIGABRT_NUMERIC_BUFFER__
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+#include <numeric/benchmark/instrumentation.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::memory
+     *
+     * \brief Sub namespace with the memory management used by the types.
+     * */
+    namespace memory {
+        /**
+         * \class ResourceDeleter
+         *
+         * \tparam T Element type.
+         *
+         * \brief Deleter for arrays allocated from a `std::pmr::memory_resource`.
+         *
+         * Destroys the elements and hands the block back to the resource it came from. It carries the resource and the
+         * element count, since `deallocate` needs both.
+         * */
+        template <typename T> struct ResourceDeleter {
+            std::pmr::memory_resource* resource {std::pmr::get_default_resource()};
+            std::size_t count {0};
+
+            void operator()(T* ptr) const {
+                if constexpr (!std::is_trivially_destructible<T>::value) {
+                    for (std::size_t i = 0; i < count; i++) {
+                        ptr[i].~T();
+                    }
+                }
+                resource->deallocate(ptr, count*sizeof(T), alignof(T));
+            }
+        };
+
+        /**
+         * \brief Owning pointer to an array allocated from a memory resource.
+         * */
+        template <typename T> using Buffer = std::unique_ptr<T[], ResourceDeleter<T>>;
+
+        /**
+         * \brief Allocate an array of `count` value initialized elements from a memory resource.
+         *
+         * This is the `std::make_unique<T[]>` of `Buffer`. A `count` of 0 yields a null buffer, and does not touch the
+         * resource, so never index into an empty buffer; use `get()` (and `get() + count`) for iterators.
+         *
+         * \param count Number of elements.
+         *
+         * \param resource The memory resource. Defaults to `std::pmr::get_default_resource()`, which is plain new / delete
+         * unless the application changed it.
+         *
+         * \return Buffer<T>
+         * */
+        template <typename T> Buffer<T> make_buffer(
+            const std::size_t& count,
+            std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+        ) {
+            if (count == 0) {
+                return Buffer<T> {nullptr, ResourceDeleter<T> {resource, 0}};
+            }
+            T* ptr {static_cast<T*>(resource->allocate(count*sizeof(T), alignof(T)))};
+            std::size_t constructed {0};
+            try {
+                for (; constructed < count; constructed++) {
+                    new (ptr + constructed) T();
+                }
+            } catch (...) {
+                for (std::size_t i = 0; i < constructed; i++) {
+                    ptr[i].~T();
+                }
+                resource->deallocate(ptr, count*sizeof(T), alignof(T));
+                throw;
+            }
+            numeric::benchmark::record_allocation(count*sizeof(T));
+            return Buffer<T> {ptr, ResourceDeleter<T> {resource, count}};
+        }
+    }
+}
+
+#endif
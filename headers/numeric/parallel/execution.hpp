@@ -0,0 +1,438 @@
+#ifndef __SIGABRT_NUMERIC_EXECUTION__
+#define __SIGABRT_NUMERIC_EXECUTION__
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+
+#include <numeric/kernels/gemm.hpp>
+#include <numeric/kernels/simd.hpp>
+#include <numeric/parallel/threadpool.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/vector.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::parallel
+     *
+     * \brief Sub namespace with the threading primitives used by the parallel algorithms.
+     * */
+    namespace parallel {
+        /**
+         * \brief Default amount of work (elements for element wise operations and reductions, multiply adds for products)
+         * below which the operations taking a `ParallelPolicy` run serially. Below this a wake up of the pool costs more
+         * than it saves.
+         * */
+        constexpr std::size_t PARALLEL_THRESHOLD {1 << 16};
+
+        /**
+         * \class ParallelPolicy
+         *
+         * \brief Execution policy for the `numeric::functions` overloads of the matrix and vector operators.
+         *
+         * This plays the role of `std::execution::par`, but carries the pool to run on, and the size threshold below which
+         * the operation stays on the calling thread. It is a cheap handle: create one per call with `par(pool)`, or keep
+         * one around. The pool has to outlive it.
+         *
+         * Like every job on a `ThreadPool`, operations on the same pool must not run concurrently from different threads.
+         * */
+        class ParallelPolicy {
+        private:
+            ThreadPool* pool;
+            std::size_t threshold;
+
+        public:
+            explicit ParallelPolicy(ThreadPool& pool, const std::size_t& threshold=PARALLEL_THRESHOLD):
+                pool {&pool}, threshold {threshold} {}
+
+            /**
+             * \brief The pool the operations run on.
+             * */
+            ThreadPool& get_pool() const {
+                return *pool;
+            }
+
+            /**
+             * \brief The amount of work below which operations run serially.
+             * */
+            std::size_t get_threshold() const {
+                return threshold;
+            }
+
+            /**
+             * \brief Whether an operation doing `work` units of work should be split between the threads.
+             * */
+            bool parallelize(const std::size_t& work) const {
+                return work >= threshold && pool->get_num_threads() > 1;
+            }
+        };
+
+        /**
+         * \brief Shorthand for `ParallelPolicy {pool, threshold}`: `add(par(pool), a, b)`.
+         * */
+        inline ParallelPolicy par(ThreadPool& pool, const std::size_t& threshold=PARALLEL_THRESHOLD) {
+            return ParallelPolicy {pool, threshold};
+        }
+    }
+
+    /**
+     * \namespace numeric::functions
+     *
+     * \brief Sub namespace with all numeric classes and functions.
+     * */
+    namespace functions {
+        //! \cond NO_DOC
+        namespace detail {
+            // Splits [0, length) into one contiguous range per thread and runs fn(part, begin, end) on each, so that the
+            // caller can keep per part results (partial sums) in a fixed order.
+            template <typename F> void forEachPart(
+                const numeric::parallel::ParallelPolicy& policy,
+                const std::size_t& length,
+                const std::size_t& parts,
+                const F& fn
+            ) {
+                const std::size_t partSize {(length + parts - 1)/parts};
+                policy.get_pool().parallel_for(0, parts, [&](const std::size_t& begin, const std::size_t& end) {
+                    for (std::size_t part = begin; part < end; part++) {
+                        const std::size_t first {std::min(length, part*partSize)};
+                        fn(part, first, std::min(length, first + partSize));
+                    }
+                });
+            }
+
+            template <typename T> void addRange(const T* a, const T* b, T* out, const std::size_t& n) {
+                if constexpr (numeric::kernels::HasSimdKernel<T>::value) {
+                    numeric::kernels::vector_kernels<T>().add(a, b, out, n);
+                } else {
+                    numeric::kernels::scalar::add(a, b, out, n);
+                }
+            }
+
+            template <typename T> void subRange(const T* a, const T* b, T* out, const std::size_t& n) {
+                if constexpr (numeric::kernels::HasSimdKernel<T>::value) {
+                    numeric::kernels::vector_kernels<T>().sub(a, b, out, n);
+                } else {
+                    numeric::kernels::scalar::sub(a, b, out, n);
+                }
+            }
+
+            template <typename T> void scaleRange(const T* a, const T& factor, T* out, const std::size_t& n) {
+                if constexpr (numeric::kernels::HasSimdKernel<T>::value) {
+                    numeric::kernels::vector_kernels<T>().scale(a, factor, out, n);
+                } else {
+                    numeric::kernels::scalar::scale(a, factor, out, n);
+                }
+            }
+
+            template <typename T> T dotRange(const T* a, const T* b, const std::size_t& n) {
+                if constexpr (numeric::kernels::HasSimdKernel<T>::value) {
+                    return numeric::kernels::vector_kernels<T>().dot(a, b, n);
+                } else {
+                    return numeric::kernels::scalar::dot(a, b, n);
+                }
+            }
+
+            // Element wise binary operation on matrices, split by rows.
+            template <typename T, typename Op> numeric::types::Matrix<T> elementWise(
+                const numeric::parallel::ParallelPolicy& policy,
+                const numeric::types::Matrix<T>& lhs,
+                const numeric::types::Matrix<T>& rhs,
+                const Op& op
+            ) {
+                if (lhs.getRows() != rhs.getRows() || lhs.getCols() != rhs.getCols()) {
+                    throw std::invalid_argument("Cannot combine matrices with different dimensions.");
+                }
+                numeric::types::Matrix<T> retval {lhs.getRows(), lhs.getCols(), lhs.get_resource()};
+                const std::size_t cols {lhs.getCols()};
+                policy.get_pool().parallel_for(0, lhs.getRows(), [&](const std::size_t& begin, const std::size_t& end) {
+                    for (std::size_t i = begin; i < end; i++) {
+                        op(lhs.rowPtr(i), rhs.rowPtr(i), retval.rowPtr(i), cols);
+                    }
+                });
+                return retval;
+            }
+
+            // Element wise binary operation on vectors, split in contiguous ranges.
+            template <typename T, typename Op> numeric::types::Vector<T> elementWise(
+                const numeric::parallel::ParallelPolicy& policy,
+                const numeric::types::Vector<T>& lhs,
+                const numeric::types::Vector<T>& rhs,
+                const Op& op
+            ) {
+                if (lhs.size() != rhs.size()) {
+                    throw std::invalid_argument("Cannot combine vectors with different dimensions.");
+                }
+                numeric::types::Vector<T> retval(lhs.size(), lhs.get_resource());
+                const T* a {lhs.data()};
+                const T* b {rhs.data()};
+                T* out {retval.data()};
+                policy.get_pool().parallel_for(0, lhs.size(), [&](const std::size_t& begin, const std::size_t& end) {
+                    op(a + begin, b + begin, out + begin, end - begin);
+                });
+                return retval;
+            }
+        }
+        //! \endcond
+
+        /**
+         * \brief Matrix addition with an execution policy. Same result as `Matrix<T> {lhs + rhs}`.
+         *
+         * \throw e std::invalid_argument if the dimensions are different.
+         * */
+        template <typename T> numeric::types::Matrix<T> add(
+            const numeric::parallel::ParallelPolicy& policy,
+            const numeric::types::Matrix<T>& lhs,
+            const numeric::types::Matrix<T>& rhs
+        ) {
+            if (!policy.parallelize(lhs.getRows()*lhs.getCols())) {
+                if (lhs.getRows() != rhs.getRows() || lhs.getCols() != rhs.getCols()) {
+                    throw std::invalid_argument("Cannot combine matrices with different dimensions.");
+                }
+                return numeric::types::Matrix<T> {lhs + rhs, lhs.get_resource()};
+            }
+            return detail::elementWise(policy, lhs, rhs, &detail::addRange<T>);
+        }
+
+        /**
+         * \brief Matrix subtraction with an execution policy. Same result as `Matrix<T> {lhs - rhs}`.
+         *
+         * \throw e std::invalid_argument if the dimensions are different.
+         * */
+        template <typename T> numeric::types::Matrix<T> subtract(
+            const numeric::parallel::ParallelPolicy& policy,
+            const numeric::types::Matrix<T>& lhs,
+            const numeric::types::Matrix<T>& rhs
+        ) {
+            if (!policy.parallelize(lhs.getRows()*lhs.getCols())) {
+                if (lhs.getRows() != rhs.getRows() || lhs.getCols() != rhs.getCols()) {
+                    throw std::invalid_argument("Cannot combine matrices with different dimensions.");
+                }
+                return numeric::types::Matrix<T> {lhs - rhs, lhs.get_resource()};
+            }
+            return detail::elementWise(policy, lhs, rhs, &detail::subRange<T>);
+        }
+
+        /**
+         * \brief Vector addition with an execution policy. Same result as `Vector<T> {lhs + rhs}`.
+         *
+         * \throw e std::invalid_argument if the dimensions are different.
+         * */
+        template <typename T> numeric::types::Vector<T> add(
+            const numeric::parallel::ParallelPolicy& policy,
+            const numeric::types::Vector<T>& lhs,
+            const numeric::types::Vector<T>& rhs
+        ) {
+            if (!policy.parallelize(lhs.size())) {
+                if (lhs.size() != rhs.size()) {
+                    throw std::invalid_argument("Cannot combine vectors with different dimensions.");
+                }
+                return numeric::types::Vector<T> {lhs + rhs, lhs.get_resource()};
+            }
+            return detail::elementWise(policy, lhs, rhs, &detail::addRange<T>);
+        }
+
+        /**
+         * \brief Vector subtraction with an execution policy. Same result as `Vector<T> {lhs - rhs}`.
+         *
+         * \throw e std::invalid_argument if the dimensions are different.
+         * */
+        template <typename T> numeric::types::Vector<T> subtract(
+            const numeric::parallel::ParallelPolicy& policy,
+            const numeric::types::Vector<T>& lhs,
+            const numeric::types::Vector<T>& rhs
+        ) {
+            if (!policy.parallelize(lhs.size())) {
+                if (lhs.size() != rhs.size()) {
+                    throw std::invalid_argument("Cannot combine vectors with different dimensions.");
+                }
+                return numeric::types::Vector<T> {lhs - rhs, lhs.get_resource()};
+            }
+            return detail::elementWise(policy, lhs, rhs, &detail::subRange<T>);
+        }
+
+        /**
+         * \brief Scale a matrix in place with an execution policy. Same result as `matrix.scale(scalar)`.
+         *
+         * \return Mutable reference to the matrix.
+         * */
+        template <typename T> numeric::types::Matrix<T>& scale(
+            const numeric::parallel::ParallelPolicy& policy,
+            numeric::types::Matrix<T>& matrix,
+            const T& scalar
+        ) {
+            if (!policy.parallelize(matrix.getRows()*matrix.getCols())) {
+                return matrix.scale(scalar);
+            }
+            const std::size_t cols {matrix.getCols()};
+            policy.get_pool().parallel_for(0, matrix.getRows(), [&](const std::size_t& begin, const std::size_t& end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    detail::scaleRange(matrix.rowPtr(i), scalar, matrix.rowPtr(i), cols);
+                }
+            });
+            return matrix;
+        }
+
+        /**
+         * \brief Matrix product with an execution policy. Same result as `lhs*rhs`.
+         *
+         * The rows of the result are split between the threads. For float and double, every thread runs the blocked GEMM
+         * engine on its block of rows of lhs, against the whole of rhs.
+         *
+         * \throw e std::invalid_argument if the dimensions do not match.
+         * */
+        template <typename T> numeric::types::Matrix<T> multiply(
+            const numeric::parallel::ParallelPolicy& policy,
+            const numeric::types::Matrix<T>& lhs,
+            const numeric::types::Matrix<T>& rhs
+        ) {
+            if (!policy.parallelize(lhs.getRows()*lhs.getCols()*rhs.getCols())) {
+                return lhs*rhs;
+            }
+            if (lhs.getCols() != rhs.getRows()) {
+                throw std::invalid_argument("Incompatible matrices for multiplication.");
+            }
+            numeric::types::Matrix<T> retval {lhs.getRows(), rhs.getCols(), lhs.get_resource()};
+            const std::size_t inner {lhs.getCols()};
+            const std::size_t cols {rhs.getCols()};
+            policy.get_pool().parallel_for(0, lhs.getRows(), [&](const std::size_t& begin, const std::size_t& end) {
+                if constexpr (numeric::kernels::HasGemmKernel<T>::value) {
+                    numeric::kernels::gemm(end - begin, cols, inner, lhs.begin() + begin, rhs.begin(), retval.begin() + begin);
+                } else {
+                    // Accumulate scaled rows of rhs, so that rhs is read row by row.
+                    for (std::size_t i = begin; i < end; i++) {
+                        const T* lhsRow {lhs.rowPtr(i)};
+                        T* dest {retval.rowPtr(i)};
+                        for (std::size_t j = 0; j < cols; j++) {
+                            dest[j] = static_cast<T>(0);
+                        }
+                        for (std::size_t k = 0; k < inner; k++) {
+                            const T factor {lhsRow[k]};
+                            const T* rhsRow {rhs.rowPtr(k)};
+                            for (std::size_t j = 0; j < cols; j++) {
+                                dest[j] += factor * rhsRow[j];
+                            }
+                        }
+                    }
+                }
+            });
+            return retval;
+        }
+
+        /**
+         * \brief Matrix * vector product with an execution policy. Same result as `lhs*rhs`.
+         *
+         * The rows of the matrix are split between the threads, and each result element is a dot product of a row.
+         *
+         * \throw e std::invalid_argument if the dimensions do not match.
+         * */
+        template <typename T> numeric::types::Vector<T> multiply(
+            const numeric::parallel::ParallelPolicy& policy,
+            const numeric::types::Matrix<T>& lhs,
+            const numeric::types::Vector<T>& rhs
+        ) {
+            if (!policy.parallelize(lhs.getRows()*lhs.getCols())) {
+                return lhs*rhs;
+            }
+            if (lhs.getCols() != rhs.size()) {
+                throw std::invalid_argument("Incompatible matrix and vector for multiplication.");
+            }
+            numeric::types::Vector<T> retval(lhs.getRows(), lhs.get_resource());
+            const T* src {rhs.data()};
+            T* dest {retval.data()};
+            policy.get_pool().parallel_for(0, lhs.getRows(), [&](const std::size_t& begin, const std::size_t& end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    dest[i] = detail::dotRange(lhs.rowPtr(i), src, lhs.getCols());
+                }
+            });
+            return retval;
+        }
+
+        /**
+         * \brief Vector * matrix product with an execution policy. Same result as `lhs*rhs`.
+         *
+         * Walking down the columns of the matrix would read it with a stride of a whole row. Instead the columns are split
+         * in one contiguous stripe per thread, and every thread accumulates the scaled rows of its stripe into its part of
+         * the result. The matrix is read row by row, every thread writes only its own part of the result, and there is no
+         * reduction at the end.
+         *
+         * \throw e std::invalid_argument if the dimensions do not match.
+         * */
+        template <typename T> numeric::types::Vector<T> multiply(
+            const numeric::parallel::ParallelPolicy& policy,
+            const numeric::types::Vector<T>& lhs,
+            const numeric::types::Matrix<T>& rhs
+        ) {
+            if (!policy.parallelize(rhs.getRows()*rhs.getCols())) {
+                return lhs*rhs;
+            }
+            if (lhs.size() != rhs.getRows()) {
+                throw std::invalid_argument("Incompatible matrix and vector for multiplication.");
+            }
+            numeric::types::Vector<T> retval(rhs.getCols(), lhs.get_resource());
+            const T* src {lhs.data()};
+            T* dest {retval.data()};
+            policy.get_pool().parallel_for(0, rhs.getCols(), [&](const std::size_t& begin, const std::size_t& end) {
+                for (std::size_t j = begin; j < end; j++) {
+                    dest[j] = static_cast<T>(0);
+                }
+                for (std::size_t k = 0; k < rhs.getRows(); k++) {
+                    const T* row {rhs.rowPtr(k)};
+                    const T factor {src[k]};
+                    for (std::size_t j = begin; j < end; j++) {
+                        dest[j] += row[j] * factor;
+                    }
+                }
+            });
+            return retval;
+        }
+
+        /**
+         * \brief Dot product with an execution policy. Same as `lhs*rhs`, up to the rounding of the sum.
+         *
+         * Every thread sums a contiguous range, and the partial sums are added in a fixed order, so the result only
+         * depends on the number of threads of the pool, not on the scheduling.
+         *
+         * \throw e std::invalid_argument if the dimensions are different.
+         * */
+        template <typename T> T dot(
+            const numeric::parallel::ParallelPolicy& policy,
+            const numeric::types::Vector<T>& lhs,
+            const numeric::types::Vector<T>& rhs
+        ) {
+            if (lhs.size() != rhs.size()) {
+                throw std::invalid_argument("Cannot compute dot product of vectors with different dimensions.");
+            }
+            if (!policy.parallelize(lhs.size())) {
+                return lhs*rhs;
+            }
+            const std::size_t parts {policy.get_pool().get_num_threads()};
+            std::vector<T> partials(parts, static_cast<T>(0));
+            const T* a {lhs.data()};
+            const T* b {rhs.data()};
+            detail::forEachPart(policy, lhs.size(), parts, [&](const std::size_t& part, const std::size_t& begin, const std::size_t& end) {
+                partials[part] = detail::dotRange(a + begin, b + begin, end - begin);
+            });
+            T sum {static_cast<T>(0)};
+            for (const T& partial : partials) {
+                sum += partial;
+            }
+            return sum;
+        }
+
+        /**
+         * \brief `Vector::mod` (the squared length) with an execution policy.
+         * */
+        template <typename T> double mod(const numeric::parallel::ParallelPolicy& policy, const numeric::types::Vector<T>& vec) {
+            return static_cast<double>(dot(policy, vec, vec));
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef __SIGABRT_NUMERIC_THREADPOOL__
+#define __SIGABRT_NUMERIC_THREADPOOL__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::parallel
+     *
+     * \brief Sub namespace with the threading primitives used by the parallel algorithms.
+     * */
+    namespace parallel {
+        /**
+         * \class ThreadPool
+         *
+         * \brief A fixed size fork-join thread pool.
+         *
+         * The pool owns `get_num_threads() - 1` worker threads; the thread calling `parallel_for` is the remaining one and
+         * takes part in the work. Workers are started once, in the constructor, and sleep on a condition variable between
+         * jobs, so a `parallel_for` costs a wake up rather than a thread creation. This matters for the pivot by pivot
+         * loops in the elimination algorithms, which issue one job per pivot.
+         *
+         * Jobs are not reentrant: do not call `parallel_for` from inside a job, or concurrently on the same pool from
+         * several threads. Like `Matrix`, the pool is neither copyable nor movable.
+         * */
+        class ThreadPool {
+        private:
+            std::vector<std::thread> workers;
+            std::mutex mutex;
+            std::condition_variable jobReady;
+            std::condition_variable jobDone;
+
+            std::function<void(std::size_t)> task;
+            std::size_t numChunks {0};
+            std::atomic<std::size_t> nextChunk {0};
+            std::size_t busyWorkers {0};
+            std::size_t generation {0};
+            bool stopping {false};
+            std::exception_ptr error;
+
+            void runChunks() {
+                for (std::size_t chunk = nextChunk.fetch_add(1); chunk < numChunks; chunk = nextChunk.fetch_add(1)) {
+                    try {
+                        task(chunk);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock {mutex};
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                    }
+                }
+            }
+
+            void workerLoop() {
+                std::size_t seen {0};
+                while (true) {
+                    {
+                        std::unique_lock<std::mutex> lock {mutex};
+                        jobReady.wait(lock, [&]() {return stopping || generation != seen;});
+                        if (stopping) {
+                            return;
+                        }
+                        seen = generation;
+                    }
+                    runChunks();
+                    {
+                        std::lock_guard<std::mutex> lock {mutex};
+                        busyWorkers--;
+                    }
+                    jobDone.notify_one();
+                }
+            }
+
+        public:
+            /**
+             * \brief Constructor.
+             *
+             * \param numThreads Total number of threads that run a job, including the calling thread. 0 means one per
+             * hardware thread. 1 means that every job runs inline on the calling thread.
+             * */
+            explicit ThreadPool(const std::size_t& numThreads=0) {
+                std::size_t total {numThreads};
+                if (total == 0) {
+                    total = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+                }
+                workers.reserve(total - 1);
+                for (std::size_t i = 1; i < total; i++) {
+                    workers.emplace_back([this]() {workerLoop();});
+                }
+            }
+
+            ThreadPool(const ThreadPool& other)=delete;
+            void operator=(const ThreadPool& other)=delete;
+
+            ~ThreadPool() {
+                {
+                    std::lock_guard<std::mutex> lock {mutex};
+                    stopping = true;
+                }
+                jobReady.notify_all();
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+            }
+
+            /**
+             * \brief Number of threads taking part in a job, including the caller.
+             * */
+            std::size_t get_num_threads() const {
+                return workers.size() + 1;
+            }
+
+            /**
+             * \brief Run `fn` over the range [begin, end), split into contiguous chunks, and wait for all of them.
+             *
+             * `fn` is called as `fn(chunkBegin, chunkEnd)` once per chunk, possibly concurrently from different threads.
+             * Chunks are at least `grain` long (except the last one), and there are at most as many as threads. If `fn`
+             * throws, the remaining chunks still run, and the first exception is rethrown here.
+             *
+             * \param begin Start of the range.
+             *
+             * \param end End of the range (exclusive).
+             *
+             * \param fn The callable.
+             *
+             * \param grain Minimum chunk length. Use this to keep tiny ranges on fewer threads.
+             * */
+            template <typename F> void parallel_for(
+                const std::size_t& begin,
+                const std::size_t& end,
+                const F& fn,
+                const std::size_t& grain=1
+            ) {
+                if (end <= begin) {
+                    return;
+                }
+                const std::size_t length {end - begin};
+                const std::size_t clampedGrain {std::max<std::size_t>(grain, 1)};
+                const std::size_t maxChunks {(length + clampedGrain - 1)/clampedGrain};
+                const std::size_t chunks {std::min(maxChunks, get_num_threads())};
+                if (chunks <= 1) {
+                    fn(begin, end);
+                    return;
+                }
+                const std::size_t chunkSize {(length + chunks - 1)/chunks};
+
+                {
+                    std::lock_guard<std::mutex> lock {mutex};
+                    task = [&](const std::size_t& chunk) {
+                        const std::size_t chunkBegin {begin + chunk*chunkSize};
+                        const std::size_t chunkEnd {std::min(end, chunkBegin + chunkSize)};
+                        if (chunkBegin < chunkEnd) {
+                            fn(chunkBegin, chunkEnd);
+                        }
+                    };
+                    numChunks = chunks;
+                    nextChunk.store(0);
+                    busyWorkers = workers.size();
+                    error = nullptr;
+                    generation++;
+                }
+                jobReady.notify_all();
+                runChunks();
+
+                std::exception_ptr failure;
+                {
+                    std::unique_lock<std::mutex> lock {mutex};
+                    jobDone.wait(lock, [&]() {return busyWorkers == 0;});
+                    task = nullptr;
+                    failure = error;
+                }
+                if (failure) {
+                    std::rethrow_exception(failure);
+                }
+            }
+        };
+    }
+}
+
+#endif
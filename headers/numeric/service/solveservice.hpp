@@ -0,0 +1,353 @@
+#ifndef __SIGABRT_NUMERIC_SOLVESERVICE__
+#define __SIGABRT_NUMERIC_SOLVESERVICE__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <numeric/math/batched.hpp>
+#include <numeric/math/errors.hpp>
+#include <numeric/math/gaussjordan.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/models.hpp>
+#include <numeric/types/systembatch.hpp>
+#include <numeric/types/vector.hpp>
+
+#include <thesoup/types/types.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::service
+     *
+     * \brief Sub namespace with the long running services built on the solvers.
+     * */
+    namespace service {
+        /**
+         * \class SolveServiceOptions
+         *
+         * \brief The configuration of a `SolveService`.
+         *
+         * \var numThreads The number of worker threads. 0 means one per hardware thread.
+         *
+         * \var maxBatch The largest number of systems solved as one batch.
+         *
+         * \var batchElements Systems with at most this many elements (rows * columns of the augmented matrix) are
+         * coalesced into batches. Larger systems are solved one at a time with `gauss_jordan`. Batching only applies to
+         * float and double systems.
+         *
+         * \var zeroPrecision The zero precision of the solvers. 0 only treats exact zeros as zero.
+         * */
+        struct SolveServiceOptions {
+            std::size_t numThreads {0};
+            std::size_t maxBatch {1024};
+            std::size_t batchElements {64};
+            double zeroPrecision {0.0};
+        };
+
+        /**
+         * \class SolveService
+         *
+         * \tparam T Element type of the systems.
+         *
+         * \brief Asynchronous solver of systems of linear equations, on a fixed set of worker threads.
+         *
+         * `submit` queues an augmented system and returns a `std::future` of its solution right away. The workers take
+         * the queued systems in order. When a worker takes a small system (see `SolveServiceOptions::batchElements`), it
+         * also takes every queued system of the same shape, up to `maxBatch`, and solves them together with
+         * `batched_gauss_jordan`. Batches are made of what is already waiting: a worker never holds a system back to
+         * wait for more, so a lone request is solved as soon as a worker is free, and a burst is absorbed in a few large
+         * batches instead of a long queue of single solves.
+         *
+         * The results are the ones of `gauss_jordan` (for single systems) or `batched_gauss_jordan` (for batches): the
+         * solution vector, or the error code. Both pivot differently, so the last bits of a floating point solution
+         * depend on whether the system was batched. For integral types, `gauss_jordan` leaves the rows scaled by their
+         * pivots, and the solution is the last column divided by them; a system whose solution is not integral fails with
+         * `NON_INTEGRAL_SOLUTION`. If a solver throws, the exception is delivered through the future.
+         *
+         * The destructor solves every queued system before joining the workers. Like `ThreadPool`, the service is
+         * neither copyable nor movable. `submit` may be called concurrently from any number of threads.
+         * */
+        template <typename T> class SolveService {
+        public:
+            using SolveResult = thesoup::types::Result<numeric::types::Vector<T>, numeric::ErrorCode>;
+
+        private:
+            struct Request {
+                numeric::types::Matrix<T> system;
+                std::promise<SolveResult> promise;
+            };
+
+            SolveServiceOptions options;
+            std::mutex mutex;
+            std::condition_variable requestReady;
+            std::list<Request> pending;
+            bool stopping {false};
+            std::atomic<std::size_t> batches {0};
+            std::atomic<std::size_t> solved {0};
+            std::vector<std::thread> workers;
+
+            bool batchable(const numeric::types::Matrix<T>& system) const {
+                return std::is_floating_point<T>::value && options.maxBatch > 1 &&
+                    system.getRows()*system.getCols() <= options.batchElements;
+            }
+
+            // Takes the first queued system, and with a small one, the queued systems of the same shape. Called with the
+            // lock held, and a non empty queue. Uses splice, since the systems can not be move assigned.
+            std::list<Request> takeWork() {
+                std::list<Request> work;
+                work.splice(work.end(), pending, pending.begin());
+                const numeric::types::Matrix<T>& first {work.front().system};
+                if (!batchable(first)) {
+                    return work;
+                }
+                for (auto it = pending.begin(); it != pending.end() && work.size() < options.maxBatch;) {
+                    auto next {std::next(it)};
+                    if (it->system.getRows() == first.getRows() && it->system.getCols() == first.getCols()) {
+                        work.splice(work.end(), pending, it);
+                    }
+                    it = next;
+                }
+                return work;
+            }
+
+            // Integers are exact, so the zero precision does not apply to them; gauss_jordan with one would not even
+            // compile for BigInt.
+            thesoup::types::Result<thesoup::types::Unit, numeric::ErrorCode> reduce(numeric::types::Matrix<T>& system) const {
+                if constexpr (numeric::types::ScalarFamilyOf<T>::value == numeric::types::ScalarFamily::INTEGER) {
+                    return numeric::functions::gauss_jordan(system);
+                } else {
+                    return options.zeroPrecision > 0.0 ?
+                        numeric::functions::gauss_jordan(system, options.zeroPrecision) :
+                        numeric::functions::gauss_jordan(system);
+                }
+            }
+
+            void solveOne(Request& request) {
+                numeric::types::Matrix<T>& system {request.system};
+                auto status {reduce(system)};
+                if (!status) {
+                    request.promise.set_value(SolveResult::failure(status.error()));
+                    return;
+                }
+                const std::size_t vars {system.getCols() - 1};
+                numeric::types::Vector<T> solution {vars};
+                for (std::size_t i = 0; i < vars; i++) {
+                    if constexpr (numeric::types::ScalarFamilyOf<T>::value == numeric::types::ScalarFamily::INTEGER) {
+                        const T pivot {system[i][i]};
+                        if (system[i][vars] % pivot != static_cast<T>(0)) {
+                            request.promise.set_value(SolveResult::failure(numeric::ErrorCode::NON_INTEGRAL_SOLUTION));
+                            return;
+                        }
+                        solution[i] = system[i][vars]/pivot;
+                    } else {
+                        solution[i] = system[i][vars];
+                    }
+                }
+                request.promise.set_value(SolveResult::success(std::move(solution)));
+            }
+
+            void solveBatch(std::list<Request>& work) {
+                if constexpr (std::is_floating_point<T>::value) {
+                    const std::size_t rows {work.front().system.getRows()};
+                    const std::size_t cols {work.front().system.getCols()};
+                    numeric::types::SystemBatch<T> batch {work.size(), rows, cols};
+                    std::size_t s {0};
+                    for (const Request& request : work) {
+                        for (std::size_t i = 0; i < rows; i++) {
+                            const T* row {request.system.rowPtr(i)};
+                            for (std::size_t j = 0; j < cols; j++) {
+                                batch.lanes(i, j)[s] = row[j];
+                            }
+                        }
+                        s++;
+                    }
+                    const std::vector<std::optional<numeric::ErrorCode>> status {
+                        numeric::functions::batched_gauss_jordan(batch, options.zeroPrecision)
+                    };
+                    s = 0;
+                    for (Request& request : work) {
+                        if (status[s]) {
+                            request.promise.set_value(SolveResult::failure(*status[s]));
+                        } else {
+                            numeric::types::Vector<T> solution {cols - 1};
+                            for (std::size_t var = 0; var < cols - 1; var++) {
+                                solution[var] = batch.solutionLanes(var)[s];
+                            }
+                            request.promise.set_value(SolveResult::success(std::move(solution)));
+                        }
+                        s++;
+                    }
+                }
+            }
+
+            void solve(std::list<Request>& work) {
+                // Counted before the futures are ready, so that a caller that got all its results sees them counted.
+                solved.fetch_add(work.size(), std::memory_order_relaxed);
+                if (work.size() > 1) {
+                    batches.fetch_add(1, std::memory_order_relaxed);
+                }
+                try {
+                    if (work.size() > 1) {
+                        solveBatch(work);
+                    } else {
+                        solveOne(work.front());
+                    }
+                } catch (...) {
+                    // The promises that were fulfilled before the failure keep their value.
+                    for (Request& request : work) {
+                        try {
+                            request.promise.set_exception(std::current_exception());
+                        } catch (const std::future_error&) {
+                        }
+                    }
+                }
+            }
+
+            void workerLoop() {
+                while (true) {
+                    std::list<Request> work;
+                    {
+                        std::unique_lock<std::mutex> lock {mutex};
+                        requestReady.wait(lock, [this]() {return stopping || !pending.empty();});
+                        if (pending.empty()) {
+                            return;
+                        }
+                        work = takeWork();
+                    }
+                    solve(work);
+                }
+            }
+
+        public:
+            /**
+             * \brief Starts the workers.
+             * */
+            explicit SolveService(const SolveServiceOptions& options=SolveServiceOptions {}): options {options} {
+                std::size_t total {options.numThreads};
+                if (total == 0) {
+                    total = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+                }
+                workers.reserve(total);
+                for (std::size_t i = 0; i < total; i++) {
+                    workers.emplace_back([this]() {workerLoop();});
+                }
+            }
+
+            SolveService(const SolveService<T>& other)=delete;
+            void operator=(const SolveService<T>& other)=delete;
+
+            /**
+             * \brief Solves the queued systems, and stops the workers.
+             * */
+            ~SolveService() {
+                {
+                    std::lock_guard<std::mutex> lock {mutex};
+                    stopping = true;
+                }
+                requestReady.notify_all();
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+            }
+
+            /**
+             * \brief Queue a system for solving.
+             *
+             * \param system The augmented matrix of the system. The service takes it over, and reduces it in place.
+             *
+             * \return std::future<Result<Vector<T>, ErrorCode>> The solution, with the error codes of `gauss_jordan`:
+             *   - `UNDERDETERMINED_SYSTEM`: If the system has less equations than variables.
+             *   - `NO_SOLUTIONS`: If the equations are inconsistent.
+             *   - `INFINITE_SOLUTIONS`: If the equations are consistent, but some variables are free.
+             *
+             * \throw e std::invalid_argument if the system has no right hand side column.
+             * */
+            std::future<SolveResult> submit(numeric::types::Matrix<T>&& system) {
+                if (system.getCols() == 0) {
+                    throw std::invalid_argument("An augmented system needs at least the right hand side column.");
+                }
+                std::list<Request> requests;
+                requests.push_back(Request {std::move(system), std::promise<SolveResult> {}});
+                std::future<SolveResult> future {requests.back().promise.get_future()};
+                {
+                    std::lock_guard<std::mutex> lock {mutex};
+                    pending.splice(pending.end(), requests);
+                }
+                requestReady.notify_one();
+                return future;
+            }
+
+            /**
+             * \brief Queue many systems at once.
+             *
+             * The systems are queued together, under one lock, so systems of the same small shape end up in the same
+             * batches.
+             *
+             * \return One future per system, in the same order.
+             *
+             * \throw e std::invalid_argument if a system has no right hand side column. Then no system is queued, and
+             * `systems` is left as it was.
+             * */
+            std::vector<std::future<SolveResult>> submit(std::vector<numeric::types::Matrix<T>>&& systems) {
+                for (const numeric::types::Matrix<T>& system : systems) {
+                    if (system.getCols() == 0) {
+                        throw std::invalid_argument("An augmented system needs at least the right hand side column.");
+                    }
+                }
+                std::list<Request> requests;
+                std::vector<std::future<SolveResult>> futures;
+                futures.reserve(systems.size());
+                for (numeric::types::Matrix<T>& system : systems) {
+                    requests.push_back(Request {std::move(system), std::promise<SolveResult> {}});
+                    futures.push_back(requests.back().promise.get_future());
+                }
+                systems.clear();
+                {
+                    std::lock_guard<std::mutex> lock {mutex};
+                    pending.splice(pending.end(), requests);
+                }
+                requestReady.notify_all();
+                return futures;
+            }
+
+            /**
+             * \brief The number of worker threads.
+             * */
+            std::size_t get_num_threads() const {
+                return workers.size();
+            }
+
+            /**
+             * \brief The number of systems handed to the solvers so far.
+             * */
+            std::size_t get_solved() const {
+                return solved.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * \brief The number of batches (of more than one system) handed to the solvers so far.
+             * */
+            std::size_t get_batches() const {
+                return batches.load(std::memory_order_relaxed);
+            }
+        };
+    }
+}
+
+#endif
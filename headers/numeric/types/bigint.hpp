@@ -0,0 +1,528 @@
+#ifndef __SIGABRT_NUMERIC_BIGINT__
+#define __SIGABRT_NUMERIC_BIGINT__
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::types
+     *
+     * \brief The namespace containing some special types.
+     * */
+    namespace types {
+        /**
+         * \class BigInt
+         *
+         * \brief An arbitrary precision signed integer, which stays in a machine word while it can.
+         *
+         * Values that fit in a `long` are stored in one, inline, and the arithmetic on them is plain `long` arithmetic
+         * with an overflow check (no heap, no loops). Only a result which would overflow is promoted to the big
+         * representation: a sign and a vector of 32 bit limbs. Big results that fit in a `long` again are demoted, so
+         * the fast path is taken again as soon as possible.
+         *
+         * This is meant as the backing integer of `Rational`, for exact elimination on matrices where `long` numerators
+         * and denominators overflow. Division (`/` and `%`) truncates towards 0, like the built in integers.
+         * */
+        class BigInt {
+        private:
+            using Magnitude = std::vector<std::uint32_t>;
+
+            // The value while `limbs` is empty.
+            long small {0};
+            // Sign and magnitude (little endian, no leading zero limbs) of the value otherwise.
+            bool negative {false};
+            Magnitude limbs;
+
+            static constexpr std::uint64_t BASE {1ULL << 32};
+
+            static Magnitude toMagnitude(std::uint64_t value) {
+                Magnitude retval;
+                while (value != 0) {
+                    retval.push_back(static_cast<std::uint32_t>(value));
+                    value >>= 32;
+                }
+                return retval;
+            }
+
+            static std::uint64_t smallMagnitude(const long& value) {
+                return value < 0? 0ULL - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+            }
+
+            static void trim(Magnitude& mag) {
+                while (!mag.empty() && mag.back() == 0) {
+                    mag.pop_back();
+                }
+            }
+
+            static int compareMagnitudes(const Magnitude& a, const Magnitude& b) {
+                if (a.size() != b.size()) {
+                    return a.size() < b.size()? -1 : 1;
+                }
+                for (std::size_t i = a.size(); i > 0; i--) {
+                    if (a[i - 1] != b[i - 1]) {
+                        return a[i - 1] < b[i - 1]? -1 : 1;
+                    }
+                }
+                return 0;
+            }
+
+            static Magnitude addMagnitudes(const Magnitude& a, const Magnitude& b) {
+                const Magnitude& longer {a.size() >= b.size()? a : b};
+                const Magnitude& shorter {a.size() >= b.size()? b : a};
+                Magnitude retval(longer.size() + 1);
+                std::uint64_t carry {0};
+                for (std::size_t i = 0; i < longer.size(); i++) {
+                    const std::uint64_t sum {static_cast<std::uint64_t>(longer[i]) + (i < shorter.size()? shorter[i] : 0) + carry};
+                    retval[i] = static_cast<std::uint32_t>(sum);
+                    carry = sum >> 32;
+                }
+                retval[longer.size()] = static_cast<std::uint32_t>(carry);
+                trim(retval);
+                return retval;
+            }
+
+            // a - b, where |a| >= |b|.
+            static Magnitude subtractMagnitudes(const Magnitude& a, const Magnitude& b) {
+                Magnitude retval(a.size());
+                std::int64_t borrow {0};
+                for (std::size_t i = 0; i < a.size(); i++) {
+                    std::int64_t diff {static_cast<std::int64_t>(a[i]) - (i < b.size()? static_cast<std::int64_t>(b[i]) : 0) - borrow};
+                    borrow = diff < 0? 1 : 0;
+                    retval[i] = static_cast<std::uint32_t>(diff + (borrow << 32));
+                }
+                trim(retval);
+                return retval;
+            }
+
+            static Magnitude multiplyMagnitudes(const Magnitude& a, const Magnitude& b) {
+                if (a.empty() || b.empty()) {
+                    return Magnitude {};
+                }
+                Magnitude retval(a.size() + b.size());
+                for (std::size_t i = 0; i < a.size(); i++) {
+                    std::uint64_t carry {0};
+                    for (std::size_t j = 0; j < b.size(); j++) {
+                        const std::uint64_t cur {static_cast<std::uint64_t>(a[i])*b[j] + retval[i + j] + carry};
+                        retval[i + j] = static_cast<std::uint32_t>(cur);
+                        carry = cur >> 32;
+                    }
+                    retval[i + b.size()] = static_cast<std::uint32_t>(carry);
+                }
+                trim(retval);
+                return retval;
+            }
+
+            // Long division (Knuth, TAOCP 4.3.1, algorithm D). `v` must not be empty.
+            static void divideMagnitudes(const Magnitude& u, const Magnitude& v, Magnitude& quotient, Magnitude& remainder) {
+                if (compareMagnitudes(u, v) < 0) {
+                    quotient.clear();
+                    remainder = u;
+                    return;
+                }
+                if (v.size() == 1) {
+                    quotient.assign(u.size(), 0);
+                    std::uint64_t rem {0};
+                    for (std::size_t i = u.size(); i > 0; i--) {
+                        const std::uint64_t cur {(rem << 32) | u[i - 1]};
+                        quotient[i - 1] = static_cast<std::uint32_t>(cur/v[0]);
+                        rem = cur % v[0];
+                    }
+                    trim(quotient);
+                    remainder = toMagnitude(rem);
+                    return;
+                }
+
+                // Normalize, so that the top limb of the divisor has its high bit set.
+                const std::size_t n {v.size()};
+                const std::size_t m {u.size()};
+                const int shift {__builtin_clz(v.back())};
+                Magnitude vn(n);
+                Magnitude un(m + 1);
+                for (std::size_t i = n - 1; i > 0; i--) {
+                    vn[i] = static_cast<std::uint32_t>((static_cast<std::uint64_t>(v[i]) << shift) | (static_cast<std::uint64_t>(v[i - 1]) >> (32 - shift)));
+                }
+                vn[0] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(v[0]) << shift);
+                un[m] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(u[m - 1]) >> (32 - shift));
+                for (std::size_t i = m - 1; i > 0; i--) {
+                    un[i] = static_cast<std::uint32_t>((static_cast<std::uint64_t>(u[i]) << shift) | (static_cast<std::uint64_t>(u[i - 1]) >> (32 - shift)));
+                }
+                un[0] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(u[0]) << shift);
+
+                quotient.assign(m - n + 1, 0);
+                for (std::size_t j = m - n + 1; j > 0; j--) {
+                    const std::size_t k {j - 1};
+                    const std::uint64_t top {(static_cast<std::uint64_t>(un[k + n]) << 32) | un[k + n - 1]};
+                    std::uint64_t qhat {top/vn[n - 1]};
+                    std::uint64_t rhat {top % vn[n - 1]};
+                    while (qhat >= BASE || qhat*vn[n - 2] > ((rhat << 32) | un[k + n - 2])) {
+                        qhat--;
+                        rhat += vn[n - 1];
+                        if (rhat >= BASE) {
+                            break;
+                        }
+                    }
+
+                    // Multiply and subtract.
+                    std::int64_t borrow {0};
+                    std::uint64_t carry {0};
+                    for (std::size_t i = 0; i < n; i++) {
+                        const std::uint64_t product {qhat*vn[i] + carry};
+                        carry = product >> 32;
+                        const std::int64_t diff {static_cast<std::int64_t>(un[i + k]) - borrow - static_cast<std::int64_t>(product & 0xFFFFFFFFULL)};
+                        borrow = diff < 0? 1 : 0;
+                        un[i + k] = static_cast<std::uint32_t>(diff + (borrow << 32));
+                    }
+                    const std::int64_t diff {static_cast<std::int64_t>(un[k + n]) - borrow - static_cast<std::int64_t>(carry)};
+                    un[k + n] = static_cast<std::uint32_t>(diff);
+                    quotient[k] = static_cast<std::uint32_t>(qhat);
+
+                    // qhat was one too large (rare): add the divisor back.
+                    if (diff < 0) {
+                        quotient[k]--;
+                        std::uint64_t addCarry {0};
+                        for (std::size_t i = 0; i < n; i++) {
+                            const std::uint64_t sum {static_cast<std::uint64_t>(un[i + k]) + vn[i] + addCarry};
+                            un[i + k] = static_cast<std::uint32_t>(sum);
+                            addCarry = sum >> 32;
+                        }
+                        un[k + n] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(un[k + n]) + addCarry);
+                    }
+                }
+                trim(quotient);
+
+                // Undo the normalization on the remainder.
+                remainder.assign(n, 0);
+                for (std::size_t i = 0; i < n; i++) {
+                    remainder[i] = static_cast<std::uint32_t>(
+                        (static_cast<std::uint64_t>(un[i]) >> shift) | (static_cast<std::uint64_t>(un[i + 1]) << (32 - shift))
+                    );
+                }
+                trim(remainder);
+            }
+
+            Magnitude magnitude() const {
+                return limbs.empty()? toMagnitude(smallMagnitude(small)) : limbs;
+            }
+
+            bool isNegative() const {
+                return limbs.empty()? small < 0 : negative;
+            }
+
+            static BigInt fromMagnitude(Magnitude&& mag, const bool& negative) {
+                BigInt retval;
+                if (mag.size() <= 2) {
+                    // Demote to a machine word if it fits.
+                    std::uint64_t value {0};
+                    for (std::size_t i = mag.size(); i > 0; i--) {
+                        value = (value << 32) | mag[i - 1];
+                    }
+                    if (!negative && value <= static_cast<std::uint64_t>(LONG_MAX)) {
+                        retval.small = static_cast<long>(value);
+                        return retval;
+                    }
+                    if (negative && value <= static_cast<std::uint64_t>(LONG_MAX) + 1) {
+                        retval.small = value == static_cast<std::uint64_t>(LONG_MAX) + 1? LONG_MIN : -static_cast<long>(value);
+                        return retval;
+                    }
+                }
+                retval.negative = negative;
+                retval.limbs = std::move(mag);
+                return retval;
+            }
+
+            static BigInt addSigned(const BigInt& lhs, const BigInt& rhs, const bool& negateRhs) {
+                const bool lhsNegative {lhs.isNegative()};
+                const bool rhsNegative {rhs.isNegative() != negateRhs && !rhs.is_zero()};
+                const Magnitude a {lhs.magnitude()};
+                const Magnitude b {rhs.magnitude()};
+                if (lhsNegative == rhsNegative) {
+                    return fromMagnitude(addMagnitudes(a, b), lhsNegative);
+                }
+                if (compareMagnitudes(a, b) >= 0) {
+                    return fromMagnitude(subtractMagnitudes(a, b), lhsNegative);
+                }
+                return fromMagnitude(subtractMagnitudes(b, a), rhsNegative);
+            }
+
+            static void divide(const BigInt& lhs, const BigInt& rhs, BigInt* quotient, BigInt* remainder) {
+                if (rhs.is_zero()) {
+                    throw std::invalid_argument("Attempt to divide by 0.");
+                }
+                if (lhs.limbs.empty() && rhs.limbs.empty() && !(lhs.small == LONG_MIN && rhs.small == -1)) {
+                    if (quotient != nullptr) {
+                        *quotient = BigInt {lhs.small/rhs.small};
+                    }
+                    if (remainder != nullptr) {
+                        *remainder = BigInt {lhs.small % rhs.small};
+                    }
+                    return;
+                }
+                Magnitude q;
+                Magnitude r;
+                divideMagnitudes(lhs.magnitude(), rhs.magnitude(), q, r);
+                if (quotient != nullptr) {
+                    *quotient = fromMagnitude(std::move(q), lhs.isNegative() != rhs.isNegative());
+                }
+                if (remainder != nullptr) {
+                    *remainder = fromMagnitude(std::move(r), lhs.isNegative());
+                }
+            }
+
+        public:
+            /**
+             * \brief Constructs 0.
+             * */
+            BigInt() {}
+
+            /**
+             * \brief Constructs a big integer from a built in integer. This is implicit, so integers mix freely with big ones.
+             * */
+            template <typename I, typename=typename std::enable_if<std::is_integral<I>::value>::type>
+            BigInt(const I& value) {
+                if constexpr (std::is_unsigned<I>::value && sizeof(I) >= sizeof(long)) {
+                    if (value > static_cast<I>(LONG_MAX)) {
+                        *this = fromMagnitude(toMagnitude(static_cast<std::uint64_t>(value)), false);
+                        return;
+                    }
+                }
+                small = static_cast<long>(value);
+            }
+
+            /**
+             * \brief Parses a decimal integer, with an optional leading `-` or `+`.
+             *
+             * \throw e std::invalid_argument if the string is not a decimal integer.
+             * */
+            explicit BigInt(const std::string& digits) {
+                std::size_t i {0};
+                bool isNeg {false};
+                if (!digits.empty() && (digits[0] == '-' || digits[0] == '+')) {
+                    isNeg = digits[0] == '-';
+                    i = 1;
+                }
+                if (i == digits.size()) {
+                    throw std::invalid_argument("Not a decimal integer: \"" + digits + "\".");
+                }
+                BigInt value;
+                for (; i < digits.size(); i++) {
+                    if (digits[i] < '0' || digits[i] > '9') {
+                        throw std::invalid_argument("Not a decimal integer: \"" + digits + "\".");
+                    }
+                    value = value*10 + (digits[i] - '0');
+                }
+                *this = isNeg? -value : value;
+            }
+
+            /**
+             * \brief Whether the value is held in a machine word (the fast path).
+             * */
+            bool is_small() const {
+                return limbs.empty();
+            }
+
+            bool is_zero() const {
+                return limbs.empty() && small == 0;
+            }
+
+            /**
+             * \brief -1, 0 or 1, as the value is negative, zero or positive.
+             * */
+            int sign() const {
+                if (limbs.empty()) {
+                    return small < 0? -1 : (small > 0? 1 : 0);
+                }
+                return negative? -1 : 1;
+            }
+
+            /**
+             * \brief Conversion to double. Values outside the range of double become infinities.
+             * */
+            explicit operator double() const {
+                if (limbs.empty()) {
+                    return static_cast<double>(small);
+                }
+                double retval {0.0};
+                for (std::size_t i = limbs.size(); i > 0; i--) {
+                    retval = retval*static_cast<double>(BASE) + static_cast<double>(limbs[i - 1]);
+                }
+                return negative? -retval : retval;
+            }
+
+            /**
+             * \brief The decimal representation.
+             * */
+            std::string to_string() const {
+                if (limbs.empty()) {
+                    return std::to_string(small);
+                }
+                std::string retval;
+                Magnitude mag {limbs};
+                const Magnitude billion {toMagnitude(1000000000ULL)};
+                while (!mag.empty()) {
+                    Magnitude q;
+                    Magnitude r;
+                    divideMagnitudes(mag, billion, q, r);
+                    std::string chunk {std::to_string(r.empty()? 0U : r[0])};
+                    if (!q.empty()) {
+                        chunk = std::string(9 - chunk.size(), '0') + chunk;
+                    }
+                    retval = chunk + retval;
+                    mag = std::move(q);
+                }
+                return negative? "-" + retval : retval;
+            }
+
+            friend BigInt operator+(const BigInt& lhs, const BigInt& rhs) {
+                long result;
+                if (lhs.limbs.empty() && rhs.limbs.empty() && !__builtin_add_overflow(lhs.small, rhs.small, &result)) {
+                    return BigInt {result};
+                }
+                return addSigned(lhs, rhs, false);
+            }
+
+            friend BigInt operator-(const BigInt& lhs, const BigInt& rhs) {
+                long result;
+                if (lhs.limbs.empty() && rhs.limbs.empty() && !__builtin_sub_overflow(lhs.small, rhs.small, &result)) {
+                    return BigInt {result};
+                }
+                return addSigned(lhs, rhs, true);
+            }
+
+            friend BigInt operator-(const BigInt& value) {
+                if (value.limbs.empty() && value.small != LONG_MIN) {
+                    return BigInt {-value.small};
+                }
+                return fromMagnitude(value.magnitude(), !value.isNegative());
+            }
+
+            friend BigInt operator*(const BigInt& lhs, const BigInt& rhs) {
+                long result;
+                if (lhs.limbs.empty() && rhs.limbs.empty() && !__builtin_mul_overflow(lhs.small, rhs.small, &result)) {
+                    return BigInt {result};
+                }
+                return fromMagnitude(multiplyMagnitudes(lhs.magnitude(), rhs.magnitude()), lhs.isNegative() != rhs.isNegative() && !lhs.is_zero() && !rhs.is_zero());
+            }
+
+            /**
+             * \throw e std::invalid_argument on division by 0.
+             * */
+            friend BigInt operator/(const BigInt& lhs, const BigInt& rhs) {
+                BigInt retval;
+                divide(lhs, rhs, &retval, nullptr);
+                return retval;
+            }
+
+            /**
+             * \throw e std::invalid_argument on division by 0.
+             * */
+            friend BigInt operator%(const BigInt& lhs, const BigInt& rhs) {
+                BigInt retval;
+                divide(lhs, rhs, nullptr, &retval);
+                return retval;
+            }
+
+            friend bool operator==(const BigInt& lhs, const BigInt& rhs) {
+                if (lhs.limbs.empty() || rhs.limbs.empty()) {
+                    // A value which fits in a long is never big.
+                    return lhs.limbs.empty() && rhs.limbs.empty() && lhs.small == rhs.small;
+                }
+                return lhs.negative == rhs.negative && lhs.limbs == rhs.limbs;
+            }
+
+            friend bool operator<(const BigInt& lhs, const BigInt& rhs) {
+                if (lhs.limbs.empty() && rhs.limbs.empty()) {
+                    return lhs.small < rhs.small;
+                }
+                const bool lhsNegative {lhs.isNegative()};
+                if (lhsNegative != rhs.isNegative()) {
+                    return lhsNegative;
+                }
+                const int cmp {compareMagnitudes(lhs.magnitude(), rhs.magnitude())};
+                return lhsNegative? cmp > 0 : cmp < 0;
+            }
+        };
+
+        inline bool operator!=(const BigInt& lhs, const BigInt& rhs) {
+            return !(lhs == rhs);
+        }
+
+        inline bool operator>(const BigInt& lhs, const BigInt& rhs) {
+            return rhs < lhs;
+        }
+
+        inline bool operator<=(const BigInt& lhs, const BigInt& rhs) {
+            return !(rhs < lhs);
+        }
+
+        inline bool operator>=(const BigInt& lhs, const BigInt& rhs) {
+            return !(lhs < rhs);
+        }
+
+        inline BigInt& operator+=(BigInt& lhs, const BigInt& rhs) {
+            lhs = lhs + rhs;
+            return lhs;
+        }
+
+        inline BigInt& operator-=(BigInt& lhs, const BigInt& rhs) {
+            lhs = lhs - rhs;
+            return lhs;
+        }
+
+        inline BigInt& operator*=(BigInt& lhs, const BigInt& rhs) {
+            lhs = lhs * rhs;
+            return lhs;
+        }
+
+        inline BigInt& operator/=(BigInt& lhs, const BigInt& rhs) {
+            lhs = lhs / rhs;
+            return lhs;
+        }
+
+        inline BigInt& operator%=(BigInt& lhs, const BigInt& rhs) {
+            lhs = lhs % rhs;
+            return lhs;
+        }
+
+        inline std::ostream& operator<<(std::ostream& stream, const BigInt& value) {
+            stream << value.to_string();
+            return stream;
+        }
+
+        /**
+         * \brief Absolute value.
+         * */
+        inline BigInt abs(const BigInt& value) {
+            return value.sign() < 0? -value : value;
+        }
+
+        /**
+         * \brief Greatest common divisor (always non negative; gcd(0, 0) is 0).
+         * */
+        inline BigInt gcd(BigInt a, BigInt b) {
+            a = abs(a);
+            b = abs(b);
+            while (!b.is_zero()) {
+                BigInt r {a % b};
+                a = std::move(b);
+                b = std::move(r);
+            }
+            return a;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,586 @@
+#ifndef __SIGABRT_NUMERIC_EXPRESSIONS__
+#define __SIGABRT_NUMERIC_EXPRESSIONS__
+
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
+
+#include <numeric/types/models.hpp>
+#include <numeric/kernels/simd.hpp>
+
+#include <thesoup/types/types.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::types
+     *
+     * \brief The namespace containing some special types.
+     * */
+    namespace types {
+        //! \cond NO_DOC
+        template <typename T> class Vector;
+        template <typename T> class Matrix;
+        //! \endcond
+
+        /**
+         * \class VectorExpression
+         *
+         * \tparam E The concrete expression type (CRTP).
+         *
+         * \brief Base of all lazily evaluated vector expressions.
+         *
+         * The element wise vector operators (`+`, `-`, negation and scaling by a scalar) do not compute anything. They
+         * return a light weight expression node that references its operands. A chain like `a*x + b*y - z` builds a tree
+         * of such nodes, and the whole tree is evaluated in a single loop when it is used to construct or assign a
+         * `Vector<T>`. No intermediate vectors are allocated.
+         *
+         * Dimension checks are done when a node is built, so a mismatch still throws `std::invalid_argument` at the
+         * operator, like before.
+         *
+         * NOTE: Expression nodes hold references to the vectors they were built from. Do not store an expression (say with
+         * `auto`) beyond the lifetime of its operands. Assign it to a `Vector<T>` instead.
+         *
+         * Every node provides `size()` and an unchecked `eval(i)`.
+         * */
+        template <typename E> struct VectorExpression {
+            const E& self() const {
+                return static_cast<const E&>(*this);
+            }
+        };
+
+        /**
+         * \class MatrixExpression
+         *
+         * \tparam E The concrete expression type (CRTP).
+         *
+         * \brief Base of all lazily evaluated matrix expressions.
+         *
+         * This is the matrix counterpart of `VectorExpression`. Every node provides `getRows()`, `getCols()` and an
+         * unchecked `eval(i, j)`. The same lifetime rules apply.
+         * */
+        template <typename E> struct MatrixExpression {
+            const E& self() const {
+                return static_cast<const E&>(*this);
+            }
+        };
+
+        /**
+         * \class StorageMapping
+         *
+         * \brief Where the elements of a matrix, or of a view on one, live.
+         *
+         * Element (i, j) is `table[firstRow + i].start[firstCol + j]`, or `table[firstRow + j].start[firstCol + i]` if
+         * `transposed` is set. `table` is the row table of the matrix that owns the storage.
+         *
+         * Every matrix expression node has an `aliases(mapping)` method. It tells if evaluating the node into the
+         * destination described by the mapping could read an element that has already been overwritten, like in
+         * `m = m.transpose()`. In that case the expression is evaluated into a temporary first.
+         * */
+        struct StorageMapping {
+            const void* table;
+            std::size_t firstRow;
+            std::size_t firstCol;
+            bool transposed;
+
+            bool operator==(const StorageMapping& other) const {
+                return table == other.table && firstRow == other.firstRow && firstCol == other.firstCol && transposed == other.transposed;
+            }
+        };
+
+        /**
+         * \class VectorTerminal
+         *
+         * \brief Leaf node referencing the storage of a `Vector<T>`.
+         * */
+        template <typename T> class VectorTerminal: public VectorExpression<VectorTerminal<T>> {
+        private:
+            const T* elems;
+            std::size_t length;
+        public:
+            using value_type = T;
+
+            VectorTerminal(const Vector<T>& vec): elems {vec.data()}, length {vec.size()} {}
+
+            std::size_t size() const {
+                return length;
+            }
+
+            const T& eval(const std::size_t& i) const {
+                return elems[i];
+            }
+
+            const T* data() const {
+                return elems;
+            }
+        };
+
+        /**
+         * \class MatrixTerminal
+         *
+         * \brief Leaf node referencing the row table of a `Matrix<T>`.
+         * */
+        template <typename T> class MatrixTerminal: public MatrixExpression<MatrixTerminal<T>> {
+        private:
+            const thesoup::types::Slice<T>* rows;
+            std::size_t nrows;
+            std::size_t ncols;
+        public:
+            using value_type = T;
+
+            MatrixTerminal(const Matrix<T>& matrix): rows {matrix.begin()}, nrows {matrix.getRows()}, ncols {matrix.getCols()} {}
+
+            std::size_t getRows() const {
+                return nrows;
+            }
+
+            std::size_t getCols() const {
+                return ncols;
+            }
+
+            const T& eval(const std::size_t& i, const std::size_t& j) const {
+                return rows[i].start[j];
+            }
+
+            bool aliases(const StorageMapping& dest) const {
+                return dest.table == rows && !(dest == StorageMapping {rows, 0, 0, false});
+            }
+        };
+
+        //! \cond NO_DOC
+        // Maps an operand type to what a node stores for it. Vectors and matrices become terminals, nodes are stored by value.
+        template <typename E> struct ExpressionOperand {
+            using type = E;
+        };
+
+        template <typename T> struct ExpressionOperand<Vector<T>> {
+            using type = VectorTerminal<T>;
+        };
+
+        template <typename T> struct ExpressionOperand<Matrix<T>> {
+            using type = MatrixTerminal<T>;
+        };
+
+        struct AddOp {
+            template <typename L, typename R> static auto apply(const L& lhs, const R& rhs) {
+                return lhs + rhs;
+            }
+
+            template <typename T> static void kernel(const T* a, const T* b, T* out, const std::size_t& n) {
+                numeric::kernels::vector_kernels<T>().add(a, b, out, n);
+            }
+        };
+
+        struct SubtractOp {
+            template <typename L, typename R> static auto apply(const L& lhs, const R& rhs) {
+                return lhs - rhs;
+            }
+
+            template <typename T> static void kernel(const T* a, const T* b, T* out, const std::size_t& n) {
+                numeric::kernels::vector_kernels<T>().sub(a, b, out, n);
+            }
+        };
+        //! \endcond
+
+        /**
+         * \class VectorBinaryExpression
+         *
+         * \brief Element wise combination (`Op` is add or subtract) of 2 vector expressions.
+         * */
+        template <typename Op, typename L, typename R>
+        class VectorBinaryExpression: public VectorExpression<VectorBinaryExpression<Op, L, R>> {
+        private:
+            L left;
+            R right;
+        public:
+            using value_type = decltype(Op::apply(std::declval<typename L::value_type>(), std::declval<typename R::value_type>()));
+
+            VectorBinaryExpression(const L& left, const R& right): left {left}, right {right} {}
+
+            std::size_t size() const {
+                return left.size();
+            }
+
+            value_type eval(const std::size_t& i) const {
+                return Op::apply(left.eval(i), right.eval(i));
+            }
+
+            const L& lhs() const {
+                return left;
+            }
+
+            const R& rhs() const {
+                return right;
+            }
+        };
+
+        /**
+         * \class VectorScaleExpression
+         *
+         * \brief A vector expression multiplied by a scalar.
+         * */
+        template <typename S, typename E>
+        class VectorScaleExpression: public VectorExpression<VectorScaleExpression<S, E>> {
+        private:
+            S scalar;
+            E expr;
+        public:
+            using value_type = typename E::value_type;
+
+            VectorScaleExpression(const S& scalar, const E& expr): scalar {scalar}, expr {expr} {}
+
+            std::size_t size() const {
+                return expr.size();
+            }
+
+            value_type eval(const std::size_t& i) const {
+                return static_cast<value_type>(scalar*expr.eval(i));
+            }
+
+            const S& factor() const {
+                return scalar;
+            }
+
+            const E& operand() const {
+                return expr;
+            }
+        };
+
+        /**
+         * \class VectorNegateExpression
+         *
+         * \brief A negated vector expression.
+         * */
+        template <typename E>
+        class VectorNegateExpression: public VectorExpression<VectorNegateExpression<E>> {
+        private:
+            E expr;
+        public:
+            using value_type = typename E::value_type;
+
+            VectorNegateExpression(const E& expr): expr {expr} {}
+
+            std::size_t size() const {
+                return expr.size();
+            }
+
+            value_type eval(const std::size_t& i) const {
+                return -expr.eval(i);
+            }
+
+            const E& operand() const {
+                return expr;
+            }
+        };
+
+        /**
+         * \class MatrixBinaryExpression
+         *
+         * \brief Element wise combination (`Op` is add or subtract) of 2 matrix expressions.
+         * */
+        template <typename Op, typename L, typename R>
+        class MatrixBinaryExpression: public MatrixExpression<MatrixBinaryExpression<Op, L, R>> {
+        private:
+            L left;
+            R right;
+        public:
+            using value_type = decltype(Op::apply(std::declval<typename L::value_type>(), std::declval<typename R::value_type>()));
+
+            MatrixBinaryExpression(const L& left, const R& right): left {left}, right {right} {}
+
+            std::size_t getRows() const {
+                return left.getRows();
+            }
+
+            std::size_t getCols() const {
+                return left.getCols();
+            }
+
+            value_type eval(const std::size_t& i, const std::size_t& j) const {
+                return Op::apply(left.eval(i, j), right.eval(i, j));
+            }
+
+            bool aliases(const StorageMapping& dest) const {
+                return left.aliases(dest) || right.aliases(dest);
+            }
+        };
+
+        /**
+         * \class MatrixScaleExpression
+         *
+         * \brief A matrix expression multiplied by a scalar.
+         * */
+        template <typename S, typename E>
+        class MatrixScaleExpression: public MatrixExpression<MatrixScaleExpression<S, E>> {
+        private:
+            S scalar;
+            E expr;
+        public:
+            using value_type = typename E::value_type;
+
+            MatrixScaleExpression(const S& scalar, const E& expr): scalar {scalar}, expr {expr} {}
+
+            std::size_t getRows() const {
+                return expr.getRows();
+            }
+
+            std::size_t getCols() const {
+                return expr.getCols();
+            }
+
+            value_type eval(const std::size_t& i, const std::size_t& j) const {
+                return static_cast<value_type>(scalar*expr.eval(i, j));
+            }
+
+            bool aliases(const StorageMapping& dest) const {
+                return expr.aliases(dest);
+            }
+        };
+
+        /**
+         * \class MatrixNegateExpression
+         *
+         * \brief A negated matrix expression.
+         * */
+        template <typename E>
+        class MatrixNegateExpression: public MatrixExpression<MatrixNegateExpression<E>> {
+        private:
+            E expr;
+        public:
+            using value_type = typename E::value_type;
+
+            MatrixNegateExpression(const E& expr): expr {expr} {}
+
+            std::size_t getRows() const {
+                return expr.getRows();
+            }
+
+            std::size_t getCols() const {
+                return expr.getCols();
+            }
+
+            value_type eval(const std::size_t& i, const std::size_t& j) const {
+                return -expr.eval(i, j);
+            }
+
+            bool aliases(const StorageMapping& dest) const {
+                return expr.aliases(dest);
+            }
+        };
+
+        /**
+         * \brief Evaluate a vector expression into a buffer.
+         *
+         * This is the single fused loop that every vector expression compiles into. The destination may alias any of
+         * the operands, as each output element only depends on the input elements with the same index.
+         *
+         * \param dest The destination buffer, of at least `expr.size()` elements.
+         *
+         * \param expr The expression.
+         * */
+        template <typename T, typename E> void evaluate_into(T* dest, const VectorExpression<E>& expr) {
+            const E& e {expr.self()};
+            const std::size_t n {e.size()};
+            for (std::size_t i = 0; i < n; i++) {
+                dest[i] = static_cast<T>(e.eval(i));
+            }
+        }
+
+        //! \cond NO_DOC
+        // Single operations directly on vectors map onto one SIMD kernel call for float and double.
+        template <typename T, typename Op>
+        void evaluate_into(T* dest, const VectorBinaryExpression<Op, VectorTerminal<T>, VectorTerminal<T>>& expr) {
+            if constexpr (numeric::kernels::HasSimdKernel<T>::value) {
+                Op::kernel(expr.lhs().data(), expr.rhs().data(), dest, expr.size());
+            } else {
+                evaluate_into(dest, static_cast<const VectorExpression<VectorBinaryExpression<Op, VectorTerminal<T>, VectorTerminal<T>>>&>(expr));
+            }
+        }
+
+        // An integer factor is converted to T by the multiplication anyway, so `2*v` takes the kernel too. A factor of a
+        // different floating point type would round differently, and stays on the loop.
+        template <typename T, typename S>
+        void evaluate_into(T* dest, const VectorScaleExpression<S, VectorTerminal<T>>& expr) {
+            if constexpr (numeric::kernels::HasSimdKernel<T>::value && (std::is_same<S, T>::value || std::is_integral<S>::value)) {
+                numeric::kernels::vector_kernels<T>().scale(expr.operand().data(), static_cast<T>(expr.factor()), dest, expr.size());
+            } else {
+                evaluate_into(dest, static_cast<const VectorExpression<VectorScaleExpression<S, VectorTerminal<T>>>&>(expr));
+            }
+        }
+
+        template <typename T>
+        void evaluate_into(T* dest, const VectorNegateExpression<VectorTerminal<T>>& expr) {
+            if constexpr (numeric::kernels::HasSimdKernel<T>::value) {
+                numeric::kernels::vector_kernels<T>().neg(expr.operand().data(), dest, expr.size());
+            } else {
+                evaluate_into(dest, static_cast<const VectorExpression<VectorNegateExpression<VectorTerminal<T>>>&>(expr));
+            }
+        }
+        //! \endcond
+
+        /**
+         * \brief Evaluate a matrix expression into a row table.
+         *
+         * \param dest The row table of the destination, with at least `expr.getRows()` rows of `expr.getCols()` elements.
+         *
+         * \param expr The expression.
+         * */
+        template <typename T, typename E> void evaluate_into(thesoup::types::Slice<T>* dest, const MatrixExpression<E>& expr) {
+            const E& e {expr.self()};
+            const std::size_t nrows {e.getRows()};
+            const std::size_t ncols {e.getCols()};
+            for (std::size_t i = 0; i < nrows; i++) {
+                T* row {dest[i].start};
+                for (std::size_t j = 0; j < ncols; j++) {
+                    row[j] = static_cast<T>(e.eval(i, j));
+                }
+            }
+        }
+
+        /**
+         * \brief Addition operator overload for 2 vector expressions.
+         *
+         * Builds a lazy sum. You can do `Vector<double> sum {v1+v2}`.
+         *
+         * \throw std::invalid_argument If the dimensions are different.
+         * */
+        template <typename L, typename R>
+        VectorBinaryExpression<AddOp, typename ExpressionOperand<L>::type, typename ExpressionOperand<R>::type>
+        operator+(const VectorExpression<L>& lhs, const VectorExpression<R>& rhs) {
+            if (lhs.self().size() != rhs.self().size()) {
+                throw std::invalid_argument("Cannot add vectors with different dimensions.");
+            }
+            return {typename ExpressionOperand<L>::type {lhs.self()}, typename ExpressionOperand<R>::type {rhs.self()}};
+        }
+
+        /**
+         * \brief Subtraction operator overload for 2 vector expressions.
+         *
+         * Builds a lazy difference. You can do `Vector<double> diff {v1-v2}`.
+         *
+         * \throw std::invalid_argument If the dimensions are different.
+         * */
+        template <typename L, typename R>
+        VectorBinaryExpression<SubtractOp, typename ExpressionOperand<L>::type, typename ExpressionOperand<R>::type>
+        operator-(const VectorExpression<L>& lhs, const VectorExpression<R>& rhs) {
+            if (lhs.self().size() != rhs.self().size()) {
+                throw std::invalid_argument("Cannot subtract vectors with different dimensions.");
+            }
+            return {typename ExpressionOperand<L>::type {lhs.self()}, typename ExpressionOperand<R>::type {rhs.self()}};
+        }
+
+        /**
+         * \brief Negation operator overload for a vector expression.
+         *
+         * Builds a lazy negation. You can do `Vector<double> neg {-v1}`.
+         * */
+        template <typename E>
+        VectorNegateExpression<typename ExpressionOperand<E>::type> operator-(const VectorExpression<E>& expr) {
+            return {typename ExpressionOperand<E>::type {expr.self()}};
+        }
+
+        /**
+         * \brief Multiplication operator overload for a scalar and a vector expression.
+         *
+         * Builds a lazy out of place scaling. You can do `Vector<double> scaled {2*v1}`. For in place updates like
+         * `v1 = 2*v1`, `v1.scale(2)` is still the better choice.
+         * */
+        template <typename S, typename E, typename=typename std::enable_if<IsScalarType<S>::value>::type>
+        VectorScaleExpression<S, typename ExpressionOperand<E>::type> operator*(const S& scalar, const VectorExpression<E>& expr) {
+            return {scalar, typename ExpressionOperand<E>::type {expr.self()}};
+        }
+
+        /**
+         * \brief Multiplication operator overload for a vector expression and a scalar.
+         *
+         * Builds a lazy out of place scaling. You can do `Vector<double> scaled {v1*2}`.
+         * */
+        template <typename S, typename E, typename=typename std::enable_if<IsScalarType<S>::value>::type>
+        VectorScaleExpression<S, typename ExpressionOperand<E>::type> operator*(const VectorExpression<E>& expr, const S& scalar) {
+            return {scalar, typename ExpressionOperand<E>::type {expr.self()}};
+        }
+
+        /**
+         * \brief Dot product of 2 vector expressions.
+         *
+         * The product of 2 plain vectors is handled by the overload in `vector.hpp`. This one covers expressions, like
+         * `(v1 + v2)*v3`, without materializing them.
+         *
+         * \throw std::invalid_argument If the dimensions are different.
+         * */
+        template <typename L, typename R>
+        auto operator*(const VectorExpression<L>& lhs, const VectorExpression<R>& rhs) {
+            const typename ExpressionOperand<L>::type left {lhs.self()};
+            const typename ExpressionOperand<R>::type right {rhs.self()};
+            if (left.size() != right.size()) {
+                throw std::invalid_argument("Cannot compute dot product of vectors with different dimensions.");
+            }
+            typename ExpressionOperand<L>::type::value_type acc {static_cast<typename ExpressionOperand<L>::type::value_type>(0)};
+            for (std::size_t i = 0; i < left.size(); i++) {
+                acc += left.eval(i)*right.eval(i);
+            }
+            return acc;
+        }
+
+        /**
+         * \brief Addition operator overload for 2 matrix expressions.
+         *
+         * \throw std::invalid_argument If the dimensions are different.
+         * */
+        template <typename L, typename R>
+        MatrixBinaryExpression<AddOp, typename ExpressionOperand<L>::type, typename ExpressionOperand<R>::type>
+        operator+(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs) {
+            if (lhs.self().getRows() != rhs.self().getRows() || lhs.self().getCols() != rhs.self().getCols()) {
+                throw std::invalid_argument("Matrices of different dimensions cannot be added");
+            }
+            return {typename ExpressionOperand<L>::type {lhs.self()}, typename ExpressionOperand<R>::type {rhs.self()}};
+        }
+
+        /**
+         * \brief Subtraction operator overload for 2 matrix expressions.
+         *
+         * \throw std::invalid_argument If the dimensions are different.
+         * */
+        template <typename L, typename R>
+        MatrixBinaryExpression<SubtractOp, typename ExpressionOperand<L>::type, typename ExpressionOperand<R>::type>
+        operator-(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs) {
+            if (lhs.self().getRows() != rhs.self().getRows() || lhs.self().getCols() != rhs.self().getCols()) {
+                throw std::invalid_argument("Matrices of different dimensions cannot be subtracted");
+            }
+            return {typename ExpressionOperand<L>::type {lhs.self()}, typename ExpressionOperand<R>::type {rhs.self()}};
+        }
+
+        /**
+         * \brief Negation operator overload for a matrix expression.
+         * */
+        template <typename E>
+        MatrixNegateExpression<typename ExpressionOperand<E>::type> operator-(const MatrixExpression<E>& expr) {
+            return {typename ExpressionOperand<E>::type {expr.self()}};
+        }
+
+        /**
+         * \brief Multiplication operator overload for a scalar and a matrix expression.
+         *
+         * For in place updates, `Matrix::scale` is still the better choice.
+         * */
+        template <typename S, typename E, typename=typename std::enable_if<IsScalarType<S>::value>::type>
+        MatrixScaleExpression<S, typename ExpressionOperand<E>::type> operator*(const S& scalar, const MatrixExpression<E>& expr) {
+            return {scalar, typename ExpressionOperand<E>::type {expr.self()}};
+        }
+
+        /**
+         * \brief Multiplication operator overload for a matrix expression and a scalar.
+         * */
+        template <typename S, typename E, typename=typename std::enable_if<IsScalarType<S>::value>::type>
+        MatrixScaleExpression<S, typename ExpressionOperand<E>::type> operator*(const MatrixExpression<E>& expr, const S& scalar) {
+            return {scalar, typename ExpressionOperand<E>::type {expr.self()}};
+        }
+    }
+}
+
+#endif
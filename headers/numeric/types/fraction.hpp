@@ -1,9 +1,12 @@
 #ifndef __SIGABRT_TYPE_FRACTION__
 #define __SIGABRT_TYPE_FRACTION__
 
+#include <climits>
 #include <exception>
 #include <iostream>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 /**
  * \namespace numeric
@@ -18,34 +21,75 @@ namespace numeric {
      * \brief The namespace containing some special types.
      * */
     namespace types {
-        namespace {
-            long validate_inputs_and_reduce(long num, long den) {
+        //! \cond NO_DOC
+        namespace detail {
+            inline unsigned long magnitude(const long& value) {
+                return value < 0? 0UL - static_cast<unsigned long>(value) : static_cast<unsigned long>(value);
+            }
+
+            // Binary (Stein's) GCD. The number of steps is logarithmic in the inputs, where the subtraction based Euclid
+            // loop this replaces was linear in the ratio of the inputs.
+            inline unsigned long gcd(unsigned long a, unsigned long b) {
+                if (a == 0) {
+                    return b;
+                }
+                if (b == 0) {
+                    return a;
+                }
+                const int shift {__builtin_ctzl(a | b)};
+                a >>= __builtin_ctzl(a);
+                do {
+                    b >>= __builtin_ctzl(b);
+                    if (a > b) {
+                        std::swap(a, b);
+                    }
+                    b -= a;
+                } while (b != 0);
+                return a << shift;
+            }
+
+            inline long validate_inputs_and_reduce(long num, long den) {
                 if (den == 0) {
                     throw std::invalid_argument("Denominator cannot be 0.");
                 }
                 if (num == 0) {
-                    return 1;
+                    // Store 0 as 0/1. A zero with a large denominator would make the following operations overflow early.
+                    return den;
                 }
                 if (num==den) {
                     return num;
                 }
-                long n1 {num < 0? -num : num};
-                long n2 {den < 0? -den : den};
-
-                while (n1 >= 1 && n2 >= 1) {
-                    if (n2 > n1) {
-                    std::swap(n1, n2);
-                    }
-                    if (n1%n2 == 0) {
-                    return n2;
-                    }
-                    long tmp = n2;
-                    n2 = n1 - n2;
-                    n1 = tmp;
+                return static_cast<long>(gcd(magnitude(num), magnitude(den)));
+            }
+            
+            [[noreturn]] inline void throw_lazy_fraction_overflow() {
+                throw std::overflow_error("LazyFraction overflow: the reduced result does not fit in a long.");
+            }
+            
+            inline long checked_negate(const long& value) {
+                if (value == LONG_MIN) {
+                    throw_lazy_fraction_overflow();
+                }
+                return -value;
+            }
+            
+            inline long checked_mul(const long& a, const long& b) {
+                long retval;
+                if (__builtin_mul_overflow(a, b, &retval)) {
+                    throw_lazy_fraction_overflow();
+                }
+                return retval;
+            }
+            
+            inline long checked_add(const long& a, const long& b) {
+                long retval;
+                if (__builtin_add_overflow(a, b, &retval)) {
+                    throw_lazy_fraction_overflow();
                 }
-                return n2;
+                return retval;
             }
         }
+        //! \endcond
         
         /**
          * \class Fraction
@@ -60,7 +104,8 @@ namespace numeric {
          * Although this library's Gauss Jordan algorithm provides an option to specify precision for 0, using fractions to 
          * maintain precision will be another alternative.
          * 
-         * NOTE: Once constructed, the value of the object cannot be changed, as both the num and den are consts.
+         * Every operation produces a fraction in it's most reduced form. When a matrix of fractions is reduced, most of the
+         * time goes into these reductions; see `LazyFraction` for a type that postpones them.
          * 
          * \var num The numerator of the fraction.
          * 
@@ -85,7 +130,17 @@ namespace numeric {
              * 
              * \exception std::invalid_argument thrown when the denominator is specified as 0.
              * */
-            Fraction(long num, long den): Fraction(validate_inputs_and_reduce(num, den), num, den) {}
+            Fraction(long num, long den): Fraction(detail::validate_inputs_and_reduce(num, den), num, den) {}
+
+            /**
+             * \brief Constructs the fraction `num/1`.
+             * 
+             * This is explicit, so that mixed arithmetic with integers goes through the integer overloads below. It is what
+             * `static_cast<Fraction>(0)` in the generic algorithms (like `rref`) uses.
+             * 
+             * \param num The numerator.
+             * */
+            explicit Fraction(long num): num {num}, den {1L} {}
 
              /**
              * \brief Default constructor
@@ -119,7 +174,7 @@ namespace numeric {
         };
         
         
-        std::ostream& operator<<(std::ostream& stream, const Fraction& f) {
+        inline std::ostream& operator<<(std::ostream& stream, const Fraction& f) {
             stream << f.num << '/' << f.den;
             return stream;
         }
@@ -139,7 +194,7 @@ namespace numeric {
             return rhs + lhs;
         }
         
-        Fraction operator+(const Fraction& lhs, const Fraction& rhs) {
+        inline Fraction operator+(const Fraction& lhs, const Fraction& rhs) {
             return Fraction {
                 lhs.num*rhs.den + rhs.num*lhs.den,
                 lhs.den*rhs.den
@@ -147,7 +202,7 @@ namespace numeric {
         }
         
         // Overload negate operator
-        Fraction operator-(const Fraction& f) {
+        inline Fraction operator-(const Fraction& f) {
             return Fraction {
                 -1*f.num,
                 f.den
@@ -168,7 +223,7 @@ namespace numeric {
             return -rhs + lhs;
         }
         
-        Fraction operator-(const Fraction& lhs, const Fraction& rhs) {
+        inline Fraction operator-(const Fraction& lhs, const Fraction& rhs) {
             return Fraction {
                 lhs.num*rhs.den - rhs.num*lhs.den,
                 lhs.den*rhs.den
@@ -196,7 +251,7 @@ namespace numeric {
             return rhs * lhs;
         }
         
-        Fraction operator*(const Fraction& lhs, const Fraction& rhs) {
+        inline Fraction operator*(const Fraction& lhs, const Fraction& rhs) {
             if (rhs.den == 0L || lhs.den == 0) {
                 throw std::invalid_argument("Multiplication with invalid fraction (0 denominator).");
             }
@@ -229,7 +284,7 @@ namespace numeric {
             };
         }
         
-        Fraction operator/(const Fraction& lhs, const Fraction& rhs) {
+        inline Fraction operator/(const Fraction& lhs, const Fraction& rhs) {
             if (rhs.num == 0L) {
                 throw std::invalid_argument("Attempt to divide by 0.");
             }
@@ -251,7 +306,7 @@ namespace numeric {
         }
         
         
-        bool operator==(const Fraction& lhs, const Fraction& rhs) {
+        inline bool operator==(const Fraction& lhs, const Fraction& rhs) {
             return lhs.num == rhs.num && lhs.den == rhs.den;
         }
         
@@ -266,7 +321,7 @@ namespace numeric {
         }
         
         
-        bool operator!=(const Fraction& lhs, const Fraction& rhs) {
+        inline bool operator!=(const Fraction& lhs, const Fraction& rhs) {
             return lhs.num != rhs.num || lhs.den != rhs.den;
         }
         
@@ -293,6 +348,282 @@ namespace numeric {
             return static_cast<double>(lhs) < static_cast<double>(rhs);
         }
         
+        // Compound assignment operators. These replace the value with the (reduced) result of the operation.
+        inline Fraction& operator+=(Fraction& lhs, const Fraction& rhs) {
+            lhs = lhs + rhs;
+            return lhs;
+        }
+        
+        inline Fraction& operator-=(Fraction& lhs, const Fraction& rhs) {
+            lhs = lhs - rhs;
+            return lhs;
+        }
+        
+        inline Fraction& operator*=(Fraction& lhs, const Fraction& rhs) {
+            lhs = lhs * rhs;
+            return lhs;
+        }
+        
+        inline Fraction& operator/=(Fraction& lhs, const Fraction& rhs) {
+            lhs = lhs / rhs;
+            return lhs;
+        }
+        
+        /**
+         * \class LazyFraction
+         * 
+         * \brief A fraction in `p/q` format, which is only reduced when it has to be.
+         * 
+         * `Fraction` reduces the result of every operation, and in an elimination over a matrix of fractions, that GCD is
+         * most of the work. This type does the arithmetic on the numerator and denominator as they are, and only reduces
+         * when a result would overflow a `long`: the operands are then reduced, and the operation is retried with
+         * the denominators' LCM (for `+` and `-`) or with cross cancellation (for `*` and `/`). If the reduced result
+         * still does not fit, a `std::overflow_error` is thrown, so the results are either exact or an exception, never
+         * silently wrapped around.
+         * 
+         * Comparisons are done by cross multiplication, so they are exact regardless of the representation. Printing
+         * shows the reduced form. `reduced()` (or a conversion to `Fraction`) gives the reduced form explicitly.
+         * 
+         * The denominator is always positive, and 0 is always stored as 0/1. The default value is 0, so a
+         * `Matrix<LazyFraction>` starts out as a zero matrix (unlike `Matrix<Fraction>`, which starts out with ones).
+         * 
+         * \var num The numerator of the fraction.
+         * 
+         * \var den The denominator of the fraction. This is always positive.
+         * */
+        struct LazyFraction {
+        public:
+            long num;
+            long den;
+            
+            /**
+             * \brief Default constructor
+             * 
+             * Constructs the fraction 0/1.
+             * */
+            LazyFraction(): num {0L}, den {1L} {}
+            
+            /**
+             * \brief Constructs the fraction `num/1`.
+             * 
+             * This is implicit, so integers mix freely with lazy fractions (`2*f + 1`). Floating point values do not
+             * convert.
+             * */
+            template <typename I, typename=typename std::enable_if<std::is_integral<I>::value>::type>
+            LazyFraction(const I& num): num {static_cast<long>(num)}, den {1L} {}
+            
+            /**
+             * \brief Constructor
+             * 
+             * Constructs a fraction with `num` and `den`, without reducing it. The sign is moved to the numerator.
+             * 
+             * \param num The numerator.
+             * 
+             * \param den The denominator. This cannot be 0.
+             * 
+             * \exception std::invalid_argument thrown when the denominator is specified as 0.
+             * */
+            LazyFraction(const long& num, const long& den): num {num}, den {den} {
+                if (den == 0) {
+                    throw std::invalid_argument("Denominator cannot be 0.");
+                }
+                if (den < 0) {
+                    this -> num = detail::checked_negate(num);
+                    this -> den = detail::checked_negate(den);
+                }
+                if (num == 0) {
+                    this -> den = 1L;
+                }
+            }
+            
+            /**
+             * \brief Constructs a lazy fraction with the value of a `Fraction`.
+             * */
+            explicit LazyFraction(const Fraction& f): LazyFraction(f.num, f.den) {}
+            
+            /**
+             * \brief Conversion to the (reduced) `Fraction`.
+             * */
+            explicit operator Fraction() const {
+                return Fraction {num, den};
+            }
+            
+            /**
+             * \brief Conversion to double.
+             * 
+             * Unlike `Fraction`, this is explicit, so that mixed expressions do not silently drop to floating point.
+             * */
+            explicit operator double() const {
+                return static_cast<double>(num)/static_cast<double>(den);
+            }
+            
+            /**
+             * \brief The same value, in it's most reduced form.
+             * */
+            LazyFraction reduced() const {
+                const long gcd {static_cast<long>(detail::gcd(detail::magnitude(num), static_cast<unsigned long>(den)))};
+                return unreduced(num/gcd, den/gcd);
+            }
+            
+            /**
+             * \brief Whether the value is 0. This does not need a multiplication.
+             * */
+            bool is_zero() const {
+                return num == 0;
+            }
+            
+            //! \cond NO_DOC
+            // Builds a fraction from parts which are already known to be valid (den > 0).
+            static LazyFraction unreduced(const long& num, const long& den) {
+                LazyFraction retval;
+                if (num != 0) {
+                    retval.num = num;
+                    retval.den = den;
+                }
+                return retval;
+            }
+            //! \endcond
+        };
+        
+        //! \cond NO_DOC
+        namespace detail {
+            // The slow path of addition: reduce both operands, and use the LCM of the denominators (Knuth, TAOCP 4.5.1).
+            inline LazyFraction add_reducing(const LazyFraction& lhs, const LazyFraction& rhs) {
+                const LazyFraction a {lhs.reduced()};
+                const LazyFraction b {rhs.reduced()};
+                const long d1 {static_cast<long>(gcd(static_cast<unsigned long>(a.den), static_cast<unsigned long>(b.den)))};
+                const long num {checked_add(checked_mul(a.num, b.den/d1), checked_mul(b.num, a.den/d1))};
+                const long d2 {static_cast<long>(gcd(magnitude(num), static_cast<unsigned long>(d1)))};
+                return LazyFraction::unreduced(num/d2, checked_mul(a.den/d1, b.den/d2));
+            }
+            
+            // The slow path of multiplication: reduce both operands, and cancel across before multiplying.
+            inline LazyFraction mul_reducing(const LazyFraction& lhs, const LazyFraction& rhs) {
+                const LazyFraction a {lhs.reduced()};
+                const LazyFraction b {rhs.reduced()};
+                const long g1 {static_cast<long>(gcd(magnitude(a.num), static_cast<unsigned long>(b.den)))};
+                const long g2 {static_cast<long>(gcd(magnitude(b.num), static_cast<unsigned long>(a.den)))};
+                return LazyFraction::unreduced(checked_mul(a.num/g1, b.num/g2), checked_mul(a.den/g2, b.den/g1));
+            }
+            
+            // A product of two longs always fits. __extension__ keeps -Wpedantic quiet about the GCC type.
+            __extension__ typedef __int128 CrossProduct;
+
+            // Returns -1, 0 or 1 as lhs is less than, equal to or greater than rhs. The denominators are positive, so
+            // this is the order of the cross products, which are computed exactly.
+            inline int compare(const LazyFraction& lhs, const LazyFraction& rhs) {
+                long l;
+                long r;
+                if (!__builtin_mul_overflow(lhs.num, rhs.den, &l) && !__builtin_mul_overflow(rhs.num, lhs.den, &r)) {
+                    return l < r? -1 : (l > r? 1 : 0);
+                }
+                const CrossProduct wideL {static_cast<CrossProduct>(lhs.num)*rhs.den};
+                const CrossProduct wideR {static_cast<CrossProduct>(rhs.num)*lhs.den};
+                return wideL < wideR? -1 : (wideL > wideR? 1 : 0);
+            }
+        }
+        //! \endcond
+        
+        inline std::ostream& operator<<(std::ostream& stream, const LazyFraction& f) {
+            const LazyFraction r {f.reduced()};
+            stream << r.num << '/' << r.den;
+            return stream;
+        }
+        
+        inline LazyFraction operator+(const LazyFraction& lhs, const LazyFraction& rhs) {
+            long num;
+            if (lhs.den == rhs.den) {
+                if (!__builtin_add_overflow(lhs.num, rhs.num, &num)) {
+                    return LazyFraction::unreduced(num, lhs.den);
+                }
+            } else {
+                long n1;
+                long n2;
+                long den;
+                if (
+                    !__builtin_mul_overflow(lhs.num, rhs.den, &n1) &&
+                    !__builtin_mul_overflow(rhs.num, lhs.den, &n2) &&
+                    !__builtin_add_overflow(n1, n2, &num) &&
+                    !__builtin_mul_overflow(lhs.den, rhs.den, &den)
+                ) {
+                    return LazyFraction::unreduced(num, den);
+                }
+            }
+            return detail::add_reducing(lhs, rhs);
+        }
+        
+        inline LazyFraction operator-(const LazyFraction& f) {
+            if (f.num == LONG_MIN) {
+                const LazyFraction r {f.reduced()};
+                return LazyFraction::unreduced(detail::checked_negate(r.num), r.den);
+            }
+            return LazyFraction::unreduced(-f.num, f.den);
+        }
+        
+        inline LazyFraction operator-(const LazyFraction& lhs, const LazyFraction& rhs) {
+            return lhs + (-rhs);
+        }
+        
+        inline LazyFraction operator*(const LazyFraction& lhs, const LazyFraction& rhs) {
+            long num;
+            long den;
+            if (!__builtin_mul_overflow(lhs.num, rhs.num, &num) && !__builtin_mul_overflow(lhs.den, rhs.den, &den)) {
+                return LazyFraction::unreduced(num, den);
+            }
+            return detail::mul_reducing(lhs, rhs);
+        }
+        
+        inline LazyFraction operator/(const LazyFraction& lhs, const LazyFraction& rhs) {
+            if (rhs.num == 0L) {
+                throw std::invalid_argument("Attempt to divide by 0.");
+            }
+            return lhs * LazyFraction {rhs.den, rhs.num};
+        }
+        
+        inline LazyFraction& operator+=(LazyFraction& lhs, const LazyFraction& rhs) {
+            lhs = lhs + rhs;
+            return lhs;
+        }
+        
+        inline LazyFraction& operator-=(LazyFraction& lhs, const LazyFraction& rhs) {
+            lhs = lhs - rhs;
+            return lhs;
+        }
+        
+        inline LazyFraction& operator*=(LazyFraction& lhs, const LazyFraction& rhs) {
+            lhs = lhs * rhs;
+            return lhs;
+        }
+        
+        inline LazyFraction& operator/=(LazyFraction& lhs, const LazyFraction& rhs) {
+            lhs = lhs / rhs;
+            return lhs;
+        }
+        
+        inline bool operator==(const LazyFraction& lhs, const LazyFraction& rhs) {
+            return (lhs.num == rhs.num && lhs.den == rhs.den) || detail::compare(lhs, rhs) == 0;
+        }
+        
+        inline bool operator!=(const LazyFraction& lhs, const LazyFraction& rhs) {
+            return !(lhs == rhs);
+        }
+        
+        inline bool operator<(const LazyFraction& lhs, const LazyFraction& rhs) {
+            return detail::compare(lhs, rhs) < 0;
+        }
+        
+        inline bool operator>(const LazyFraction& lhs, const LazyFraction& rhs) {
+            return detail::compare(lhs, rhs) > 0;
+        }
+        
+        inline bool operator<=(const LazyFraction& lhs, const LazyFraction& rhs) {
+            return detail::compare(lhs, rhs) <= 0;
+        }
+        
+        inline bool operator>=(const LazyFraction& lhs, const LazyFraction& rhs) {
+            return detail::compare(lhs, rhs) >= 0;
+        }
+        
     }
 }
 
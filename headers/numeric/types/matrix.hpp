@@ -2,13 +2,24 @@
 #define __SIGABRT_NUMERIC_MATRIX__
 
 
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <exception>
 #include<iostream>
 #include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
 
+#include <numeric/benchmark/instrumentation.hpp>
+#include <numeric/memory/buffer.hpp>
 #include <numeric/types/vector.hpp>
+#include <numeric/types/expressions.hpp>
+#include <numeric/types/matrixview.hpp>
+#include <numeric/types/permutation.hpp>
 #include <numeric/types/models.hpp>
+#include <numeric/kernels/gemm.hpp>
 
 #include <thesoup/types/types.hpp>
 
@@ -44,7 +55,8 @@ namespace numeric {
          * 
          * NOTE: All row operations throw `out_of_range` error on invalid rows.
          * 
-         * This also has the addition and multiplication operators overriden. Multiply operator can also multiply the matrix with a vector
+         * This also has the addition and multiplication operators overriden. Addition, subtraction, negation and scaling by a
+         * scalar are lazy (see `MatrixExpression`), and a `Matrix` can be constructed from, or assigned such an expression. Multiply operator can also multiply the matrix with a vector
          * (`Sigabrt::Types::Vector`), not `std::vector`.
          * 
          * NOTE: When we matrix*vector, we assume it's a column vector and the result is a column vector as well, but when doing vector
@@ -53,14 +65,25 @@ namespace numeric {
          * Matrix also has index operations and range for defined. You can do `matrix[i][j]` on both const and non const objects/references,
          * and also use this in range for loops like `for (auto row : matrix)`.
          * 
+         * For hot loops, `rowPtr(i)` and `atUnchecked(i, j)` give access without the range checks. These only `assert` the
+         * indices, so the checks are gone in release (`NDEBUG`) builds. Rows are not guaranteed to be contiguous with each
+         * other (`exchangeRows` swaps row pointers), so always go through `rowPtr` per row. `row_permutation` tells which
+         * stored row each row points to, and `compact` puts the elements back in row major order for code that needs one
+         * flat buffer.
+         * 
+         * The row table and the elements are allocated from a `std::pmr::memory_resource`, which is the default resource
+         * unless one is passed to the constructor. Pass a `numeric::memory::Arena` to create and destroy many small matrices
+         * without going to malloc. The resource travels with the storage on moves, and results of arithmetic use the default
+         * resource.
+         * 
          * */
-        template <typename T> class Matrix {
+        template <typename T> class Matrix: public MatrixExpression<Matrix<T>> {
             static_assert(std::is_default_constructible<T>::value, "Type T has to be default constructible.");
         private:
             std::size_t nrows;
             std::size_t ncols;
-            std::unique_ptr<thesoup::types::Slice<T>[]> rows;
-            std::unique_ptr<T[]> storage;
+            numeric::memory::Buffer<thesoup::types::Slice<T>> rows;
+            numeric::memory::Buffer<T> storage;
             
             void initializeSlices() {
                 for (std::size_t i = 0; i < nrows; i++) {
@@ -70,22 +93,26 @@ namespace numeric {
             }
 
         public:
+            using value_type = T;
+            
             /**
              * \brief Constructs a nrows x ncols empty matrix.
              * 
              * \param nrows Number of rows.
              * \param ncols Number of columns in matrix.
+             * \param resource The memory resource to allocate from.
              * 
              * \return Matrix<T> (rows x cols)
              * 
              * */
             Matrix(
                 const std::size_t& nrows, 
-                const std::size_t& ncols
+                const std::size_t& ncols,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
             ): nrows {nrows}, 
                 ncols {ncols}, 
-                rows {std::make_unique<thesoup::types::Slice<T>[]>(nrows)},
-                storage {std::make_unique<T[]>(nrows * ncols)} {
+                rows {numeric::memory::make_buffer<thesoup::types::Slice<T>>(nrows, resource)},
+                storage {numeric::memory::make_buffer<T>(nrows * ncols, resource)} {
                     initializeSlices();
                 }
 
@@ -93,10 +120,14 @@ namespace numeric {
              * \brief Constructs a nrows x ncols matrix from a vector of vectors.
              * 
              * \param vecs vector of vectors of type `T`
+             * \param resource The memory resource to allocate from.
              * 
              * \return Matrix<T>
              * */
-            Matrix(const std::vector<std::vector<T>>& vecs) {
+            Matrix(
+                const std::vector<std::vector<T>>& vecs,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+            ) {
                 if (vecs.size() == 0) {
                     throw std::invalid_argument("Matrix cannot have 0 rows.");
                 } else if (vecs[0].size() == 0) {
@@ -104,8 +135,8 @@ namespace numeric {
                 } else {
                     nrows = vecs.size();
                     ncols = vecs[0].size();
-                    rows = std::make_unique<thesoup::types::Slice<T>[]>(nrows);
-                    storage = std::make_unique<T[]>(nrows * ncols);
+                    rows = numeric::memory::make_buffer<thesoup::types::Slice<T>>(nrows, resource);
+                    storage = numeric::memory::make_buffer<T>(nrows * ncols, resource);
                     
                     for (std::size_t i = 0; i < nrows; i++) {
                         if (vecs[i].size() != ncols) {
@@ -119,6 +150,59 @@ namespace numeric {
                 }
             }
 
+            /**
+             * \brief Constructs a matrix from an expression.
+             * 
+             * The expression (like `A + 2*B - C`) is evaluated in a single pass directly into the new matrix.
+             * 
+             * \param expr The matrix expression.
+             * \param resource The memory resource to allocate from.
+             * 
+             * The constructor is explicit if the element type of the expression is not T.
+             * 
+             * \return Matrix<T>
+             * */
+            template <typename E, typename std::enable_if<std::is_same<typename E::value_type, T>::value, int>::type=0> Matrix(
+                const MatrixExpression<E>& expr,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+            ): Matrix(expr.self().getRows(), expr.self().getCols(), resource) {
+                evaluate_into(rows.get(), expr.self());
+            }
+
+            //! \cond NO_DOC
+            template <typename E, typename std::enable_if<!std::is_same<typename E::value_type, T>::value, int>::type=0> explicit Matrix(
+                const MatrixExpression<E>& expr,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+            ): Matrix(expr.self().getRows(), expr.self().getCols(), resource) {
+                evaluate_into(rows.get(), expr.self());
+            }
+            //! \endcond
+            
+            /**
+             * \brief Assign an expression to this matrix.
+             * 
+             * The expression is evaluated in a single pass. The existing storage is reused if the dimensions match, and
+             * the expression may refer to this matrix (as in `m = m + n`). If it reads this matrix through a view that
+             * moves the elements around (as in `m = m.transpose()`), it is evaluated into new storage instead.
+             * 
+             * \param expr The matrix expression.
+             * 
+             * \return Mutable reference to this matrix.
+             * */
+            template <typename E> Matrix<T>& operator=(const MatrixExpression<E>& expr) {
+                if (expr.self().getRows() != nrows || expr.self().getCols() != ncols ||
+                    expr.self().aliases(StorageMapping {rows.get(), 0, 0, false})) {
+                    Matrix<T> fresh {expr, get_resource()};
+                    nrows = fresh.nrows;
+                    ncols = fresh.ncols;
+                    rows = std::move(fresh.rows);
+                    storage = std::move(fresh.storage);
+                } else {
+                    evaluate_into(rows.get(), expr.self());
+                }
+                return *this;
+            }
+
             Matrix(const Matrix<T>& other)=delete;
             void operator=(const Matrix<T> other)=delete;
 
@@ -137,6 +221,13 @@ namespace numeric {
                 other.storage = nullptr;
             }
 
+            /**
+             * \brief The memory resource the matrix was allocated from.
+             * */
+            std::pmr::memory_resource* get_resource() const {
+                return storage.get_deleter().resource;
+            }
+
             thesoup::types::Slice<T>& operator[](const std::size_t& row) {
                 if (row >= nrows) {
                     throw std::out_of_range("Matrix row index out of range.");
@@ -152,22 +243,148 @@ namespace numeric {
                 return rows[row];
             }
 
+            /**
+             * \brief Unchecked pointer to the first element of a row.
+             * 
+             * The row index is only checked with `assert`, so this costs nothing in release builds.
+             * 
+             * \param row The row index.
+             * 
+             * \return T* Pointer to `getCols()` contiguous elements.
+             * */
+            T* rowPtr(const std::size_t& row) {
+                assert(row < nrows);
+                return rows[row].start;
+            }
+            
+            //! \cond NO_DOC
+            const T* rowPtr(const std::size_t& row) const {
+                assert(row < nrows);
+                return rows[row].start;
+            }
+            //! \endcond
+            
+            /**
+             * \brief Unchecked element access.
+             * 
+             * The indices are only checked with `assert`, so this costs nothing in release builds.
+             * 
+             * \param row The row index.
+             * 
+             * \param col The column index.
+             * 
+             * \return T& Reference to the element.
+             * */
+            T& atUnchecked(const std::size_t& row, const std::size_t& col) {
+                assert(row < nrows && col < ncols);
+                return rows[row].start[col];
+            }
+            
+            //! \cond NO_DOC
+            const T& atUnchecked(const std::size_t& row, const std::size_t& col) const {
+                assert(row < nrows && col < ncols);
+                return rows[row].start[col];
+            }
+            //! \endcond
+
             const thesoup::types::Slice<T>* begin() const {
-                return &rows[0];
+                return rows.get();
             }
 
             const thesoup::types::Slice<T>* end() const {
-                return &rows[nrows];
+                return rows.get() + nrows;
             }
 
             thesoup::types::Slice<T>* begin() {
-                return &rows[0];
+                return rows.get();
             }
 
             thesoup::types::Slice<T>* end() {
-                return &rows[nrows];
+                return rows.get() + nrows;
+            }
+
+            /**
+             * \brief A mutable view on the whole matrix. See `MatrixView`.
+             * */
+            MatrixView<T> view() {
+                return MatrixView<T> {rows.get(), nrows, ncols};
+            }
+
+            //! \cond NO_DOC
+            ConstMatrixView<T> view() const {
+                return ConstMatrixView<T> {rows.get(), nrows, ncols};
+            }
+            //! \endcond
+
+            /**
+             * \brief A view on the `numRows x numCols` block starting at (`row`, `col`). Nothing is copied.
+             * 
+             * \throw e std::out_of_range if the block does not fit in the matrix.
+             * */
+            MatrixView<T> submatrix(
+                const std::size_t& row,
+                const std::size_t& col,
+                const std::size_t& numRows,
+                const std::size_t& numCols
+            ) {
+                return view().submatrix(row, col, numRows, numCols);
+            }
+
+            //! \cond NO_DOC
+            ConstMatrixView<T> submatrix(
+                const std::size_t& row,
+                const std::size_t& col,
+                const std::size_t& numRows,
+                const std::size_t& numCols
+            ) const {
+                return view().submatrix(row, col, numRows, numCols);
+            }
+            //! \endcond
+
+            /**
+             * \brief A view on `count` consecutive rows, starting at `first`. Nothing is copied.
+             * 
+             * \throw e std::out_of_range if the rows do not fit in the matrix.
+             * */
+            MatrixView<T> rowRange(const std::size_t& first, const std::size_t& count) {
+                return view().rowRange(first, count);
             }
 
+            //! \cond NO_DOC
+            ConstMatrixView<T> rowRange(const std::size_t& first, const std::size_t& count) const {
+                return view().rowRange(first, count);
+            }
+            //! \endcond
+
+            /**
+             * \brief A view on a column, as a `getRows() x 1` matrix. Nothing is copied.
+             * 
+             * \throw e std::out_of_range if the column is out of range.
+             * */
+            MatrixView<T> column(const std::size_t& col) {
+                return view().column(col);
+            }
+
+            //! \cond NO_DOC
+            ConstMatrixView<T> column(const std::size_t& col) const {
+                return view().column(col);
+            }
+            //! \endcond
+
+            /**
+             * \brief A transposed view on the matrix. Nothing is copied; use `Matrix<T> {m.transpose()}` for a transposed
+             * copy.
+             * */
+            MatrixView<T> transpose() {
+                return view().transpose();
+            }
+
+            //! \cond NO_DOC
+            ConstMatrixView<T> transpose() const {
+                return view().transpose();
+            }
+            //! \endcond
+
             /**             * 
              * \brief Identity matrix generator.
              * 
@@ -253,11 +470,13 @@ namespace numeric {
                 const std::size_t& r2,
                 const T& b
             ) {
-                if (r1 > nrows || r2 > nrows) {
+                if (r1 >= nrows || r2 >= nrows) {
                     throw std::out_of_range("Row access out of range.");
                 } else {
+                    T* dest {rows[r1].start};
+                    const T* src {rows[r2].start};
                     for (std::size_t i = 0; i < ncols; i++) {
-                        rows[r1][i] = a*rows[r1][i] + b*rows[r2][i];
+                        dest[i] = a*dest[i] + b*src[i];
                     }
                     return *this;
                 }
@@ -276,14 +495,108 @@ namespace numeric {
              * \return Mutable reference to this matrix.
              * */
             Matrix<T>& exchangeRows(const std::size_t& r1, const std::size_t& r2) {
-                if (r1 > nrows || r2 > nrows) {
+                if (r1 >= nrows || r2 >= nrows) {
                     throw std::out_of_range("Row access out of range.");
                 } else {
+                    numeric::benchmark::record_row_swap();
                     std::swap(rows[r1].start, rows[r2].start);
                     return *this;
                 }
             }
 
+            /**
+             * \brief Apply a row permutation by reordering the row pointers. No elements are copied.
+             * 
+             * Row i of the matrix becomes what was row `permutation[i]`. For example, replaying the permutation `rref`
+             * recorded on one matrix, on another one.
+             * 
+             * \param permutation The permutation.
+             * 
+             * \throw e std::invalid_argument if the size of the permutation is not the number of rows.
+             * 
+             * \return Mutable reference to this matrix.
+             * */
+            Matrix<T>& permuteRows(const Permutation& permutation) {
+                if (permutation.size() != nrows) {
+                    throw std::invalid_argument("Permutation size does not match the number of rows.");
+                }
+                std::vector<T*> starts(nrows);
+                for (std::size_t i = 0; i < nrows; i++) {
+                    starts[i] = rows[permutation[i]].start;
+                }
+                for (std::size_t i = 0; i < nrows; i++) {
+                    rows[i].start = starts[i];
+                }
+                return *this;
+            }
+
+            /**
+             * \brief The permutation of the rows relative to the storage.
+             * 
+             * Row i of the matrix is row `row_permutation()[i]` of the underlying row major buffer. This is the identity
+             * after construction and after `compact`, and every `exchangeRows` since then is a swap in it, so its sign is
+             * the sign of those exchanges.
+             * */
+            Permutation row_permutation() const {
+                std::vector<std::size_t> order(nrows);
+                for (std::size_t i = 0; i < nrows; i++) {
+                    order[i] = ncols == 0? i : static_cast<std::size_t>(rows[i].start - storage.get())/ncols;
+                }
+                return Permutation {std::move(order)};
+            }
+
+            /**
+             * \brief Whether the rows are in row major order in the storage, that is, no row exchanges are pending.
+             * */
+            bool isContiguous() const {
+                for (std::size_t i = 0; i < nrows; i++) {
+                    if (rows[i].start != storage.get() + i*ncols) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /**
+             * \brief Move the elements so that the rows are in row major order in the storage again.
+             * 
+             * After this, `rowPtr(0)` is a flat `getRows()` x `getCols()` buffer, as kernels and writers of flat buffers
+             * expect. The rows are moved along the cycles of the row permutation, so every row that is out of place is
+             * moved exactly once, as a whole, through a single row of scratch space. This is a no op on a contiguous
+             * matrix.
+             * 
+             * \return Mutable reference to this matrix.
+             * */
+            Matrix<T>& compact() {
+                if (isContiguous()) {
+                    return *this;
+                }
+                T* base {storage.get()};
+                std::vector<std::size_t> source(nrows);
+                for (std::size_t i = 0; i < nrows; i++) {
+                    source[i] = static_cast<std::size_t>(rows[i].start - base)/ncols;
+                }
+                numeric::memory::Buffer<T> scratch {numeric::memory::make_buffer<T>(ncols, get_resource())};
+                std::vector<bool> done(nrows, false);
+                for (std::size_t i = 0; i < nrows; i++) {
+                    if (done[i] || source[i] == i) {
+                        continue;
+                    }
+                    // Stored row i is overwritten first, so park it, then pull every row of the cycle into place.
+                    std::move(base + i*ncols, base + (i + 1)*ncols, scratch.get());
+                    std::size_t j {i};
+                    while (source[j] != i) {
+                        std::move(base + source[j]*ncols, base + (source[j] + 1)*ncols, base + j*ncols);
+                        done[j] = true;
+                        j = source[j];
+                    }
+                    std::move(scratch.get(), scratch.get() + ncols, base + j*ncols);
+                    done[j] = true;
+                }
+                initializeSlices();
+                return *this;
+            }
+
             /**
              * \brief Scale a row.
              * 
@@ -297,11 +610,12 @@ namespace numeric {
              * \return Mutable reference to this matrix.
              * */
             Matrix<T>& scaleRow(const std::size_t& row, const T& factor) {
-                if (row > nrows) {
+                if (row >= nrows) {
                     throw std::out_of_range("Row access out of range.");
                 }
-                for (auto& elem : rows[row]) {
-                    elem *= factor;
+                T* elems {rows[row].start};
+                for (std::size_t i = 0; i < ncols; i++) {
+                    elems[i] *= factor;
                 }
                 return *this;
             }
@@ -325,70 +639,122 @@ namespace numeric {
             }
         };
         
-        // Override add operator
-        template <typename T> Matrix<T> operator+(const Matrix<T>& lhs, const Matrix<T>& rhs) {
-            if (lhs.getRows() != rhs.getRows() || lhs.getCols() != rhs.getCols()) {
-                throw std::invalid_argument("Matrices of different dimensions cannot be added");
-            }
-            Matrix<T> retval {lhs.getRows(), lhs.getCols()};
-            for (std::size_t i = 0; i < lhs.getRows(); i++) {
-                for (std::size_t j = 0; j < lhs.getCols(); j++) {
-                    retval[i][j] = lhs[i][j] + rhs[i][j];
-                }
-            }
-            return retval;
-        }
+        //! \cond NO_DOC
+        template <typename E> Matrix(const MatrixExpression<E>&) -> Matrix<typename E::value_type>;
+        //! \endcond
         
-        // Override subtract operator
-        template <typename T> Matrix<T> operator-(const Matrix<T>& lhs, const Matrix<T>& rhs) {
-            if (lhs.getRows() != rhs.getRows() || lhs.getCols() != rhs.getCols()) {
-                throw std::invalid_argument("Matrices of different dimensions cannot be added");
-            }
-            Matrix<T> retval {lhs.getRows(), lhs.getCols()};
-            for (std::size_t i = 0; i < lhs.getRows(); i++) {
-                for (std::size_t j = 0; j < lhs.getCols(); j++) {
-                    retval[i][j] = lhs[i][j] - rhs[i][j];
-                }
-            }
-            return retval;
-        }
-        
-        // Override multiply operator.
+        // Override multiply operator. The products allocate their result from the memory resource of lhs.
         template <typename T> Matrix<T> operator*(const Matrix<T>& lhs, const Matrix<T>& rhs) {
+            const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::MATRIX_MATRIX};
             if (lhs.getCols() != rhs.getRows()) {
                 throw std::invalid_argument("Incompatible matrices for multiplication.");
             }
-            Matrix<T> retval {lhs.getRows(), rhs.getCols()};
+            Matrix<T> retval {lhs.getRows(), rhs.getCols(), lhs.get_resource()};
             
-            for (std::size_t i = 0; i < lhs.getRows(); i++) {
-                
-                for (std::size_t j = 0; j < rhs.getCols(); j++) {
+            if constexpr (numeric::kernels::HasGemmKernel<T>::value) {
+                // Floating point types go through the blocked engine. The result is value initialized (0).
+                numeric::kernels::gemm(lhs.getRows(), rhs.getCols(), lhs.getCols(), lhs.begin(), rhs.begin(), retval.begin());
+            } else {
+                for (std::size_t i = 0; i < lhs.getRows(); i++) {
+                    const T* lhsRow {lhs.rowPtr(i)};
+                    T* dest {retval.rowPtr(i)};
                     
-                    T sum = static_cast<T>(0);
-                    for (std::size_t k = 0; k < lhs.getCols(); k++) {
-                            sum += lhs[i][k] * rhs[k][j];
+                    for (std::size_t j = 0; j < rhs.getCols(); j++) {
+                        
+                        T sum = static_cast<T>(0);
+                        for (std::size_t k = 0; k < lhs.getCols(); k++) {
+                                sum += lhsRow[k] * rhs.atUnchecked(k, j);
+                        }
+                        dest[j] = sum;
                     }
-                    retval[i][j] = sum;
                 }
             }
             return retval;
         }
         
+        //! \cond NO_DOC
+        namespace detail {
+            // A view that is not transposed is multiplied through its row slices, so the blocked engine applies to
+            // floating point blocks too. A transposed operand is copied once for that (O(n^2) against the O(n^3) product).
+            template <typename T> Matrix<T> multiplyViews(
+                const ConstMatrixView<T>& lhs,
+                const ConstMatrixView<T>& rhs,
+                std::pmr::memory_resource* resource
+            ) {
+                if (lhs.getCols() != rhs.getRows()) {
+                    throw std::invalid_argument("Incompatible matrices for multiplication.");
+                }
+                if constexpr (numeric::kernels::HasGemmKernel<T>::value) {
+                    if (lhs.isTransposed()) {
+                        const Matrix<T> copy {lhs};
+                        return multiplyViews(copy.view(), rhs, resource);
+                    } else if (rhs.isTransposed()) {
+                        const Matrix<T> copy {rhs};
+                        return multiplyViews(lhs, copy.view(), resource);
+                    }
+                }
+                Matrix<T> retval {lhs.getRows(), rhs.getCols(), resource};
+                if constexpr (numeric::kernels::HasGemmKernel<T>::value) {
+                    std::vector<thesoup::types::Slice<T>> lhsRows(lhs.getRows());
+                    std::vector<thesoup::types::Slice<T>> rhsRows(rhs.getRows());
+                    for (std::size_t i = 0; i < lhs.getRows(); i++) {
+                        lhsRows[i] = lhs.rowSlice(i);
+                    }
+                    for (std::size_t i = 0; i < rhs.getRows(); i++) {
+                        rhsRows[i] = rhs.rowSlice(i);
+                    }
+                    numeric::kernels::gemm(lhs.getRows(), rhs.getCols(), lhs.getCols(), lhsRows.data(), rhsRows.data(), retval.begin());
+                } else {
+                    for (std::size_t i = 0; i < lhs.getRows(); i++) {
+                        T* dest {retval.rowPtr(i)};
+                        for (std::size_t j = 0; j < rhs.getCols(); j++) {
+                            T sum = static_cast<T>(0);
+                            for (std::size_t k = 0; k < lhs.getCols(); k++) {
+                                sum += lhs.atUnchecked(i, k) * rhs.atUnchecked(k, j);
+                            }
+                            dest[j] = sum;
+                        }
+                    }
+                }
+                return retval;
+            }
+        }
+        //! \endcond
+
+        // Override multiply operator for views. The products of views allocate from the default memory resource.
+        template <typename T> Matrix<T> operator*(const ConstMatrixView<T>& lhs, const ConstMatrixView<T>& rhs) {
+            const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::MATRIX_MATRIX};
+            return detail::multiplyViews(lhs, rhs, std::pmr::get_default_resource());
+        }
+
+        template <typename T> Matrix<T> operator*(const Matrix<T>& lhs, const ConstMatrixView<T>& rhs) {
+            const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::MATRIX_MATRIX};
+            return detail::multiplyViews(lhs.view(), rhs, lhs.get_resource());
+        }
+
+        template <typename T> Matrix<T> operator*(const ConstMatrixView<T>& lhs, const Matrix<T>& rhs) {
+            const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::MATRIX_MATRIX};
+            return detail::multiplyViews(lhs, rhs.view(), std::pmr::get_default_resource());
+        }
+
         // Override multiply operator  lhs = matrix and rhs = vector.
         template <typename T> numeric::types::Vector<T> operator*(const Matrix<T>& lhs, const numeric::types::Vector<T>& rhs) {
+            const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::MATRIX_VECTOR};
             if (lhs.getCols() != rhs.size()) {
                 throw std::invalid_argument("Incompatible matrix and vector for multiplication.");
             }
             
-            Vector<T> retval(lhs.getRows());
-            
+            Vector<T> retval(lhs.getRows(), lhs.get_resource());
+            const T* src {rhs.data()};
+            T* dest {retval.data()};
             
             for (std::size_t i = 0; i < lhs.getRows(); i++) {
+                const T* row {lhs.rowPtr(i)};
                 T sum = static_cast<T>(0);
                 for (std::size_t k = 0; k < lhs.getCols(); k++) {
-                    sum += lhs[i][k] * rhs[k];
+                    sum += row[k] * src[k];
                 }
-                retval[i] = sum;
+                dest[i] = sum;
             }
             
             return retval;
@@ -396,24 +762,69 @@ namespace numeric {
         
         // Override multiply operator lhs = vector and rhs = matrix.
         template <typename T> numeric::types::Vector<T> operator*(const numeric::types::Vector<T>& lhs, const Matrix<T>& rhs) {
+            const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::MATRIX_VECTOR};
             if (lhs.size() != rhs.getRows()) {
                 throw std::invalid_argument("Incompatible matrix and vector for multiplication.");
             }
             
-            Vector<T> retval(rhs.getCols());
+            Vector<T> retval(rhs.getCols(), lhs.get_resource());
+            const T* src {lhs.data()};
+            T* dest {retval.data()};
+            for (std::size_t i = 0; i < rhs.getCols(); i++) {
+                dest[i] = static_cast<T>(0);
+            }
             
+            // Accumulate scaled rows instead of walking down the columns, so that the matrix is read row by row.
+            for (std::size_t k = 0; k < rhs.getRows(); k++) {
+                const T* row {rhs.rowPtr(k)};
+                const T factor {src[k]};
+                for (std::size_t i = 0; i < rhs.getCols(); i++) {
+                    dest[i] += row[i] * factor;
+                }
+            }
             
+            return retval;
+        }
+
+        // Override multiply operator lhs = view and rhs = vector.
+        template <typename T> numeric::types::Vector<T> operator*(const ConstMatrixView<T>& lhs, const numeric::types::Vector<T>& rhs) {
+            const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::MATRIX_VECTOR};
+            if (lhs.getCols() != rhs.size()) {
+                throw std::invalid_argument("Incompatible matrix and vector for multiplication.");
+            }
+
+            Vector<T> retval(lhs.getRows());
+            const T* src {rhs.data()};
+            T* dest {retval.data()};
+            for (std::size_t i = 0; i < lhs.getRows(); i++) {
+                T sum = static_cast<T>(0);
+                for (std::size_t k = 0; k < lhs.getCols(); k++) {
+                    sum += lhs.atUnchecked(i, k) * src[k];
+                }
+                dest[i] = sum;
+            }
+            return retval;
+        }
+
+        // Override multiply operator lhs = vector and rhs = view.
+        template <typename T> numeric::types::Vector<T> operator*(const numeric::types::Vector<T>& lhs, const ConstMatrixView<T>& rhs) {
+            const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::MATRIX_VECTOR};
+            if (lhs.size() != rhs.getRows()) {
+                throw std::invalid_argument("Incompatible matrix and vector for multiplication.");
+            }
+
+            Vector<T> retval(rhs.getCols(), lhs.get_resource());
+            const T* src {lhs.data()};
+            T* dest {retval.data()};
             for (std::size_t i = 0; i < rhs.getCols(); i++) {
                 T sum = static_cast<T>(0);
                 for (std::size_t k = 0; k < rhs.getRows(); k++) {
-                    sum += rhs[k][i] * lhs[k];
+                    sum += src[k] * rhs.atUnchecked(k, i);
                 }
-                retval[i] = sum;
+                dest[i] = sum;
             }
-            
             return retval;
         }
-        
     }
 }
 
@@ -0,0 +1,414 @@
+#ifndef __SIGABRT_NUMERIC_MATRIXVIEW__
+#define __SIGABRT_NUMERIC_MATRIXVIEW__
+
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <numeric/benchmark/instrumentation.hpp>
+#include <numeric/types/expressions.hpp>
+
+#include <thesoup/types/types.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::types
+     *
+     * \brief The namespace containing some special types.
+     * */
+    namespace types {
+        //! \cond NO_DOC
+        template <typename T> class MatrixView;
+        //! \endcond
+
+        /**
+         * \class ConstMatrixView
+         *
+         * \tparam T Some numeric type
+         *
+         * \brief A read only window on (a block of) a matrix, possibly transposed, that shares the storage of the matrix.
+         *
+         * A view is a handle: it is cheap to copy, and never allocates. It is made of the row table of the matrix it looks
+         * at, an offset, the dimensions, and a transposed flag. Get one from `Matrix::view`, `submatrix`, `rowRange`,
+         * `column` or `transpose`, or build one over any row table (for instance over the data of a few `Vector`s).
+         * Views of views compose, so `m.transpose().submatrix(1, 1, 2, 2)` is still a view on `m`.
+         *
+         * Because the view goes through the row table of the matrix, it follows the rows of the matrix through
+         * `exchangeRows`. A view must not outlive its matrix, and is invalidated when the matrix is assigned an expression
+         * of different dimensions.
+         *
+         * A view is a matrix expression, so it can be used in `+`, `-` and scaling, and a `Matrix` can be constructed from
+         * it (which copies the elements). Products with matrices, vectors and other views are defined in `matrix.hpp`.
+         *
+         * Rows of a view that is not transposed are contiguous (`rowSlice`). Rows of a transposed view are strided.
+         * */
+        template <typename T> class ConstMatrixView: public MatrixExpression<ConstMatrixView<T>> {
+        protected:
+            const thesoup::types::Slice<T>* rows;
+            std::size_t firstRow;
+            std::size_t firstCol;
+            std::size_t nrows;
+            std::size_t ncols;
+            bool flipped;
+
+            // The mutable pointers live in the slices, so a const row table still gives mutable elements to MatrixView.
+            T& element(const std::size_t& row, const std::size_t& col) const {
+                return flipped? rows[firstRow + col].start[firstCol + row] : rows[firstRow + row].start[firstCol + col];
+            }
+
+            ConstMatrixView(
+                const thesoup::types::Slice<T>* rows,
+                const std::size_t& firstRow,
+                const std::size_t& firstCol,
+                const std::size_t& nrows,
+                const std::size_t& ncols,
+                const bool& flipped
+            ): rows {rows}, firstRow {firstRow}, firstCol {firstCol}, nrows {nrows}, ncols {ncols}, flipped {flipped} {}
+
+            ConstMatrixView<T> block(
+                const std::size_t& row,
+                const std::size_t& col,
+                const std::size_t& numRows,
+                const std::size_t& numCols
+            ) const {
+                if (row + numRows > nrows || col + numCols > ncols) {
+                    throw std::out_of_range("Submatrix out of range.");
+                }
+                return flipped?
+                    ConstMatrixView<T> {rows, firstRow + col, firstCol + row, numRows, numCols, true} :
+                    ConstMatrixView<T> {rows, firstRow + row, firstCol + col, numRows, numCols, false};
+            }
+
+        public:
+            using value_type = T;
+
+            /**
+             * \brief Constructs a view over a row table.
+             *
+             * \param rows A table of `nrows` slices, each with at least `ncols` elements.
+             * \param nrows Number of rows.
+             * \param ncols Number of columns.
+             * */
+            ConstMatrixView(
+                const thesoup::types::Slice<T>* rows,
+                const std::size_t& nrows,
+                const std::size_t& ncols
+            ): ConstMatrixView(rows, 0, 0, nrows, ncols, false) {}
+
+            /**
+             * \brief Get the number of rows in the view.
+             * */
+            std::size_t getRows() const {
+                return nrows;
+            }
+
+            /**
+             * \brief Get the number of columns in the view.
+             * */
+            std::size_t getCols() const {
+                return ncols;
+            }
+
+            /**
+             * \brief Whether the view is transposed with respect to the storage, that is whether its rows are strided.
+             * */
+            bool isTransposed() const {
+                return flipped;
+            }
+
+            /**
+             * \brief Element access.
+             *
+             * \throw e std::out_of_range if the indices are out of the view.
+             * */
+            const T& at(const std::size_t& row, const std::size_t& col) const {
+                if (row >= nrows || col >= ncols) {
+                    throw std::out_of_range("Matrix view index out of range.");
+                }
+                return element(row, col);
+            }
+
+            /**
+             * \brief Unchecked element access. The indices are only checked with `assert`.
+             * */
+            const T& atUnchecked(const std::size_t& row, const std::size_t& col) const {
+                assert(row < nrows && col < ncols);
+                return element(row, col);
+            }
+
+            //! \cond NO_DOC
+            const T& eval(const std::size_t& row, const std::size_t& col) const {
+                return element(row, col);
+            }
+
+            bool aliases(const StorageMapping& dest) const {
+                return dest.table == rows && !(dest == mapping());
+            }
+            //! \endcond
+
+            /**
+             * \brief Where the elements of this view live.
+             * */
+            StorageMapping mapping() const {
+                return StorageMapping {rows, firstRow, firstCol, flipped};
+            }
+
+            /**
+             * \brief A row of a view that is not transposed, as a contiguous slice. Only checked with `assert`.
+             * */
+            thesoup::types::Slice<T> rowSlice(const std::size_t& row) const {
+                assert(!flipped && row < nrows);
+                return thesoup::types::Slice<T> {rows[firstRow + row].start + firstCol, ncols};
+            }
+
+            /**
+             * \brief A view on the `numRows x numCols` block starting at (`row`, `col`).
+             *
+             * \throw e std::out_of_range if the block does not fit in this view.
+             * */
+            ConstMatrixView<T> submatrix(
+                const std::size_t& row,
+                const std::size_t& col,
+                const std::size_t& numRows,
+                const std::size_t& numCols
+            ) const {
+                return block(row, col, numRows, numCols);
+            }
+
+            /**
+             * \brief A view on `count` consecutive rows, starting at `first`.
+             *
+             * \throw e std::out_of_range if the rows do not fit in this view.
+             * */
+            ConstMatrixView<T> rowRange(const std::size_t& first, const std::size_t& count) const {
+                return block(first, 0, count, ncols);
+            }
+
+            /**
+             * \brief A view on column `col`, as a `getRows() x 1` matrix.
+             *
+             * \throw e std::out_of_range if the column is out of this view.
+             * */
+            ConstMatrixView<T> column(const std::size_t& col) const {
+                return block(0, col, nrows, 1);
+            }
+
+            /**
+             * \brief A transposed view. Nothing moves, the indices are swapped on access.
+             * */
+            ConstMatrixView<T> transpose() const {
+                return ConstMatrixView<T> {rows, firstRow, firstCol, ncols, nrows, !flipped};
+            }
+        };
+
+        /**
+         * \class MatrixView
+         *
+         * \tparam T Some numeric type
+         *
+         * \brief A mutable window on (a block of) a matrix, which shares the storage of the matrix.
+         *
+         * Same as `ConstMatrixView`, and converts to it, but the elements can be modified through the view. It has the row
+         * operations of `Matrix` (`linearCombRows`, `exchangeRows`, `scaleRow` and `scale`), so in place algorithms like
+         * `rref` can run on a block of a matrix. They only touch the elements inside the view: `exchangeRows` swaps
+         * elements, not the rows of the matrix.
+         *
+         * Assigning a matrix expression (or another view) to a view writes the elements into the matrix, like
+         * `a.submatrix(0, 0, 2, 2) = b.transpose()`. The dimensions have to match. Copying a view (the copy constructor)
+         * still gives another handle on the same elements.
+         * */
+        template <typename T> class MatrixView: public ConstMatrixView<T> {
+        private:
+            explicit MatrixView(const ConstMatrixView<T>& other): ConstMatrixView<T>(other) {}
+
+            template <typename E> void assign(const E& expr) {
+                if (expr.getRows() != this->nrows || expr.getCols() != this->ncols) {
+                    throw std::invalid_argument("Cannot assign an expression of different dimensions to a matrix view.");
+                }
+                if (expr.aliases(this->mapping())) {
+                    std::vector<T> scratch(this->nrows*this->ncols);
+                    for (std::size_t i = 0; i < this->nrows; i++) {
+                        for (std::size_t j = 0; j < this->ncols; j++) {
+                            scratch[i*this->ncols + j] = static_cast<T>(expr.eval(i, j));
+                        }
+                    }
+                    for (std::size_t i = 0; i < this->nrows; i++) {
+                        for (std::size_t j = 0; j < this->ncols; j++) {
+                            this->element(i, j) = std::move(scratch[i*this->ncols + j]);
+                        }
+                    }
+                } else {
+                    for (std::size_t i = 0; i < this->nrows; i++) {
+                        for (std::size_t j = 0; j < this->ncols; j++) {
+                            this->element(i, j) = static_cast<T>(expr.eval(i, j));
+                        }
+                    }
+                }
+            }
+
+            void checkRow(const std::size_t& row) const {
+                if (row >= this->nrows) {
+                    throw std::out_of_range("Row access out of range.");
+                }
+            }
+
+        public:
+            /**
+             * \brief Constructs a mutable view over a row table.
+             *
+             * \param rows A table of `nrows` slices, each with at least `ncols` elements.
+             * \param nrows Number of rows.
+             * \param ncols Number of columns.
+             * */
+            MatrixView(
+                thesoup::types::Slice<T>* rows,
+                const std::size_t& nrows,
+                const std::size_t& ncols
+            ): ConstMatrixView<T>(rows, nrows, ncols) {}
+
+            MatrixView(const MatrixView<T>& other)=default;
+
+            /**
+             * \brief Assign the elements of another view. See the class description.
+             *
+             * \throw e std::invalid_argument if the dimensions are different.
+             * */
+            MatrixView<T>& operator=(const MatrixView<T>& other) {
+                assign(static_cast<const ConstMatrixView<T>&>(other));
+                return *this;
+            }
+
+            /**
+             * \brief Assign an expression. It is evaluated into a temporary first if it reads this view's elements in a
+             * different order (for instance a transpose of the view itself).
+             *
+             * \throw e std::invalid_argument if the dimensions are different.
+             * */
+            template <typename E> MatrixView<T>& operator=(const MatrixExpression<E>& expr) {
+                assign(expr.self());
+                return *this;
+            }
+
+            /**
+             * \brief Element access.
+             *
+             * \throw e std::out_of_range if the indices are out of the view.
+             * */
+            T& at(const std::size_t& row, const std::size_t& col) const {
+                if (row >= this->nrows || col >= this->ncols) {
+                    throw std::out_of_range("Matrix view index out of range.");
+                }
+                return this->element(row, col);
+            }
+
+            /**
+             * \brief Unchecked element access. The indices are only checked with `assert`.
+             * */
+            T& atUnchecked(const std::size_t& row, const std::size_t& col) const {
+                assert(row < this->nrows && col < this->ncols);
+                return this->element(row, col);
+            }
+
+            //! \cond NO_DOC
+            MatrixView<T> submatrix(
+                const std::size_t& row,
+                const std::size_t& col,
+                const std::size_t& numRows,
+                const std::size_t& numCols
+            ) const {
+                return MatrixView<T> {this->block(row, col, numRows, numCols)};
+            }
+
+            MatrixView<T> rowRange(const std::size_t& first, const std::size_t& count) const {
+                return MatrixView<T> {this->block(first, 0, count, this->ncols)};
+            }
+
+            MatrixView<T> column(const std::size_t& col) const {
+                return MatrixView<T> {this->block(0, col, this->nrows, 1)};
+            }
+
+            MatrixView<T> transpose() const {
+                return MatrixView<T> {ConstMatrixView<T>::transpose()};
+            }
+            //! \endcond
+
+            /**
+             * \brief Linear combination of rows, R1 -> aR1 + bR2. See `Matrix::linearCombRows`.
+             *
+             * \throw e std::out_of_range if either r1 or r2 exeeds the rows of the view.
+             * */
+            const MatrixView<T>& linearCombRows(
+                const std::size_t& r1,
+                const T& a,
+                const std::size_t& r2,
+                const T& b
+            ) const {
+                checkRow(r1);
+                checkRow(r2);
+                if (!this->flipped) {
+                    T* dest {this->rowSlice(r1).start};
+                    const T* src {this->rowSlice(r2).start};
+                    for (std::size_t j = 0; j < this->ncols; j++) {
+                        dest[j] = a*dest[j] + b*src[j];
+                    }
+                } else {
+                    for (std::size_t j = 0; j < this->ncols; j++) {
+                        T& dest {this->element(r1, j)};
+                        dest = a*dest + b*this->element(r2, j);
+                    }
+                }
+                return *this;
+            }
+
+            /**
+             * \brief Exchange 2 rows of the view, element by element.
+             *
+             * \throw e std::out_of_range if either r1 or r2 exeeds the rows of the view.
+             * */
+            const MatrixView<T>& exchangeRows(const std::size_t& r1, const std::size_t& r2) const {
+                checkRow(r1);
+                checkRow(r2);
+                numeric::benchmark::record_row_swap();
+                if (r1 != r2) {
+                    for (std::size_t j = 0; j < this->ncols; j++) {
+                        std::swap(this->element(r1, j), this->element(r2, j));
+                    }
+                }
+                return *this;
+            }
+
+            /**
+             * \brief Scale a row by a factor.
+             *
+             * \throw e std::out_of_range if the row exeeds the rows of the view.
+             * */
+            const MatrixView<T>& scaleRow(const std::size_t& row, const T& factor) const {
+                checkRow(row);
+                for (std::size_t j = 0; j < this->ncols; j++) {
+                    this->element(row, j) *= factor;
+                }
+                return *this;
+            }
+
+            /**
+             * \brief Scale every element of the view by a scalar.
+             * */
+            const MatrixView<T>& scale(const T& scalar) const {
+                for (std::size_t i = 0; i < this->nrows; i++) {
+                    scaleRow(i, scalar);
+                }
+                return *this;
+            }
+        };
+    }
+}
+
+#endif
@@ -7,7 +7,9 @@
 #include <type_traits>
 #include <vector>
 
+#include <numeric/types/bigint.hpp>
 #include <numeric/types/fraction.hpp>
+#include <numeric/types/rational.hpp>
 
 /**
  * \namespace numeric
@@ -21,6 +23,53 @@ namespace numeric {
      * \brief Sub namespace with all numeric classes and functions.
      * */
     namespace types {
+        /**
+         * \class TimingStatistics
+         *
+         * \brief The distribution of the time per iteration of a benchmark, over its samples, in nanoseconds.
+         *
+         * Negative values mean that nothing was measured. `samples` is the number of samples the statistics are over.
+         * */
+        struct TimingStatistics {
+            double min {-1.0};
+            double median {-1.0};
+            double p99 {-1.0};
+            double mean {-1.0};
+            double stddev {-1.0};
+            unsigned long samples {0};
+        };
+
+        inline bool operator==(const TimingStatistics& lhs, const TimingStatistics& rhs) {
+            return lhs.min == rhs.min &&
+                lhs.median == rhs.median &&
+                lhs.p99 == rhs.p99 &&
+                lhs.mean == rhs.mean &&
+                lhs.stddev == rhs.stddev &&
+                lhs.samples == rhs.samples;
+        }
+
+        /**
+         * \class CounterValues
+         *
+         * \brief Hardware counter readings per iteration of a benchmark.
+         *
+         * `available` is false if the counters were not requested, or could not be opened (not Linux, no permission for
+         * perf events, or no PMU, as in many virtual machines).
+         * */
+        struct CounterValues {
+            bool available {false};
+            double cycles {0.0};
+            double instructions {0.0};
+            double cacheMisses {0.0};
+        };
+
+        inline bool operator==(const CounterValues& lhs, const CounterValues& rhs) {
+            return lhs.available == rhs.available &&
+                lhs.cycles == rhs.cycles &&
+                lhs.instructions == rhs.instructions &&
+                lhs.cacheMisses == rhs.cacheMisses;
+        }
+
         /**
          * \class RunInfo 
          * 
@@ -34,19 +83,28 @@ namespace numeric {
          * \var iterations This field represents the number of iterations  to average over for that input size. 
          * Ideally you would want to have lesser iterations for large inputs.
          * 
-         * \var runTime This field is an output field, representing the execution time for that iteration.
+         * \var runTimeInMillis This field is an output field, representing the mean execution time of 1 iteration, in
+         * milliseconds.
+         * 
+         * \var nanosPerIteration Output field, with the distribution of the time per iteration over the samples.
+         * 
+         * \var counters Output field, with the hardware counters per iteration, if they were requested.
          * 
          * */
         struct RunInfo {
             unsigned long inputSize {0};
             unsigned long iterations {0};
             double runTimeInMillis {-1.0};
+            TimingStatistics nanosPerIteration {};
+            CounterValues counters {};
         };
         
-        bool operator==(const RunInfo& lhs, const RunInfo& rhs) {
+        inline bool operator==(const RunInfo& lhs, const RunInfo& rhs) {
             return lhs.inputSize == rhs.inputSize &&
                 lhs.iterations == rhs.iterations &&
-                lhs.runTimeInMillis == rhs.runTimeInMillis;
+                lhs.runTimeInMillis == rhs.runTimeInMillis &&
+                lhs.nanosPerIteration == rhs.nanosPerIteration &&
+                lhs.counters == rhs.counters;
         }
 
         /**
@@ -69,12 +127,56 @@ namespace numeric {
             T,
             typename std::enable_if<
                 std::is_arithmetic<T>::value ||
-                std::is_same<numeric::types::Fraction, typename std::remove_cv<T>::type>::value
+                std::is_same<numeric::types::Fraction, typename std::remove_cv<T>::type>::value ||
+                std::is_same<numeric::types::LazyFraction, typename std::remove_cv<T>::type>::value ||
+                std::is_same<numeric::types::BigInt, typename std::remove_cv<T>::type>::value ||
+                std::is_same<numeric::types::Rational, typename std::remove_cv<T>::type>::value
             >::type
         > {
             static constexpr bool value {true};
         };
         //! \endcond
+
+        /**
+         * \enum ScalarFamily
+         *
+         * The families of scalar types the algorithms have specialized kernels for. See `ScalarFamilyOf`.
+         *   - `FLOATING_POINT`: `float`, `double` and `long double`. Rounding is expected, so updates are fused and
+         *     vectorized.
+         *   - `INTEGER`: The integral types (but `bool`) and `BigInt`. Division truncates, so eliminations avoid it.
+         *   - `EXACT`: `Fraction`, `LazyFraction` and `Rational`. Every operation is exact and costs a reduction, so
+         *     eliminations do as few of them as possible.
+         *   - `OTHER`: Every other type. These take the generic loops.
+         * */
+        enum class ScalarFamily {
+            FLOATING_POINT,
+            INTEGER,
+            EXACT,
+            OTHER
+        };
+
+        /**
+         * \class ScalarFamilyOf
+         *
+         * \brief The `ScalarFamily` of type `T`, which the algorithms dispatch on with `if constexpr`.
+         *
+         * \tparam T The type under test
+         * */
+        template <typename T> struct ScalarFamilyOf {
+        private:
+            using Type = typename std::remove_cv<T>::type;
+
+        public:
+            static constexpr ScalarFamily value {
+                std::is_floating_point<Type>::value ? ScalarFamily::FLOATING_POINT :
+                (std::is_integral<Type>::value && !std::is_same<bool, Type>::value) ||
+                std::is_same<numeric::types::BigInt, Type>::value ? ScalarFamily::INTEGER :
+                std::is_same<numeric::types::Fraction, Type>::value ||
+                std::is_same<numeric::types::LazyFraction, Type>::value ||
+                std::is_same<numeric::types::Rational, Type>::value ? ScalarFamily::EXACT :
+                ScalarFamily::OTHER
+            };
+        };
     }
 
 }
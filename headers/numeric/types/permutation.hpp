@@ -0,0 +1,175 @@
+#ifndef __SIGABRT_NUMERIC_PERMUTATION__
+#define __SIGABRT_NUMERIC_PERMUTATION__
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <numeric/types/vector.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::types
+     *
+     * \brief The namespace containing some special types.
+     * */
+    namespace types {
+        /**
+         * \class Permutation
+         *
+         * \brief A row permutation P, with its sign.
+         *
+         * Row i of P*A is row `p[i]` of A, the same convention as `LUDecomposition::get_row_permutation`. This is what
+         * `rref` records its row exchanges in, so that they can be reused: `get_sign()` is the sign the exchanges
+         * contribute to a determinant, and `apply` replays them on a new right hand side. `Matrix::permuteRows` applies
+         * one to a matrix without copying elements, and `Matrix::row_permutation` reads back the one a matrix carries.
+         * */
+        class Permutation {
+        private:
+            std::vector<std::size_t> order;
+            int sign;
+
+        public:
+            /**
+             * \brief The identity permutation of size n.
+             * */
+            explicit Permutation(const std::size_t& n=0): order(n), sign {1} {
+                for (std::size_t i = 0; i < n; i++) {
+                    order[i] = i;
+                }
+            }
+
+            /**
+             * \brief A permutation from the row order, for example `LUDecomposition::get_row_permutation()`.
+             *
+             * \param order Row i of P*A is row `order[i]` of A.
+             *
+             * \throw e std::invalid_argument if order is not a permutation of 0..n-1.
+             * */
+            explicit Permutation(std::vector<std::size_t> order): order {std::move(order)}, sign {1} {
+                const std::size_t n {this->order.size()};
+                std::vector<bool> seen(n, false);
+                for (const std::size_t& i : this->order) {
+                    if (i >= n || seen[i]) {
+                        throw std::invalid_argument("The row order is not a permutation.");
+                    }
+                    seen[i] = true;
+                }
+                // Every cycle of length l is l - 1 transpositions.
+                std::fill(seen.begin(), seen.end(), false);
+                for (std::size_t i = 0; i < n; i++) {
+                    for (std::size_t j = i; !seen[j]; j = this->order[j]) {
+                        seen[j] = true;
+                        if (this->order[j] != i) {
+                            sign = -sign;
+                        }
+                    }
+                }
+            }
+
+            /**
+             * \brief The number of rows the permutation acts on.
+             * */
+            std::size_t size() const {
+                return order.size();
+            }
+
+            /**
+             * \brief The row of A that is row i of P*A. Unchecked.
+             * */
+            const std::size_t& operator[](const std::size_t& i) const {
+                return order[i];
+            }
+
+            /**
+             * \brief The row order: row i of P*A is row `get_order()[i]` of A.
+             * */
+            const std::vector<std::size_t>& get_order() const {
+                return order;
+            }
+
+            /**
+             * \brief The sign of the permutation: 1 for an even number of exchanges, -1 for an odd number.
+             * */
+            int get_sign() const {
+                return sign;
+            }
+
+            /**
+             * \brief Whether this is the identity.
+             * */
+            bool isIdentity() const {
+                for (std::size_t i = 0; i < order.size(); i++) {
+                    if (order[i] != i) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /**
+             * \brief Record an exchange of rows i and j (after the ones already recorded).
+             *
+             * \throw e std::out_of_range if either index is out of range.
+             *
+             * \return Mutable reference to this permutation.
+             * */
+            Permutation& swap(const std::size_t& i, const std::size_t& j) {
+                if (i >= order.size() || j >= order.size()) {
+                    throw std::out_of_range("Permutation index out of range.");
+                }
+                if (i != j) {
+                    std::swap(order[i], order[j]);
+                    sign = -sign;
+                }
+                return *this;
+            }
+
+            /**
+             * \brief The inverse permutation, which undoes this one.
+             * */
+            Permutation inverse() const {
+                Permutation retval {order.size()};
+                for (std::size_t i = 0; i < order.size(); i++) {
+                    retval.order[order[i]] = i;
+                }
+                retval.sign = sign;
+                return retval;
+            }
+
+            /**
+             * \brief P*b: replay the permutation on a vector.
+             *
+             * \throw e std::invalid_argument if the vector has the wrong size.
+             * */
+            template <typename T> Vector<T> apply(const Vector<T>& b) const {
+                if (b.size() != order.size()) {
+                    throw std::invalid_argument("Vector size does not match the permutation.");
+                }
+                Vector<T> retval {order.size()};
+                for (std::size_t i = 0; i < order.size(); i++) {
+                    retval[i] = b[order[i]];
+                }
+                return retval;
+            }
+
+            friend bool operator==(const Permutation& lhs, const Permutation& rhs) {
+                return lhs.order == rhs.order;
+            }
+
+            friend bool operator!=(const Permutation& lhs, const Permutation& rhs) {
+                return !(lhs == rhs);
+            }
+        };
+    }
+}
+
+#endif
@@ -1,10 +1,12 @@
 #ifndef __SIGABRT_NUMERIC_PLANE__
 #define __SIGABRT_NUMERIC_PLANE__
 
+#include <cstddef>
 #include <exception>
 #include <tuple>
 
 #include <numeric/types/vector.hpp>
+#include <numeric/types/smallvector.hpp>
 
 /**
  * \namespace numeric
@@ -30,12 +32,26 @@ namespace numeric {
          * only tage integral values do not make sense in convention, this is templatized to make it more generic. This class
          * provides for easy translation between the linear form `ax + by + cz = k` and the point-normal form `N.(X-X0) = 0`
          * 
+         * The normal and the point are kept both as `Vector<T>` (returned by `get_normal` and `get_point`) and as
+         * `SmallVector<T, 3>` (returned by `get_small_normal` and `get_small_point`). Code working with small vectors should
+         * use the latter, which do not touch the heap.
+         * 
          * */
         template <typename T> class Plane {
         private:
+            numeric::types::SmallVector<T, 3> smallNormal;
+            numeric::types::SmallVector<T, 3> smallPoint;
             numeric::types::Vector<T> normal;
             numeric::types::Vector<T> point;
             std::tuple<T, T, T, T> coefficients;
+
+            void copySmallToVectors() {
+                for (std::size_t i = 0; i < 3; i++) {
+                    normal.atUnchecked(i) = smallNormal.atUnchecked(i);
+                    point.atUnchecked(i) = smallPoint.atUnchecked(i);
+                }
+            }
+
         public:
             /**
              * 
@@ -44,23 +60,24 @@ namespace numeric {
                 if (a == static_cast<T>(0) && b == static_cast<T>(0) && c == static_cast<T>(0)) {
                     throw std::invalid_argument("A plane of the form ax + by + cz = K, cannot have a=0 and b=0 and c=0.");
                 }
-                normal[0] = a;
-                normal[1] = b;
-                normal[2] = c;
+                smallNormal[0] = a;
+                smallNormal[1] = b;
+                smallNormal[2] = c;
                 
                 if(a != static_cast<T>(0)) {
-                    point[0] = k/a;
-                    point[1] = static_cast<T>(0);
-                    point[2] = static_cast<T>(0);
+                    smallPoint[0] = k/a;
+                    smallPoint[1] = static_cast<T>(0);
+                    smallPoint[2] = static_cast<T>(0);
                 } else if (b != static_cast<T>(0)) {
-                    point[0] = static_cast<T>(0);
-                    point[1] = k/b;
-                    point[2] = static_cast<T>(0);
+                    smallPoint[0] = static_cast<T>(0);
+                    smallPoint[1] = k/b;
+                    smallPoint[2] = static_cast<T>(0);
                 } else if (c != static_cast<T>(0)) {
-                    point[0] = static_cast<T>(0);
-                    point[1] = static_cast<T>(0);
-                    point[2] = k/c;
+                    smallPoint[0] = static_cast<T>(0);
+                    smallPoint[1] = static_cast<T>(0);
+                    smallPoint[2] = k/c;
                 }
+                copySmallToVectors();
             }
             
             template <typename U, typename V> 
@@ -68,13 +85,8 @@ namespace numeric {
                 if (normal.size() != 3 || point.size() != 3) {
                     throw std::invalid_argument("Vectors representing planes normals and points have to be of dimension 3.");
                 }
-                this -> normal[0] = normal[0];
-                this -> normal[1] = normal[1];
-                this -> normal[2] = normal[2];
-                
-                this -> point[0] = point[0];
-                this -> point[1] = point[1];
-                this -> point[2] = point[2];
+                smallNormal = numeric::types::SmallVector<T, 3> {normal};
+                smallPoint = numeric::types::SmallVector<T, 3> {point};
                 
                 coefficients = std::make_tuple(
                     static_cast<T>(normal[0]),
@@ -82,6 +94,42 @@ namespace numeric {
                     static_cast<T>(normal[2]),
                     static_cast<T>(normal*point)
                 );
+                copySmallToVectors();
+            }
+            
+            /**
+             * \brief Construct a plane of the form `N.(X-X0) = 0` from small vectors.
+             * */
+            template <typename U, typename V> 
+            Plane(const numeric::types::SmallVector<U, 3>& normal, const numeric::types::SmallVector<V, 3>& point):
+                smallNormal {static_cast<T>(normal[0]), static_cast<T>(normal[1]), static_cast<T>(normal[2])},
+                smallPoint {static_cast<T>(point[0]), static_cast<T>(point[1]), static_cast<T>(point[2])},
+                normal {3},
+                point {3},
+                coefficients {std::make_tuple(
+                    static_cast<T>(normal[0]),
+                    static_cast<T>(normal[1]),
+                    static_cast<T>(normal[2]),
+                    static_cast<T>(normal*point)
+                )} {
+                copySmallToVectors();
+            }
+
+            Plane(const Plane<T>& other):
+                smallNormal {other.smallNormal},
+                smallPoint {other.smallPoint},
+                normal {3},
+                point {3},
+                coefficients {other.coefficients} {
+                copySmallToVectors();
+            }
+
+            Plane(Plane<T>&& other)=default;
+
+            Plane<T>& operator=(Plane<T>&& other)=default;
+
+            Plane<T>& operator=(const Plane<T>& other) {
+                return *this = Plane<T> {other};
             }
             
             const numeric::types::Vector<T>& get_normal() const {
@@ -91,6 +139,20 @@ namespace numeric {
             const numeric::types::Vector<T>& get_point() const {
                 return point;
             }
+
+            /**
+             * \brief The normal, as a small vector.
+             * */
+            const numeric::types::SmallVector<T, 3>& get_small_normal() const {
+                return smallNormal;
+            }
+
+            /**
+             * \brief The point, as a small vector.
+             * */
+            const numeric::types::SmallVector<T, 3>& get_small_point() const {
+                return smallPoint;
+            }
             
             const std::tuple<T,T,T,T>& get_coefficients() const {
                 return coefficients;
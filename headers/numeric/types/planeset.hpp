@@ -0,0 +1,175 @@
+#ifndef __SIGABRT_NUMERIC_PLANESET__
+#define __SIGABRT_NUMERIC_PLANESET__
+
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <memory_resource>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <numeric/memory/buffer.hpp>
+#include <numeric/types/plane.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::types
+     *
+     * \brief The namespace containing some special types.
+     * */
+    namespace types {
+        /**
+         * \class PlaneSet
+         *
+         * \tparam T float or double.
+         *
+         * \brief Many planes `ax + by + cz = k`, stored as a structure of arrays.
+         *
+         * Each `Plane` carries two heap vectors and two small vectors, which is fine for a few planes but not for testing
+         * millions of points against thousands of planes. Here every coefficient of all the planes is one contiguous
+         * array (`a()`, `b()`, `c()` and `k()`), next to the inverse length of every normal (`inverse_norms()`). The
+         * queries in `math/planes.hpp` run over blocks of points with the points in the innermost loop, which the
+         * compiler turns into SIMD code.
+         *
+         * The storage is allocated from a `std::pmr::memory_resource`, like `Matrix` and `SystemBatch`. Like them, this
+         * is not copyable.
+         * */
+        template <typename T> class PlaneSet {
+        private:
+            static_assert(std::is_floating_point<T>::value, "PlaneSet needs a floating point type.");
+
+            std::size_t count;
+            // a, b, c, k and the inverse norms, count elements each.
+            numeric::memory::Buffer<T> storage;
+
+            T* column(const std::size_t& i) const {
+                return storage.get() + i*count;
+            }
+
+        public:
+            using value_type = T;
+
+            /**
+             * \brief Constructs `count` planes, all of them `x = 0` until they are `set`.
+             * */
+            explicit PlaneSet(
+                const std::size_t& count,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+            ): count {count}, storage {numeric::memory::make_buffer<T>(5*count, resource)} {
+                for (std::size_t p = 0; p < count; p++) {
+                    set(p, static_cast<T>(1), static_cast<T>(0), static_cast<T>(0), static_cast<T>(0));
+                }
+            }
+
+            /**
+             * \brief Constructs the set from individual planes.
+             * */
+            explicit PlaneSet(
+                const std::vector<Plane<T>>& planes,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+            ): count {planes.size()}, storage {numeric::memory::make_buffer<T>(5*planes.size(), resource)} {
+                for (std::size_t p = 0; p < count; p++) {
+                    set(p, planes[p]);
+                }
+            }
+
+            PlaneSet(const PlaneSet<T>& other)=delete;
+            void operator=(const PlaneSet<T>& other)=delete;
+            PlaneSet(PlaneSet<T>&& other)=default;
+            PlaneSet<T>& operator=(PlaneSet<T>&& other)=default;
+
+            /**
+             * \brief The number of planes.
+             * */
+            std::size_t getCount() const {
+                return count;
+            }
+
+            /**
+             * \brief Replace plane p with `ax + by + cz = k`.
+             *
+             * \throw e std::out_of_range if p is out of range.
+             * \throw e std::invalid_argument if a, b and c are all 0, like the `Plane` constructor.
+             * */
+            void set(const std::size_t& p, const T& a, const T& b, const T& c, const T& k) {
+                if (p >= count) {
+                    throw std::out_of_range("Plane index out of range.");
+                }
+                if (a == static_cast<T>(0) && b == static_cast<T>(0) && c == static_cast<T>(0)) {
+                    throw std::invalid_argument("A plane of the form ax + by + cz = K, cannot have a=0 and b=0 and c=0.");
+                }
+                column(0)[p] = a;
+                column(1)[p] = b;
+                column(2)[p] = c;
+                column(3)[p] = k;
+                column(4)[p] = static_cast<T>(1)/std::sqrt(a*a + b*b + c*c);
+            }
+
+            /**
+             * \brief Replace plane p.
+             *
+             * \throw e std::out_of_range if p is out of range.
+             * */
+            void set(const std::size_t& p, const Plane<T>& plane) {
+                const std::tuple<T, T, T, T>& coefficients {plane.get_coefficients()};
+                set(p, std::get<0>(coefficients), std::get<1>(coefficients), std::get<2>(coefficients), std::get<3>(coefficients));
+            }
+
+            /**
+             * \brief Plane p, as a `Plane`.
+             *
+             * \throw e std::out_of_range if p is out of range.
+             * */
+            Plane<T> get(const std::size_t& p) const {
+                if (p >= count) {
+                    throw std::out_of_range("Plane index out of range.");
+                }
+                return Plane<T> {column(0)[p], column(1)[p], column(2)[p], column(3)[p]};
+            }
+
+            /**
+             * \brief The x coefficients of the normals: `a()[p]` for plane p.
+             * */
+            const T* a() const {
+                return column(0);
+            }
+
+            /**
+             * \brief The y coefficients of the normals.
+             * */
+            const T* b() const {
+                return column(1);
+            }
+
+            /**
+             * \brief The z coefficients of the normals.
+             * */
+            const T* c() const {
+                return column(2);
+            }
+
+            /**
+             * \brief The right hand sides.
+             * */
+            const T* k() const {
+                return column(3);
+            }
+
+            /**
+             * \brief One over the length of every normal.
+             * */
+            const T* inverse_norms() const {
+                return column(4);
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef __SIGABRT_NUMERIC_RATIONAL__
+#define __SIGABRT_NUMERIC_RATIONAL__
+
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <numeric/types/bigint.hpp>
+#include <numeric/types/fraction.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::types
+     *
+     * \brief The namespace containing some special types.
+     * */
+    namespace types {
+        /**
+         * \class Rational
+         *
+         * \brief An exact rational number that cannot overflow: a `BigInt` numerator and denominator.
+         *
+         * `Fraction` and `LazyFraction` keep their numerator and denominator in a `long`, so elimination on larger or
+         * badly conditioned matrices (the Hilbert matrix is the classic example) eventually overflows them. A `Rational`
+         * never overflows; while the numbers fit in a machine word, the `BigInt` arithmetic is `long` arithmetic plus an
+         * overflow check, so the cost over `Fraction` is small until the numbers actually grow.
+         *
+         * A rational is always kept reduced, with a positive denominator (0 is 0/1), so equality is a plain comparison of
+         * the numerators and the denominators. Addition and multiplication cancel common factors before multiplying (Knuth,
+         * TAOCP 4.5.1), to keep the intermediate numbers as small as the result.
+         *
+         * Works with `Matrix`, `rref` and `gauss_jordan` like the other scalar types. For matrices with integer entries,
+         * `bareiss` (in numeric/math/bareiss.hpp) is usually faster still.
+         * */
+        class Rational {
+        private:
+            BigInt num;
+            BigInt den;
+
+            struct Reduced {};
+
+            // Construct from parts that are already reduced, with a positive denominator.
+            Rational(BigInt&& num, BigInt&& den, Reduced): num {std::move(num)}, den {std::move(den)} {}
+
+        public:
+            /**
+             * \brief Default constructor. Constructs 0.
+             * */
+            Rational(): num {0}, den {1} {}
+
+            /**
+             * \brief Constructs the integer `num/1`. This is implicit, so integers mix freely with rationals.
+             * */
+            template <typename I, typename=typename std::enable_if<std::is_integral<I>::value>::type>
+            Rational(const I& num): num {num}, den {1} {}
+
+            /**
+             * \brief Constructs the integer `num/1`.
+             * */
+            Rational(const BigInt& num): num {num}, den {1} {}
+
+            /**
+             * \brief Constructs `num/den`, reduced.
+             *
+             * \exception std::invalid_argument thrown when the denominator is 0.
+             * */
+            Rational(const BigInt& num, const BigInt& den) {
+                if (den.is_zero()) {
+                    throw std::invalid_argument("Denominator cannot be 0.");
+                }
+                const BigInt divisor {gcd(num, den)};
+                this -> num = num/divisor;
+                this -> den = den/divisor;
+                if (this -> den.sign() < 0) {
+                    this -> num = -this -> num;
+                    this -> den = -this -> den;
+                }
+            }
+
+            /**
+             * \brief Constructs a rational with the value of a `Fraction`.
+             * */
+            explicit Rational(const Fraction& f): Rational(BigInt {f.num}, BigInt {f.den}) {}
+
+            /**
+             * \brief Constructs a rational with the value of a `LazyFraction`.
+             * */
+            explicit Rational(const LazyFraction& f): Rational(BigInt {f.num}, BigInt {f.den}) {}
+
+            const BigInt& get_numerator() const {
+                return num;
+            }
+
+            /**
+             * \brief The denominator, which is always positive.
+             * */
+            const BigInt& get_denominator() const {
+                return den;
+            }
+
+            bool is_zero() const {
+                return num.is_zero();
+            }
+
+            /**
+             * \brief Conversion to double.
+             *
+             * This is explicit, so that mixed expressions do not silently drop to floating point. Numerators and denominators
+             * beyond the range of double give infinities or NaN.
+             * */
+            explicit operator double() const {
+                return static_cast<double>(num)/static_cast<double>(den);
+            }
+
+            friend Rational operator+(const Rational& lhs, const Rational& rhs) {
+                if (lhs.den == rhs.den) {
+                    return Rational {lhs.num + rhs.num, lhs.den};
+                }
+                const BigInt d1 {gcd(lhs.den, rhs.den)};
+                if (d1 == 1) {
+                    return Rational {lhs.num*rhs.den + rhs.num*lhs.den, lhs.den*rhs.den, Reduced {}};
+                }
+                BigInt t {lhs.num*(rhs.den/d1) + rhs.num*(lhs.den/d1)};
+                const BigInt d2 {gcd(t, d1)};
+                return Rational {t/d2, (lhs.den/d1)*(rhs.den/d2), Reduced {}};
+            }
+
+            friend Rational operator-(const Rational& value) {
+                return Rational {-value.num, BigInt {value.den}, Reduced {}};
+            }
+
+            friend Rational operator*(const Rational& lhs, const Rational& rhs) {
+                if (lhs.is_zero() || rhs.is_zero()) {
+                    return Rational {};
+                }
+                const BigInt g1 {gcd(lhs.num, rhs.den)};
+                const BigInt g2 {gcd(rhs.num, lhs.den)};
+                return Rational {(lhs.num/g1)*(rhs.num/g2), (lhs.den/g2)*(rhs.den/g1), Reduced {}};
+            }
+
+            /**
+             * \exception std::invalid_argument thrown on division by 0.
+             * */
+            friend Rational operator/(const Rational& lhs, const Rational& rhs) {
+                if (rhs.is_zero()) {
+                    throw std::invalid_argument("Attempt to divide by 0.");
+                }
+                const Rational inverse {rhs.num.sign() < 0?
+                    Rational {-rhs.den, -rhs.num, Reduced {}} :
+                    Rational {BigInt {rhs.den}, BigInt {rhs.num}, Reduced {}}};
+                return lhs*inverse;
+            }
+
+            friend bool operator==(const Rational& lhs, const Rational& rhs) {
+                return lhs.num == rhs.num && lhs.den == rhs.den;
+            }
+
+            friend bool operator<(const Rational& lhs, const Rational& rhs) {
+                if (lhs.den == rhs.den) {
+                    return lhs.num < rhs.num;
+                }
+                return lhs.num*rhs.den < rhs.num*lhs.den;
+            }
+        };
+
+        inline Rational operator-(const Rational& lhs, const Rational& rhs) {
+            return lhs + (-rhs);
+        }
+
+        inline bool operator!=(const Rational& lhs, const Rational& rhs) {
+            return !(lhs == rhs);
+        }
+
+        inline bool operator>(const Rational& lhs, const Rational& rhs) {
+            return rhs < lhs;
+        }
+
+        inline bool operator<=(const Rational& lhs, const Rational& rhs) {
+            return !(rhs < lhs);
+        }
+
+        inline bool operator>=(const Rational& lhs, const Rational& rhs) {
+            return !(lhs < rhs);
+        }
+
+        inline Rational& operator+=(Rational& lhs, const Rational& rhs) {
+            lhs = lhs + rhs;
+            return lhs;
+        }
+
+        inline Rational& operator-=(Rational& lhs, const Rational& rhs) {
+            lhs = lhs - rhs;
+            return lhs;
+        }
+
+        inline Rational& operator*=(Rational& lhs, const Rational& rhs) {
+            lhs = lhs * rhs;
+            return lhs;
+        }
+
+        inline Rational& operator/=(Rational& lhs, const Rational& rhs) {
+            lhs = lhs / rhs;
+            return lhs;
+        }
+
+        inline std::ostream& operator<<(std::ostream& stream, const Rational& value) {
+            stream << value.get_numerator() << '/' << value.get_denominator();
+            return stream;
+        }
+    }
+}
+
+#endif
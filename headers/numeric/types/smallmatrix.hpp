@@ -0,0 +1,293 @@
+#ifndef __SIGABRT_NUMERIC_SMALL_MATRIX__
+#define __SIGABRT_NUMERIC_SMALL_MATRIX__
+
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <numeric/types/models.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/smallvector.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::types
+     *
+     * \brief The namespace containing some special types.
+     * */
+    namespace types {
+        /**
+         * \class SmallMatrix
+         *
+         * \tparam T Some numeric type.
+         *
+         * \tparam R Number of rows.
+         *
+         * \tparam C Number of columns.
+         *
+         * \brief A fixed size matrix, stored inline as R `SmallVector<T, C>` rows.
+         *
+         * This is the counterpart of `Matrix` for small, compile time dimensions (3x3 rotations, 4x4 transforms). There is no
+         * heap storage, it is copyable, everything is `constexpr`, and the arithmetic is unrolled at compile time.
+         *
+         * `matrix[i][j]` works like it does for `Matrix`, range checked; `atUnchecked(i, j)` skips the checks. Products with
+         * `SmallVector` follow the `Matrix` convention: matrix*vector takes a column vector, vector*matrix a row vector.
+         * Incompatible dimensions are compile errors.
+         * */
+        template <typename T, std::size_t R, std::size_t C> class SmallMatrix {
+            static_assert(R > 0 && C > 0, "SmallMatrix cannot have 0 rows or columns.");
+        private:
+            SmallVector<T, C> rows[R];
+
+        public:
+            using value_type = T;
+
+            /**
+             * \brief Constructs a matrix with value initialized (0 for numeric types) elements.
+             * */
+            constexpr SmallMatrix(): rows {} {}
+
+            /**
+             * \brief Constructs a matrix from nested arrays, like `SmallMatrix<double, 2, 2> {{{1, 2}, {3, 4}}}`.
+             *
+             * This is the same shape as the `std::vector<std::vector<T>>` constructor of `Matrix`, but the dimensions are
+             * checked at compile time.
+             * */
+            constexpr SmallMatrix(const T (&elems)[R][C]): rows {} {
+                for (std::size_t i = 0; i < R; i++) {
+                    for (std::size_t j = 0; j < C; j++) {
+                        rows[i].atUnchecked(j) = elems[i][j];
+                    }
+                }
+            }
+
+            /**
+             * \brief Constructs a matrix from exactly R `SmallVector<T, C>` rows.
+             * */
+            template <
+                typename... Rows,
+                typename=typename std::enable_if<sizeof...(Rows) == R && (std::is_same<Rows, SmallVector<T, C>>::value && ...)>::type
+            >
+            constexpr SmallMatrix(const Rows&... src): rows {src...} {}
+
+            /**
+             * \brief Constructs a small matrix from a `Matrix`.
+             *
+             * \throw e std::invalid_argument if the dimensions of the matrix are not R x C.
+             * */
+            template <typename U> explicit SmallMatrix(const Matrix<U>& matrix) {
+                if (matrix.getRows() != R || matrix.getCols() != C) {
+                    throw std::invalid_argument("Dimensions of the matrix do not match the small matrix.");
+                }
+                for (std::size_t i = 0; i < R; i++) {
+                    const U* src {matrix.rowPtr(i)};
+                    for (std::size_t j = 0; j < C; j++) {
+                        rows[i].atUnchecked(j) = static_cast<T>(src[j]);
+                    }
+                }
+            }
+
+            /**
+             * \brief Conversion to a (heap allocated) `Matrix<T>`.
+             * */
+            Matrix<T> to_matrix() const {
+                Matrix<T> retval {R, C};
+                for (std::size_t i = 0; i < R; i++) {
+                    T* dest {retval.rowPtr(i)};
+                    for (std::size_t j = 0; j < C; j++) {
+                        dest[j] = rows[i].atUnchecked(j);
+                    }
+                }
+                return retval;
+            }
+
+            static constexpr std::size_t getRows() {
+                return R;
+            }
+
+            static constexpr std::size_t getCols() {
+                return C;
+            }
+
+            constexpr SmallVector<T, C>& operator[](const std::size_t& row) {
+                if (row >= R) {
+                    throw std::out_of_range("Matrix row index out of range.");
+                }
+                return rows[row];
+            }
+
+            constexpr const SmallVector<T, C>& operator[](const std::size_t& row) const {
+                if (row >= R) {
+                    throw std::out_of_range("Matrix row index out of range.");
+                }
+                return rows[row];
+            }
+
+            /**
+             * \brief Unchecked row access (only an `assert`).
+             * */
+            constexpr SmallVector<T, C>& row(const std::size_t& row) {
+                assert(row < R);
+                return rows[row];
+            }
+
+            //! \cond NO_DOC
+            constexpr const SmallVector<T, C>& row(const std::size_t& row) const {
+                assert(row < R);
+                return rows[row];
+            }
+            //! \endcond
+
+            /**
+             * \brief Unchecked element access (only an `assert`).
+             * */
+            constexpr T& atUnchecked(const std::size_t& row, const std::size_t& col) {
+                assert(row < R && col < C);
+                return rows[row].atUnchecked(col);
+            }
+
+            //! \cond NO_DOC
+            constexpr const T& atUnchecked(const std::size_t& row, const std::size_t& col) const {
+                assert(row < R && col < C);
+                return rows[row].atUnchecked(col);
+            }
+            //! \endcond
+
+            constexpr SmallVector<T, C>* begin() {
+                return rows;
+            }
+
+            constexpr const SmallVector<T, C>* begin() const {
+                return rows;
+            }
+
+            constexpr SmallVector<T, C>* end() {
+                return rows + R;
+            }
+
+            constexpr const SmallVector<T, C>* end() const {
+                return rows + R;
+            }
+
+            /**
+             * \brief Column j, as a `SmallVector`.
+             * */
+            constexpr SmallVector<T, R> column(const std::size_t& col) const {
+                return SmallVector<T, R>::generate([&](const std::size_t& i) {return rows[i].atUnchecked(col);});
+            }
+
+            /**
+             * \brief The transposed (C x R) matrix.
+             * */
+            constexpr SmallMatrix<T, C, R> transpose() const {
+                return SmallMatrix<T, C, R>::generateRows([&](const std::size_t& j) {return column(j);});
+            }
+
+            //! \cond NO_DOC
+            template <typename F, std::size_t... I> static constexpr SmallMatrix<T, R, C> generateRows(const F& fn, std::index_sequence<I...>) {
+                return SmallMatrix<T, R, C> {SmallVector<T, C> {fn(I)}...};
+            }
+            //! \endcond
+
+            /**
+             * \brief Build a matrix whose row i is `fn(i)` (a `SmallVector<T, C>`). The calls are expanded at compile time.
+             * */
+            template <typename F> static constexpr SmallMatrix<T, R, C> generateRows(const F& fn) {
+                return generateRows(fn, std::make_index_sequence<R> {});
+            }
+
+            /**
+             * \brief Identity matrix generator.
+             * */
+            static constexpr SmallMatrix<T, R, C> identity() {
+                static_assert(R == C, "Only square matrices have an identity.");
+                return generateRows([](const std::size_t& i) {
+                    return SmallVector<T, C>::generate([&](const std::size_t& j) {return i == j? static_cast<T>(1) : static_cast<T>(0);});
+                });
+            }
+        };
+
+        template <typename T, std::size_t R, std::size_t C>
+        constexpr SmallMatrix<T, R, C> operator+(const SmallMatrix<T, R, C>& lhs, const SmallMatrix<T, R, C>& rhs) {
+            return SmallMatrix<T, R, C>::generateRows([&](const std::size_t& i) {return lhs.row(i) + rhs.row(i);});
+        }
+
+        template <typename T, std::size_t R, std::size_t C>
+        constexpr SmallMatrix<T, R, C> operator-(const SmallMatrix<T, R, C>& lhs, const SmallMatrix<T, R, C>& rhs) {
+            return SmallMatrix<T, R, C>::generateRows([&](const std::size_t& i) {return lhs.row(i) - rhs.row(i);});
+        }
+
+        template <typename T, std::size_t R, std::size_t C>
+        constexpr SmallMatrix<T, R, C> operator-(const SmallMatrix<T, R, C>& matrix) {
+            return SmallMatrix<T, R, C>::generateRows([&](const std::size_t& i) {return -matrix.row(i);});
+        }
+
+        template <typename S, typename T, std::size_t R, std::size_t C, typename=typename std::enable_if<IsScalarType<S>::value>::type>
+        constexpr SmallMatrix<T, R, C> operator*(const S& scalar, const SmallMatrix<T, R, C>& matrix) {
+            return SmallMatrix<T, R, C>::generateRows([&](const std::size_t& i) {return scalar*matrix.row(i);});
+        }
+
+        template <typename S, typename T, std::size_t R, std::size_t C, typename=typename std::enable_if<IsScalarType<S>::value>::type>
+        constexpr SmallMatrix<T, R, C> operator*(const SmallMatrix<T, R, C>& matrix, const S& scalar) {
+            return SmallMatrix<T, R, C>::generateRows([&](const std::size_t& i) {return matrix.row(i)*scalar;});
+        }
+
+        //! \cond NO_DOC
+        template <typename T, std::size_t K, std::size_t C, std::size_t... I>
+        constexpr SmallVector<T, C> smallRowTimesMatrix(const SmallVector<T, K>& row, const SmallMatrix<T, K, C>& rhs, std::index_sequence<I...>) {
+            return ((rhs.row(I)*row.atUnchecked(I)) + ...);
+        }
+        //! \endcond
+
+        /**
+         * \brief Matrix multiplication. Row i of the result is accumulated as a combination of the rows of `rhs`.
+         * */
+        template <typename T, std::size_t R, std::size_t K, std::size_t C>
+        constexpr SmallMatrix<T, R, C> operator*(const SmallMatrix<T, R, K>& lhs, const SmallMatrix<T, K, C>& rhs) {
+            return SmallMatrix<T, R, C>::generateRows([&](const std::size_t& i) {
+                return smallRowTimesMatrix<T, K, C>(lhs.row(i), rhs, std::make_index_sequence<K> {});
+            });
+        }
+
+        /**
+         * \brief Matrix times a column vector.
+         * */
+        template <typename T, std::size_t R, std::size_t C>
+        constexpr SmallVector<T, R> operator*(const SmallMatrix<T, R, C>& lhs, const SmallVector<T, C>& rhs) {
+            return SmallVector<T, R>::generate([&](const std::size_t& i) {return lhs.row(i)*rhs;});
+        }
+
+        /**
+         * \brief Row vector times a matrix.
+         * */
+        template <typename T, std::size_t R, std::size_t C>
+        constexpr SmallVector<T, C> operator*(const SmallVector<T, R>& lhs, const SmallMatrix<T, R, C>& rhs) {
+            return smallRowTimesMatrix<T, R, C>(lhs, rhs, std::make_index_sequence<R> {});
+        }
+
+        template <typename T, typename U, std::size_t R, std::size_t C>
+        constexpr bool operator==(const SmallMatrix<T, R, C>& lhs, const SmallMatrix<U, R, C>& rhs) {
+            for (std::size_t i = 0; i < R; i++) {
+                if (lhs.row(i) != rhs.row(i)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename T, typename U, std::size_t R, std::size_t C>
+        constexpr bool operator!=(const SmallMatrix<T, R, C>& lhs, const SmallMatrix<U, R, C>& rhs) {
+            return !(lhs == rhs);
+        }
+    }
+}
+
+#endif
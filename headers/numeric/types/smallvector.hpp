@@ -0,0 +1,250 @@
+#ifndef __SIGABRT_NUMERIC_SMALL_VECTOR__
+#define __SIGABRT_NUMERIC_SMALL_VECTOR__
+
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <numeric/types/models.hpp>
+#include <numeric/types/vector.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::types
+     *
+     * \brief The namespace containing some special types.
+     * */
+    namespace types {
+        /**
+         * \class SmallVector
+         *
+         * \tparam T Some numeric type.
+         *
+         * \tparam N The (compile time) dimension.
+         *
+         * \brief A fixed size vector, stored inline.
+         *
+         * This is the counterpart of `Vector` for small, compile time dimensions, like 3D geometry. The elements live inside
+         * the object (no heap), so unlike `Vector` this is cheap to copy and is copyable. Everything is `constexpr`, and the
+         * arithmetic is unrolled at compile time over the N elements, so there are no loops left for the optimizer to
+         * second guess.
+         *
+         * Functionality mirrors `Vector`:
+         *   - `size()`, `mod()` (the magnitude squared), index operator with range check and `atUnchecked`.
+         *   - Add, subtract, negate, scale by a scalar, dot product (`operator*`) and equality.
+         *   - Explicit conversions to and from `Vector<T>`, for code that needs the dynamic type.
+         *
+         * Dimension mismatches are compile errors rather than `INCOMPATIBLE_VECTORS`.
+         * */
+        template <typename T, std::size_t N> class SmallVector {
+            static_assert(N > 0, "SmallVector cannot have 0 dimensions.");
+            static_assert(std::is_default_constructible<T>::value, "Type T has to be default constructible.");
+        private:
+            T elems[N];
+
+            template <typename U, std::size_t... I>
+            constexpr SmallVector(const U* src, std::index_sequence<I...>): elems {static_cast<T>(src[I])...} {}
+
+        public:
+            using value_type = T;
+
+            /**
+             * \brief Constructs a vector with value initialized (0 for numeric types) elements.
+             * */
+            constexpr SmallVector(): elems {} {}
+
+            /**
+             * \brief Constructs a vector from exactly N elements, like `SmallVector<double, 3> {1.0, 2.0, 3.0}`.
+             * */
+            template <
+                typename... Args,
+                typename=typename std::enable_if<sizeof...(Args) == N && (std::is_convertible<Args, T>::value && ...)>::type
+            >
+            constexpr SmallVector(const Args&... args): elems {static_cast<T>(args)...} {}
+
+            /**
+             * \brief Constructs a small vector from a `Vector`.
+             *
+             * \throw e std::invalid_argument if the dimension of the vector is not N.
+             * */
+            template <typename U>
+            explicit SmallVector(const Vector<U>& vec): SmallVector(checkedData(vec), std::make_index_sequence<N> {}) {}
+
+            //! \cond NO_DOC
+            template <typename U> static const U* checkedData(const Vector<U>& vec) {
+                if (vec.size() != N) {
+                    throw std::invalid_argument("Dimension of the vector does not match the small vector.");
+                }
+                return vec.data();
+            }
+            //! \endcond
+
+            /**
+             * \brief Conversion to a (heap allocated) `Vector<T>`. This is explicit, so that the allocation is visible.
+             * */
+            explicit operator Vector<T>() const {
+                Vector<T> retval {N};
+                for (std::size_t i = 0; i < N; i++) {
+                    retval.atUnchecked(i) = elems[i];
+                }
+                return retval;
+            }
+
+            /**
+             * \brief The dimension, N.
+             * */
+            static constexpr std::size_t size() {
+                return N;
+            }
+
+            constexpr T& operator[](const std::size_t& index) {
+                if (index >= N) {
+                    throw std::out_of_range("Index out of range.");
+                }
+                return elems[index];
+            }
+
+            constexpr const T& operator[](const std::size_t& index) const {
+                if (index >= N) {
+                    throw std::out_of_range("Index out of range.");
+                }
+                return elems[index];
+            }
+
+            /**
+             * \brief Element access without the range check (only an `assert`).
+             * */
+            constexpr T& atUnchecked(const std::size_t& index) {
+                assert(index < N);
+                return elems[index];
+            }
+
+            //! \cond NO_DOC
+            constexpr const T& atUnchecked(const std::size_t& index) const {
+                assert(index < N);
+                return elems[index];
+            }
+            //! \endcond
+
+            constexpr T* data() {
+                return elems;
+            }
+
+            constexpr const T* data() const {
+                return elems;
+            }
+
+            constexpr T* begin() {
+                return elems;
+            }
+
+            constexpr const T* begin() const {
+                return elems;
+            }
+
+            constexpr T* end() {
+                return elems + N;
+            }
+
+            constexpr const T* end() const {
+                return elems + N;
+            }
+
+            /**
+             * \brief Modulus (length) of the vector, squared. Same as `Vector::mod`.
+             * */
+            constexpr double mod() const {
+                return static_cast<double>(dot(*this));
+            }
+
+            /**
+             * \brief Dot product with another small vector of the same dimension.
+             * */
+            template <typename U> constexpr T dot(const SmallVector<U, N>& other) const {
+                return dotImpl(other, std::make_index_sequence<N> {});
+            }
+
+            /**
+             * \brief Scale the vector in place.
+             *
+             * \return A reference to this.
+             * */
+            template <typename S> constexpr SmallVector<T, N>& scale(const S& scalar) {
+                for (std::size_t i = 0; i < N; i++) {
+                    elems[i] = elems[i]*scalar;
+                }
+                return *this;
+            }
+
+            //! \cond NO_DOC
+            template <typename U, std::size_t... I>
+            constexpr T dotImpl(const SmallVector<U, N>& other, std::index_sequence<I...>) const {
+                return ((elems[I]*other.atUnchecked(I)) + ...);
+            }
+
+            template <typename F, std::size_t... I> static constexpr SmallVector<T, N> generate(const F& fn, std::index_sequence<I...>) {
+                return SmallVector<T, N> {static_cast<T>(fn(I))...};
+            }
+            //! \endcond
+
+            /**
+             * \brief Build a vector whose element i is `fn(i)`. The calls are expanded at compile time.
+             * */
+            template <typename F> static constexpr SmallVector<T, N> generate(const F& fn) {
+                return generate(fn, std::make_index_sequence<N> {});
+            }
+        };
+
+        template <typename T, std::size_t N> constexpr SmallVector<T, N> operator+(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs) {
+            return SmallVector<T, N>::generate([&](const std::size_t& i) {return lhs.atUnchecked(i) + rhs.atUnchecked(i);});
+        }
+
+        template <typename T, std::size_t N> constexpr SmallVector<T, N> operator-(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs) {
+            return SmallVector<T, N>::generate([&](const std::size_t& i) {return lhs.atUnchecked(i) - rhs.atUnchecked(i);});
+        }
+
+        template <typename T, std::size_t N> constexpr SmallVector<T, N> operator-(const SmallVector<T, N>& vec) {
+            return SmallVector<T, N>::generate([&](const std::size_t& i) {return -vec.atUnchecked(i);});
+        }
+
+        template <typename S, typename T, std::size_t N, typename=typename std::enable_if<IsScalarType<S>::value>::type>
+        constexpr SmallVector<T, N> operator*(const S& scalar, const SmallVector<T, N>& vec) {
+            return SmallVector<T, N>::generate([&](const std::size_t& i) {return scalar*vec.atUnchecked(i);});
+        }
+
+        template <typename S, typename T, std::size_t N, typename=typename std::enable_if<IsScalarType<S>::value>::type>
+        constexpr SmallVector<T, N> operator*(const SmallVector<T, N>& vec, const S& scalar) {
+            return SmallVector<T, N>::generate([&](const std::size_t& i) {return vec.atUnchecked(i)*scalar;});
+        }
+
+        /**
+         * \brief Dot product of 2 small vectors. Like for `Vector`, the types do not have to be the same.
+         * */
+        template <typename T, typename U, std::size_t N> constexpr T operator*(const SmallVector<T, N>& lhs, const SmallVector<U, N>& rhs) {
+            return lhs.dot(rhs);
+        }
+
+        template <typename T, typename U, std::size_t N> constexpr bool operator==(const SmallVector<T, N>& lhs, const SmallVector<U, N>& rhs) {
+            for (std::size_t i = 0; i < N; i++) {
+                if (lhs.atUnchecked(i) != rhs.atUnchecked(i)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename T, typename U, std::size_t N> constexpr bool operator!=(const SmallVector<T, N>& lhs, const SmallVector<U, N>& rhs) {
+            return !(lhs == rhs);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,336 @@
+#ifndef __SIGABRT_NUMERIC_SPARSEMATRIX__
+#define __SIGABRT_NUMERIC_SPARSEMATRIX__
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/matrixview.hpp>
+#include <numeric/types/models.hpp>
+#include <numeric/types/vector.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::types
+     *
+     * \brief The namespace containing some special types.
+     * */
+    namespace types {
+        /**
+         * \enum SparseLayout
+         *
+         * - `CSR`: compressed sparse rows. The non zero elements are stored row by row. Best for matrix*vector products
+         *   and for row operations.
+         * - `CSC`: compressed sparse columns. The non zero elements are stored column by column. Best for column access.
+         * */
+        enum class SparseLayout {
+            CSR,
+            CSC
+        };
+
+        /**
+         * \class Triplet
+         *
+         * \brief One non zero element of a sparse matrix, for building one.
+         * */
+        template <typename T> struct Triplet {
+            std::size_t row;
+            std::size_t col;
+            T value;
+        };
+
+        /**
+         * \class SparseMatrix
+         *
+         * \tparam T Some numeric type
+         *
+         * \brief A matrix that only stores its non zero elements, in CSR or CSC layout.
+         *
+         * The elements are stored in 3 arrays. In CSR layout, the column indices and the values of row i are at positions
+         * [offsets[i], offsets[i + 1]) of `indices` and `values`, sorted by column. CSC is the same with rows and columns
+         * swapped. The memory is O(rows + non zeros) for CSR, and O(cols + non zeros) for CSC.
+         *
+         * Elements equal to 0 are never stored. Like `Matrix`, this is not copyable; convert explicitly with
+         * `with_layout`, or to a dense matrix with `to_dense`.
+         *
+         * Multiplying with a `Vector` (`a*x`) is defined for both layouts. See `parallel_multiply` in `math/sparse.hpp`
+         * for the multithreaded version, and `SparseLUDecomposition` and `sparse_gauss_jordan` for solving systems.
+         * */
+        template <typename T> class SparseMatrix {
+        private:
+            std::size_t nrows;
+            std::size_t ncols;
+            SparseLayout layout;
+            std::vector<std::size_t> offsets;
+            std::vector<std::size_t> indices;
+            std::vector<T> values;
+
+            std::size_t majorDim() const {
+                return layout == SparseLayout::CSR? nrows : ncols;
+            }
+
+            std::size_t minorDim() const {
+                return layout == SparseLayout::CSR? ncols : nrows;
+            }
+
+            // Rebuild the arrays from triplets: sort by (major, minor), sum the duplicates and drop the zeros.
+            void build(std::vector<Triplet<T>>&& triplets) {
+                for (const Triplet<T>& triplet : triplets) {
+                    if (triplet.row >= nrows || triplet.col >= ncols) {
+                        throw std::out_of_range("Sparse matrix element out of range.");
+                    }
+                }
+                const bool rowMajor {layout == SparseLayout::CSR};
+                auto major {[rowMajor](const Triplet<T>& triplet) {return rowMajor? triplet.row : triplet.col;}};
+                auto minor {[rowMajor](const Triplet<T>& triplet) {return rowMajor? triplet.col : triplet.row;}};
+                std::stable_sort(triplets.begin(), triplets.end(), [&](const Triplet<T>& lhs, const Triplet<T>& rhs) {
+                    return major(lhs) < major(rhs) || (major(lhs) == major(rhs) && minor(lhs) < minor(rhs));
+                });
+
+                offsets.assign(majorDim() + 1, 0);
+                indices.clear();
+                values.clear();
+                indices.reserve(triplets.size());
+                values.reserve(triplets.size());
+                for (std::size_t i = 0; i < triplets.size();) {
+                    T sum {triplets[i].value};
+                    std::size_t j {i + 1};
+                    while (j < triplets.size() && major(triplets[j]) == major(triplets[i]) && minor(triplets[j]) == minor(triplets[i])) {
+                        sum += triplets[j].value;
+                        j++;
+                    }
+                    if (sum != static_cast<T>(0)) {
+                        offsets[major(triplets[i]) + 1]++;
+                        indices.push_back(minor(triplets[i]));
+                        values.push_back(sum);
+                    }
+                    i = j;
+                }
+                for (std::size_t i = 0; i < majorDim(); i++) {
+                    offsets[i + 1] += offsets[i];
+                }
+            }
+
+        public:
+            using value_type = T;
+
+            /**
+             * \brief Constructs a nrows x ncols sparse matrix of zeros.
+             * */
+            SparseMatrix(
+                const std::size_t& nrows,
+                const std::size_t& ncols,
+                const SparseLayout& layout=SparseLayout::CSR
+            ): nrows {nrows}, ncols {ncols}, layout {layout}, offsets(majorDim() + 1, 0), indices {}, values {} {}
+
+            /**
+             * \brief Constructs a sparse matrix from its non zero elements.
+             *
+             * The triplets can come in any order. Duplicates are summed, and elements that are (or sum to) 0 are dropped.
+             *
+             * \throw e std::out_of_range if an element is out of the dimensions.
+             * */
+            SparseMatrix(
+                const std::size_t& nrows,
+                const std::size_t& ncols,
+                std::vector<Triplet<T>> triplets,
+                const SparseLayout& layout=SparseLayout::CSR
+            ): SparseMatrix(nrows, ncols, layout) {
+                build(std::move(triplets));
+            }
+
+            /**
+             * \brief Constructs a sparse matrix from the non zero elements of a dense matrix, or of a view on one.
+             * */
+            explicit SparseMatrix(const ConstMatrixView<T>& dense, const SparseLayout& layout=SparseLayout::CSR):
+                SparseMatrix(dense.getRows(), dense.getCols(), layout) {
+                std::vector<Triplet<T>> triplets {};
+                for (std::size_t i = 0; i < nrows; i++) {
+                    for (std::size_t j = 0; j < ncols; j++) {
+                        const T& elem {dense.atUnchecked(i, j)};
+                        if (elem != static_cast<T>(0)) {
+                            triplets.push_back(Triplet<T> {i, j, elem});
+                        }
+                    }
+                }
+                build(std::move(triplets));
+            }
+
+            //! \cond NO_DOC
+            explicit SparseMatrix(const Matrix<T>& dense, const SparseLayout& layout=SparseLayout::CSR):
+                SparseMatrix(dense.view(), layout) {}
+            //! \endcond
+
+            SparseMatrix(const SparseMatrix<T>& other)=delete;
+            void operator=(const SparseMatrix<T>& other)=delete;
+            SparseMatrix(SparseMatrix<T>&& other)=default;
+            SparseMatrix<T>& operator=(SparseMatrix<T>&& other)=default;
+
+            /**
+             * \brief Get the number of rows in the matrix.
+             * */
+            std::size_t getRows() const {
+                return nrows;
+            }
+
+            /**
+             * \brief Get the number of columns in the matrix.
+             * */
+            std::size_t getCols() const {
+                return ncols;
+            }
+
+            /**
+             * \brief The storage layout.
+             * */
+            SparseLayout get_layout() const {
+                return layout;
+            }
+
+            /**
+             * \brief The number of stored (non zero) elements.
+             * */
+            std::size_t nonZeros() const {
+                return values.size();
+            }
+
+            /**
+             * \brief The offsets of the rows (CSR) or columns (CSC) in `get_indices` and `get_values`. There is one more
+             * offset than rows (columns); the last one is `nonZeros()`.
+             * */
+            const std::vector<std::size_t>& get_offsets() const {
+                return offsets;
+            }
+
+            /**
+             * \brief The column (CSR) or row (CSC) index of every stored element.
+             * */
+            const std::vector<std::size_t>& get_indices() const {
+                return indices;
+            }
+
+            /**
+             * \brief The stored elements.
+             * */
+            const std::vector<T>& get_values() const {
+                return values;
+            }
+
+            /**
+             * \brief Element access. This is a binary search in the row (CSR) or column (CSC).
+             *
+             * \throw e std::out_of_range if the indices are out of range.
+             *
+             * \return The element, 0 if it is not stored.
+             * */
+            T at(const std::size_t& row, const std::size_t& col) const {
+                if (row >= nrows || col >= ncols) {
+                    throw std::out_of_range("Sparse matrix index out of range.");
+                }
+                const std::size_t major {layout == SparseLayout::CSR? row : col};
+                const std::size_t minor {layout == SparseLayout::CSR? col : row};
+                const auto first {indices.begin() + static_cast<std::ptrdiff_t>(offsets[major])};
+                const auto last {indices.begin() + static_cast<std::ptrdiff_t>(offsets[major + 1])};
+                const auto it {std::lower_bound(first, last, minor)};
+                if (it != last && *it == minor) {
+                    return values[static_cast<std::size_t>(it - indices.begin())];
+                }
+                return static_cast<T>(0);
+            }
+
+            /**
+             * \brief A copy of the matrix in the given layout. This is a transposition of the storage, O(non zeros).
+             * */
+            SparseMatrix<T> with_layout(const SparseLayout& target) const {
+                SparseMatrix<T> retval {nrows, ncols, target};
+                if (target == layout) {
+                    retval.offsets = offsets;
+                    retval.indices = indices;
+                    retval.values = values;
+                    return retval;
+                }
+                // Count the elements per new major index, then scatter.
+                for (const std::size_t& index : indices) {
+                    retval.offsets[index + 1]++;
+                }
+                for (std::size_t i = 0; i < retval.majorDim(); i++) {
+                    retval.offsets[i + 1] += retval.offsets[i];
+                }
+                retval.indices.resize(values.size());
+                retval.values.resize(values.size());
+                std::vector<std::size_t> next(retval.offsets.begin(), retval.offsets.end() - 1);
+                for (std::size_t major = 0; major < majorDim(); major++) {
+                    for (std::size_t p = offsets[major]; p < offsets[major + 1]; p++) {
+                        const std::size_t dest {next[indices[p]]++};
+                        retval.indices[dest] = major;
+                        retval.values[dest] = values[p];
+                    }
+                }
+                return retval;
+            }
+
+            /**
+             * \brief A dense copy of the matrix.
+             * */
+            Matrix<T> to_dense() const {
+                Matrix<T> retval {Matrix<T>::zero(nrows, ncols)};
+                for (std::size_t major = 0; major < majorDim(); major++) {
+                    for (std::size_t p = offsets[major]; p < offsets[major + 1]; p++) {
+                        if (layout == SparseLayout::CSR) {
+                            retval.atUnchecked(major, indices[p]) = values[p];
+                        } else {
+                            retval.atUnchecked(indices[p], major) = values[p];
+                        }
+                    }
+                }
+                return retval;
+            }
+        };
+
+        // Override multiply operator lhs = sparse matrix and rhs = vector. The product is a dense vector.
+        template <typename T> numeric::types::Vector<T> operator*(const SparseMatrix<T>& lhs, const numeric::types::Vector<T>& rhs) {
+            if (lhs.getCols() != rhs.size()) {
+                throw std::invalid_argument("Incompatible matrix and vector for multiplication.");
+            }
+
+            Vector<T> retval(lhs.getRows(), rhs.get_resource());
+            const T* src {rhs.data()};
+            T* dest {retval.data()};
+            const std::vector<std::size_t>& offsets {lhs.get_offsets()};
+            const std::vector<std::size_t>& indices {lhs.get_indices()};
+            const std::vector<T>& values {lhs.get_values()};
+            if (lhs.get_layout() == SparseLayout::CSR) {
+                for (std::size_t i = 0; i < lhs.getRows(); i++) {
+                    T sum = static_cast<T>(0);
+                    for (std::size_t p = offsets[i]; p < offsets[i + 1]; p++) {
+                        sum += values[p] * src[indices[p]];
+                    }
+                    dest[i] = sum;
+                }
+            } else {
+                for (std::size_t i = 0; i < lhs.getRows(); i++) {
+                    dest[i] = static_cast<T>(0);
+                }
+                for (std::size_t j = 0; j < lhs.getCols(); j++) {
+                    const T factor {src[j]};
+                    for (std::size_t p = offsets[j]; p < offsets[j + 1]; p++) {
+                        dest[indices[p]] += values[p] * factor;
+                    }
+                }
+            }
+            return retval;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef __SIGABRT_NUMERIC_SYSTEMBATCH__
+#define __SIGABRT_NUMERIC_SYSTEMBATCH__
+
+#include <cstddef>
+#include <exception>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+
+#include <numeric/memory/buffer.hpp>
+
+/**
+ * \namespace numeric
+ *
+ * \brief The root namespace.
+ * */
+namespace numeric {
+    /**
+     * \namespace numeric::types
+     *
+     * \brief The namespace containing some special types.
+     * */
+    namespace types {
+        /**
+         * \class SystemBatch
+         *
+         * \tparam T float or double.
+         *
+         * \brief Many independent augmented systems of the same shape, stored as a structure of arrays.
+         *
+         * Every system is a rows x cols augmented matrix (the last column is the right hand side), so it has cols - 1
+         * variables. Element (row, col) of all the systems is one contiguous array of `getCount()` values (see `lanes`):
+         * the systems are the innermost dimension. This is what lets `batched_gauss_jordan` in `math/batched.hpp` run the
+         * same elimination step on consecutive systems with SIMD instructions, instead of one small matrix at a time.
+         *
+         * The solutions are stored the same way, one array per variable, and are filled by the solver.
+         *
+         * The storage is allocated from a `std::pmr::memory_resource`, like `Matrix` and `Vector`. Like them, this is not
+         * copyable.
+         * */
+        template <typename T> class SystemBatch {
+        private:
+            static_assert(std::is_floating_point<T>::value, "SystemBatch needs a floating point type.");
+
+            std::size_t count;
+            std::size_t nrows;
+            std::size_t ncols;
+            numeric::memory::Buffer<T> storage;
+            numeric::memory::Buffer<T> solutions;
+
+        public:
+            using value_type = T;
+
+            /**
+             * \brief Constructs a batch of `count` systems of rows x cols, all zeros.
+             *
+             * \throw e std::invalid_argument if there is no right hand side column.
+             * */
+            SystemBatch(
+                const std::size_t& count,
+                const std::size_t& rows,
+                const std::size_t& cols,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+            ): count {count},
+                nrows {rows},
+                ncols {cols},
+                storage {numeric::memory::make_buffer<T>(count*rows*cols, resource)},
+                solutions {numeric::memory::make_buffer<T>(count*(cols > 0? cols - 1 : 0), resource)} {
+                if (cols == 0) {
+                    throw std::invalid_argument("An augmented system needs at least the right hand side column.");
+                }
+            }
+
+            SystemBatch(const SystemBatch<T>& other)=delete;
+            void operator=(const SystemBatch<T>& other)=delete;
+            SystemBatch(SystemBatch<T>&& other)=default;
+            SystemBatch<T>& operator=(SystemBatch<T>&& other)=default;
+
+            /**
+             * \brief The number of systems.
+             * */
+            std::size_t getCount() const {
+                return count;
+            }
+
+            /**
+             * \brief The number of rows (equations) of every system.
+             * */
+            std::size_t getRows() const {
+                return nrows;
+            }
+
+            /**
+             * \brief The number of columns of every augmented system. There are `getCols() - 1` variables.
+             * */
+            std::size_t getCols() const {
+                return ncols;
+            }
+
+            /**
+             * \brief Element (row, col) of every system: `lanes(row, col)[system]`.
+             * */
+            T* lanes(const std::size_t& row, const std::size_t& col) {
+                return storage.get() + (row*ncols + col)*count;
+            }
+
+            //! \cond NO_DOC
+            const T* lanes(const std::size_t& row, const std::size_t& col) const {
+                return storage.get() + (row*ncols + col)*count;
+            }
+            //! \endcond
+
+            /**
+             * \brief Element access, with range checks.
+             *
+             * \throw e std::out_of_range if an index is out of range.
+             * */
+            T& at(const std::size_t& system, const std::size_t& row, const std::size_t& col) {
+                if (system >= count || row >= nrows || col >= ncols) {
+                    throw std::out_of_range("System batch index out of range.");
+                }
+                return lanes(row, col)[system];
+            }
+
+            //! \cond NO_DOC
+            const T& at(const std::size_t& system, const std::size_t& row, const std::size_t& col) const {
+                if (system >= count || row >= nrows || col >= ncols) {
+                    throw std::out_of_range("System batch index out of range.");
+                }
+                return lanes(row, col)[system];
+            }
+            //! \endcond
+
+            /**
+             * \brief Variable `var` of the solution of every system: `solutionLanes(var)[system]`.
+             *
+             * Only meaningful for the systems `batched_gauss_jordan` reported as solved.
+             * */
+            T* solutionLanes(const std::size_t& var) {
+                return solutions.get() + var*count;
+            }
+
+            //! \cond NO_DOC
+            const T* solutionLanes(const std::size_t& var) const {
+                return solutions.get() + var*count;
+            }
+            //! \endcond
+
+            /**
+             * \brief Variable `var` of the solution of a system, with range checks.
+             *
+             * \throw e std::out_of_range if an index is out of range.
+             * */
+            const T& solution(const std::size_t& system, const std::size_t& var) const {
+                if (system >= count || var >= ncols - 1) {
+                    throw std::out_of_range("System batch index out of range.");
+                }
+                return solutionLanes(var)[system];
+            }
+        };
+    }
+}
+
+#endif
@@ -1,14 +1,21 @@
 #ifndef __SIGABRT_NUMERIC_VECTOR__
 #define __SIGABRT_NUMERIC_VECTOR__
 
+#include <atomic>
+#include <cassert>
 #include <cmath>
 #include <exception>
 #include <initializer_list>
 #include <memory>
+#include <memory_resource>
 #include <type_traits>
 #include <vector>
 
+#include <numeric/benchmark/instrumentation.hpp>
+#include <numeric/memory/buffer.hpp>
 #include <numeric/types/models.hpp>
+#include <numeric/types/expressions.hpp>
+#include <numeric/kernels/simd.hpp>
 
 /**
  * \namespace numeric
@@ -39,38 +46,137 @@ namespace numeric {
          *   - There is no copy constructor and assignment operator. They have been deleted. You do have move constructor and move assignment.
          * 
          * Functionality:
-         *   - A `mod` function that gives the root sum of square size.
+         *   - A `mod` function that gives the sum of squares (the magnitude squared). It is cached, see below.
          *   - The usual `size` function.
-         *   - Defined add, subtract and multiply (dot product) operators.
+         *   - Defined add, subtract and multiply (dot product) operators. Add, subtract, negate and scaling by a scalar are
+         *     lazy, see `VectorExpression`. A `Vector` can be constructed from, or assigned an expression.
          *   - The `Matrix` class defines multiplication rules with this class.
          *   - Defined index ([]) operator with range check.
+         *   - `data()` and `atUnchecked(i)` for hot loops. These skip the range check (it is only an `assert`, so it is gone in
+         *     release builds).
+         * 
+         * `mod` is computed once and cached, on const and non const vectors alike, so it is cheap to call repeatedly (as the
+         * functions in `vectorspaces.hpp` do). Every member that hands out mutable access to the elements (non const
+         * `operator[]`, `atUnchecked`, `data`, `begin` and `end`), `scale` and assignment invalidate the cache. If you hold
+         * on to a mutable pointer or reference across a call to `mod` and write through it afterwards, call
+         * `invalidate_mod()`. The cache is an atomic, so calling `mod` on a shared const vector from several threads is
+         * safe.
+         * 
+         * For `float` and `double`, the dot product, `mod`, `scale`, add, subtract and negate run on the SIMD kernels in
+         * `numeric/kernels/simd.hpp`, picked at runtime for the CPU. Other types use plain loops over the storage.
+         * 
+         * The storage is allocated from a `std::pmr::memory_resource`, which is the default resource unless one is passed to
+         * the constructor. Pass a `numeric::memory::Arena` to get many short lived vectors without going to malloc. The
+         * resource travels with the storage on moves, and results of arithmetic use the default resource.
          * 
          * */
-        template <typename T> class Vector {
+        template <typename T> class Vector: public VectorExpression<Vector<T>> {
             static_assert(std::is_default_constructible<T>::value, "Type T has to be default constructible.");
         private:
             std::size_t length;
-            std::unique_ptr<T[]> storage;
-            double magnitude {-1.0};
+            numeric::memory::Buffer<T> storage;
+            // The cached mod, or a negative value if it has to be recomputed.
+            mutable std::atomic<double> magnitude {-1.0};
+            
+            T sumOfSquares() const {
+                if constexpr (numeric::kernels::HasSimdKernel<T>::value) {
+                    return numeric::kernels::vector_kernels<T>().dot(storage.get(), storage.get(), length);
+                } else {
+                    return numeric::kernels::scalar::dot(storage.get(), storage.get(), length);
+                }
+            }
         public:
-            Vector(const std::size_t& length): length {length}, storage {std::make_unique<T[]>(length)} {}
-            Vector(const std::vector<T>& elems): length {elems.size()}, storage {std::make_unique<T[]>(elems.size())} {
+            using value_type = T;
+            
+            Vector(
+                const std::size_t& length,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+            ): length {length}, storage {numeric::memory::make_buffer<T>(length, resource)} {}
+            
+            Vector(
+                const std::vector<T>& elems,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+            ): length {elems.size()}, storage {numeric::memory::make_buffer<T>(elems.size(), resource)} {
                 auto it {elems.begin()};
                 for (std::size_t i = 0; i < elems.size(); i++, it++) {
                     storage[i] = *it;
                 }
             }
             
-            Vector(Vector<T>&& other): length {other.length}, storage {std::move(other.storage)} {
+            Vector(Vector<T>&& other):
+                length {other.length},
+                storage {std::move(other.storage)},
+                magnitude {other.magnitude.load(std::memory_order_relaxed)} {
                 other.length = 0;
                 other.storage = nullptr;
+                other.invalidate_mod();
             }
             
             void operator=(Vector<T>&& other){
                 length = other.length;
                 storage = std::move(other.storage); // Assignment will release and reset.
+                magnitude.store(other.magnitude.load(std::memory_order_relaxed), std::memory_order_relaxed);
                 other.length = 0;
                 other.storage = nullptr;
+                other.invalidate_mod();
+            }
+            
+            /**
+             * \brief Construct a vector from an expression.
+             * 
+             * The expression is evaluated in a single pass, directly into the new vector's storage.
+             * 
+             * \param expr The vector expression, like `a*x + b*y - z`.
+             * 
+             * \param resource The memory resource to allocate the storage from.
+             * 
+             * The constructor is explicit if the element type of the expression is not T, so that conversions are spelled
+             * out, as in `Vector<float> single {doubles + doubles}`.
+             * */
+            template <typename E, typename std::enable_if<std::is_same<typename E::value_type, T>::value, int>::type=0> Vector(
+                const VectorExpression<E>& expr,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+            ): length {expr.self().size()}, storage {numeric::memory::make_buffer<T>(expr.self().size(), resource)} {
+                evaluate_into(storage.get(), expr.self());
+            }
+
+            //! \cond NO_DOC
+            template <typename E, typename std::enable_if<!std::is_same<typename E::value_type, T>::value, int>::type=0> explicit Vector(
+                const VectorExpression<E>& expr,
+                std::pmr::memory_resource* resource=std::pmr::get_default_resource()
+            ): length {expr.self().size()}, storage {numeric::memory::make_buffer<T>(expr.self().size(), resource)} {
+                evaluate_into(storage.get(), expr.self());
+            }
+            //! \endcond
+            
+            /**
+             * \brief Assign an expression to this vector.
+             * 
+             * The expression is evaluated in a single pass. The existing storage is reused if the dimensions match, and
+             * the expression may refer to this vector (as in `v = v + w`).
+             * 
+             * \param expr The vector expression.
+             * 
+             * \return A reference to this.
+             * */
+            template <typename E> Vector<T>& operator=(const VectorExpression<E>& expr) {
+                if (expr.self().size() != length) {
+                    auto fresh {numeric::memory::make_buffer<T>(expr.self().size(), get_resource())};
+                    evaluate_into(fresh.get(), expr.self());
+                    storage = std::move(fresh);
+                    length = expr.self().size();
+                } else {
+                    evaluate_into(storage.get(), expr.self());
+                }
+                invalidate_mod();
+                return *this;
+            }
+            
+            /**
+             * \brief The memory resource the storage was allocated from.
+             * */
+            std::pmr::memory_resource* get_resource() const {
+                return storage.get_deleter().resource;
             }
             
             // Delete the copy constructor and copy asignment as copying is usually a bad idea
@@ -100,30 +206,29 @@ namespace numeric {
              * \brief Modulus (length) of the vector
              * 
              * This function returns the magnitude (length) squared of the vector. Alailable for both const and non const objects / references.
+             * The value is cached until the vector is modified, see the class documentation.
              * 
              * \return: The magnitude.
              * */
             double mod() const {
-                T acc {static_cast<T>(0)};
-                for (std::size_t i = 0; i < length; i++) {
-                    acc += storage[i]*storage[i];
+                const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::VECTOR_MOD};
+                double cached {magnitude.load(std::memory_order_relaxed)};
+                if (cached < 0) {
+                    // Threads racing here compute the same value, so whichever store lands is fine.
+                    cached = static_cast<double>(sumOfSquares());
+                    magnitude.store(cached, std::memory_order_relaxed);
                 }
-                return static_cast<double>(acc);
+                return cached;
             }
-            
-            //! \cond NO_DOC
-            double mod() {
-                if(magnitude < 0) {
-                    T acc {static_cast<T>(0)};
-                    for (std::size_t i = 0; i < length; i++) {
-                        acc += storage[i]*storage[i];
-                    }
-                    magnitude = static_cast<double>(acc);
-                    
-                } 
-                return magnitude;
+
+            /**
+             * \brief Drop the cached `mod`.
+             * 
+             * Only needed after writing through a pointer or reference that was obtained before the last call to `mod`.
+             * */
+            void invalidate_mod() {
+                magnitude.store(-1.0, std::memory_order_relaxed);
             }
-            //! \endcond
             
             /**
              * \brief Scale the vector
@@ -136,9 +241,14 @@ namespace numeric {
              * \return A reference to this.
              * */
             Vector<T>& scale(const T& scalar) {
-                for (std::size_t i = 0; i < length; i++) {
-                    storage[i] *= scalar;
+                if constexpr (numeric::kernels::HasSimdKernel<T>::value) {
+                    numeric::kernels::vector_kernels<T>().scale(storage.get(), scalar, storage.get(), length);
+                } else {
+                    for (std::size_t i = 0; i < length; i++) {
+                        storage[i] *= scalar;
+                    }
                 }
+                invalidate_mod();
                 return *this;
             }
             
@@ -153,29 +263,71 @@ namespace numeric {
                 if (index >= length) {
                     throw std::out_of_range("Vector index out of range.");
                 }
+                invalidate_mod();
                 return storage[index];
             }
             
+            /**
+             * \brief Unchecked element access.
+             * 
+             * The index is only checked with `assert`, so this costs nothing in release builds.
+             * 
+             * \param index The index.
+             * 
+             * \return Reference to the element.
+             * */
+            T& atUnchecked(const std::size_t& index) {
+                assert(index < length);
+                invalidate_mod();
+                return storage[index];
+            }
+            
+            //! \cond NO_DOC
+            const T& atUnchecked(const std::size_t& index) const {
+                assert(index < length);
+                return storage[index];
+            }
+            //! \endcond
+            
+            /**
+             * \brief Pointer to the contiguous storage of the vector.
+             * 
+             * \return Pointer to `size()` elements.
+             * */
+            T* data() {
+                invalidate_mod();
+                return storage.get();
+            }
+            
+            //! \cond NO_DOC
+            const T* data() const {
+                return storage.get();
+            }
+            //! \endcond
+            
             const T* begin() const {
-                return &storage[0];
+                return storage.get();
             }
             
             T* begin() {
-                return &storage[0];
+                invalidate_mod();
+                return storage.get();
             }
             
             const T* end() const {
-                return &storage[length];
+                return storage.get() + length;
             }
             
             T* end() {
-                return &storage[length];
+                invalidate_mod();
+                return storage.get() + length;
             }
-            
-            template <typename U, typename V> friend Vector<U> operator*(const V& scalar, const Vector<U>& rhs);
-            template <typename U, typename V> friend Vector<U> operator*(const Vector<U>& lhs, const V& scalar);
         };
         
+        //! \cond NO_DOC
+        template <typename E> Vector(const VectorExpression<E>&) -> Vector<typename E::value_type>;
+        //! \endcond
+        
         /**
          * \tparam T The vector type.
          * 
@@ -189,123 +341,15 @@ namespace numeric {
          * \param rhs v2 vector.
          * */
         template <typename T, typename U> T operator*(const Vector<T>& lhs, const Vector<U>& rhs) {
+            const numeric::benchmark::ScopedTimer<T> timer {numeric::benchmark::Kernel::VECTOR_DOT};
             if (lhs.size() != rhs.size()) {
                 throw std::invalid_argument("Cannot compute dot product of vectors with different dimensions.");
             }
-            T acc {static_cast<T>(0)};
-            for (std::size_t i = 0; i < lhs.size(); i++) {
-                acc += (lhs[i] * rhs[i]);
-            }
-            return acc;
-        }
-        
-        /**
-         * \tparam T The vector type.
-         * 
-         * \brief Multiplication operator overload for a vector with a scalar.
-         * 
-         * This overloads the multiply operator to perform an out of place scaling of a vector. You can do Vector<double> scaled {2*v1}
-         * 
-         * Take note that this returns a new vector. So for scenarios, where you have to update 
-         * a vector like `v1 = 2 * v1` just use `v1.scale(2)` instead. That will scale v1 in place 
-         * and not waste time copying.
-         * 
-         * \param scalar A scalar.
-         * 
-         * \param rhs v1 vector.
-         * */
-        template <typename T, typename U> Vector<T> operator*(const U& scalar, const Vector<T>& rhs) {
-            Vector<T> res {rhs.size()};
-            for (std::size_t i = 0; i < rhs.size(); i++) {
-                res[i] = scalar*rhs[i];
-            }
-            res.magnitude = scalar*rhs.magnitude;
-            return res;
-        }
-        
-        /**
-         * \tparam T The vector type.
-         * 
-         * \brief Multiplication operator overload for a vector with a scalar.
-         * 
-         * This overloads the multiply operator to perform an out of place scaling of a vector. You can do Vector<double> scaled {v1*2}
-         * 
-         * Take note that this returns a new vector. So for scenarios, where you have to update 
-         * a vector like `v1 = v1*2` just use `v1.scale(2)` instead. That will scale v1 in place 
-         * and not waste time copying.
-         * 
-         * \param scalar A scalar.
-         * 
-         * \param lhs v1 vector.
-         * */
-        template <typename T,typename U> Vector<T> operator*(const Vector<T>& lhs, const U& scalar) {
-            Vector<T> res {lhs.size()};
-            for (std::size_t i = 0; i < lhs.size(); i++) {
-                res[i] = scalar*lhs[i];
-            }
-            res.magnitude = scalar*lhs.magnitude;
-            return res;
-        }
-        
-        /**
-         * \tparam T The vector type.
-         * 
-         * \brief Addition operator overload for 2 vectors.
-         * 
-         * This overloads the addition operator to perform sum of 2 vectors. You can do double `Vector<double> sum {v1+v2}`.
-         * 
-         * \param lhs v1 vector.
-         * 
-         * \param rhs v2 vector.
-         * */
-        template <typename T> Vector<T> operator+(const Vector<T>& lhs, const Vector<T>& rhs) {
-            if (lhs.size() != rhs.size()) {
-                throw std::invalid_argument("Cannot compute dot product of vectors with different dimensions.");
-            }
-            Vector<T> retval {lhs.size()};
-            for (std::size_t i = 0; i < lhs.size(); i++) {
-                retval[i] = lhs[i] + rhs[i];
-            }
-            return retval;
-        }
-        
-        /**
-         * \tparam T The vector type.
-         * 
-         * \brief Subtraction operator overload for 2 vectors.
-         * 
-         * This overloads the subtraction operator to perform subtraction of 2 vectors. You can do double `Vector<double> diff {v1-v2}`.
-         * 
-         * \param lhs v1 vector.
-         * 
-         * \param rhs v2 vector.
-         * */
-        template <typename T> Vector<T> operator-(const Vector<T>& lhs, const Vector<T>& rhs) {
-            if (lhs.size() != rhs.size()) {
-                throw std::invalid_argument("Cannot compute dot product of vectors with different dimensions.");
-            }
-            Vector<T> retval {lhs.size()};
-            for (std::size_t i = 0; i < lhs.size(); i++) {
-                retval[i] = lhs[i] - rhs[i];
-            }
-            return retval;
-        }
-        
-        /**
-         * \tparam T The vector type.
-         * 
-         * \brief Negation operator overload for a vector.
-         * 
-         * This overloads the negation operator negate vectors. You can do double `Vector<double> neg {-v1}`.
-         * 
-         * \param lhs v1 vector.
-         * */
-        template <typename T> Vector<T> operator-(const Vector<T>& lhs) {
-            Vector<T> retval {lhs.size()};
-            for (std::size_t i = 0; i < lhs.size(); i++) {
-                retval[i] = -lhs[i];
+            if constexpr (std::is_same<T, U>::value && numeric::kernels::HasSimdKernel<T>::value) {
+                return numeric::kernels::vector_kernels<T>().dot(lhs.data(), rhs.data(), lhs.size());
+            } else {
+                return numeric::kernels::scalar::dot(lhs.data(), rhs.data(), lhs.size());
             }
-            return retval;
         }
         
         /**
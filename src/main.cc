@@ -1,52 +1,82 @@
-#include <numeric/types/models.hpp>
-#include <numeric/types/vector.hpp>
-#include <numeric/math/rref.hpp>
-#include <numeric/types/fraction.hpp>
-#include <numeric/types/plane.hpp>
+#include <numeric/service/solveservice.hpp>
 #include <numeric/types/matrix.hpp>
-#include <numeric/benchmark/benchmark.hpp>
-#include <numeric/math/vectorspaces.hpp>
+#include <numeric/types/vector.hpp>
 #include <numeric/math/errors.hpp>
 
+#include <chrono>
+#include <cstddef>
+#include <future>
 #include <iostream>
+#include <string>
 #include <vector>
-#include <iterator>
-#include <type_traits>
 
-using Sigabrt::Types::Fraction;
-using Sigabrt::Types::Vector;
-using Sigabrt::Types::Plane;
-using Sigabrt::Types::IsScalarType;
-using Sigabrt::Types::Matrix;
-using Sigabrt::Types::Result;
-using Sigabrt::Numeric::ErrorCode;
-using Sigabrt::Types::OperationType;
-using Sigabrt::Types::Unit;
-using Sigabrt::Numeric::isNormalToPlane;
-using Sigabrt::Numeric::cross;
-using Sigabrt::Numeric::rref;
+using numeric::service::SolveService;
+using numeric::service::SolveServiceOptions;
+using numeric::types::Matrix;
+using numeric::ErrorCode;
 
-void display(const Matrix<double>& m) {
-    for (const auto& row: m) {
-        for (const auto& elem: row) {
-            std::cout << elem << " ";
-        }
-        std::cout << "\n";
+// Reads the systems from stdin and writes their solutions to stdout, in the same order.
+//
+// Every system is its number of rows and columns, followed by the elements of its augmented matrix, row by row. Every
+// solution is one line: "ok" and the solution, or "error" and the error code. Systems are submitted as soon as they are
+// read, and solutions are written as soon as they, and the ones before them, are ready, so the input can be a stream.
+
+const char* describe(const ErrorCode& code) {
+    switch (code) {
+        case ErrorCode::UNDERDETERMINED_SYSTEM: return "UNDERDETERMINED_SYSTEM";
+        case ErrorCode::INFINITE_SOLUTIONS: return "INFINITE_SOLUTIONS";
+        case ErrorCode::NO_SOLUTIONS: return "NO_SOLUTIONS";
+        default: return "UNKNOWN_ERROR";
+    }
+}
+
+void write(SolveService<double>::SolveResult&& result) {
+    if (!result) {
+        std::cout << "error " << describe(result.error()) << "\n";
+        return;
     }
+    std::cout << "ok";
+    for (const double& elem : result.unwrap()) {
+        std::cout << " " << elem;
+    }
+    std::cout << "\n";
 }
 
-int main() {
-    Matrix<double> matrix {{
-        {1,2},
-        {7,14},
-        {11,22}
-    }};
-    Result<Unit, ErrorCode> res {rref(matrix)};
-    display(matrix);
-    auto resType {res.type};
-    if (resType == OperationType::OK) {
-        std::cout << "OK\n";
-    } else {
-        std::cout << "Not OK\n";
+int main(int argc, char** argv) {
+    SolveServiceOptions options {};
+    if (argc > 1) {
+        options.numThreads = std::stoul(argv[1]);
+    }
+    SolveService<double> service {options};
+
+    std::vector<std::future<SolveService<double>::SolveResult>> results;
+    std::size_t written {0};
+    std::size_t rows {0};
+    std::size_t cols {0};
+    while (std::cin >> rows >> cols) {
+        if (rows == 0 || cols == 0) {
+            std::cerr << "Bad system shape " << rows << " x " << cols << "\n";
+            return 1;
+        }
+        Matrix<double> system {rows, cols};
+        for (std::size_t i = 0; i < rows; i++) {
+            for (std::size_t j = 0; j < cols; j++) {
+                if (!(std::cin >> system[i][j])) {
+                    std::cerr << "Truncated system " << results.size() << "\n";
+                    return 1;
+                }
+            }
+        }
+        results.push_back(service.submit(std::move(system)));
+        for (; written < results.size(); written++) {
+            if (results[written].wait_for(std::chrono::seconds {0}) != std::future_status::ready) {
+                break;
+            }
+            write(results[written].get());
+        }
+    }
+    for (; written < results.size(); written++) {
+        write(results[written].get());
     }
+    return 0;
 }
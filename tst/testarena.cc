@@ -0,0 +1,253 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+
+#include <catch2/catch.hpp>
+#include <numeric/memory/arena.hpp>
+#include <numeric/memory/buffer.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/vector.hpp>
+
+using numeric::memory::Arena;
+using numeric::memory::make_buffer;
+using numeric::types::Matrix;
+using numeric::types::Vector;
+
+class CountingResource: public std::pmr::memory_resource {
+public:
+    std::size_t allocations {0};
+    std::size_t deallocations {0};
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+        deallocations++;
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+struct ThrowsOnThird {
+    static int count;
+    ThrowsOnThird() {
+        if (++count == 3) {
+            throw std::runtime_error("Third.");
+        }
+    }
+};
+int ThrowsOnThird::count {0};
+
+SCENARIO("Arena memory resource.") {
+
+    GIVEN("I have an arena on top of a counting resource.") {
+
+        CountingResource upstream;
+        Arena arena {1024, &upstream};
+
+        WHEN("I allocate blocks of different alignments.") {
+
+            void* a {arena.allocate(3, 1)};
+            void* b {arena.allocate(16, 64)};
+            void* c {arena.allocate(8, 8)};
+
+            THEN("They should be aligned, and come from a single upstream chunk.") {
+
+                REQUIRE(nullptr != a);
+                REQUIRE(0 == reinterpret_cast<std::uintptr_t>(b) % 64);
+                REQUIRE(0 == reinterpret_cast<std::uintptr_t>(c) % 8);
+                REQUIRE(1 == upstream.allocations);
+                REQUIRE(27 == arena.bytes_used());
+            }
+        }
+
+        WHEN("I free the latest allocation and allocate again.") {
+
+            void* a {arena.allocate(100, 8)};
+            arena.deallocate(a, 100, 8);
+            void* b {arena.allocate(100, 8)};
+
+            THEN("The space should be reused.") {
+
+                REQUIRE(a == b);
+                REQUIRE(100 == arena.bytes_used());
+            }
+        }
+
+        WHEN("I allocate more than a chunk, reset, and allocate the same again.") {
+
+            for (int i = 0; i < 10; i++) {
+                REQUIRE(nullptr != arena.allocate(500, 8));
+            }
+            const std::size_t reserved {arena.bytes_reserved()};
+            const std::size_t chunks {upstream.allocations};
+            arena.reset();
+            for (int i = 0; i < 10; i++) {
+                REQUIRE(nullptr != arena.allocate(500, 8));
+            }
+
+            THEN("The second round should not go upstream.") {
+
+                REQUIRE(chunks > 1);
+                REQUIRE(chunks == upstream.allocations);
+                REQUIRE(reserved == arena.bytes_reserved());
+            }
+
+            AND_WHEN("I release the arena.") {
+
+                arena.release();
+
+                THEN("All chunks should be returned upstream.") {
+
+                    REQUIRE(upstream.allocations == upstream.deallocations);
+                    REQUIRE(0 == arena.bytes_reserved());
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Matrices and vectors on a memory resource.") {
+
+    GIVEN("I have a counting resource.") {
+
+        CountingResource resource;
+
+        WHEN("I create and destroy a matrix and a vector on it.") {
+
+            {
+                Matrix<double> m {3, 4, &resource};
+                Vector<double> v {{1, 2, 3}, &resource};
+                REQUIRE(&resource == m.get_resource());
+                REQUIRE(&resource == v.get_resource());
+                REQUIRE(0.0 == m[2][3]);
+                REQUIRE(3.0 == v[2]);
+
+                Matrix<double> moved {std::move(m)};
+                REQUIRE(&resource == moved.get_resource());
+            }
+
+            THEN("Every allocation should have gone through it, and been given back.") {
+
+                REQUIRE(3 == resource.allocations);
+                REQUIRE(3 == resource.deallocations);
+            }
+        }
+
+        WHEN("I assign an expression of a different size to a matrix and a vector on it.") {
+
+            Matrix<double> m {1, 1, &resource};
+            Vector<double> v {1, &resource};
+            Matrix<double> a {{{1, 2}, {3, 4}}};
+            Vector<double> x {{1, 2}};
+            m = a + a;
+            v = x - x;
+
+            THEN("The new storage should come from the same resource.") {
+
+                REQUIRE(&resource == m.get_resource());
+                REQUIRE(&resource == v.get_resource());
+                REQUIRE(8.0 == m[1][1]);
+                REQUIRE(6 == resource.allocations);
+            }
+        }
+    }
+
+    GIVEN("I have a counting resource and some operands on it.") {
+
+        CountingResource resource;
+
+        WHEN("I multiply them.") {
+
+            {
+                Matrix<double> a {{{1, 2}, {3, 4}}, &resource};
+                Vector<double> x {{1, 1}, &resource};
+                Matrix<double> product {a*a};
+                Vector<double> column {a*x};
+                Vector<double> row {x*a};
+
+                REQUIRE(&resource == product.get_resource());
+                REQUIRE(&resource == column.get_resource());
+                REQUIRE(&resource == row.get_resource());
+                REQUIRE(22.0 == product[1][1]);
+                REQUIRE(7.0 == column[1]);
+                REQUIRE(6.0 == row[1]);
+            }
+
+            THEN("The results should have been allocated from the resource of the left hand side.") {
+
+                REQUIRE(7 == resource.allocations);
+                REQUIRE(7 == resource.deallocations);
+            }
+        }
+    }
+
+    GIVEN("I have a zero length vector and matrix.") {
+
+        Vector<double> v {0};
+        Matrix<double> m {0, 0};
+
+        WHEN("I iterate over them.") {
+
+            std::size_t count {0};
+            for (const auto& elem : v) {
+                count += elem == 0.0? 1 : 2;
+            }
+            for (const auto& row : m) {
+                count += row.size;
+            }
+
+            THEN("There should be nothing to visit.") {
+
+                REQUIRE(v.begin() == v.end());
+                REQUIRE(m.begin() == m.end());
+                REQUIRE(0 == count);
+                REQUIRE(v == Vector<double> {0});
+            }
+        }
+    }
+
+    GIVEN("I have an arena.") {
+
+        Arena arena;
+
+        WHEN("I do a computation on it.") {
+
+            Matrix<double> a {{{1, 2}, {3, 4}}, &arena};
+            Vector<double> x {{1, 1}, &arena};
+            Vector<double> y {a*x - x, &arena};
+
+            THEN("The results should be as usual.") {
+
+                REQUIRE(2.0 == y[0]);
+                REQUIRE(6.0 == y[1]);
+                REQUIRE(arena.bytes_used() > 0);
+            }
+        }
+    }
+
+    GIVEN("I have a type which throws from its constructor.") {
+
+        CountingResource resource;
+        ThrowsOnThird::count = 0;
+
+        WHEN("I make a buffer of it.") {
+
+            THEN("The memory should be given back.") {
+
+                REQUIRE_THROWS_AS(make_buffer<ThrowsOnThird>(5, &resource), std::runtime_error);
+                REQUIRE(1 == resource.allocations);
+                REQUIRE(1 == resource.deallocations);
+            }
+        }
+    }
+}
@@ -0,0 +1,166 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cmath>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/systembatch.hpp>
+#include <numeric/math/batched.hpp>
+#include <numeric/math/errors.hpp>
+#include <numeric/math/gaussjordan.hpp>
+#include <numeric/parallel/threadpool.hpp>
+
+using numeric::types::Matrix;
+using numeric::types::SystemBatch;
+using numeric::functions::batched_gauss_jordan;
+using numeric::functions::gauss_jordan;
+using numeric::parallel::ThreadPool;
+using numeric::ErrorCode;
+
+SystemBatch<double> randomBatch(const std::size_t& count, const std::size_t& rows, const std::size_t& cols, const unsigned int& seed) {
+    std::mt19937 mt(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    SystemBatch<double> batch {count, rows, cols};
+    for (std::size_t s = 0; s < count; s++) {
+        for (std::size_t i = 0; i < rows; i++) {
+            for (std::size_t j = 0; j < cols; j++) {
+                batch.at(s, i, j) = dist(mt);
+            }
+        }
+    }
+    return batch;
+}
+
+Matrix<double> systemOf(const SystemBatch<double>& batch, const std::size_t& s) {
+    Matrix<double> matrix {batch.getRows(), batch.getCols()};
+    for (std::size_t i = 0; i < batch.getRows(); i++) {
+        for (std::size_t j = 0; j < batch.getCols(); j++) {
+            matrix[i][j] = batch.at(s, i, j);
+        }
+    }
+    return matrix;
+}
+
+SCENARIO("Batched gauss jordan.") {
+
+    GIVEN("I have a batch of random 4x5 systems, not a multiple of the tile size.") {
+
+        const std::size_t count {1000};
+        SystemBatch<double> batch {randomBatch(count, 4, 5, 7)};
+        std::vector<Matrix<double>> originals {};
+        for (std::size_t s = 0; s < count; s++) {
+            originals.push_back(systemOf(batch, s));
+        }
+
+        WHEN("I solve them together.") {
+
+            std::vector<std::optional<ErrorCode>> status {batched_gauss_jordan(batch)};
+
+            THEN("Every system should be solved, with the same solution as gauss_jordan.") {
+
+                REQUIRE(count == status.size());
+                for (std::size_t s = 0; s < count; s++) {
+                    REQUIRE(!status[s]);
+                    REQUIRE(gauss_jordan(originals[s]));
+                    for (std::size_t v = 0; v < 4; v++) {
+                        REQUIRE(std::fabs(originals[s][v][4] - batch.solution(s, v)) < 1e-8);
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("I have the same batch of 3x4 systems twice.") {
+
+        SystemBatch<double> serial {randomBatch(777, 3, 4, 11)};
+        SystemBatch<double> parallel {randomBatch(777, 3, 4, 11)};
+
+        WHEN("I solve one serially and the other with a thread pool.") {
+
+            ThreadPool pool {4};
+            std::vector<std::optional<ErrorCode>> serialStatus {batched_gauss_jordan(serial)};
+            std::vector<std::optional<ErrorCode>> parallelStatus {batched_gauss_jordan(parallel, pool)};
+
+            THEN("The results should be identical.") {
+
+                REQUIRE(serialStatus == parallelStatus);
+                for (std::size_t s = 0; s < 777; s++) {
+                    for (std::size_t v = 0; v < 3; v++) {
+                        REQUIRE(serial.solution(s, v) == parallel.solution(s, v));
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("I have a batch mixing solvable, inconsistent, free and zero leading systems.") {
+
+        const std::vector<std::vector<std::vector<double>>> systems {
+            {{0, 2, 1, 7}, {1, 1, 1, 6}, {2, 1, 3, 13}},
+            {{1, 1, 0, 1}, {2, 2, 0, 3}, {0, 0, 1, 1}},
+            {{1, 1, 0, 1}, {2, 2, 0, 2}, {0, 0, 1, 1}},
+            {{0, 0, 1, 1}, {0, 0, 1, 2}, {0, 0, 0, 0}},
+            {{0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}}
+        };
+        SystemBatch<double> batch {systems.size(), 3, 4};
+        for (std::size_t s = 0; s < systems.size(); s++) {
+            for (std::size_t i = 0; i < 3; i++) {
+                for (std::size_t j = 0; j < 4; j++) {
+                    batch.at(s, i, j) = systems[s][i][j];
+                }
+            }
+        }
+
+        WHEN("I solve them together.") {
+
+            std::vector<std::optional<ErrorCode>> status {batched_gauss_jordan(batch)};
+
+            THEN("Every system should get its own status.") {
+
+                REQUIRE(!status[0]);
+                REQUIRE(std::fabs(1.0 - batch.solution(0, 0)) < 1e-12);
+                REQUIRE(std::fabs(2.0 - batch.solution(0, 1)) < 1e-12);
+                REQUIRE(std::fabs(3.0 - batch.solution(0, 2)) < 1e-12);
+                REQUIRE(ErrorCode::NO_SOLUTIONS == *status[1]);
+                REQUIRE(ErrorCode::INFINITE_SOLUTIONS == *status[2]);
+                REQUIRE(ErrorCode::NO_SOLUTIONS == *status[3]);
+                REQUIRE(ErrorCode::INFINITE_SOLUTIONS == *status[4]);
+            }
+        }
+    }
+
+    GIVEN("I have a batch of under determined systems.") {
+
+        SystemBatch<double> batch {randomBatch(10, 2, 4, 3)};
+
+        WHEN("I try to solve them.") {
+
+            std::vector<std::optional<ErrorCode>> status {batched_gauss_jordan(batch)};
+
+            THEN("Every system should be reported as under determined.") {
+
+                for (const std::optional<ErrorCode>& code : status) {
+                    REQUIRE(ErrorCode::UNDERDETERMINED_SYSTEM == *code);
+                }
+            }
+        }
+    }
+
+    GIVEN("I have a batch.") {
+
+        SystemBatch<float> batch {3, 2, 3};
+
+        WHEN("I access it out of range.") {
+
+            THEN("An exception should be thrown.") {
+
+                REQUIRE_THROWS_AS(batch.at(3, 0, 0), std::out_of_range);
+                REQUIRE_THROWS_AS(batch.at(0, 2, 0), std::out_of_range);
+                REQUIRE_THROWS_AS(batch.solution(0, 2), std::out_of_range);
+            }
+        }
+    }
+}
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <exception>
+#include <functional>
 #include <vector>
 #include <iostream>
 #include <map>
@@ -10,9 +11,12 @@
 #include <catch2/catch.hpp>
 #include <numeric/types/models.hpp>
 #include <numeric/benchmark/benchmark.hpp>
+#include <numeric/benchmark/counters.hpp>
 
 using numeric::types::RunInfo;
 using numeric::benchmark::Benchmark;
+using numeric::benchmark::BenchmarkOptions;
+using numeric::benchmark::HardwareCounters;
 
 double max(const std::vector<double>& arr) {
     double maxItem {arr[0]};
@@ -78,3 +82,83 @@ SCENARIO("Benchmark runner.") {
         }
     }
 }
+
+SCENARIO("Benchmark statistics.") {
+
+    GIVEN("I have a function that counts its calls, and some run infos.") {
+
+        std::vector<RunInfo> inputs {
+            {1000UL, 100UL},
+            {2000UL, 7UL}
+        };
+        unsigned long calls {0};
+        std::function<double(std::vector<double>)> dut {[&](std::vector<double> input) {
+            calls++;
+            return max(input);
+        }};
+
+        WHEN("I run it with a warmup and samples.") {
+
+            BenchmarkOptions options {};
+            options.warmupIterations = 5;
+            options.samples = 20;
+            Benchmark<std::vector<double>, double, decltype(inputs.begin())> bm {genInput, dut, inputs.begin(), inputs.end(), options};
+            bm.run();
+
+            THEN("The warmup calls should not be timed, and I should get a distribution of the time per iteration.") {
+
+                REQUIRE(5 + 100 + 5 + 7 == calls);
+                for (const auto& [inputSize, run] : bm.get_run_infos()) {
+                    REQUIRE(run.nanosPerIteration.min > 0);
+                    REQUIRE(run.nanosPerIteration.min <= run.nanosPerIteration.median);
+                    REQUIRE(run.nanosPerIteration.median <= run.nanosPerIteration.p99);
+                    REQUIRE(run.nanosPerIteration.mean >= run.nanosPerIteration.min);
+                    REQUIRE(run.nanosPerIteration.mean <= run.nanosPerIteration.p99);
+                    REQUIRE(run.nanosPerIteration.stddev >= 0);
+                    // The mean time in milliseconds, and the mean of the samples in nanoseconds, are of the same magnitude.
+                    REQUIRE(run.runTimeInMillis*1e6 > run.nanosPerIteration.min/2);
+                    REQUIRE(run.runTimeInMillis*1e6 < run.nanosPerIteration.p99*2);
+                    REQUIRE_FALSE(run.counters.available);
+                }
+            }
+        }
+
+        WHEN("I ask for hardware counters.") {
+
+            BenchmarkOptions options {};
+            options.hardwareCounters = true;
+            Benchmark<std::vector<double>, double, decltype(inputs.begin())> bm {genInput, dut, inputs.begin(), inputs.end(), options};
+            bm.run();
+
+            THEN("I should get them where perf events are available.") {
+
+                for (const auto& [inputSize, run] : bm.get_run_infos()) {
+                    REQUIRE(run.counters.available == HardwareCounters {}.available());
+                    if (run.counters.available) {
+                        REQUIRE(run.counters.cycles > 0);
+                        REQUIRE(run.counters.instructions > static_cast<double>(inputSize));
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("I have a function with no output.") {
+
+        std::vector<RunInfo> inputs {{10UL, 10UL}};
+        unsigned long calls {0};
+        std::function<void(int)> dut {[&](int) {calls++;}};
+
+        WHEN("I benchmark it.") {
+
+            Benchmark<int, void, decltype(inputs.begin())> bm {[](const unsigned long& n) {return static_cast<int>(n);}, dut, inputs.begin(), inputs.end()};
+            bm.run();
+
+            THEN("It should run all iterations.") {
+
+                REQUIRE(10 == calls);
+                REQUIRE(bm.get_run_infos().at(10UL).runTimeInMillis >= 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,191 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/device/device.hpp>
+#include <numeric/math/errors.hpp>
+#include <numeric/math/lu.hpp>
+#include <numeric/parallel/threadpool.hpp>
+#include <numeric/types/bigint.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/vector.hpp>
+
+using numeric::device::Device;
+using numeric::device::DeviceMatrix;
+using numeric::device::DeviceVector;
+using numeric::device::to_device;
+using numeric::device::to_host;
+using numeric::functions::DeviceLUDecomposition;
+using numeric::functions::LUDecomposition;
+using numeric::functions::multiply;
+using numeric::functions::rref;
+using numeric::parallel::ThreadPool;
+using numeric::types::BigInt;
+using numeric::types::Matrix;
+using numeric::types::Vector;
+using numeric::ErrorCode;
+
+Matrix<double> randomMatrix(const std::size_t& rows, const std::size_t& cols, const unsigned int& seed) {
+    std::mt19937 generator {seed};
+    std::uniform_real_distribution<double> distribution {-1.0, 1.0};
+    Matrix<double> retval {rows, cols};
+    for (std::size_t i = 0; i < rows; i++) {
+        for (std::size_t j = 0; j < cols; j++) {
+            retval[i][j] = distribution(generator);
+        }
+    }
+    return retval;
+}
+
+SCENARIO("Device offload.") {
+
+    ThreadPool pool {4};
+    Device device {pool};
+
+    GIVEN("I have matrices on the host.") {
+
+        Matrix<double> a {randomMatrix(96, 80, 1)};
+        Matrix<double> b {randomMatrix(80, 64, 2)};
+        Matrix<double> c {randomMatrix(64, 32, 3)};
+
+        WHEN("I move them to the device and multiply them there.") {
+
+            DeviceMatrix<double> da {to_device(device, a)};
+            DeviceMatrix<double> db {to_device(device, b)};
+            DeviceMatrix<double> dc {to_device(device, c)};
+            const std::size_t uploaded {device.get_bytes_to_device()};
+            DeviceMatrix<double> product {multiply(multiply(da, db), dc)};
+
+            THEN("Only the operands and the final result should cross to and from the device.") {
+
+                REQUIRE((96*80 + 80*64 + 64*32)*sizeof(double) == uploaded);
+                REQUIRE(uploaded == device.get_bytes_to_device());
+                REQUIRE(0 == device.get_bytes_to_host());
+
+                Matrix<double> result {to_host(product)};
+                REQUIRE(96*32*sizeof(double) == device.get_bytes_to_host());
+
+                Matrix<double> expected {Matrix<double> {a*b}*c};
+                REQUIRE(96 == result.getRows());
+                REQUIRE(32 == result.getCols());
+                for (std::size_t i = 0; i < 96; i++) {
+                    for (std::size_t j = 0; j < 32; j++) {
+                        REQUIRE(std::fabs(expected[i][j] - result[i][j]) < 1e-10);
+                    }
+                }
+            }
+        }
+
+        THEN("Mismatched operands should throw.") {
+
+            DeviceMatrix<double> da {to_device(device, a)};
+            REQUIRE_THROWS_AS(multiply(da, da), std::invalid_argument);
+
+            Device other {pool};
+            DeviceMatrix<double> db {to_device(other, b)};
+            REQUIRE_THROWS_AS(multiply(da, db), std::invalid_argument);
+        }
+    }
+
+    GIVEN("I have a system on the device.") {
+
+        const std::size_t n {40};
+        Matrix<double> a {randomMatrix(n, n, 4)};
+        for (std::size_t i = 0; i < n; i++) {
+            a[i][i] += static_cast<double>(n);
+        }
+        Vector<double> b {n};
+        for (std::size_t i = 0; i < n; i++) {
+            b[i] = static_cast<double>(i);
+        }
+        DeviceMatrix<double> da {to_device(device, a)};
+        DeviceVector<double> db {to_device(device, b)};
+
+        WHEN("I factor it and solve on the device.") {
+
+            auto lu {DeviceLUDecomposition<double>::factor(da)};
+            REQUIRE(lu);
+            auto x {lu.unwrap().solve(db)};
+            REQUIRE(x);
+            DeviceVector<double> ax {multiply(da, x.unwrap())};
+
+            THEN("A*x should give back b.") {
+
+                Vector<double> result {to_host(ax)};
+                for (std::size_t i = 0; i < n; i++) {
+                    REQUIRE(std::fabs(b[i] - result[i]) < 1e-9);
+                }
+                REQUIRE(n*sizeof(double) == device.get_bytes_to_host());
+            }
+
+            THEN("A right hand side of the wrong size should fail.") {
+
+                DeviceVector<double> wrong {device, n + 1};
+                auto failed {lu.unwrap().solve(wrong)};
+                REQUIRE(!failed);
+                REQUIRE(ErrorCode::INCOMPATIBLE_VECTORS == failed.error());
+            }
+        }
+
+        WHEN("I reduce the augmented matrix on the device.") {
+
+            Matrix<double> augmented {n, n + 1};
+            for (std::size_t i = 0; i < n; i++) {
+                for (std::size_t j = 0; j < n; j++) {
+                    augmented[i][j] = a[i][j];
+                }
+                augmented[i][n] = b[i];
+            }
+            DeviceMatrix<double> daugmented {to_device(device, augmented)};
+            REQUIRE(rref(daugmented, 1e-12));
+
+            THEN("The last column should be the solution.") {
+
+                Matrix<double> reduced {to_host(daugmented)};
+                auto lu {LUDecomposition<double>::factor(a)};
+                auto solved {lu.unwrap().solve(b)};
+                for (std::size_t i = 0; i < n; i++) {
+                    REQUIRE(std::fabs(solved.unwrap()[i] - reduced[i][n]) < 1e-9);
+                }
+            }
+        }
+    }
+
+    GIVEN("I have a big integer system on the device.") {
+
+        DeviceMatrix<BigInt> system {to_device(device, Matrix<BigInt> {{{BigInt {0}, BigInt {3}, BigInt {1}}, {BigInt {2}, BigInt {0}, BigInt {1}}}})};
+        DeviceMatrix<BigInt> rounded {to_device(device, Matrix<BigInt> {{{BigInt {0}, BigInt {3}, BigInt {1}}, {BigInt {2}, BigInt {0}, BigInt {1}}}})};
+
+        WHEN("I reduce it on the device, with and without a zero precision.") {
+
+            REQUIRE(rref(system));
+            REQUIRE(rref(rounded, 1e-12));
+
+            THEN("The rows should be reduced fraction free, like on the host.") {
+
+                auto isReduced {[](const Matrix<BigInt>& reduced) {
+                    return BigInt {2} == reduced[0][0] && BigInt {0} == reduced[0][1] && BigInt {1} == reduced[0][2] &&
+                        BigInt {0} == reduced[1][0] && BigInt {3} == reduced[1][1] && BigInt {1} == reduced[1][2];
+                }};
+                REQUIRE(isReduced(to_host(system)));
+                REQUIRE(isReduced(to_host(rounded)));
+            }
+        }
+    }
+
+    GIVEN("I have a singular matrix on the device.") {
+
+        DeviceMatrix<double> singular {to_device(device, Matrix<double> {{{1.0, 2.0}, {2.0, 4.0}}})};
+
+        THEN("Factoring it should fail like on the host.") {
+
+            auto lu {DeviceLUDecomposition<double>::factor(singular)};
+            REQUIRE(!lu);
+            REQUIRE(ErrorCode::SINGULAR_MATRIX == lu.error());
+        }
+    }
+}
@@ -0,0 +1,258 @@
+#define CATCH_CONFIG_MAIN
+
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/kernels/elimination.hpp>
+#include <numeric/math/errors.hpp>
+#include <numeric/math/rref.hpp>
+#include <numeric/types/fraction.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/models.hpp>
+
+using numeric::functions::rref;
+using numeric::kernels::make_primitive;
+using numeric::kernels::reciprocal;
+using numeric::kernels::subtract_multiple;
+using numeric::types::BigInt;
+using numeric::types::Fraction;
+using numeric::types::LazyFraction;
+using numeric::types::Matrix;
+using numeric::types::Rational;
+using numeric::types::ScalarFamily;
+using numeric::types::ScalarFamilyOf;
+using numeric::ErrorCode;
+
+template <typename T> Matrix<T> randomMatrix(const std::size_t& rows, const std::size_t& cols, std::mt19937& generator) {
+    std::uniform_int_distribution<long> distribution {-9, 9};
+    Matrix<T> retval {rows, cols};
+    for (std::size_t i = 0; i < rows; i++) {
+        for (std::size_t j = 0; j < cols; j++) {
+            retval[i][j] = static_cast<T>(distribution(generator));
+        }
+    }
+    return retval;
+}
+
+template <typename T> bool hasElements(const Matrix<T>& matrix, const std::vector<std::vector<long>>& rows) {
+    for (std::size_t i = 0; i < rows.size(); i++) {
+        for (std::size_t j = 0; j < rows[i].size(); j++) {
+            if (matrix[i][j] != static_cast<T>(rows[i][j])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+SCENARIO("Scalar families.") {
+
+    GIVEN("I have the scalar types of the library.") {
+
+        THEN("Each should be in its family.") {
+
+            REQUIRE(ScalarFamily::FLOATING_POINT == ScalarFamilyOf<double>::value);
+            REQUIRE(ScalarFamily::FLOATING_POINT == ScalarFamilyOf<const float>::value);
+            REQUIRE(ScalarFamily::INTEGER == ScalarFamilyOf<int>::value);
+            REQUIRE(ScalarFamily::INTEGER == ScalarFamilyOf<long>::value);
+            REQUIRE(ScalarFamily::OTHER == ScalarFamilyOf<bool>::value);
+            REQUIRE(ScalarFamily::EXACT == ScalarFamilyOf<Fraction>::value);
+            REQUIRE(ScalarFamily::EXACT == ScalarFamilyOf<LazyFraction>::value);
+            REQUIRE(ScalarFamily::EXACT == ScalarFamilyOf<Rational>::value);
+            REQUIRE(ScalarFamily::INTEGER == ScalarFamilyOf<BigInt>::value);
+        }
+    }
+}
+
+SCENARIO("Elimination kernels.") {
+
+    GIVEN("I have rows of each family.") {
+
+        THEN("The reciprocal of a fraction should be the swapped fraction.") {
+
+            const Fraction inverse {reciprocal(Fraction {-4, 6})};
+            REQUIRE(3 == inverse.num);
+            REQUIRE(-2 == inverse.den);
+            REQUIRE(Fraction {1} == Fraction {-2, 3}*inverse);
+        }
+
+        THEN("Subtracting a multiple should be the same in every family.") {
+
+            std::vector<double> doubles {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0};
+            const std::vector<double> doubleSource {1.0, 0.0, -1.0, 2.0, 0.0, 1.0, 3.0};
+            subtract_multiple(doubles.data(), doubleSource.data(), 2.0, doubles.size());
+            REQUIRE(std::vector<double> {-1.0, 2.0, 5.0, 0.0, 5.0, 4.0, 1.0} == doubles);
+
+            std::vector<Fraction> fractions {Fraction {1, 2}, Fraction {1}, Fraction {3, 4}};
+            const std::vector<Fraction> fractionSource {Fraction {1}, Fraction {0}, Fraction {1, 4}};
+            subtract_multiple(fractions.data(), fractionSource.data(), Fraction {1, 2}, fractions.size());
+            REQUIRE(0.0 == static_cast<double>(fractions[0]));
+            REQUIRE(1.0 == static_cast<double>(fractions[1]));
+            REQUIRE(0.625 == static_cast<double>(fractions[2]));
+        }
+
+        THEN("Integer rows should be made primitive, with a positive leading element.") {
+
+            std::vector<long> row {0, -6, 4, -10};
+            make_primitive(row.data(), row.size());
+            REQUIRE(std::vector<long> {0, 3, -2, 5} == row);
+
+            std::vector<int> zeros {0, 0, 0};
+            make_primitive(zeros.data(), zeros.size());
+            REQUIRE(std::vector<int> {0, 0, 0} == zeros);
+        }
+    }
+}
+
+SCENARIO("RREF on each scalar family.") {
+
+    std::mt19937 generator {11};
+
+    GIVEN("I have an integer system with an integer solution.") {
+
+        Matrix<int> system {{{2, 1, 5}, {1, -1, 1}}};
+
+        WHEN("I reduce it.") {
+
+            auto result {rref(system)};
+
+            THEN("I should get the reduced form itself.") {
+
+                REQUIRE(result);
+                REQUIRE(hasElements(system, {{1, 0, 2}, {0, 1, 1}}));
+            }
+        }
+    }
+
+    GIVEN("I have an integer system with a fractional solution.") {
+
+        Matrix<int> system {{{0, 3, 1}, {2, 0, 1}}};
+
+        WHEN("I reduce it.") {
+
+            auto result {rref(system)};
+
+            THEN("Each row should be the smallest integer multiple of the reduced one.") {
+
+                REQUIRE(result);
+                REQUIRE(hasElements(system, {{2, 0, 1}, {0, 3, 1}}));
+            }
+        }
+    }
+
+    GIVEN("I have big integer systems.") {
+
+        Matrix<BigInt> integral {{{BigInt {2}, BigInt {1}, BigInt {3}}, {BigInt {3}, BigInt {2}, BigInt {5}}}};
+        // The minors reach 10^24, past the range of long.
+        Matrix<BigInt> large {{{BigInt {1000000000000L}, BigInt {1}, BigInt {1}}, {BigInt {1}, BigInt {1000000000000L}, BigInt {1}}}};
+
+        WHEN("I reduce them.") {
+
+            auto integralResult {rref(integral)};
+            auto largeResult {rref(large)};
+
+            THEN("They should be reduced fraction free, like the built in integers.") {
+
+                REQUIRE(integralResult);
+                REQUIRE(hasElements(integral, {{1, 0, 1}, {0, 1, 1}}));
+                REQUIRE(largeResult);
+                REQUIRE(hasElements(large, {{1000000000001L, 0, 1}, {0, 1000000000001L, 1}}));
+            }
+        }
+    }
+
+    GIVEN("I have random integer matrices.") {
+
+        THEN("Their reductions should be multiples of the exact ones, on matrices and on transposed views.") {
+
+            for (std::size_t trial = 0; trial < 50; trial++) {
+                const std::size_t rows {1 + trial%6};
+                const std::size_t cols {1 + (trial/6)%7};
+                Matrix<long> integers {randomMatrix<long>(rows, cols, generator)};
+                Matrix<Fraction> fractions {rows, cols};
+                Matrix<long> transposed {cols, rows};
+                for (std::size_t i = 0; i < rows; i++) {
+                    for (std::size_t j = 0; j < cols; j++) {
+                        fractions[i][j] = Fraction {integers[i][j]};
+                        transposed[j][i] = integers[i][j];
+                    }
+                }
+
+                auto exact {rref(fractions)};
+                auto result {rref(integers)};
+                auto viewResult {rref(transposed.transpose())};
+                REQUIRE(static_cast<bool>(exact) == static_cast<bool>(result));
+                REQUIRE(static_cast<bool>(exact) == static_cast<bool>(viewResult));
+                if (!exact) {
+                    REQUIRE(ErrorCode::FREE_COLUMNS_RREF == result.error());
+                    continue;
+                }
+                for (std::size_t i = 0; i < rows; i++) {
+                    const std::size_t pivot {i < cols? i : cols};
+                    for (std::size_t j = 0; j < cols; j++) {
+                        REQUIRE(integers[i][j] == transposed[j][i]);
+                        if (pivot < cols) {
+                            REQUIRE(integers[i][pivot] > 0);
+                            REQUIRE(static_cast<double>(Fraction {integers[i][j], integers[i][pivot]}) == static_cast<double>(fractions[i][j]));
+                        } else {
+                            REQUIRE(0 == integers[i][j]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("I have a floating point matrix with a column that is a multiple of another.") {
+
+        Matrix<double> matrix {{{11.0, 22.0, 17.0}, {1.0, 2.0, 36.0}, {3.0, 6.0, 5.0}}};
+
+        WHEN("I reduce it.") {
+
+            auto result {rref(matrix)};
+
+            THEN("The dependent column should cancel exactly.") {
+
+                REQUIRE(!result);
+                REQUIRE(ErrorCode::FREE_COLUMNS_RREF == result.error());
+                REQUIRE(0.0 == matrix[1][1]);
+                REQUIRE(0.0 == matrix[2][1]);
+            }
+        }
+
+        WHEN("I reduce it with a zero precision.") {
+
+            auto result {rref(matrix, 1e-10)};
+
+            THEN("The fused updates should leave the dependent column rounded off to zero.") {
+
+                REQUIRE(!result);
+                REQUIRE(ErrorCode::FREE_COLUMNS_RREF == result.error());
+                REQUIRE(0.0 == matrix[1][1]);
+                REQUIRE(0.0 == matrix[2][1]);
+            }
+        }
+    }
+
+    GIVEN("I have a fraction matrix.") {
+
+        Matrix<Fraction> matrix {{{Fraction {2}, Fraction {4}, Fraction {1}}, {Fraction {3}, Fraction {1}, Fraction {2}}}};
+
+        WHEN("I reduce it.") {
+
+            auto result {rref(matrix)};
+
+            THEN("I should get the exact reduced form.") {
+
+                REQUIRE(result);
+                REQUIRE(1.0 == static_cast<double>(matrix[0][0]));
+                REQUIRE(0.0 == static_cast<double>(matrix[0][1]));
+                REQUIRE(0.7 == static_cast<double>(matrix[0][2]));
+                REQUIRE(0.0 == static_cast<double>(matrix[1][0]));
+                REQUIRE(1.0 == static_cast<double>(matrix[1][1]));
+                REQUIRE(-0.1 == static_cast<double>(matrix[1][2]));
+            }
+        }
+    }
+}
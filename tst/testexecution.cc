@@ -0,0 +1,182 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/parallel/execution.hpp>
+#include <numeric/parallel/threadpool.hpp>
+
+using numeric::types::Matrix;
+using numeric::types::Vector;
+using numeric::parallel::ParallelPolicy;
+using numeric::parallel::ThreadPool;
+using numeric::parallel::par;
+using numeric::functions::add;
+using numeric::functions::dot;
+using numeric::functions::mod;
+using numeric::functions::multiply;
+using numeric::functions::scale;
+using numeric::functions::subtract;
+
+template <typename T> Matrix<T> randomMatrix(const std::size_t& rows, const std::size_t& cols, const unsigned int& seed) {
+    std::mt19937 mt(seed);
+    std::uniform_int_distribution<int> dist(-9, 9);
+    Matrix<T> matrix {rows, cols};
+    for (std::size_t i = 0; i < rows; i++) {
+        for (std::size_t j = 0; j < cols; j++) {
+            matrix[i][j] = static_cast<T>(dist(mt));
+        }
+    }
+    return matrix;
+}
+
+template <typename T> Vector<T> randomVector(const std::size_t& n, const unsigned int& seed) {
+    std::mt19937 mt(seed);
+    std::uniform_int_distribution<int> dist(-9, 9);
+    Vector<T> vec {n};
+    for (std::size_t i = 0; i < n; i++) {
+        vec[i] = static_cast<T>(dist(mt));
+    }
+    return vec;
+}
+
+template <typename T> bool isEqual(const Matrix<T>& lhs, const Matrix<T>& rhs) {
+    if (lhs.getRows() != rhs.getRows() || lhs.getCols() != rhs.getCols()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.getRows(); i++) {
+        for (std::size_t j = 0; j < lhs.getCols(); j++) {
+            if (lhs[i][j] != rhs[i][j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename T> void checkElementWise(const ParallelPolicy& policy) {
+    Matrix<T> a {randomMatrix<T>(97, 61, 1)};
+    Matrix<T> b {randomMatrix<T>(97, 61, 2)};
+    a.exchangeRows(0, 96);
+
+    REQUIRE(isEqual(Matrix<T> {a + b}, add(policy, a, b)));
+    REQUIRE(isEqual(Matrix<T> {a - b}, subtract(policy, a, b)));
+
+    Matrix<T> expected {a + b};
+    expected.scale(3);
+    Matrix<T> scaled {add(policy, a, b)};
+    scale(policy, scaled, static_cast<T>(3));
+    REQUIRE(isEqual(expected, scaled));
+
+    REQUIRE_THROWS_AS(add(policy, a, randomMatrix<T>(97, 60, 3)), std::invalid_argument);
+}
+
+template <typename T> void checkProducts(const ParallelPolicy& policy) {
+    Matrix<T> a {randomMatrix<T>(131, 77, 4)};
+    Matrix<T> b {randomMatrix<T>(77, 53, 5)};
+    Vector<T> x {randomVector<T>(77, 6)};
+    Vector<T> y {randomVector<T>(131, 7)};
+
+    REQUIRE(isEqual(a*b, multiply(policy, a, b)));
+    REQUIRE(a*x == multiply(policy, a, x));
+    REQUIRE(y*a == multiply(policy, y, a));
+
+    REQUIRE_THROWS_AS(multiply(policy, b, b), std::invalid_argument);
+    REQUIRE_THROWS_AS(multiply(policy, a, y), std::invalid_argument);
+    REQUIRE_THROWS_AS(multiply(policy, x, a), std::invalid_argument);
+}
+
+template <typename T> void checkVectors(const ParallelPolicy& policy) {
+    Vector<T> x {randomVector<T>(10007, 8)};
+    Vector<T> y {randomVector<T>(10007, 9)};
+
+    REQUIRE(Vector<T> {x + y} == add(policy, x, y));
+    REQUIRE(Vector<T> {x - y} == subtract(policy, x, y));
+    REQUIRE(x*y == dot(policy, x, y));
+    REQUIRE(x.mod() == mod(policy, x));
+
+    REQUIRE_THROWS_AS(dot(policy, x, randomVector<T>(3, 10)), std::invalid_argument);
+}
+
+SCENARIO("Parallel operators match the serial ones.") {
+
+    GIVEN("I have a policy that sends everything to a pool of 4 threads.") {
+
+        // A threshold of 0 forces every operation onto the pool, even for these small sizes.
+        ThreadPool pool {4};
+        const ParallelPolicy policy {par(pool, 0)};
+
+        WHEN("I use double operands, which go through the SIMD and GEMM kernels.") {
+
+            THEN("Every operation should give the serial result.") {
+
+                checkElementWise<double>(policy);
+                checkProducts<double>(policy);
+                checkVectors<double>(policy);
+            }
+        }
+
+        WHEN("I use int operands, which go through the generic loops.") {
+
+            THEN("Every operation should give the serial result.") {
+
+                checkElementWise<int>(policy);
+                checkProducts<int>(policy);
+                checkVectors<int>(policy);
+            }
+        }
+    }
+}
+
+SCENARIO("Parallel policy threshold.") {
+
+    GIVEN("I have a policy with the default threshold.") {
+
+        ThreadPool pool {4};
+        ParallelPolicy policy {pool};
+
+        THEN("Small operations should stay serial, and large ones go to the pool.") {
+
+            REQUIRE(numeric::parallel::PARALLEL_THRESHOLD == policy.get_threshold());
+            REQUIRE(!policy.parallelize(100));
+            REQUIRE(policy.parallelize(numeric::parallel::PARALLEL_THRESHOLD));
+        }
+    }
+
+    GIVEN("I have a policy on a single thread.") {
+
+        ThreadPool pool {1};
+        ParallelPolicy policy {pool, 0};
+
+        THEN("Nothing should be split.") {
+
+            REQUIRE(!policy.parallelize(1 << 30));
+        }
+    }
+
+    GIVEN("I have large float operands.") {
+
+        ThreadPool pool {4};
+        Matrix<double> a {randomMatrix<double>(300, 300, 11)};
+        Matrix<double> b {randomMatrix<double>(300, 300, 12)};
+
+        WHEN("I multiply them with the default policy.") {
+
+            Matrix<double> product {multiply(par(pool), a, b)};
+
+            THEN("The product should match the serial one.") {
+
+                Matrix<double> expected {a*b};
+                for (std::size_t i = 0; i < 300; i++) {
+                    for (std::size_t j = 0; j < 300; j++) {
+                        REQUIRE(std::fabs(expected[i][j] - product[i][j]) < 1e-9);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,206 @@
+#define CATCH_CONFIG_MAIN
+
+#include <algorithm>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/expressions.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/vector.hpp>
+
+using numeric::types::Matrix;
+using numeric::types::Vector;
+using numeric::types::VectorExpression;
+
+template <typename T> bool isEqual(const Matrix<T>& matrix, const std::vector<std::vector<T>>& vecs) {
+    if (matrix.getRows() != vecs.size() || matrix.getCols() != vecs[0].size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < vecs.size(); i++) {
+        for (std::size_t j = 0; j < vecs[0].size(); j++) {
+            if (matrix[i][j] != vecs[i][j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+SCENARIO("Vector expressions.") {
+
+    GIVEN("I have some vectors.") {
+
+        Vector<double> x {{1, 2, 3, 4, 5}};
+        Vector<double> y {{5, 4, 3, 2, 1}};
+        Vector<double> z {{1, 1, 1, 1, 1}};
+
+        WHEN("I build a chained expression.") {
+
+            auto expr {2.0*x + y*3.0 - z};
+
+            THEN("Nothing should be computed until it is assigned, and the expression should be a single node tree.") {
+
+                REQUIRE(std::is_base_of<VectorExpression<decltype(expr)>, decltype(expr)>::value);
+                REQUIRE(5 == expr.size());
+
+                Vector<double> result {expr};
+                std::vector<double> expected {16, 15, 14, 13, 12};
+                REQUIRE(std::equal(expected.begin(), expected.end(), result.begin()));
+            }
+        }
+
+        WHEN("I assign an expression referring to the destination vector.") {
+
+            x = x + y - (-z);
+
+            THEN("The result should be computed element wise in place.") {
+
+                std::vector<double> expected {7, 7, 7, 7, 7};
+                REQUIRE(5 == x.size());
+                REQUIRE(std::equal(expected.begin(), expected.end(), x.begin()));
+            }
+        }
+
+        WHEN("I assign an expression of a different dimension to a vector.") {
+
+            Vector<double> dest {2};
+            dest = x + y;
+
+            THEN("The vector should take the dimension of the expression.") {
+
+                std::vector<double> expected {6, 6, 6, 6, 6};
+                REQUIRE(5 == dest.size());
+                REQUIRE(std::equal(expected.begin(), expected.end(), dest.begin()));
+            }
+        }
+
+        WHEN("I take the dot product of an expression.") {
+
+            double dot {(x + y)*z};
+
+            THEN("The result should be as expected.") {
+
+                REQUIRE(30.0 == dot);
+            }
+        }
+
+        WHEN("I scale a vector by an integer.") {
+
+            Vector<double> scaled {2*x};
+            Vector<double> halved {x*0.5f};
+
+            THEN("The result should be the same as scaling by the equivalent floating point values.") {
+
+                std::vector<double> expected {2, 4, 6, 8, 10};
+                REQUIRE(std::equal(expected.begin(), expected.end(), scaled.begin()));
+                std::vector<double> expectedHalves {0.5, 1, 1.5, 2, 2.5};
+                REQUIRE(std::equal(expectedHalves.begin(), expectedHalves.end(), halved.begin()));
+            }
+        }
+
+        WHEN("I convert an expression to a vector of a different element type.") {
+
+            Vector<float> single {x + y};
+
+            THEN("The conversion should only be possible explicitly.") {
+
+                REQUIRE(std::is_convertible<decltype(x + y), Vector<double>>::value);
+                REQUIRE_FALSE(std::is_convertible<decltype(x + y), Vector<float>>::value);
+                REQUIRE(std::is_constructible<Vector<float>, decltype(x + y)>::value);
+                using MatrixSum = decltype(std::declval<const Matrix<int>&>() + std::declval<const Matrix<int>&>());
+                REQUIRE(std::is_convertible<MatrixSum, Matrix<int>>::value);
+                REQUIRE_FALSE(std::is_convertible<MatrixSum, Matrix<double>>::value);
+                REQUIRE(std::is_constructible<Matrix<double>, MatrixSum>::value);
+                REQUIRE(6.0f == single[0]);
+            }
+        }
+
+        WHEN("I build an expression out of vectors of different dimensions.") {
+
+            Vector<double> w {{1, 2}};
+
+            THEN("I should get an invalid argument error when building it.") {
+
+                REQUIRE_THROWS_AS(x + w, std::invalid_argument);
+                REQUIRE_THROWS_AS(2.0*x - w, std::invalid_argument);
+            }
+        }
+    }
+
+    GIVEN("I have some integer vectors.") {
+
+        Vector<int> x {{1, 2, 3}};
+        Vector<int> y {{3, 2, 1}};
+
+        WHEN("I scale and combine them.") {
+
+            Vector<int> result {3*x - y*2};
+
+            THEN("The generic loop should produce the right result.") {
+
+                std::vector<int> expected {-3, 2, 7};
+                REQUIRE(std::equal(expected.begin(), expected.end(), result.begin()));
+            }
+        }
+    }
+}
+
+SCENARIO("Matrix expressions.") {
+
+    GIVEN("I have some matrices.") {
+
+        Matrix<double> a {{
+            {1, 2},
+            {3, 4}
+        }};
+        Matrix<double> b {{
+            {4, 3},
+            {2, 1}
+        }};
+
+        WHEN("I build a chained expression and assign it.") {
+
+            Matrix<double> result {2.0*a - b + -a*0.5};
+
+            THEN("The result should be as expected.") {
+
+                REQUIRE(isEqual(result, {{-2.5, 0.0}, {2.5, 5.0}}));
+            }
+        }
+
+        WHEN("I assign an expression referring to the destination matrix.") {
+
+            a = a + b;
+
+            THEN("The result should be computed element wise in place.") {
+
+                REQUIRE(isEqual(a, {{5.0, 5.0}, {5.0, 5.0}}));
+            }
+        }
+
+        WHEN("I exchange rows of an operand before using it in an expression.") {
+
+            b.exchangeRows(0, 1);
+            Matrix<double> result {a - b};
+
+            THEN("The expression should honour the exchanged rows.") {
+
+                REQUIRE(isEqual(result, {{-1.0, 1.0}, {-1.0, 1.0}}));
+            }
+        }
+
+        WHEN("I assign an expression of a different dimension to a matrix.") {
+
+            Matrix<double> dest {3, 3};
+            dest = a + b;
+
+            THEN("The matrix should take the dimensions of the expression.") {
+
+                REQUIRE(isEqual(dest, {{5.0, 5.0}, {5.0, 5.0}}));
+            }
+        }
+    }
+}
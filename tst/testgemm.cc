@@ -0,0 +1,120 @@
+#define CATCH_CONFIG_MAIN
+
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/kernels/gemm.hpp>
+#include <numeric/types/matrix.hpp>
+
+using numeric::types::Matrix;
+
+template <typename T> Matrix<T> randomMatrix(const std::size_t& rows, const std::size_t& cols) {
+    std::mt19937 mt(42);
+    std::uniform_int_distribution<int> dist(-8, 8);
+    Matrix<T> retval {rows, cols};
+    for (auto& row : retval) {
+        for (auto& elem : row) {
+            elem = static_cast<T>(dist(mt));
+        }
+    }
+    return retval;
+}
+
+template <typename T> Matrix<T> naiveProduct(const Matrix<T>& lhs, const Matrix<T>& rhs) {
+    Matrix<T> retval {lhs.getRows(), rhs.getCols()};
+    for (std::size_t i = 0; i < lhs.getRows(); i++) {
+        for (std::size_t j = 0; j < rhs.getCols(); j++) {
+            T sum {static_cast<T>(0)};
+            for (std::size_t k = 0; k < lhs.getCols(); k++) {
+                sum += lhs[i][k]*rhs[k][j];
+            }
+            retval[i][j] = sum;
+        }
+    }
+    return retval;
+}
+
+template <typename T> bool isEqual(const Matrix<T>& lhs, const Matrix<T>& rhs) {
+    if (lhs.getRows() != rhs.getRows() || lhs.getCols() != rhs.getCols()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.getRows(); i++) {
+        for (std::size_t j = 0; j < lhs.getCols(); j++) {
+            if (lhs[i][j] != rhs[i][j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+SCENARIO("Blocked matrix multiplication.") {
+
+    GIVEN("I have 2 double matrices whose dimensions are not multiples of the block sizes.") {
+
+        Matrix<double> m1 {randomMatrix<double>(131, 277)};
+        Matrix<double> m2 {randomMatrix<double>(277, 2053)};
+
+        WHEN("I multiply them.") {
+
+            Matrix<double> product {m1 * m2};
+
+            THEN("The result should match the naive product.") {
+
+                // All inputs are small integers, so the products are exact regardless of summation order.
+                REQUIRE(isEqual(product, naiveProduct(m1, m2)));
+            }
+        }
+    }
+
+    GIVEN("I have 2 float matrices.") {
+
+        Matrix<float> m1 {randomMatrix<float>(67, 300)};
+        Matrix<float> m2 {randomMatrix<float>(300, 45)};
+
+        WHEN("I multiply them.") {
+
+            Matrix<float> product {m1 * m2};
+
+            THEN("The result should match the naive product.") {
+
+                REQUIRE(isEqual(product, naiveProduct(m1, m2)));
+            }
+        }
+    }
+
+    GIVEN("I have a matrix whose rows have been exchanged.") {
+
+        Matrix<double> m1 {randomMatrix<double>(64, 64)};
+        Matrix<double> m2 {randomMatrix<double>(64, 64)};
+        m1.exchangeRows(0, 63).exchangeRows(5, 17);
+        m2.exchangeRows(1, 2);
+
+        WHEN("I multiply it with another matrix.") {
+
+            Matrix<double> product {m1 * m2};
+
+            THEN("The result should honour the exchanged rows.") {
+
+                REQUIRE(isEqual(product, naiveProduct(m1, m2)));
+            }
+        }
+    }
+
+    GIVEN("I have 2 integer matrices.") {
+
+        Matrix<int> m1 {randomMatrix<int>(40, 50)};
+        Matrix<int> m2 {randomMatrix<int>(50, 30)};
+
+        WHEN("I multiply them.") {
+
+            Matrix<int> product {m1 * m2};
+
+            THEN("The generic path should be used and the result should match the naive product.") {
+
+                REQUIRE(isEqual(product, naiveProduct(m1, m2)));
+            }
+        }
+    }
+}
@@ -0,0 +1,149 @@
+#define CATCH_CONFIG_MAIN
+
+// This test checks the counters, so it turns them on whatever the meson option says.
+#ifndef NUMERIC_INSTRUMENTATION
+#define NUMERIC_INSTRUMENTATION
+#endif
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/benchmark/instrumentation.hpp>
+#include <numeric/math/gaussjordan.hpp>
+#include <numeric/math/lu.hpp>
+#include <numeric/math/rref.hpp>
+#include <numeric/math/vectorspaces.hpp>
+#include <numeric/types/fraction.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/vector.hpp>
+
+using numeric::benchmark::InstrumentationStats;
+using numeric::benchmark::Kernel;
+using numeric::benchmark::KernelStats;
+using numeric::benchmark::ScopedTimer;
+using numeric::benchmark::instrumentation_stats;
+using numeric::benchmark::reset_instrumentation;
+using numeric::functions::LUDecomposition;
+using numeric::functions::gauss_jordan;
+using numeric::functions::linear_independence_of_system;
+using numeric::functions::rref;
+using numeric::types::Fraction;
+using numeric::types::Matrix;
+using numeric::types::Vector;
+
+std::uint64_t callsOf(const InstrumentationStats& stats, const std::string& id) {
+    const KernelStats* kernel {stats.find(id)};
+    return kernel ? kernel->calls : 0;
+}
+
+SCENARIO("Instrumentation.") {
+
+    REQUIRE(numeric::benchmark::INSTRUMENTATION_ENABLED);
+    reset_instrumentation();
+
+    GIVEN("I allocate matrices and vectors.") {
+
+        Matrix<double> matrix {3, 4};
+        Vector<float> vec {10};
+
+        THEN("Their storage should be counted.") {
+
+            const InstrumentationStats stats {instrumentation_stats()};
+            // The elements and the row table of the matrix, and the elements of the vector.
+            REQUIRE(3 == stats.allocations);
+            REQUIRE(12*sizeof(double) + 3*sizeof(thesoup::types::Slice<double>) + 10*sizeof(float) == stats.bytesAllocated);
+            REQUIRE(stats.kernels.empty());
+        }
+    }
+
+    GIVEN("I run the kernels the benchmarks measure.") {
+
+        Matrix<double> a {{{1.0, 2.0}, {3.0, 4.0}}};
+        Matrix<double> b {{{0.0, 1.0}, {1.0, 0.0}}};
+        Vector<double> x {std::vector<double> {1.0, 1.0}};
+        Matrix<double> product {a*b};
+        Vector<double> ax {a*x};
+        const double dot {x*ax};
+        const double mod {ax.mod()};
+
+        Matrix<double> system {{{0.0, 1.0, 2.0}, {1.0, 0.0, 3.0}}};
+        REQUIRE(gauss_jordan(system));
+
+        Matrix<Fraction> exact {{{Fraction {0}, Fraction {1}}, {Fraction {2}, Fraction {1}}}};
+        REQUIRE(rref(exact));
+
+        Vector<double> v1 {std::vector<double> {1.0, 0.0}};
+        Vector<double> v2 {std::vector<double> {0.0, 1.0}};
+        REQUIRE(linear_independence_of_system<double>({std::ref(v1), std::ref(v2)}).unwrap());
+
+        THEN("Every call should be under the id of its benchmark case.") {
+
+            REQUIRE(10.0 == dot);
+            REQUIRE(58.0 == mod);
+            const InstrumentationStats stats {instrumentation_stats()};
+            REQUIRE(1 == callsOf(stats, "matrix_matrix_double"));
+            REQUIRE(1 == callsOf(stats, "matrix_vector_double"));
+            REQUIRE(1 == callsOf(stats, "vector_dot_double"));
+            REQUIRE(1 == callsOf(stats, "vector_mod_double"));
+            REQUIRE(1 == callsOf(stats, "gauss_jordan_double"));
+            REQUIRE(1 == callsOf(stats, "rref_fraction"));
+            REQUIRE(1 == callsOf(stats, "linear_independence_double"));
+            // gauss_jordan and linear_independence_of_system both run rref.
+            REQUIRE(2 == callsOf(stats, "rref_double"));
+            // One exchange in the system, one in the fractions, none in the independence test.
+            REQUIRE(2 == stats.rowSwaps);
+            REQUIRE(0 == stats.pivotFailures);
+            REQUIRE(nullptr == stats.find("rref_float"));
+        }
+    }
+
+    GIVEN("I multiply vectors by matrices and views.") {
+
+        const Matrix<double> a {{{1.0, 2.0}, {3.0, 4.0}}};
+        Vector<double> x {std::vector<double> {1.0, 1.0}};
+        Vector<double> xa {x*a};
+        Vector<double> xView {x*a.view()};
+
+        THEN("The products should be counted with the matrix vector ones.") {
+
+            REQUIRE(4.0 == xa[0]);
+            REQUIRE(6.0 == xView[1]);
+            REQUIRE(2 == callsOf(instrumentation_stats(), "matrix_vector_double"));
+        }
+    }
+
+    GIVEN("I reduce singular matrices.") {
+
+        Matrix<double> singular {{{1.0, 2.0, 3.0}, {2.0, 4.0, 6.0}}};
+        REQUIRE(!rref(singular));
+        REQUIRE(!LUDecomposition<double>::factor(Matrix<double> {{{1.0, 1.0}, {1.0, 1.0}}}));
+
+        THEN("The columns without a pivot should be counted.") {
+
+            REQUIRE(2 == instrumentation_stats().pivotFailures);
+        }
+    }
+
+    GIVEN("I time my own code with a scoped timer.") {
+
+        {
+            const ScopedTimer<float> timer {Kernel::MATRIX_MATRIX};
+        }
+        {
+            const ScopedTimer<float> timer {Kernel::MATRIX_MATRIX};
+        }
+
+        THEN("It should be counted like a library kernel.") {
+
+            REQUIRE(2 == callsOf(instrumentation_stats(), "matrix_matrix_float"));
+
+            reset_instrumentation();
+            const InstrumentationStats stats {instrumentation_stats()};
+            REQUIRE(stats.kernels.empty());
+            REQUIRE(0 == stats.allocations);
+        }
+    }
+}
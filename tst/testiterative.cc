@@ -0,0 +1,247 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/sparsematrix.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/math/errors.hpp>
+#include <numeric/math/iterative.hpp>
+
+#include <thesoup/types/types.hpp>
+
+using numeric::types::Matrix;
+using numeric::types::SparseMatrix;
+using numeric::types::Triplet;
+using numeric::types::Vector;
+using numeric::functions::ILU0Preconditioner;
+using numeric::functions::IterativeOptions;
+using numeric::functions::IterativeSolution;
+using numeric::functions::JacobiPreconditioner;
+using numeric::functions::conjugate_gradient;
+using numeric::functions::gmres;
+using thesoup::types::Result;
+using numeric::ErrorCode;
+
+// The 5 point discretization of -laplace(u) + c*du/dx on a k x k grid. Symmetric positive definite for c = 0.
+SparseMatrix<double> gridOperator(const std::size_t& k, const double& convection) {
+    std::vector<Triplet<double>> triplets {};
+    for (std::size_t i = 0; i < k; i++) {
+        for (std::size_t j = 0; j < k; j++) {
+            const std::size_t row {i*k + j};
+            triplets.push_back(Triplet<double> {row, row, 4.0});
+            if (i > 0) {
+                triplets.push_back(Triplet<double> {row, row - k, -1.0});
+            }
+            if (i + 1 < k) {
+                triplets.push_back(Triplet<double> {row, row + k, -1.0});
+            }
+            if (j > 0) {
+                triplets.push_back(Triplet<double> {row, row - 1, -1.0 - convection});
+            }
+            if (j + 1 < k) {
+                triplets.push_back(Triplet<double> {row, row + 1, -1.0 + convection});
+            }
+        }
+    }
+    return SparseMatrix<double> {k*k, k*k, std::move(triplets)};
+}
+
+Vector<double> ones(const std::size_t& n) {
+    Vector<double> vec {n};
+    for (std::size_t i = 0; i < n; i++) {
+        vec[i] = 1.0;
+    }
+    return vec;
+}
+
+template <typename M> double relativeResidual(const M& a, const Vector<double>& x, const Vector<double>& b) {
+    Vector<double> r {b - a*x};
+    return std::sqrt((r*r)/(b*b));
+}
+
+SCENARIO("Conjugate gradient.") {
+
+    GIVEN("I have a symmetric positive definite sparse system.") {
+
+        SparseMatrix<double> a {gridOperator(30, 0.0)};
+        Vector<double> b {ones(900)};
+
+        WHEN("I solve it without a preconditioner, with Jacobi and with ILU0.") {
+
+            auto plain {conjugate_gradient(a, b)};
+            auto jacobi {JacobiPreconditioner<double>::create(a)};
+            auto ilu {ILU0Preconditioner<double>::factor(a)};
+
+            THEN("All of them should converge, and ILU0 should take fewer iterations.") {
+
+                REQUIRE(plain);
+                REQUIRE(jacobi);
+                REQUIRE(ilu);
+                auto withJacobi {conjugate_gradient(a, b, jacobi.unwrap())};
+                auto withIlu {conjugate_gradient(a, b, ilu.unwrap())};
+                REQUIRE(withJacobi);
+                REQUIRE(withIlu);
+                REQUIRE(relativeResidual(a, plain.unwrap().solution, b) < 1e-8);
+                REQUIRE(relativeResidual(a, withJacobi.unwrap().solution, b) < 1e-8);
+                REQUIRE(relativeResidual(a, withIlu.unwrap().solution, b) < 1e-8);
+                REQUIRE(plain.unwrap().residual <= 1e-10);
+                REQUIRE(withIlu.unwrap().iterations < plain.unwrap().iterations);
+            }
+        }
+
+        WHEN("I allow too few iterations.") {
+
+            IterativeOptions options {};
+            options.maxIterations = 3;
+            auto result {conjugate_gradient(a, b, options)};
+
+            THEN("A NOT_CONVERGED error should be returned.") {
+
+                REQUIRE(!result);
+                REQUIRE(ErrorCode::NOT_CONVERGED == result.error());
+            }
+        }
+    }
+
+    GIVEN("I have a small dense symmetric positive definite system.") {
+
+        Matrix<double> a {{
+            {4, 1, 0},
+            {1, 3, 1},
+            {0, 1, 2}
+        }};
+        Vector<double> b {{6, 10, 8}};
+
+        WHEN("I solve it.") {
+
+            auto result {conjugate_gradient(a, b)};
+
+            THEN("It should converge to the exact solution in at most 3 iterations.") {
+
+                REQUIRE(result);
+                REQUIRE(result.unwrap().iterations <= 3);
+                REQUIRE(std::fabs(1.0 - result.unwrap().solution[0]) < 1e-9);
+                REQUIRE(std::fabs(2.0 - result.unwrap().solution[1]) < 1e-9);
+                REQUIRE(std::fabs(3.0 - result.unwrap().solution[2]) < 1e-9);
+            }
+        }
+
+        WHEN("I solve it with a zero right hand side.") {
+
+            auto result {conjugate_gradient(a, Vector<double> {{0, 0, 0}})};
+
+            THEN("The solution should be 0, with no iterations.") {
+
+                REQUIRE(result);
+                REQUIRE(0 == result.unwrap().iterations);
+                REQUIRE(Vector<double> {{0, 0, 0}} == result.unwrap().solution);
+            }
+        }
+    }
+}
+
+SCENARIO("GMRES.") {
+
+    GIVEN("I have a non symmetric sparse system.") {
+
+        SparseMatrix<double> a {gridOperator(30, 0.4)};
+        Vector<double> b {ones(900)};
+
+        WHEN("I solve it without a preconditioner and with ILU0.") {
+
+            IterativeOptions options {};
+            options.restart = 20;
+            options.maxIterations = 5000;
+            auto plain {gmres(a, b, options)};
+            auto ilu {ILU0Preconditioner<double>::factor(a)};
+
+            THEN("Both should converge, and ILU0 should take fewer iterations.") {
+
+                REQUIRE(plain);
+                REQUIRE(ilu);
+                auto withIlu {gmres(a, b, ilu.unwrap(), options)};
+                REQUIRE(withIlu);
+                REQUIRE(relativeResidual(a, plain.unwrap().solution, b) <= 1e-10);
+                REQUIRE(relativeResidual(a, withIlu.unwrap().solution, b) <= 1e-10);
+                REQUIRE(withIlu.unwrap().iterations < plain.unwrap().iterations);
+            }
+        }
+    }
+
+    GIVEN("I have a small dense non symmetric system.") {
+
+        Matrix<double> a {{
+            {0, 2, 1},
+            {1, 1, 1},
+            {2, 1, 3}
+        }};
+        Vector<double> b {{7, 6, 13}};
+
+        WHEN("I solve it with a Jacobi preconditioner.") {
+
+            auto jacobi {JacobiPreconditioner<double>::create(a)};
+
+            THEN("The zero on the diagonal should be reported.") {
+
+                REQUIRE(!jacobi);
+                REQUIRE(ErrorCode::SINGULAR_MATRIX == jacobi.error());
+            }
+        }
+
+        WHEN("I solve it with ILU0 on the dense matrix.") {
+
+            auto ilu {ILU0Preconditioner<double>::factor(a)};
+
+            THEN("The zero leading element should be reported.") {
+
+                REQUIRE(!ilu);
+                REQUIRE(ErrorCode::SINGULAR_MATRIX == ilu.error());
+            }
+        }
+
+        WHEN("I solve it without a preconditioner.") {
+
+            auto result {gmres(a, b)};
+
+            THEN("It should converge to the exact solution.") {
+
+                REQUIRE(result);
+                REQUIRE(std::fabs(1.0 - result.unwrap().solution[0]) < 1e-9);
+                REQUIRE(std::fabs(2.0 - result.unwrap().solution[1]) < 1e-9);
+                REQUIRE(std::fabs(3.0 - result.unwrap().solution[2]) < 1e-9);
+            }
+        }
+    }
+
+    GIVEN("I have bad arguments.") {
+
+        Matrix<double> nonSquare {{
+            {1, 2, 3},
+            {4, 5, 6}
+        }};
+        Matrix<double> square {{
+            {1, 0},
+            {0, 1}
+        }};
+
+        WHEN("I try to solve.") {
+
+            Result<IterativeSolution<double>, ErrorCode> r1 {gmres(nonSquare, Vector<double> {{1, 2}})};
+            Result<IterativeSolution<double>, ErrorCode> r2 {gmres(square, Vector<double> {{1, 2, 3}})};
+            Result<IterativeSolution<double>, ErrorCode> r3 {conjugate_gradient(nonSquare, Vector<double> {{1, 2}})};
+
+            THEN("The errors should be reported.") {
+
+                REQUIRE(!r1);
+                REQUIRE(ErrorCode::NON_SQUARE_MATRIX == r1.error());
+                REQUIRE(!r2);
+                REQUIRE(ErrorCode::INCOMPATIBLE_VECTORS == r2.error());
+                REQUIRE(!r3);
+                REQUIRE(ErrorCode::NON_SQUARE_MATRIX == r3.error());
+            }
+        }
+    }
+}
@@ -0,0 +1,209 @@
+#define CATCH_CONFIG_MAIN
+
+#include <chrono>
+#include <climits>
+#include <exception>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/fraction.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/models.hpp>
+#include <numeric/math/rref.hpp>
+
+using numeric::types::Fraction;
+using numeric::types::LazyFraction;
+using numeric::types::Matrix;
+using numeric::types::IsScalarType;
+using numeric::functions::rref;
+
+SCENARIO("Lazy fraction arithmetic.") {
+
+    GIVEN("I have some lazy fractions.") {
+
+        LazyFraction f1 {1, 6};
+        LazyFraction f2 {1, 3};
+
+        WHEN("I do arithmetic with them.") {
+
+            LazyFraction sum {f1 + f2};
+            LazyFraction product {f1 * f2 * 6};
+            LazyFraction quotient {f1 / f2};
+            LazyFraction difference {2 - f2 - f1};
+
+            THEN("The results should have the right values, but not be reduced.") {
+
+                REQUIRE(9 == sum.num);
+                REQUIRE(18 == sum.den);
+                REQUIRE(LazyFraction {1, 2} == sum);
+                REQUIRE(LazyFraction {1, 3} == product);
+                REQUIRE(LazyFraction {1, 2} == quotient);
+                REQUIRE(LazyFraction {3, 2} == difference);
+                REQUIRE(1 == sum.reduced().num);
+                REQUIRE(2 == sum.reduced().den);
+            }
+        }
+
+        WHEN("I compare and print them.") {
+
+            std::stringstream stream;
+            stream << (f1 + f2);
+
+            THEN("Comparisons should be exact, and the output should be reduced.") {
+
+                REQUIRE(f1 < f2);
+                REQUIRE(f2 >= f1);
+                REQUIRE(f1 != f2);
+                REQUIRE(LazyFraction {2, 12} == f1);
+                REQUIRE(LazyFraction {2, -12} == -f1);
+                REQUIRE(0 == f1 - f1);
+                REQUIRE("1/2" == stream.str());
+                REQUIRE(Fraction {1, 2} == static_cast<Fraction>(f1 + f2));
+                REQUIRE(0.5 == static_cast<double>(f1 + f2));
+            }
+        }
+
+        WHEN("I construct or divide with a zero denominator.") {
+
+            THEN("I should get an exception.") {
+
+                REQUIRE_THROWS_AS(LazyFraction(1, 0), std::invalid_argument);
+                REQUIRE_THROWS_AS(f1 / LazyFraction {}, std::invalid_argument);
+            }
+        }
+    }
+
+    GIVEN("I have fractions whose unreduced products do not fit in a long.") {
+
+        const long big {1L << 40};
+        LazyFraction f1 {big + 1, big};
+        LazyFraction f2 {3*big, 2*big};
+
+        WHEN("I combine them.") {
+
+            LazyFraction sum {f1 + f2};
+            LazyFraction product {f1 * f2};
+
+            THEN("The operands should be reduced instead, and the result should be exact.") {
+
+                REQUIRE(LazyFraction {5*big + 2, 2*big} == sum);
+                REQUIRE(LazyFraction {3*big + 3, 2*big} == product);
+            }
+        }
+
+        WHEN("The reduced result does not fit either.") {
+
+            LazyFraction huge {LONG_MAX, 1};
+
+            THEN("I should get an overflow error rather than a wrong result.") {
+
+                REQUIRE_THROWS_AS(huge + huge, std::overflow_error);
+                REQUIRE_THROWS_AS(huge * 3, std::overflow_error);
+            }
+        }
+
+        WHEN("I compare distinct fractions whose cross products do not fit, and whose quotients are too close for a long double.") {
+
+            LazyFraction larger {LONG_MAX - 1, LONG_MAX};
+            LazyFraction smaller {LONG_MAX - 2, LONG_MAX - 1};
+
+            THEN("The order should still be exact, and strict.") {
+
+                REQUIRE(smaller < larger);
+                REQUIRE_FALSE(larger < smaller);
+                REQUIRE(larger > smaller);
+                REQUIRE(larger != smaller);
+                REQUIRE(larger == LazyFraction {LONG_MAX - 1, LONG_MAX});
+            }
+        }
+    }
+
+    GIVEN("The scalar type trait.") {
+
+        THEN("Lazy fractions should be scalars.") {
+
+            REQUIRE(IsScalarType<LazyFraction>::value);
+            REQUIRE(IsScalarType<const LazyFraction>::value);
+        }
+    }
+}
+
+SCENARIO("Exact RREF with lazy fractions.") {
+
+    GIVEN("I have some small random systems.") {
+
+        std::mt19937 mt(7);
+        std::uniform_int_distribution<int> dist(-9, 9);
+
+        WHEN("I reduce them with fractions and with lazy fractions.") {
+
+            THEN("The results should be the same.") {
+
+                for (int repeat = 0; repeat < 20; repeat++) {
+                    Matrix<Fraction> eager {5, 6};
+                    Matrix<LazyFraction> lazy {5, 6};
+                    for (std::size_t i = 0; i < 5; i++) {
+                        for (std::size_t j = 0; j < 6; j++) {
+                            const int value {dist(mt)};
+                            eager[i][j] = Fraction {value};
+                            lazy[i][j] = LazyFraction {value};
+                        }
+                    }
+                    REQUIRE(static_cast<bool>(rref(eager)) == static_cast<bool>(rref(lazy)));
+                    for (std::size_t i = 0; i < 5; i++) {
+                        for (std::size_t j = 0; j < 6; j++) {
+                            REQUIRE(LazyFraction {eager[i][j]} == lazy[i][j]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("I have a 200x200 rational system with a known solution.") {
+
+        // A = D*L*U, with L and U unit bidiagonal and D a diagonal of small integers, so the pivots are not 1 and the
+        // denominators keep growing unless they are reduced. The right hand side is A*x for x = (1, -1, 1, ...).
+        const std::size_t n {200};
+        Matrix<LazyFraction> system {n, n + 1};
+        std::vector<long> d(n);
+        for (std::size_t i = 0; i < n; i++) {
+            d[i] = 2 + static_cast<long>(i % 5);
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            // Row i of L*U is e_{i-1} + 2 e_i + e_{i+1}, except for the first row which is e_0 + e_1.
+            const long diagonal {i == 0? 1L : 2L};
+            system[i][i] = LazyFraction {d[i]*diagonal};
+            if (i > 0) {
+                system[i][i - 1] = LazyFraction {d[i]};
+            }
+            if (i + 1 < n) {
+                system[i][i + 1] = LazyFraction {d[i]};
+            }
+            long rhs {0};
+            for (std::size_t j = (i == 0? 0 : i - 1); j <= i + 1 && j < n; j++) {
+                rhs += static_cast<long>(system[i][j].num)*((j % 2 == 0)? 1 : -1);
+            }
+            system[i][n] = LazyFraction {rhs};
+        }
+
+        WHEN("I reduce it.") {
+
+            const auto start {std::chrono::steady_clock::now()};
+            auto result {rref(system)};
+            const auto seconds {std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+
+            THEN("I should get the exact solution, in seconds.") {
+
+                REQUIRE(result);
+                for (std::size_t i = 0; i < n; i++) {
+                    REQUIRE(1 == system[i][i]);
+                    REQUIRE(((i % 2 == 0)? 1 : -1) == system[i][n]);
+                }
+                REQUIRE(seconds < 30.0);
+            }
+        }
+    }
+}
@@ -0,0 +1,160 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/math/lu.hpp>
+#include <numeric/math/errors.hpp>
+
+#include <thesoup/types/types.hpp>
+
+using numeric::types::Matrix;
+using numeric::types::Vector;
+using numeric::functions::LUDecomposition;
+using numeric::functions::Pivoting;
+using thesoup::types::Result;
+using numeric::ErrorCode;
+
+bool isClose(const double& lhs, const double& rhs) {
+    return std::fabs(lhs - rhs) < 1e-9;
+}
+
+SCENARIO("LU decomposition.") {
+
+    GIVEN("I have a non singular matrix with a zero leading element.") {
+
+        Matrix<double> a {{
+            {0, 2, 1},
+            {1, 1, 1},
+            {2, 1, 3}
+        }};
+
+        WHEN("I factor it with partial pivoting, and solve for a right hand side.") {
+
+            auto lu {LUDecomposition<double>::factor(a)};
+            Vector<double> b {{7, 6, 13}};
+
+            THEN("The solution should be correct.") {
+
+                REQUIRE(lu);
+                Result<Vector<double>, ErrorCode> x {lu.unwrap().solve(b)};
+                REQUIRE(x);
+                REQUIRE(isClose(1.0, x.unwrap()[0]));
+                REQUIRE(isClose(2.0, x.unwrap()[1]));
+                REQUIRE(isClose(3.0, x.unwrap()[2]));
+                REQUIRE(isClose(-3.0, lu.unwrap().determinant()));
+            }
+        }
+
+        WHEN("I factor it with complete pivoting, and solve for many right hand sides.") {
+
+            auto lu {LUDecomposition<double>::factor(a, Pivoting::COMPLETE)};
+            Matrix<double> b {{
+                {5, 0},
+                {6, 1},
+                {13, 2}
+            }};
+
+            THEN("Every column of the result should solve the corresponding column of the right hand sides.") {
+
+                REQUIRE(lu);
+                Result<Matrix<double>, ErrorCode> x {lu.unwrap().solve(b)};
+                REQUIRE(x);
+                Matrix<double> product {a * x.unwrap()};
+                for (std::size_t i = 0; i < 3; i++) {
+                    for (std::size_t j = 0; j < 2; j++) {
+                        REQUIRE(isClose(b[i][j], product[i][j]));
+                    }
+                }
+                REQUIRE(isClose(-3.0, lu.unwrap().determinant()));
+            }
+        }
+
+        WHEN("I try to solve for a right hand side of the wrong dimension.") {
+
+            auto lu {LUDecomposition<double>::factor(a)};
+            Vector<double> b {{1, 2}};
+            Matrix<double> bs {{{1, 2}, {3, 4}}};
+
+            THEN("I should get an error.") {
+
+                REQUIRE(ErrorCode::INCOMPATIBLE_VECTORS == lu.unwrap().solve(b).error());
+                REQUIRE(ErrorCode::INCOMPATIBLE_VECTORS == lu.unwrap().solve(bs).error());
+            }
+        }
+    }
+
+    GIVEN("I have a large random matrix.") {
+
+        std::mt19937 mt(7);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        const std::size_t n {60};
+        Matrix<double> a {n, n};
+        Vector<double> b {n};
+        for (std::size_t i = 0; i < n; i++) {
+            for (std::size_t j = 0; j < n; j++) {
+                a[i][j] = dist(mt);
+            }
+            b[i] = dist(mt);
+        }
+
+        WHEN("I factor it once and solve several times.") {
+
+            auto lu {LUDecomposition<double>::factor(a)};
+
+            THEN("The residuals should be tiny.") {
+
+                REQUIRE(lu);
+                for (int repeat = 0; repeat < 3; repeat++) {
+                    Vector<double> x {std::move(lu.unwrap().solve(b).unwrap())};
+                    Vector<double> residual {a*x - b};
+                    REQUIRE(residual.mod() < 1e-18);
+                    b.scale(2.0);
+                }
+            }
+        }
+    }
+
+    GIVEN("I have a singular matrix.") {
+
+        Matrix<double> a {{
+            {1, 2, 3},
+            {2, 4, 6},
+            {1, 0, 1}
+        }};
+
+        WHEN("I try to factor it.") {
+
+            auto lu {LUDecomposition<double>::factor(a)};
+
+            THEN("I should get a singular matrix error.") {
+
+                REQUIRE_FALSE(lu);
+                REQUIRE(ErrorCode::SINGULAR_MATRIX == lu.error());
+            }
+        }
+    }
+
+    GIVEN("I have a non square matrix.") {
+
+        Matrix<double> a {{
+            {1, 2, 3},
+            {2, 4, 7}
+        }};
+
+        WHEN("I try to factor it.") {
+
+            auto lu {LUDecomposition<double>::factor(a)};
+
+            THEN("I should get a non square matrix error.") {
+
+                REQUIRE_FALSE(lu);
+                REQUIRE(ErrorCode::NON_SQUARE_MATRIX == lu.error());
+            }
+        }
+    }
+}
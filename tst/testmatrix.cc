@@ -607,3 +607,48 @@ SCENARIO("Composite matrix operations.") {
         }
     }
 }
+
+SCENARIO("Unchecked matrix and vector access.") {
+    
+    GIVEN("I have a matrix and a vector.") {
+        Matrix<int> m1 {
+            {
+                {1,2,3},
+                {4,5,6}
+            }
+        };
+        Vector<int> v1 {{7,8,9}};
+        
+        WHEN("I access them through the unchecked API.") {
+            
+            THEN("I should see the same elements as with the index operators.") {
+                
+                for (std::size_t i = 0; i < m1.getRows(); i++) {
+                    const int* row {m1.rowPtr(i)};
+                    for (std::size_t j = 0; j < m1.getCols(); j++) {
+                        REQUIRE(m1[i][j] == row[j]);
+                        REQUIRE(m1[i][j] == m1.atUnchecked(i, j));
+                    }
+                }
+                for (std::size_t i = 0; i < v1.size(); i++) {
+                    REQUIRE(v1[i] == v1.data()[i]);
+                    REQUIRE(v1[i] == v1.atUnchecked(i));
+                }
+            }
+        }
+        
+        WHEN("I exchange rows and write through the unchecked API.") {
+            
+            m1.exchangeRows(0, 1);
+            m1.rowPtr(0)[0] = 10;
+            m1.atUnchecked(1, 2) = 30;
+            v1.data()[1] = 80;
+            
+            THEN("The writes should land on the right elements.") {
+                
+                REQUIRE(isEqual(m1, {{10,5,6}, {1,2,30}}));
+                REQUIRE(80 == v1[1]);
+            }
+        }
+    }
+}
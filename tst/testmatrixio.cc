@@ -0,0 +1,216 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <catch2/catch.hpp>
+#include <numeric/io/matrixio.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/math/rref.hpp>
+
+using numeric::io::MapMode;
+using numeric::io::MappedMatrix;
+using numeric::io::MatrixFileReader;
+using numeric::io::MatrixFileWriter;
+using numeric::io::read_matrix;
+using numeric::io::read_vector;
+using numeric::io::write_matrix;
+using numeric::io::write_vector;
+using numeric::types::Matrix;
+using numeric::types::Vector;
+
+Matrix<double> sequence(const std::size_t& rows, const std::size_t& cols) {
+    Matrix<double> retval {rows, cols};
+    for (std::size_t i = 0; i < rows; i++) {
+        for (std::size_t j = 0; j < cols; j++) {
+            retval[i][j] = static_cast<double>(i*cols + j) + 0.5;
+        }
+    }
+    return retval;
+}
+
+std::string tempFile(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("numeric-testmatrixio-" + name + ".mat")).string();
+}
+
+SCENARIO("Binary matrix streams.") {
+
+    GIVEN("I have a matrix and a vector.") {
+
+        Matrix<double> matrix {sequence(5, 3)};
+        Vector<int> vec {{3, -1, 4, -1, 5}};
+
+        WHEN("I write and read them back.") {
+
+            std::stringstream stream;
+            write_matrix(stream, matrix);
+            write_matrix(stream, matrix.transpose());
+            write_vector(stream, vec);
+            Matrix<double> copy {read_matrix<double>(stream)};
+            Matrix<double> transposed {read_matrix<double>(stream)};
+            Vector<int> vecCopy {read_vector<int>(stream)};
+
+            THEN("I should get the same elements.") {
+
+                REQUIRE(2*(64 + 15*sizeof(double)) + 64 + 5*sizeof(int) == stream.str().size());
+                REQUIRE(5 == copy.getRows());
+                REQUIRE(3 == copy.getCols());
+                REQUIRE(3 == transposed.getRows());
+                for (std::size_t i = 0; i < 5; i++) {
+                    for (std::size_t j = 0; j < 3; j++) {
+                        REQUIRE(matrix[i][j] == copy[i][j]);
+                        REQUIRE(matrix[i][j] == transposed[j][i]);
+                    }
+                }
+                REQUIRE(5 == vecCopy.size());
+                REQUIRE(-1 == vecCopy[3]);
+            }
+        }
+
+        WHEN("I read a stream as the wrong type, or a broken stream.") {
+
+            std::stringstream stream;
+            write_matrix(stream, matrix);
+            const std::string bytes {stream.str()};
+            std::stringstream truncated {bytes.substr(0, bytes.size() - 1)};
+            std::stringstream garbage {std::string(100, 'x')};
+            std::stringstream asFloat {bytes};
+            std::stringstream asLong {bytes};
+            std::stringstream asVector {bytes};
+
+            THEN("I should get errors.") {
+
+                REQUIRE_THROWS_AS(read_matrix<double>(truncated), std::invalid_argument);
+                REQUIRE_THROWS_AS(read_matrix<double>(garbage), std::invalid_argument);
+                REQUIRE_THROWS_AS(read_matrix<float>(asFloat), std::invalid_argument);
+                REQUIRE_THROWS_AS(read_matrix<std::int64_t>(asLong), std::invalid_argument);
+                REQUIRE_THROWS_AS(read_vector<double>(asVector), std::invalid_argument);
+            }
+        }
+    }
+
+    GIVEN("I have a matrix that I stream in blocks.") {
+
+        Matrix<double> matrix {sequence(10, 4)};
+
+        WHEN("I write it 3 rows at a time, and read it 4 rows at a time.") {
+
+            std::stringstream stream;
+            MatrixFileWriter<double> writer {stream, 10, 4};
+            for (std::size_t row = 0; row < 10; row += 3) {
+                writer.write(matrix.rowRange(row, row + 3 <= 10? 3 : 10 - row));
+            }
+
+            MatrixFileReader<double> reader {stream};
+            Matrix<double> block {4, 4};
+            Matrix<double> copy {10, 4};
+            std::size_t consumed {0};
+            std::size_t reads {0};
+            while (std::size_t rows = reader.read(block.view())) {
+                copy.rowRange(consumed, rows) = block.rowRange(0, rows);
+                consumed += rows;
+                reads++;
+            }
+
+            THEN("I should get the same matrix.") {
+
+                REQUIRE(writer.finished());
+                REQUIRE(10 == writer.rowsWritten());
+                REQUIRE(10 == reader.getRows());
+                REQUIRE(4 == reader.getCols());
+                REQUIRE(0 == reader.remaining());
+                REQUIRE(10 == consumed);
+                REQUIRE(3 == reads);
+                for (std::size_t i = 0; i < 10; i++) {
+                    for (std::size_t j = 0; j < 4; j++) {
+                        REQUIRE(matrix[i][j] == copy[i][j]);
+                    }
+                }
+            }
+        }
+
+        WHEN("I write blocks that do not fit.") {
+
+            std::stringstream stream;
+            MatrixFileWriter<double> writer {stream, 4, 4};
+            writer.write(matrix.rowRange(0, 3));
+
+            THEN("I should get errors.") {
+
+                REQUIRE_THROWS_AS(writer.write(matrix.rowRange(0, 2)), std::invalid_argument);
+                REQUIRE_THROWS_AS(writer.write(matrix.submatrix(0, 0, 1, 3)), std::invalid_argument);
+                REQUIRE_FALSE(writer.finished());
+            }
+        }
+    }
+}
+
+SCENARIO("Memory mapped matrices.") {
+
+    GIVEN("I have a matrix file.") {
+
+        const std::string path {tempFile("mapped")};
+        Matrix<double> system {{
+            {0, 2, 1, 7},
+            {1, 1, 1, 6},
+            {2, 1, -1, 1}
+        }};
+        {
+            std::ofstream file {path, std::ios::binary};
+            write_matrix(file, system);
+        }
+
+        WHEN("I map it read only.") {
+
+            MappedMatrix<double> mapped {path};
+            Matrix<double> copy {mapped.view()};
+
+            THEN("The views should see the file.") {
+
+                REQUIRE(3 == mapped.getRows());
+                REQUIRE(4 == mapped.getCols());
+                REQUIRE(7.0 == mapped.view().at(0, 3));
+                REQUIRE(-1.0 == copy[2][2]);
+                REQUIRE_THROWS_AS(mapped.mutableView(), std::logic_error);
+            }
+        }
+
+        WHEN("I map it read write and reduce it in place.") {
+
+            {
+                MappedMatrix<double> mapped {path, MapMode::READ_WRITE};
+                REQUIRE(numeric::functions::rref(mapped.mutableView()));
+                mapped.sync();
+            }
+            std::ifstream file {path, std::ios::binary};
+            Matrix<double> solved {read_matrix<double>(file)};
+
+            THEN("The file should hold the reduced system.") {
+
+                REQUIRE(1.0 == Approx(solved[0][3]));
+                REQUIRE(2.0 == Approx(solved[1][3]));
+                REQUIRE(3.0 == Approx(solved[2][3]));
+                REQUIRE(1.0 == solved[1][1]);
+            }
+        }
+
+        WHEN("The file is truncated, or missing.") {
+
+            std::filesystem::resize_file(path, 64 + 11*sizeof(double));
+
+            THEN("I should get errors.") {
+
+                REQUIRE_THROWS_AS(MappedMatrix<double> {path}, std::invalid_argument);
+                REQUIRE_THROWS_AS(MappedMatrix<float> {path}, std::invalid_argument);
+                REQUIRE_THROWS_AS(MappedMatrix<double> {tempFile("missing")}, std::runtime_error);
+            }
+        }
+
+        std::filesystem::remove(path);
+    }
+}
@@ -0,0 +1,215 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cmath>
+#include <random>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/bigint.hpp>
+#include <numeric/types/fraction.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/math/rref.hpp>
+#include <numeric/math/parallelrref.hpp>
+#include <numeric/math/errors.hpp>
+#include <numeric/parallel/threadpool.hpp>
+
+#include <thesoup/types/types.hpp>
+
+using numeric::types::BigInt;
+using numeric::types::Fraction;
+using numeric::types::Matrix;
+using numeric::functions::rref;
+using numeric::functions::parallel_rref;
+using numeric::parallel::ThreadPool;
+using thesoup::types::Result;
+using thesoup::types::Unit;
+using numeric::ErrorCode;
+
+Matrix<double> randomMatrix(const std::size_t& rows, const std::size_t& cols, const unsigned int& seed) {
+    std::mt19937 mt(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    Matrix<double> matrix {rows, cols};
+    for (std::size_t i = 0; i < rows; i++) {
+        for (std::size_t j = 0; j < cols; j++) {
+            matrix[i][j] = dist(mt);
+        }
+    }
+    return matrix;
+}
+
+Matrix<double> copyOf(const Matrix<double>& matrix) {
+    Matrix<double> copy {matrix.getRows(), matrix.getCols()};
+    for (std::size_t i = 0; i < matrix.getRows(); i++) {
+        for (std::size_t j = 0; j < matrix.getCols(); j++) {
+            copy[i][j] = matrix[i][j];
+        }
+    }
+    return copy;
+}
+
+bool isClose(const Matrix<double>& lhs, const Matrix<double>& rhs) {
+    for (std::size_t i = 0; i < lhs.getRows(); i++) {
+        for (std::size_t j = 0; j < lhs.getCols(); j++) {
+            if (std::fabs(lhs[i][j] - rhs[i][j]) > 1e-8) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool isIdentical(const Matrix<double>& lhs, const Matrix<double>& rhs) {
+    for (std::size_t i = 0; i < lhs.getRows(); i++) {
+        for (std::size_t j = 0; j < lhs.getCols(); j++) {
+            if (lhs[i][j] != rhs[i][j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 2*x0 = 1, and x0 + xi = 1 for the other rows, so every variable is 1/2.
+template <typename T> Matrix<T> halvesSystem(const std::size_t& vars) {
+    Matrix<T> matrix {vars, vars + 1};
+    for (std::size_t i = 0; i < vars; i++) {
+        for (std::size_t j = 0; j <= vars; j++) {
+            matrix[i][j] = static_cast<T>(j == vars || j == 0 || i == j? 1 : 0);
+        }
+    }
+    matrix[0][0] = static_cast<T>(2);
+    return matrix;
+}
+
+SCENARIO("Parallel RREF algorithm.") {
+
+    ThreadPool pool {4};
+
+    GIVEN("I have a large, well conditioned, augmented matrix.") {
+
+        Matrix<double> input {randomMatrix(300, 301, 1)};
+        for (std::size_t i = 0; i < 300; i++) {
+            input[i][i] += 300.0;
+        }
+        Matrix<double> expected {copyOf(input)};
+        Result<Unit, ErrorCode> expectedResult {rref(expected)};
+
+        WHEN("I run it through the parallel rref algorithm.") {
+
+            Result<Unit, ErrorCode> result {parallel_rref(input, pool)};
+
+            THEN("The result should be the same as from the serial algorithm, bit for bit.") {
+
+                REQUIRE(expectedResult);
+                REQUIRE(result);
+                REQUIRE(isIdentical(expected, input));
+            }
+        }
+    }
+
+    GIVEN("I have a large matrix that needs row exchanges, with free columns in several panels.") {
+
+        Matrix<double> input {randomMatrix(200, 230, 2)};
+        for (std::size_t i = 0; i < 200; i++) {
+            input[i][i] += 200.0;
+        }
+        for (std::size_t i = 0; i < 200; i += 3) {
+            input[i][i] = 0.0;
+        }
+        for (std::size_t i = 0; i < 200; i++) {
+            input[i][0] = 0.0;
+            input[i][70] = 0.0;
+            input[i][150] = 0.0;
+        }
+        Matrix<double> expected {copyOf(input)};
+        Result<Unit, ErrorCode> expectedResult {rref(expected)};
+
+        WHEN("I run it through the parallel rref algorithm.") {
+
+            Result<Unit, ErrorCode> result {parallel_rref(input, pool)};
+
+            THEN("I should get the same free columns error and the same matrix as from the serial algorithm.") {
+
+                REQUIRE_FALSE(expectedResult);
+                REQUIRE_FALSE(result);
+                REQUIRE(ErrorCode::FREE_COLUMNS_RREF == result.error());
+                REQUIRE(isIdentical(expected, input));
+            }
+        }
+
+        WHEN("I run it through the parallel rref algorithm, with a zero precision.") {
+
+            Matrix<double> rounded {copyOf(input)};
+            rref(rounded, 1e-10);
+            Result<Unit, ErrorCode> result {parallel_rref(input, pool, 1e-10)};
+
+            THEN("I should get the same result as from the serial algorithm.") {
+
+                REQUIRE_FALSE(result);
+                REQUIRE(ErrorCode::FREE_COLUMNS_RREF == result.error());
+                REQUIRE(isClose(rounded, input));
+            }
+        }
+    }
+
+    GIVEN("I have a small matrix.") {
+
+        Matrix<double> input {{
+            {1, 10},
+            {2, 17},
+            {5, 11}
+        }};
+
+        WHEN("I run it through the parallel rref algorithm.") {
+
+            Result<Unit, ErrorCode> result {parallel_rref(input, pool)};
+
+            THEN("It should be reduced like with the serial algorithm.") {
+
+                REQUIRE(result);
+                REQUIRE(1.0 == input[0][0]);
+                REQUIRE(0.0 == input[0][1]);
+                REQUIRE(0.0 == input[1][0]);
+                REQUIRE(1.0 == input[1][1]);
+                REQUIRE(0.0 == input[2][0]);
+                REQUIRE(0.0 == input[2][1]);
+            }
+        }
+    }
+
+    GIVEN("I have large integer and fraction systems, with a fractional solution.") {
+
+        Matrix<long> integers {halvesSystem<long>(130)};
+        Matrix<BigInt> bigIntegers {halvesSystem<BigInt>(130)};
+        Matrix<Fraction> fractions {halvesSystem<Fraction>(130)};
+
+        WHEN("I run them through the parallel rref algorithm, with and without a zero precision.") {
+
+            Matrix<long> rounded {halvesSystem<long>(130)};
+            Matrix<BigInt> roundedBigIntegers {halvesSystem<BigInt>(130)};
+            Result<Unit, ErrorCode> integerResult {parallel_rref(integers, pool)};
+            Result<Unit, ErrorCode> roundedResult {parallel_rref(rounded, pool, 1e-10)};
+            Result<Unit, ErrorCode> bigIntegerResult {parallel_rref(bigIntegers, pool)};
+            Result<Unit, ErrorCode> roundedBigIntegerResult {parallel_rref(roundedBigIntegers, pool, 1e-10)};
+            Result<Unit, ErrorCode> fractionResult {parallel_rref(fractions, pool)};
+
+            THEN("They should be reduced by the serial algorithm, without truncation.") {
+
+                REQUIRE(integerResult);
+                REQUIRE(roundedResult);
+                REQUIRE(bigIntegerResult);
+                REQUIRE(roundedBigIntegerResult);
+                REQUIRE(fractionResult);
+                for (std::size_t i = 0; i < 130; i++) {
+                    for (std::size_t j = 0; j <= 130; j++) {
+                        const long expected {j == 130? 1 : (i == j? 2 : 0)};
+                        REQUIRE(expected == integers[i][j]);
+                        REQUIRE(expected == rounded[i][j]);
+                        REQUIRE(BigInt {expected} == bigIntegers[i][j]);
+                        REQUIRE(BigInt {expected} == roundedBigIntegers[i][j]);
+                        REQUIRE(static_cast<double>(expected)/2.0 == static_cast<double>(fractions[i][j]));
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,185 @@
+#define CATCH_CONFIG_MAIN
+
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/permutation.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/math/rref.hpp>
+#include <numeric/math/errors.hpp>
+
+using numeric::types::Matrix;
+using numeric::types::Permutation;
+using numeric::types::Vector;
+using numeric::functions::rref;
+
+template <typename T> bool isEqual(const Matrix<T>& matrix, const std::vector<std::vector<T>>& vecs) {
+    if (matrix.getRows() != vecs.size() || matrix.getCols() != vecs[0].size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < vecs.size(); i++) {
+        for (std::size_t j = 0; j < vecs[0].size(); j++) {
+            if (matrix[i][j] != vecs[i][j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+SCENARIO("Permutations.") {
+
+    GIVEN("I have a permutation built from a row order.") {
+
+        Permutation p {std::vector<std::size_t> {2, 0, 1, 4, 3}};
+
+        THEN("Its sign should count the transpositions.") {
+
+            // A 3 cycle and a transposition: 2 + 1 exchanges.
+            REQUIRE(-1 == p.get_sign());
+            REQUIRE(!p.isIdentity());
+            REQUIRE(1 == Permutation {4}.get_sign());
+            REQUIRE(Permutation {4}.isIdentity());
+        }
+
+        THEN("The inverse should undo it.") {
+
+            Permutation inverse {p.inverse()};
+            REQUIRE(inverse.get_order() == std::vector<std::size_t> {1, 2, 0, 4, 3});
+            REQUIRE(inverse.get_sign() == p.get_sign());
+        }
+
+        THEN("Applying it to a vector should reorder the elements.") {
+
+            Vector<int> b {std::vector<int> {10, 11, 12, 13, 14}};
+            REQUIRE(Vector<int> {std::vector<int> {12, 10, 11, 14, 13}} == p.apply(b));
+            REQUIRE_THROWS_AS(p.apply(Vector<int> {3}), std::invalid_argument);
+        }
+
+        WHEN("I record more exchanges.") {
+
+            p.swap(0, 1).swap(3, 3);
+
+            THEN("The order and sign should follow.") {
+
+                REQUIRE(p.get_order() == std::vector<std::size_t> {0, 2, 1, 4, 3});
+                REQUIRE(1 == p.get_sign());
+                REQUIRE_THROWS_AS(p.swap(0, 5), std::out_of_range);
+            }
+        }
+    }
+
+    GIVEN("I have a row order that is not a permutation.") {
+
+        THEN("The constructor should throw.") {
+
+            const std::vector<std::size_t> repeated {0, 0, 1};
+            const std::vector<std::size_t> outOfRange {0, 3, 1};
+            REQUIRE_THROWS_AS(Permutation(repeated), std::invalid_argument);
+            REQUIRE_THROWS_AS(Permutation(outOfRange), std::invalid_argument);
+        }
+    }
+}
+
+SCENARIO("Matrix row permutation and compaction.") {
+
+    GIVEN("I have a matrix with exchanged rows.") {
+
+        Matrix<int> matrix {{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}}};
+        REQUIRE(matrix.isContiguous());
+        REQUIRE(matrix.row_permutation().isIdentity());
+
+        matrix.exchangeRows(0, 2).exchangeRows(1, 2).exchangeRows(2, 3);
+
+        THEN("The row permutation should say where every row is stored.") {
+
+            REQUIRE(!matrix.isContiguous());
+            REQUIRE(matrix.row_permutation().get_order() == std::vector<std::size_t> {2, 0, 3, 1});
+            REQUIRE(-1 == matrix.row_permutation().get_sign());
+        }
+
+        WHEN("I compact it.") {
+
+            matrix.compact();
+
+            THEN("The rows should be the same, and stored in row major order.") {
+
+                REQUIRE(isEqual(matrix, {{7, 8, 9}, {1, 2, 3}, {10, 11, 12}, {4, 5, 6}}));
+                REQUIRE(matrix.isContiguous());
+                const int* flat {matrix.rowPtr(0)};
+                const std::vector<int> expected {7, 8, 9, 1, 2, 3, 10, 11, 12, 4, 5, 6};
+                for (std::size_t i = 0; i < expected.size(); i++) {
+                    REQUIRE(expected[i] == flat[i]);
+                }
+            }
+        }
+
+        WHEN("I undo the permutation it carries.") {
+
+            matrix.permuteRows(matrix.row_permutation().inverse());
+
+            THEN("The matrix should be back in the original order, without moving elements.") {
+
+                REQUIRE(matrix.isContiguous());
+                REQUIRE(isEqual(matrix, {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}}));
+                REQUIRE_THROWS_AS(matrix.permuteRows(Permutation {3}), std::invalid_argument);
+            }
+        }
+    }
+}
+
+SCENARIO("RREF with permutation tracking.") {
+
+    GIVEN("I have a system that needs row exchanges.") {
+
+        Matrix<double> matrix {{{0.0, 2.0, 1.0, 7.0}, {0.0, 1.0, 1.0, 5.0}, {1.0, 1.0, 1.0, 6.0}}};
+
+        WHEN("I reduce it and record the exchanges.") {
+
+            Permutation permutation {};
+            REQUIRE(rref(matrix, permutation));
+
+            THEN("The recorded permutation should match the one the matrix carries.") {
+
+                REQUIRE(isEqual(matrix, {{1.0, 0.0, 0.0, 1.0}, {0.0, 1.0, 0.0, 2.0}, {0.0, 0.0, 1.0, 3.0}}));
+                REQUIRE(permutation == matrix.row_permutation());
+                REQUIRE(permutation.get_order() == std::vector<std::size_t> {2, 1, 0});
+                REQUIRE(-1 == permutation.get_sign());
+            }
+
+            THEN("Replaying it should reorder a new right hand side like the rows.") {
+
+                Vector<double> b {std::vector<double> {7.0, 5.0, 6.0}};
+                REQUIRE(Vector<double> {std::vector<double> {6.0, 5.0, 7.0}} == permutation.apply(b));
+            }
+
+            THEN("Compacting should keep the result.") {
+
+                matrix.compact();
+                REQUIRE(matrix.isContiguous());
+                REQUIRE(isEqual(matrix, {{1.0, 0.0, 0.0, 1.0}, {0.0, 1.0, 0.0, 2.0}, {0.0, 0.0, 1.0, 3.0}}));
+            }
+        }
+    }
+
+    GIVEN("I have a view of a matrix that needs a row exchange.") {
+
+        Matrix<double> matrix {{{0.0, 1.0, 4.0}, {2.0, 0.0, 8.0}}};
+
+        WHEN("I reduce the view with round off and record the exchanges.") {
+
+            Permutation permutation {};
+            REQUIRE(rref(matrix.view(), 1e-12, permutation));
+
+            THEN("The exchange should be recorded, and the storage should stay in row major order.") {
+
+                REQUIRE(isEqual(matrix, {{1.0, 0.0, 4.0}, {0.0, 1.0, 4.0}}));
+                REQUIRE(permutation.get_order() == std::vector<std::size_t> {1, 0});
+                REQUIRE(-1 == permutation.get_sign());
+                REQUIRE(matrix.isContiguous());
+            }
+        }
+    }
+}
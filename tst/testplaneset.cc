@@ -0,0 +1,142 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/plane.hpp>
+#include <numeric/types/planeset.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/math/planes.hpp>
+#include <numeric/parallel/threadpool.hpp>
+
+using numeric::types::Plane;
+using numeric::types::PlaneSet;
+using numeric::types::Vector;
+using numeric::parallel::ThreadPool;
+using numeric::functions::classify_points;
+using numeric::functions::cosine_angle;
+using numeric::functions::is_normal_to_plane;
+using numeric::functions::signed_distances;
+
+SCENARIO("Plane set queries.") {
+
+    GIVEN("I have a few planes, and some points.") {
+
+        std::vector<Plane<double>> planes {};
+        planes.emplace_back(0.0, 0.0, 2.0, 4.0);
+        planes.emplace_back(Vector<double> {{1, 1, 0}}, Vector<double> {{1, 0, 0}});
+        PlaneSet<double> set {planes};
+
+        const std::vector<double> x {0.0, 3.0, 1.0, 0.0};
+        const std::vector<double> y {0.0, 0.0, 1.0, 1.0};
+        const std::vector<double> z {5.0, 2.0, 0.0, -1.0};
+
+        WHEN("I compute the signed distances.") {
+
+            std::vector<double> out(2*4);
+            signed_distances(set, x.data(), y.data(), z.data(), 4, out.data());
+
+            THEN("They should be positive in front of the planes, and negative behind them.") {
+
+                const double root2 {std::sqrt(2.0)};
+                const std::vector<double> expected {3.0, 0.0, -2.0, -3.0, -1.0/root2, 2.0/root2, 1.0/root2, 0.0};
+                for (std::size_t i = 0; i < expected.size(); i++) {
+                    REQUIRE(std::fabs(expected[i] - out[i]) < 1e-12);
+                }
+            }
+        }
+
+        WHEN("I classify the points.") {
+
+            std::vector<signed char> out(2*4);
+            classify_points(set, x.data(), y.data(), z.data(), 4, out.data(), 1e-12);
+
+            THEN("Every point should be on the right side, or on the plane.") {
+
+                REQUIRE(std::vector<signed char> {1, 0, -1, -1, -1, 1, 1, 0} == out);
+            }
+        }
+
+        WHEN("I test vectors against the normals.") {
+
+            const std::vector<double> vx {0.0, 2.0, 0.0, -1.0};
+            const std::vector<double> vy {0.0, 2.0, 1.0, -1.0};
+            const std::vector<double> vz {3.0, 0.0, 1.0, 0.0};
+            std::vector<double> cosines(2*4);
+            cosine_angle(set, vx.data(), vy.data(), vz.data(), 4, cosines.data());
+            bool flags[8];
+            is_normal_to_plane(set, vx.data(), vy.data(), vz.data(), 4, flags, 1e-12);
+
+            THEN("The cosines and the normal tests should match the single plane functions.") {
+
+                const double halfRoot2 {std::sqrt(0.5)};
+                const std::vector<double> expected {1.0, 0.0, halfRoot2, 0.0, 0.0, 1.0, 0.5, -1.0};
+                for (std::size_t i = 0; i < expected.size(); i++) {
+                    REQUIRE(std::fabs(expected[i] - cosines[i]) < 1e-12);
+                    REQUIRE(flags[i] == (std::fabs(expected[i] - 1.0) < 1e-12));
+                }
+            }
+        }
+
+        THEN("Planes should round trip, and be checked like Plane.") {
+
+            REQUIRE(std::get<3>(set.get(1).get_coefficients()) == 1.0);
+            REQUIRE_THROWS_AS(set.get(2), std::out_of_range);
+            REQUIRE_THROWS_AS(set.set(0, 0.0, 0.0, 0.0, 1.0), std::invalid_argument);
+        }
+    }
+
+    GIVEN("I have many random planes and points.") {
+
+        std::mt19937 mt(3);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        const std::size_t numPlanes {37};
+        const std::size_t numPoints {5000};
+        PlaneSet<double> set {numPlanes};
+        for (std::size_t p = 0; p < numPlanes; p++) {
+            set.set(p, dist(mt), dist(mt), dist(mt) + 2.0, dist(mt));
+        }
+        std::vector<double> x(numPoints);
+        std::vector<double> y(numPoints);
+        std::vector<double> z(numPoints);
+        for (std::size_t i = 0; i < numPoints; i++) {
+            x[i] = dist(mt);
+            y[i] = dist(mt);
+            z[i] = dist(mt);
+        }
+
+        WHEN("I run the queries serially and on a thread pool.") {
+
+            ThreadPool pool {4};
+            std::vector<double> serial(numPlanes*numPoints);
+            std::vector<double> parallel(numPlanes*numPoints);
+            signed_distances(set, x.data(), y.data(), z.data(), numPoints, serial.data());
+            signed_distances(set, pool, x.data(), y.data(), z.data(), numPoints, parallel.data());
+            std::vector<signed char> sides(numPlanes*numPoints);
+            classify_points(set, pool, x.data(), y.data(), z.data(), numPoints, sides.data());
+            std::vector<double> cosines(numPlanes*numPoints);
+            cosine_angle(set, pool, x.data(), y.data(), z.data(), numPoints, cosines.data());
+
+            THEN("The results should be identical, and match the single plane computations.") {
+
+                REQUIRE(serial == parallel);
+                for (std::size_t p = 0; p < numPlanes; p++) {
+                    const Plane<double> plane {set.get(p)};
+                    const Vector<double>& normal {plane.get_normal()};
+                    const double length {std::sqrt(normal*normal)};
+                    for (std::size_t i = 0; i < numPoints; i += 97) {
+                        Vector<double> point {{x[i], y[i], z[i]}};
+                        const double distance {(normal*point - std::get<3>(plane.get_coefficients()))/length};
+                        REQUIRE(std::fabs(distance - serial[p*numPoints + i]) < 1e-12);
+                        REQUIRE(sides[p*numPoints + i] == (distance > 0.0? 1 : -1));
+                        const double cosine {(normal*point)/std::sqrt((normal*normal)*(point*point))};
+                        REQUIRE(std::fabs(cosine - cosines[p*numPoints + i]) < 1e-12);
+                    }
+                }
+            }
+        }
+    }
+}
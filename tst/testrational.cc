@@ -0,0 +1,344 @@
+#define CATCH_CONFIG_MAIN
+
+#include <climits>
+#include <exception>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/bigint.hpp>
+#include <numeric/types/fraction.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/models.hpp>
+#include <numeric/types/rational.hpp>
+#include <numeric/math/bareiss.hpp>
+#include <numeric/math/gaussjordan.hpp>
+#include <numeric/math/rref.hpp>
+
+using numeric::types::BigInt;
+using numeric::types::Fraction;
+using numeric::types::IsScalarType;
+using numeric::types::LazyFraction;
+using numeric::types::Matrix;
+using numeric::types::Rational;
+using numeric::functions::bareiss;
+using numeric::functions::bareiss_rref;
+using numeric::functions::gauss_jordan;
+using numeric::functions::rref;
+
+SCENARIO("Big integer arithmetic.") {
+
+    GIVEN("I have some small big integers.") {
+
+        std::mt19937 mt(3);
+        std::uniform_int_distribution<long> dist(-3000000000L, 3000000000L);
+
+        WHEN("I do arithmetic with them.") {
+
+            THEN("The results should match long arithmetic, and stay in a machine word.") {
+
+                for (int repeat = 0; repeat < 1000; repeat++) {
+                    const long a {dist(mt)};
+                    const long b {dist(mt)};
+                    REQUIRE(BigInt {a + b} == BigInt {a} + BigInt {b});
+                    REQUIRE(BigInt {a - b} == BigInt {a} - b);
+                    REQUIRE(BigInt {a*b} == a*BigInt {b});
+                    REQUIRE((BigInt {a}*b).is_small());
+                    if (b != 0) {
+                        REQUIRE(BigInt {a/b} == BigInt {a}/BigInt {b});
+                        REQUIRE(BigInt {a % b} == BigInt {a} % BigInt {b});
+                    }
+                    REQUIRE((a < b) == (BigInt {a} < BigInt {b}));
+                }
+            }
+        }
+    }
+
+    GIVEN("I have big integers that do not fit in a long.") {
+
+        const BigInt two {2};
+        BigInt power {1};
+        for (int i = 0; i < 100; i++) {
+            power *= two;
+        }
+
+        WHEN("I print and parse them.") {
+
+            std::stringstream stream;
+            stream << -power;
+
+            THEN("I should get the decimal representation back.") {
+
+                REQUIRE("1267650600228229401496703205376" == power.to_string());
+                REQUIRE("-1267650600228229401496703205376" == stream.str());
+                REQUIRE(power == BigInt {std::string {"1267650600228229401496703205376"}});
+                REQUIRE(std::string {"1000000000000000000000"} == (BigInt {std::string {"999999999999999999999"}} + 1).to_string());
+                REQUIRE_THROWS_AS(BigInt {std::string {"12a"}}, std::invalid_argument);
+                REQUIRE(1267650600228229401496703205376.0 == static_cast<double>(power));
+            }
+        }
+
+        WHEN("I overflow a long and come back.") {
+
+            const BigInt max {LONG_MAX};
+            const BigInt min {LONG_MIN};
+
+            THEN("The value should be promoted, and demoted again when it fits.") {
+
+                REQUIRE_FALSE((max + 1).is_small());
+                REQUIRE((max + 1 - 1).is_small());
+                REQUIRE(max == max + 1 - 1);
+                REQUIRE_FALSE((-min).is_small());
+                REQUIRE(min == -(-min));
+                REQUIRE((-min) - 1 == max);
+                REQUIRE(min/(-1) == max + 1);
+                REQUIRE(min*min/min == min);
+                REQUIRE(BigInt {ULONG_MAX} == max*2 + 1);
+            }
+        }
+
+        WHEN("I divide random big integers.") {
+
+            std::mt19937 mt(5);
+            std::uniform_int_distribution<long> dist(LONG_MIN, LONG_MAX);
+
+            THEN("The quotient and the remainder should satisfy a = q*b + r, with |r| < |b| and the sign of a.") {
+
+                for (int repeat = 0; repeat < 500; repeat++) {
+                    BigInt a {dist(mt)};
+                    BigInt b {dist(mt)};
+                    for (int i = 0; i < repeat % 5; i++) {
+                        a = a*dist(mt) + dist(mt);
+                    }
+                    for (int i = 0; i < repeat % 3; i++) {
+                        b = b*dist(mt) + dist(mt);
+                    }
+                    if (b.is_zero()) {
+                        continue;
+                    }
+                    const BigInt q {a/b};
+                    const BigInt r {a % b};
+                    REQUIRE(a == q*b + r);
+                    REQUIRE(abs(r) < abs(b));
+                    REQUIRE((r.is_zero() || r.sign() == a.sign()));
+                    REQUIRE(a*b/b == a);
+                    REQUIRE((a*b % b).is_zero());
+                }
+            }
+        }
+
+        WHEN("I take greatest common divisors.") {
+
+            const BigInt a {power*3*7};
+            const BigInt b {power*5*7};
+
+            THEN("They should be exact.") {
+
+                REQUIRE(power*7 == gcd(a, b));
+                REQUIRE(power*7 == gcd(-a, b));
+                REQUIRE(a == gcd(a, 0));
+                REQUIRE_THROWS_AS(a/0, std::invalid_argument);
+            }
+        }
+    }
+
+    GIVEN("The scalar type trait.") {
+
+        THEN("Big integers and rationals should be scalars.") {
+
+            REQUIRE(IsScalarType<BigInt>::value);
+            REQUIRE(IsScalarType<Rational>::value);
+            REQUIRE(IsScalarType<const Rational>::value);
+        }
+    }
+}
+
+SCENARIO("Rational arithmetic.") {
+
+    GIVEN("I have some rationals.") {
+
+        Rational r1 {1, 6};
+        Rational r2 {BigInt {2}, BigInt {-6}};
+
+        WHEN("I do arithmetic with them.") {
+
+            THEN("The results should be exact and reduced.") {
+
+                REQUIRE(Rational {1, 2} == r1 - r2);
+                REQUIRE(Rational {-1, 6} == r1 + r2);
+                REQUIRE(Rational {-1, 18} == r1*r2);
+                REQUIRE(Rational {-1, 2} == r1/r2);
+                REQUIRE(BigInt {-1} == (r1/r2).get_numerator());
+                REQUIRE(BigInt {2} == (r1/r2).get_denominator());
+                REQUIRE(0 == r1 - r1);
+                REQUIRE(BigInt {1} == (r1 - r1).get_denominator());
+                REQUIRE(r2 < r1);
+                REQUIRE(r1 >= r2);
+                REQUIRE(Rational {Fraction {1, 6}} == r1);
+                REQUIRE(0.5 == static_cast<double>(r1 - r2));
+                REQUIRE_THROWS_AS(Rational(1, 0), std::invalid_argument);
+                REQUIRE_THROWS_AS(r1/0, std::invalid_argument);
+            }
+        }
+
+        WHEN("The numerators and denominators outgrow a long.") {
+
+            Rational sum {0};
+            for (long i = 1; i <= 60; i++) {
+                sum += Rational {1, i*i};
+            }
+            std::stringstream stream;
+            stream << Rational {1, LONG_MAX}*Rational {1, LONG_MAX};
+
+            THEN("The results should still be exact.") {
+
+                REQUIRE_FALSE(sum.get_denominator().is_small());
+                REQUIRE(1.6284 < static_cast<double>(sum));
+                REQUIRE(1.6285 > static_cast<double>(sum));
+                REQUIRE("1/85070591730234615847396907784232501249" == stream.str());
+            }
+        }
+    }
+}
+
+// The n x (n + 1) augmented Hilbert system, H x = b, for x = (1, -1, 1, ...).
+template <typename T> Matrix<T> hilbertSystem(const std::size_t& n) {
+    Matrix<T> system {n, n + 1};
+    for (std::size_t i = 0; i < n; i++) {
+        T rhs {0};
+        for (std::size_t j = 0; j < n; j++) {
+            system[i][j] = T {1, static_cast<long>(i + j + 1)};
+            rhs += (j % 2 == 0)? system[i][j] : -system[i][j];
+        }
+        system[i][n] = rhs;
+    }
+    return system;
+}
+
+SCENARIO("Exact elimination with rationals.") {
+
+    GIVEN("I have a 16x16 Hilbert system, whose exact solution overflows long fractions.") {
+
+        const std::size_t n {16};
+        Matrix<Rational> system {hilbertSystem<Rational>(n)};
+        Matrix<Rational> copy {hilbertSystem<Rational>(n)};
+
+        WHEN("I reduce it with rref and with gauss_jordan.") {
+
+            auto result {rref(system)};
+            Matrix<Rational> augmented {hilbertSystem<Rational>(n)};
+            auto solution {gauss_jordan(augmented)};
+
+            THEN("I should get the exact solution.") {
+
+                REQUIRE(result);
+                REQUIRE(solution);
+                for (std::size_t i = 0; i < n; i++) {
+                    REQUIRE(Rational {i % 2 == 0? 1 : -1} == system[i][n]);
+                    REQUIRE(Rational {i % 2 == 0? 1 : -1} == augmented[i][n]);
+                }
+            }
+        }
+
+        WHEN("I reduce a slightly larger one with lazy fractions.") {
+
+            // rref normalizes the pivot row before eliminating, which keeps the 16x16 system within longs.
+            Matrix<LazyFraction> lazy {hilbertSystem<LazyFraction>(n + 2)};
+
+            THEN("They should overflow.") {
+
+                REQUIRE_THROWS_AS(rref(lazy), std::overflow_error);
+            }
+        }
+
+        WHEN("I reduce it with bareiss_rref.") {
+
+            auto result {bareiss_rref(copy)};
+
+            THEN("I should get the exact solution too.") {
+
+                REQUIRE(result);
+                for (std::size_t i = 0; i < n; i++) {
+                    REQUIRE(1 == copy[i][i]);
+                    REQUIRE(Rational {i % 2 == 0? 1 : -1} == copy[i][n]);
+                }
+            }
+        }
+    }
+
+    GIVEN("I have random integer systems.") {
+
+        std::mt19937 mt(11);
+        std::uniform_int_distribution<long> dist(-99, 99);
+
+        WHEN("I reduce them fraction free with big integers, and with rationals.") {
+
+            THEN("The fraction free result should be the RREF scaled by the last pivot.") {
+
+                for (int repeat = 0; repeat < 10; repeat++) {
+                    const std::size_t n {static_cast<std::size_t>(4 + 2*repeat)};
+                    Matrix<BigInt> integers {n, n + 1};
+                    Matrix<Rational> rationals {n, n + 1};
+                    Matrix<Rational> viaBareiss {n, n + 1};
+                    for (std::size_t i = 0; i < n; i++) {
+                        for (std::size_t j = 0; j <= n; j++) {
+                            const long value {dist(mt)};
+                            integers[i][j] = BigInt {value};
+                            rationals[i][j] = Rational {value};
+                            viaBareiss[i][j] = Rational {value};
+                        }
+                    }
+                    REQUIRE(static_cast<bool>(rref(rationals)) == static_cast<bool>(bareiss(integers)));
+                    REQUIRE(static_cast<bool>(bareiss_rref(viaBareiss)));
+                    const BigInt& last {integers[n - 1][n - 1]};
+                    for (std::size_t i = 0; i < n; i++) {
+                        for (std::size_t j = 0; j <= n; j++) {
+                            REQUIRE(rationals[i][j]*Rational {last} == Rational {integers[i][j]});
+                            REQUIRE(rationals[i][j] == viaBareiss[i][j]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("I have a square integer matrix with a known determinant.") {
+
+        Matrix<BigInt> matrix {3, 3};
+        const long elems[3][3] {{2, -3, 1}, {2, 0, -1}, {1, 4, 5}};
+        for (std::size_t i = 0; i < 3; i++) {
+            for (std::size_t j = 0; j < 3; j++) {
+                matrix[i][j] = BigInt {elems[i][j]};
+            }
+        }
+
+        WHEN("I eliminate it fraction free.") {
+
+            auto result {bareiss(matrix)};
+
+            THEN("The pivots should all be the determinant.") {
+
+                REQUIRE(result);
+                for (std::size_t i = 0; i < 3; i++) {
+                    REQUIRE(BigInt {49} == matrix[i][i]);
+                }
+                REQUIRE(BigInt {0} == matrix[0][1]);
+            }
+        }
+
+        WHEN("The matrix is singular.") {
+
+            matrix[2][0] = BigInt {4};
+            matrix[2][1] = BigInt {-3};
+            matrix[2][2] = BigInt {0};
+
+            THEN("I should get an error.") {
+
+                auto result {bareiss(matrix)};
+                REQUIRE_FALSE(result);
+                REQUIRE(numeric::ErrorCode::FREE_COLUMNS_RREF == result.error());
+            }
+        }
+    }
+}
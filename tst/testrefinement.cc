@@ -0,0 +1,178 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/bigint.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/rational.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/math/errors.hpp>
+#include <numeric/math/lu.hpp>
+#include <numeric/math/refinement.hpp>
+
+using numeric::types::BigInt;
+using numeric::types::Matrix;
+using numeric::types::Rational;
+using numeric::types::Vector;
+using numeric::functions::LUDecomposition;
+using numeric::functions::RefinementOptions;
+using numeric::functions::mixed_precision_solve;
+using numeric::ErrorCode;
+
+SCENARIO("Mixed precision solve.") {
+
+    GIVEN("I have a well conditioned double system.") {
+
+        const std::size_t n {50};
+        std::mt19937 generator {42};
+        std::uniform_real_distribution<double> distribution {-1.0, 1.0};
+        Matrix<double> a {n, n};
+        Vector<double> b {n};
+        for (std::size_t i = 0; i < n; i++) {
+            for (std::size_t j = 0; j < n; j++) {
+                a[i][j] = distribution(generator);
+            }
+            a[i][i] += static_cast<double>(n);
+            b[i] = distribution(generator);
+        }
+
+        WHEN("I solve it with a float factorization.") {
+
+            auto result {mixed_precision_solve(a, b)};
+
+            THEN("The refined solution should have double accuracy.") {
+
+                REQUIRE(result);
+                REQUIRE(result.unwrap().residual <= 1e-12);
+                REQUIRE(result.unwrap().iterations >= 1);
+
+                auto lu {LUDecomposition<double>::factor(a)};
+                REQUIRE(lu);
+                auto solved {lu.unwrap().solve(b)};
+                const Vector<double>& expected {solved.unwrap()};
+                for (std::size_t i = 0; i < n; i++) {
+                    REQUIRE(std::fabs(expected[i] - result.unwrap().solution[i]) < 1e-12);
+                }
+            }
+        }
+
+        WHEN("I allow exactly as many refinement steps as it takes.") {
+
+            auto unlimited {mixed_precision_solve(a, b)};
+            REQUIRE(unlimited);
+            RefinementOptions options {};
+            options.maxIterations = unlimited.unwrap().iterations;
+            auto result {mixed_precision_solve(a, b, options)};
+
+            THEN("It should still converge, with all of them.") {
+
+                REQUIRE(result);
+                REQUIRE(options.maxIterations == result.unwrap().iterations);
+            }
+        }
+
+        WHEN("I do not allow any refinement.") {
+
+            RefinementOptions options {};
+            options.maxIterations = 0;
+            auto result {mixed_precision_solve(a, b, options)};
+
+            THEN("The float solution alone should not be accurate enough.") {
+
+                REQUIRE(!result);
+                REQUIRE(ErrorCode::NOT_CONVERGED == result.error());
+            }
+        }
+    }
+
+    GIVEN("I have a rational system.") {
+
+        Matrix<Rational> a {3, 3};
+        const std::vector<std::vector<int>> coefficients {{4, 1, 2}, {1, 5, 1}, {2, 1, 6}};
+        for (std::size_t i = 0; i < 3; i++) {
+            for (std::size_t j = 0; j < 3; j++) {
+                a[i][j] = Rational {coefficients[i][j]};
+            }
+        }
+        // The solution is (1/3, -1/7, 2/5), none of which a float or a double can hold.
+        const std::vector<Rational> expected {Rational {1, 3}, Rational {-1, 7}, Rational {2, 5}};
+        Vector<Rational> b {3};
+        for (std::size_t i = 0; i < 3; i++) {
+            b[i] = a[i][0]*expected[0] + a[i][1]*expected[1] + a[i][2]*expected[2];
+        }
+
+        WHEN("I solve it with a tolerance below double precision.") {
+
+            RefinementOptions options {};
+            options.tolerance = 1e-30;
+            auto result {mixed_precision_solve(a, b, options)};
+
+            THEN("The exact residual should reach the tolerance.") {
+
+                REQUIRE(result);
+                REQUIRE(result.unwrap().residual <= 1e-30);
+                for (std::size_t i = 0; i < 3; i++) {
+                    const Rational error {result.unwrap().solution[i] - expected[i]};
+                    REQUIRE(std::fabs(static_cast<double>(error)) < 1e-30);
+                }
+            }
+        }
+    }
+
+    GIVEN("I have a rational system with a pivot that is subnormal in float.") {
+
+        Matrix<Rational> a {2, 2};
+        a[0][0] = Rational {BigInt {1}, BigInt {std::string {"1"} + std::string(40, '0')}};
+        a[0][1] = Rational {0};
+        a[1][0] = Rational {0};
+        a[1][1] = Rational {1};
+        Vector<Rational> b {2};
+        b[0] = Rational {1};
+        b[1] = Rational {1};
+
+        WHEN("I solve it with a float factorization.") {
+
+            auto result {mixed_precision_solve(a, b)};
+
+            THEN("The correction overflows float, and the solver should give up.") {
+
+                REQUIRE(!result);
+                REQUIRE(ErrorCode::NOT_CONVERGED == result.error());
+            }
+        }
+    }
+
+    GIVEN("I have systems that can not be solved.") {
+
+        Matrix<double> nonSquare {{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}}};
+        Matrix<double> singular {{{1.0, 2.0}, {2.0, 4.0}}};
+        Matrix<double> regular {{{2.0, 1.0}, {1.0, 3.0}}};
+
+        THEN("The solver should fail with the matching error.") {
+
+            auto notSquare {mixed_precision_solve(nonSquare, Vector<double> {2})};
+            REQUIRE(!notSquare);
+            REQUIRE(ErrorCode::NON_SQUARE_MATRIX == notSquare.error());
+
+            auto badSize {mixed_precision_solve(regular, Vector<double> {3})};
+            REQUIRE(!badSize);
+            REQUIRE(ErrorCode::INCOMPATIBLE_VECTORS == badSize.error());
+
+            auto notRegular {mixed_precision_solve(singular, Vector<double> {std::vector<double> {1.0, 2.0}})};
+            REQUIRE(!notRegular);
+            REQUIRE(ErrorCode::SINGULAR_MATRIX == notRegular.error());
+        }
+
+        THEN("A zero right hand side should give the zero solution.") {
+
+            auto result {mixed_precision_solve(regular, Vector<double> {std::vector<double> {0.0, 0.0}})};
+            REQUIRE(result);
+            REQUIRE(0.0 == result.unwrap().solution[0]);
+            REQUIRE(0.0 == result.unwrap().solution[1]);
+        }
+    }
+}
@@ -0,0 +1,173 @@
+#define CATCH_CONFIG_MAIN
+
+#include <exception>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/models.hpp>
+#include <numeric/benchmark/benchmark.hpp>
+#include <numeric/benchmark/report.hpp>
+
+using numeric::types::RunInfo;
+using numeric::benchmark::Benchmark;
+using numeric::benchmark::Comparison;
+using numeric::benchmark::ComparisonOptions;
+using numeric::benchmark::ReportOptions;
+using numeric::benchmark::compare_to_baseline;
+using numeric::benchmark::read_csv;
+using numeric::benchmark::write_csv;
+using numeric::benchmark::write_json;
+
+RunInfo makeRun(const unsigned long& inputSize, const double& meanNanos, const double& stddevNanos) {
+    RunInfo run {inputSize, 1000UL};
+    run.runTimeInMillis = meanNanos*1e-6;
+    run.nanosPerIteration.min = meanNanos - stddevNanos;
+    run.nanosPerIteration.median = meanNanos;
+    run.nanosPerIteration.p99 = meanNanos + 3*stddevNanos;
+    run.nanosPerIteration.mean = meanNanos;
+    run.nanosPerIteration.stddev = stddevNanos;
+    run.nanosPerIteration.samples = 20;
+    return run;
+}
+
+SCENARIO("Benchmark reports.") {
+
+    GIVEN("I have the results of a benchmark.") {
+
+        std::map<unsigned long, RunInfo> runs {
+            {100UL, makeRun(100UL, 1000.0, 10.0)},
+            {200UL, makeRun(200UL, 2000.5, 20.25)}
+        };
+        runs[200UL].counters.available = true;
+        runs[200UL].counters.cycles = 4000.0;
+        runs[200UL].counters.instructions = 8000.0;
+        runs[200UL].counters.cacheMisses = 3.5;
+        ReportOptions options {};
+        options.name = "max \"of\" doubles";
+        options.work = [](const unsigned long& n) {return static_cast<double>(n);};
+
+        WHEN("I write them as CSV and read them back.") {
+
+            std::stringstream stream;
+            write_csv(stream, runs, options);
+            const auto loaded {read_csv(stream)};
+
+            THEN("I should get the same run infos.") {
+
+                REQUIRE(runs == loaded);
+            }
+        }
+
+        WHEN("I write them as JSON.") {
+
+            std::stringstream stream;
+            write_json(stream, runs, options);
+            const std::string json {stream.str()};
+
+            THEN("The report should have the runs, the throughput and the build.") {
+
+                REQUIRE(std::string::npos != json.find("\"name\": \"max \\\"of\\\" doubles\""));
+                REQUIRE(std::string::npos != json.find("\"throughputUnit\": \"elements/s\""));
+                REQUIRE(std::string::npos != json.find("\"inputSize\": 200"));
+                // 100 elements per microsecond.
+                REQUIRE(std::string::npos != json.find("\"throughput\": 100000000"));
+                REQUIRE(std::string::npos != json.find("\"cacheMisses\": 3.5"));
+                REQUIRE(std::string::npos != json.find("\"compiler\": "));
+                REQUIRE(std::string::npos != json.find("\"instructionSet\": "));
+            }
+        }
+
+        WHEN("I read something that is not a report.") {
+
+            std::stringstream notCsv {"a,b,c\n1,2,3\n"};
+            std::stringstream badRow {"inputSize,iterations,meanMillis,minNanos\n1,2\n"};
+
+            THEN("I should get an exception.") {
+
+                REQUIRE_THROWS_AS(read_csv(notCsv), std::invalid_argument);
+                REQUIRE_THROWS_AS(read_csv(badRow), std::invalid_argument);
+            }
+        }
+    }
+
+    GIVEN("I have a baseline, and new results.") {
+
+        std::map<unsigned long, RunInfo> baseline {
+            {100UL, makeRun(100UL, 1000.0, 10.0)},
+            {200UL, makeRun(200UL, 2000.0, 20.0)},
+            {300UL, makeRun(300UL, 3000.0, 1000.0)},
+            {400UL, makeRun(400UL, 4000.0, 40.0)}
+        };
+        std::map<unsigned long, RunInfo> current {
+            // 20% slower, consistently.
+            {100UL, makeRun(100UL, 1200.0, 10.0)},
+            // Faster.
+            {200UL, makeRun(200UL, 1500.0, 20.0)},
+            // 20% slower, but noisy.
+            {300UL, makeRun(300UL, 3600.0, 1000.0)},
+            // 1% slower, consistently.
+            {400UL, makeRun(400UL, 4040.0, 1.0)},
+            // Not in the baseline.
+            {500UL, makeRun(500UL, 5000.0, 50.0)}
+        };
+
+        WHEN("I compare them.") {
+
+            const std::vector<Comparison> comparisons {compare_to_baseline(baseline, current)};
+
+            THEN("Only the significant slowdowns should be flagged.") {
+
+                REQUIRE(4 == comparisons.size());
+                REQUIRE(100UL == comparisons[0].inputSize);
+                REQUIRE(comparisons[0].slowdown);
+                REQUIRE(Approx(0.2) == comparisons[0].relativeChange);
+                REQUIRE_FALSE(comparisons[1].slowdown);
+                REQUIRE(comparisons[1].relativeChange < 0);
+                REQUIRE_FALSE(comparisons[2].slowdown);
+                REQUIRE_FALSE(comparisons[3].slowdown);
+            }
+        }
+
+        WHEN("I compare them with a lower threshold.") {
+
+            ComparisonOptions options {};
+            options.minRelativeSlowdown = 0.005;
+            const std::vector<Comparison> comparisons {compare_to_baseline(baseline, current, options)};
+
+            THEN("The small, consistent slowdown should be flagged too.") {
+
+                REQUIRE(comparisons[3].slowdown);
+            }
+        }
+    }
+
+    GIVEN("I have a benchmark that I run.") {
+
+        std::vector<RunInfo> inputs {{10UL, 50UL}, {20UL, 50UL}};
+        Benchmark<std::vector<double>, double, decltype(inputs.begin())> bm {
+            [](const unsigned long& n) {return std::vector<double>(n, 1.0);},
+            [](std::vector<double> input) {return input[0];},
+            inputs.begin(),
+            inputs.end()
+        };
+        bm.run();
+
+        WHEN("I save its results as a baseline and compare against it.") {
+
+            std::stringstream stream;
+            write_csv(stream, bm.get_run_infos());
+            const auto saved {read_csv(stream)};
+
+            THEN("Nothing should be flagged.") {
+
+                for (const Comparison& comparison : compare_to_baseline(saved, bm.get_run_infos())) {
+                    REQUIRE_FALSE(comparison.slowdown);
+                    REQUIRE(0.0 == comparison.relativeChange);
+                }
+            }
+        }
+    }
+}
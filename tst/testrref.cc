@@ -1,6 +1,7 @@
 #define CATCH_CONFIG_MAIN
 
 #include <catch2/catch.hpp>
+#include <numeric/types/bigint.hpp>
 #include <numeric/types/matrix.hpp>
 #include <numeric/types/models.hpp>
 #include <numeric/math/rref.hpp>
@@ -8,6 +9,7 @@
 
 #include <thesoup/types/types.hpp>
 
+using numeric::types::BigInt;
 using numeric::types::Matrix;
 using numeric::functions::rref;
 using thesoup::types::Slice;
@@ -107,3 +109,79 @@ SCENARIO("RREF algorithm.") {
 }
 
 
+
+SCENARIO("RREF with a zero precision.") {
+
+    GIVEN("I have a system whose first diagonal element is tiny, but not zero.") {
+
+        Matrix<double> testInput {{
+            {1e-20, 1.0, 1.0},
+            {1.0, 1.0, 2.0}
+        }};
+
+        WHEN("I run it through the rref algorithm with a zero precision.") {
+
+            Result<Unit, ErrorCode> result {rref(testInput, 1e-30)};
+
+            THEN("The largest element should be the pivot, and the solution should be accurate.") {
+
+                REQUIRE(result);
+                REQUIRE(isEqual(testInput, {{1.0, 0.0, 1.0}, {0.0, 1.0, 1.0}}));
+            }
+        }
+
+        WHEN("I run it through the rref algorithm with a larger zero precision.") {
+
+            testInput[1][0] = 1e-15;
+            Result<Unit, ErrorCode> result {rref(testInput, 1e-10)};
+
+            THEN("The first column should round off to zero, and be free.") {
+
+                REQUIRE_FALSE(result);
+                REQUIRE(ErrorCode::FREE_COLUMNS_RREF == result.error());
+                REQUIRE(0.0 == testInput[0][0]);
+                REQUIRE(0.0 == testInput[1][0]);
+            }
+        }
+    }
+
+    GIVEN("I have a matrix with small round off errors.") {
+
+        Matrix<double> testInput {{
+            {2.0, 4.0, 6.0},
+            {1.0, 2.0 + 1e-14, 3.0},
+            {4.0, 1.0, 5.0}
+        }};
+
+        WHEN("I run it through the rref algorithm with a zero precision.") {
+
+            Result<Unit, ErrorCode> result {rref(testInput, 1e-12)};
+
+            THEN("The errors should be rounded off, leaving an exact zero row.") {
+
+                REQUIRE_FALSE(result);
+                REQUIRE(ErrorCode::FREE_COLUMNS_RREF == result.error());
+                REQUIRE(isEqual(testInput, {{1.0, 0.0, 1.0}, {0.0, 1.0, 1.0}, {0.0, 0.0, 0.0}}));
+            }
+        }
+    }
+
+    GIVEN("I have a big integer system with a fractional solution.") {
+
+        Matrix<BigInt> testInput {{
+            {BigInt {0}, BigInt {3}, BigInt {1}},
+            {BigInt {2}, BigInt {0}, BigInt {1}}
+        }};
+
+        WHEN("I run it through the rref algorithm with a zero precision.") {
+
+            Result<Unit, ErrorCode> result {rref(testInput, 1e-9)};
+
+            THEN("Nothing should be rounded off, and the rows should be reduced fraction free.") {
+
+                REQUIRE(result);
+                REQUIRE(isEqual(testInput, {{BigInt {2}, BigInt {0}, BigInt {1}}, {BigInt {0}, BigInt {3}, BigInt {1}}}));
+            }
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#define CATCH_CONFIG_MAIN
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/models.hpp>
+#include <numeric/benchmark/benchmark.hpp>
+#include <numeric/benchmark/scaling.hpp>
+
+using numeric::types::RunInfo;
+using numeric::benchmark::Benchmark;
+using numeric::benchmark::BenchmarkOptions;
+using numeric::benchmark::ScalingBenchmark;
+using numeric::benchmark::ScalingMode;
+using numeric::benchmark::ScalingOptions;
+using numeric::benchmark::ScalingPoint;
+using numeric::benchmark::inputs_exceeding_cache;
+using numeric::benchmark::last_level_cache_bytes;
+
+SCENARIO("Scaling benchmarks.") {
+
+    GIVEN("I have a DUT that sleeps, so that it scales perfectly, and counts its calls.") {
+
+        std::vector<RunInfo> inputs {{1UL, 8UL}};
+        std::atomic<unsigned long> calls {0};
+        std::function<int(int)> dut {[&](int input) {
+            calls++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            return input;
+        }};
+        auto gen {[](const unsigned long& n) {return static_cast<int>(n);}};
+
+        WHEN("I measure strong scaling over 1, 2 and 4 threads.") {
+
+            ScalingOptions options {};
+            options.threadCounts = {4, 1, 2, 2};
+            options.warmupIterations = 1;
+            ScalingBenchmark<int, int, decltype(inputs.begin())> bm {gen, dut, inputs.begin(), inputs.end(), options};
+            bm.run();
+
+            THEN("The iterations should be split, and the speedup should follow the threads.") {
+
+                // 8 iterations for each of the 3 thread counts, and 1 warmup call per thread.
+                REQUIRE(3*8 + 1 + 2 + 4 == calls.load());
+                const std::vector<ScalingPoint>& curve {bm.get_curves().at(1UL)};
+                REQUIRE(3 == curve.size());
+                REQUIRE(1 == curve[0].threads);
+                REQUIRE(4 == curve[2].threads);
+                REQUIRE(1.0 == curve[0].speedup);
+                REQUIRE(curve[1].speedup > 1.5);
+                REQUIRE(curve[2].speedup > 2.5);
+                REQUIRE(curve[2].efficiency > 0.6);
+                REQUIRE(curve[2].wallMillis < curve[0].wallMillis);
+                REQUIRE(4 == curve[2].nanosPerIteration.samples);
+                REQUIRE(curve[2].nanosPerIteration.min >= 5e6);
+            }
+        }
+
+        WHEN("I measure weak scaling.") {
+
+            ScalingOptions options {};
+            options.threadCounts = {1, 4};
+            options.mode = ScalingMode::WEAK;
+            options.pinThreads = false;
+            ScalingBenchmark<int, int, decltype(inputs.begin())> bm {gen, dut, inputs.begin(), inputs.end(), options};
+            bm.run();
+
+            THEN("Every thread should run all the iterations, in about the same wall time.") {
+
+                REQUIRE(8 + 4*8 == calls.load());
+                const std::vector<ScalingPoint>& curve {bm.get_curves().at(1UL)};
+                REQUIRE(curve[1].speedup > 2.5);
+                REQUIRE(curve[1].efficiency > 0.6);
+            }
+        }
+    }
+
+    GIVEN("I have a DUT that throws.") {
+
+        std::vector<RunInfo> inputs {{1UL, 4UL}};
+        std::function<int(int)> dut {[](int) -> int {throw std::runtime_error("Bad input.");}};
+        ScalingOptions options {};
+        options.threadCounts = {2};
+        ScalingBenchmark<int, int, decltype(inputs.begin())> bm {
+            [](const unsigned long& n) {return static_cast<int>(n);}, dut, inputs.begin(), inputs.end(), options
+        };
+
+        THEN("The exception should reach the caller, after the threads are done.") {
+
+            REQUIRE_THROWS_AS(bm.run(), std::runtime_error);
+        }
+    }
+
+    GIVEN("I want to rotate through inputs larger than the last level cache.") {
+
+        const unsigned long poolSize {inputs_exceeding_cache(1024*1024)};
+        std::vector<RunInfo> inputs {{3UL, 20UL}};
+        std::vector<const int*> seen {};
+        std::function<int(std::shared_ptr<int>)> dut {[&](std::shared_ptr<int> input) {
+            seen.push_back(input.get());
+            return *input;
+        }};
+
+        WHEN("I use a pool of inputs.") {
+
+            BenchmarkOptions options {};
+            options.inputPoolSize = 5;
+            Benchmark<std::shared_ptr<int>, int, decltype(inputs.begin())> bm {
+                [](const unsigned long& n) {return std::make_shared<int>(static_cast<int>(n));}, dut, inputs.begin(), inputs.end(), options
+            };
+            bm.run();
+
+            THEN("The iterations should go through all of them in turn.") {
+
+                REQUIRE(poolSize >= 2*last_level_cache_bytes()/(1024*1024));
+                REQUIRE(20 == seen.size());
+                for (std::size_t i = 0; i < seen.size(); i++) {
+                    REQUIRE(seen[i] == seen[i % 5]);
+                    if (i > 0 && i < 5) {
+                        REQUIRE(seen[i] != seen[i - 1]);
+                    }
+                }
+            }
+        }
+    }
+}
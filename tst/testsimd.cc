@@ -0,0 +1,163 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/kernels/simd.hpp>
+#include <numeric/types/vector.hpp>
+
+using numeric::kernels::InstructionSet;
+using numeric::kernels::is_supported;
+using numeric::kernels::set_instruction_set;
+using numeric::kernels::vector_kernels;
+using numeric::types::Vector;
+
+template <typename T> std::vector<T> randomInts(const std::size_t& size, const unsigned int& seed) {
+    std::mt19937 mt(seed);
+    std::uniform_int_distribution<int> dist(-16, 16);
+    std::vector<T> retval(size);
+    for (auto& elem : retval) {
+        elem = static_cast<T>(dist(mt));
+    }
+    return retval;
+}
+
+// Small integers keep every partial sum exact, so all instruction sets have to agree bit for bit with the scalar loops.
+template <typename T> bool kernelsMatchScalar(const std::size_t& size) {
+    std::vector<T> a {randomInts<T>(size, 1)};
+    std::vector<T> b {randomInts<T>(size, 2)};
+    std::vector<T> expected(size);
+    std::vector<T> actual(size);
+    const auto& kernels {vector_kernels<T>()};
+
+    if (kernels.dot(a.data(), b.data(), size) != numeric::kernels::scalar::dot(a.data(), b.data(), size)) {
+        return false;
+    }
+
+    numeric::kernels::scalar::add(a.data(), b.data(), expected.data(), size);
+    kernels.add(a.data(), b.data(), actual.data(), size);
+    if (expected != actual) {
+        return false;
+    }
+
+    numeric::kernels::scalar::sub(a.data(), b.data(), expected.data(), size);
+    kernels.sub(a.data(), b.data(), actual.data(), size);
+    if (expected != actual) {
+        return false;
+    }
+
+    numeric::kernels::scalar::scale(a.data(), static_cast<T>(3), expected.data(), size);
+    kernels.scale(a.data(), static_cast<T>(3), actual.data(), size);
+    if (expected != actual) {
+        return false;
+    }
+
+    expected = b;
+    actual = b;
+    numeric::kernels::scalar::axpy(a.data(), static_cast<T>(-3), expected.data(), size);
+    kernels.axpy(a.data(), static_cast<T>(-3), actual.data(), size);
+    if (expected != actual) {
+        return false;
+    }
+
+    numeric::kernels::scalar::neg(a.data(), expected.data(), size);
+    kernels.neg(a.data(), actual.data(), size);
+    return expected == actual;
+}
+
+SCENARIO("SIMD vector kernels.") {
+
+    GIVEN("I have the list of instruction sets.") {
+
+        std::vector<InstructionSet> instructionSets {
+            InstructionSet::SCALAR,
+            InstructionSet::SSE2,
+            InstructionSet::AVX2,
+            InstructionSet::AVX512,
+            InstructionSet::NEON
+        };
+
+        WHEN("I run the kernels of every supported instruction set on inputs of various sizes.") {
+
+            THEN("The results should match the scalar loops.") {
+
+                for (const auto& instructionSet : instructionSets) {
+                    if (!is_supported(instructionSet)) {
+                        REQUIRE_FALSE(set_instruction_set(instructionSet));
+                        continue;
+                    }
+                    REQUIRE(set_instruction_set(instructionSet));
+                    REQUIRE(instructionSet == vector_kernels<double>().instructionSet);
+                    REQUIRE(instructionSet == vector_kernels<float>().instructionSet);
+
+                    for (std::size_t size = 0; size < 70; size++) {
+                        REQUIRE(kernelsMatchScalar<double>(size));
+                        REQUIRE(kernelsMatchScalar<float>(size));
+                    }
+                    REQUIRE(kernelsMatchScalar<double>(100003));
+                    REQUIRE(kernelsMatchScalar<float>(100003));
+                }
+                set_instruction_set(numeric::kernels::detected_instruction_set());
+            }
+        }
+    }
+
+    GIVEN("I have signed zeros and NaNs.") {
+
+        std::vector<double> values(37);
+        for (std::size_t i = 0; i < values.size(); i++) {
+            values[i] = i % 2 == 0? 0.0 : std::numeric_limits<double>::quiet_NaN();
+        }
+
+        WHEN("I negate them with the kernels of every supported instruction set.") {
+
+            THEN("Every sign bit should be flipped.") {
+
+                for (const auto& instructionSet : {InstructionSet::SCALAR, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512, InstructionSet::NEON}) {
+                    if (!set_instruction_set(instructionSet)) {
+                        continue;
+                    }
+                    std::vector<double> negated(values.size());
+                    vector_kernels<double>().neg(values.data(), negated.data(), values.size());
+                    for (std::size_t i = 0; i < values.size(); i++) {
+                        REQUIRE(std::signbit(values[i]) != std::signbit(negated[i]));
+                    }
+                }
+                set_instruction_set(numeric::kernels::detected_instruction_set());
+            }
+        }
+    }
+
+    GIVEN("I have 2 large double vectors.") {
+
+        Vector<double> v1 {randomInts<double>(200001, 3)};
+        Vector<double> v2 {randomInts<double>(200001, 4)};
+
+        WHEN("I use the vector operators.") {
+
+            Vector<double> sum {v1 + v2};
+            Vector<double> diff {v1 - v2};
+            Vector<double> neg {-v1};
+            double dot {v1 * v2};
+            double mod {v1.mod()};
+
+            THEN("The results should be the same as element wise computation.") {
+
+                double expectedDot {0.0};
+                double expectedMod {0.0};
+                for (std::size_t i = 0; i < v1.size(); i++) {
+                    REQUIRE(v1[i] + v2[i] == sum[i]);
+                    REQUIRE(v1[i] - v2[i] == diff[i]);
+                    REQUIRE(-v1[i] == neg[i]);
+                    expectedDot += v1[i]*v2[i];
+                    expectedMod += v1[i]*v1[i];
+                }
+                REQUIRE(expectedDot == dot);
+                REQUIRE(expectedMod == mod);
+            }
+        }
+    }
+}
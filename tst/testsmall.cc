@@ -0,0 +1,190 @@
+#define CATCH_CONFIG_MAIN
+
+#include <exception>
+#include <type_traits>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/smallvector.hpp>
+#include <numeric/types/smallmatrix.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/plane.hpp>
+#include <numeric/math/vectorspaces.hpp>
+
+using numeric::types::SmallVector;
+using numeric::types::SmallMatrix;
+using numeric::types::Vector;
+using numeric::types::Matrix;
+using numeric::types::Plane;
+using numeric::functions::cross;
+using numeric::functions::cosine_angle;
+using numeric::functions::is_normal_to_plane;
+
+// Everything has to be usable in constant expressions.
+constexpr SmallVector<int, 3> X {1, 0, 0};
+constexpr SmallVector<int, 3> Y {0, 1, 0};
+static_assert(cross(X, Y) == SmallVector<int, 3> {0, 0, 1}, "Cross product should be constexpr.");
+static_assert(2*X + Y - X == SmallVector<int, 3> {1, 1, 0}, "Arithmetic should be constexpr.");
+static_assert(1 == X*X, "Dot product should be constexpr.");
+static_assert(SmallMatrix<int, 2, 2>::identity()*SmallVector<int, 2> {3, 4} == SmallVector<int, 2> {3, 4}, "Matrix product should be constexpr.");
+static_assert(std::is_trivially_copyable<SmallVector<double, 3>>::value, "Small vectors should be trivially copyable.");
+static_assert(sizeof(SmallMatrix<double, 3, 3>) == 9*sizeof(double), "Small matrices should have no overhead.");
+
+SCENARIO("Small vectors.") {
+
+    GIVEN("I have some small vectors.") {
+
+        SmallVector<double, 3> v1 {1.0, 2.0, 3.0};
+        SmallVector<double, 3> v2 {4.0, 5.0, 6.0};
+
+        WHEN("I do arithmetic with them.") {
+
+            SmallVector<double, 3> sum {v1 + v2};
+            SmallVector<double, 3> diff {v2 - v1};
+            SmallVector<double, 3> scaled {2.0*v1};
+            SmallVector<double, 3> negated {-v1};
+            SmallVector<double, 3> copy {v1};
+            copy.scale(3.0);
+
+            THEN("The results should be as expected.") {
+
+                REQUIRE(SmallVector<double, 3> {5.0, 7.0, 9.0} == sum);
+                REQUIRE(SmallVector<double, 3> {3.0, 3.0, 3.0} == diff);
+                REQUIRE(SmallVector<double, 3> {2.0, 4.0, 6.0} == scaled);
+                REQUIRE(SmallVector<double, 3> {-1.0, -2.0, -3.0} == negated);
+                REQUIRE(SmallVector<double, 3> {3.0, 6.0, 9.0} == copy);
+                REQUIRE(32.0 == v1*v2);
+                REQUIRE(14.0 == v1.mod());
+                REQUIRE(3 == v1.size());
+            }
+        }
+
+        WHEN("I index them out of range.") {
+
+            THEN("I should get an out of range error.") {
+
+                REQUIRE(3.0 == v1[2]);
+                REQUIRE_THROWS_AS(v1[3], std::out_of_range);
+            }
+        }
+
+        WHEN("I convert them to and from dynamic vectors.") {
+
+            Vector<double> dynamic {static_cast<Vector<double>>(v1)};
+            Vector<double> wrongSize {{1.0, 2.0}};
+
+            THEN("The elements should be preserved, and a dimension mismatch should be an error.") {
+
+                REQUIRE(3 == dynamic.size());
+                REQUIRE(2.0 == dynamic[1]);
+                REQUIRE(v1 == SmallVector<double, 3> {dynamic});
+                REQUIRE_THROWS_AS((SmallVector<double, 3> {wrongSize}), std::invalid_argument);
+                REQUIRE_FALSE(std::is_convertible<SmallVector<double, 3>, Vector<double>>::value);
+            }
+        }
+    }
+}
+
+SCENARIO("Small matrices.") {
+
+    GIVEN("I have some small matrices.") {
+
+        SmallMatrix<double, 2, 3> a {{
+            {1, 2, 3},
+            {4, 5, 6}
+        }};
+        SmallMatrix<double, 3, 2> b {{
+            {7, 8},
+            {9, 10},
+            {11, 12}
+        }};
+
+        WHEN("I multiply them, and multiply with vectors.") {
+
+            SmallMatrix<double, 2, 2> product {a*b};
+            SmallVector<double, 2> column {a*SmallVector<double, 3> {1, 1, 1}};
+            SmallVector<double, 3> row {SmallVector<double, 2> {1, 1}*a};
+
+            THEN("The results should match the dynamic matrix.") {
+
+                Matrix<double> expected {a.to_matrix()*b.to_matrix()};
+                for (std::size_t i = 0; i < 2; i++) {
+                    for (std::size_t j = 0; j < 2; j++) {
+                        REQUIRE(expected[i][j] == product[i][j]);
+                    }
+                }
+                REQUIRE(SmallVector<double, 2> {6, 15} == column);
+                REQUIRE(SmallVector<double, 3> {5, 7, 9} == row);
+            }
+        }
+
+        WHEN("I transpose, add and scale them.") {
+
+            SmallMatrix<double, 3, 2> transposed {a.transpose()};
+            SmallMatrix<double, 3, 2> combined {transposed + 2.0*b - -b};
+
+            THEN("The results should be as expected.") {
+
+                REQUIRE(SmallMatrix<double, 3, 2> {{{1, 4}, {2, 5}, {3, 6}}} == transposed);
+                REQUIRE(SmallMatrix<double, 3, 2> {{{22, 28}, {29, 35}, {36, 42}}} == combined);
+                REQUIRE(SmallVector<double, 3> {3, 3, 3} == transposed.column(1) - transposed.column(0));
+            }
+        }
+
+        WHEN("I convert them from dynamic matrices.") {
+
+            Matrix<double> dynamic {{{1, 2, 3}, {4, 5, 6}}};
+
+            THEN("The elements should be preserved, and a dimension mismatch should be an error.") {
+
+                REQUIRE(a == SmallMatrix<double, 2, 3> {dynamic});
+                REQUIRE_THROWS_AS((SmallMatrix<double, 3, 2> {dynamic}), std::invalid_argument);
+                REQUIRE_THROWS_AS(a[2], std::out_of_range);
+            }
+        }
+    }
+}
+
+SCENARIO("Geometry with small vectors.") {
+
+    GIVEN("I have a plane built from small vectors.") {
+
+        SmallVector<double, 3> normal {-4, -3, 9};
+        SmallVector<double, 3> point {-5, 3, -3};
+        Plane<double> plane {normal, point};
+
+        WHEN("I query it.") {
+
+            auto [a, b, c, k] = plane.get_coefficients();
+            Plane<double> copy {plane};
+            Plane<double> assigned {1, 1, 1, 1};
+            assigned = copy;
+
+            THEN("It should hold the normal, the point and the coefficients, and be copyable.") {
+
+                REQUIRE(normal == plane.get_small_normal());
+                REQUIRE(point == copy.get_small_point());
+                REQUIRE(Vector<double> {{-4, -3, 9}} == copy.get_normal());
+                REQUIRE(Vector<double> {{-5, 3, -3}} == plane.get_point());
+                REQUIRE(Vector<double> {{-5, 3, -3}} == assigned.get_point());
+                REQUIRE(normal == assigned.get_small_normal());
+                REQUIRE(k == a*point[0] + b*point[1] + c*point[2]);
+            }
+        }
+
+        WHEN("I use the small vector overloads of the vector space functions.") {
+
+            SmallVector<double, 3> u {1, 0, 0};
+            SmallVector<double, 3> v {0, 2, 0};
+
+            THEN("They should give the same answers as the dynamic versions.") {
+
+                REQUIRE(true == is_normal_to_plane(plane, SmallVector<double, 3> {-8, -6, 18}));
+                REQUIRE(false == is_normal_to_plane(plane, u));
+                REQUIRE(SmallVector<double, 3> {0, 0, 2} == cross(u, v));
+                REQUIRE(0.0 == cosine_angle(u, v));
+                REQUIRE(is_normal_to_plane(plane, Vector<double> {{-8, -6, 18}}).unwrap());
+            }
+        }
+    }
+}
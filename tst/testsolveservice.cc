@@ -0,0 +1,229 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cmath>
+#include <future>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/math/errors.hpp>
+#include <numeric/service/solveservice.hpp>
+#include <numeric/types/bigint.hpp>
+#include <numeric/types/fraction.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/vector.hpp>
+
+using numeric::service::SolveService;
+using numeric::service::SolveServiceOptions;
+using numeric::types::BigInt;
+using numeric::types::Fraction;
+using numeric::types::Matrix;
+using numeric::types::Vector;
+using numeric::ErrorCode;
+
+// A random system with the solution (1, 2, ..., n).
+Matrix<double> systemWithSolution(const std::size_t& n, std::mt19937& generator) {
+    std::uniform_real_distribution<double> distribution {-1.0, 1.0};
+    Matrix<double> retval {n, n + 1};
+    for (std::size_t i = 0; i < n; i++) {
+        double rhs {0.0};
+        for (std::size_t j = 0; j < n; j++) {
+            retval[i][j] = distribution(generator) + (i == j ? static_cast<double>(n) : 0.0);
+            rhs += retval[i][j]*static_cast<double>(j + 1);
+        }
+        retval[i][n] = rhs;
+    }
+    return retval;
+}
+
+bool hasSolution(const Vector<double>& solution, const std::size_t& n) {
+    if (solution.size() != n) {
+        return false;
+    }
+    for (std::size_t j = 0; j < n; j++) {
+        if (std::fabs(static_cast<double>(j + 1) - solution[j]) > 1e-9) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SCENARIO("Solve service.") {
+
+    std::mt19937 generator {7};
+
+    GIVEN("I have a service with one worker.") {
+
+        SolveServiceOptions options {};
+        options.numThreads = 1;
+        SolveService<double> service {options};
+        REQUIRE(1 == service.get_num_threads());
+
+        WHEN("I submit a burst of small systems at once.") {
+
+            std::vector<Matrix<double>> systems;
+            for (std::size_t s = 0; s < 500; s++) {
+                systems.push_back(systemWithSolution(3, generator));
+            }
+            auto futures {service.submit(std::move(systems))};
+
+            THEN("They should be solved in one batch.") {
+
+                REQUIRE(500 == futures.size());
+                for (auto& future : futures) {
+                    auto result {future.get()};
+                    REQUIRE(result);
+                    REQUIRE(hasSolution(result.unwrap(), 3));
+                }
+                REQUIRE(500 == service.get_solved());
+                REQUIRE(1 == service.get_batches());
+            }
+        }
+
+        WHEN("I submit systems of different shapes and sizes at once.") {
+
+            std::vector<Matrix<double>> systems;
+            systems.push_back(systemWithSolution(2, generator));
+            systems.push_back(systemWithSolution(20, generator));
+            systems.push_back(systemWithSolution(3, generator));
+            systems.push_back(systemWithSolution(2, generator));
+            systems.push_back(Matrix<double> {{{1.0, 2.0, 3.0}, {2.0, 4.0, 7.0}}});
+            auto futures {service.submit(std::move(systems))};
+
+            THEN("Every system should get its own result.") {
+
+                const std::vector<std::size_t> sizes {2, 20, 3, 2};
+                for (std::size_t s = 0; s < sizes.size(); s++) {
+                    auto result {futures[s].get()};
+                    REQUIRE(result);
+                    REQUIRE(hasSolution(result.unwrap(), sizes[s]));
+                }
+                auto inconsistent {futures[4].get()};
+                REQUIRE(!inconsistent);
+                REQUIRE(ErrorCode::NO_SOLUTIONS == inconsistent.error());
+
+                // The two 2x3 systems and the inconsistent one share a shape; the others are alone.
+                REQUIRE(5 == service.get_solved());
+                REQUIRE(1 == service.get_batches());
+            }
+        }
+
+        WHEN("I submit systems at once, and one of them has no right hand side column.") {
+
+            std::vector<Matrix<double>> systems;
+            systems.push_back(Matrix<double> {{{1.0, 1.0, 3.0}, {1.0, -1.0, 1.0}}});
+            systems.push_back(Matrix<double> {1, 0});
+
+            THEN("Nothing should be queued, and the systems should be left as they were.") {
+
+                REQUIRE_THROWS_AS(service.submit(std::move(systems)), std::invalid_argument);
+                REQUIRE(2 == systems.size());
+                REQUIRE(2 == systems[0].getRows());
+                REQUIRE(3 == systems[0].getCols());
+                REQUIRE(3.0 == systems[0][0][2]);
+                REQUIRE(0 == service.get_solved());
+            }
+        }
+    }
+
+    GIVEN("I have a service with several workers.") {
+
+        SolveServiceOptions options {};
+        options.numThreads = 4;
+        SolveService<double> service {options};
+
+        WHEN("Several clients submit systems concurrently.") {
+
+            std::vector<std::vector<Matrix<double>>> inputs(4);
+            for (auto& input : inputs) {
+                for (std::size_t s = 0; s < 200; s++) {
+                    input.push_back(systemWithSolution(1 + s%5, generator));
+                }
+            }
+            std::vector<std::vector<std::future<SolveService<double>::SolveResult>>> outputs(4);
+            std::vector<std::thread> clients;
+            for (std::size_t c = 0; c < 4; c++) {
+                clients.emplace_back([&, c]() {
+                    for (auto& system : inputs[c]) {
+                        outputs[c].push_back(service.submit(std::move(system)));
+                    }
+                });
+            }
+            for (auto& client : clients) {
+                client.join();
+            }
+
+            THEN("Every client should get the right solutions.") {
+
+                for (std::size_t c = 0; c < 4; c++) {
+                    REQUIRE(200 == outputs[c].size());
+                    for (std::size_t s = 0; s < 200; s++) {
+                        auto result {outputs[c][s].get()};
+                        REQUIRE(result);
+                        REQUIRE(hasSolution(result.unwrap(), 1 + s%5));
+                    }
+                }
+                REQUIRE(800 == service.get_solved());
+            }
+        }
+    }
+
+    GIVEN("I have a service for exact systems.") {
+
+        SolveService<Fraction> service {};
+
+        THEN("Systems should be solved one by one with gauss_jordan.") {
+
+            auto future {service.submit(Matrix<Fraction> {{{Fraction {1}, Fraction {1}, Fraction {3}}, {Fraction {1}, Fraction {-1}, Fraction {1}}}})};
+            auto underdetermined {service.submit(Matrix<Fraction> {{{Fraction {1}, Fraction {1}, Fraction {3}}}})};
+            auto result {future.get()};
+            REQUIRE(result);
+            REQUIRE(2.0 == static_cast<double>(result.unwrap()[0]));
+            REQUIRE(1.0 == static_cast<double>(result.unwrap()[1]));
+            auto failed {underdetermined.get()};
+            REQUIRE(!failed);
+            REQUIRE(ErrorCode::UNDERDETERMINED_SYSTEM == failed.error());
+            REQUIRE(0 == service.get_batches());
+        }
+    }
+
+    GIVEN("I have a service for integer systems.") {
+
+        SolveService<long> service {};
+
+        THEN("The solutions should be divided by the pivots, and fail if they are not integral.") {
+
+            auto integral {service.submit(Matrix<long> {{{2, 1, 5}, {3, 2, 8}}})};
+            auto fractional {service.submit(Matrix<long> {{{2, 4, 1}, {3, 1, 2}}})};
+            auto result {integral.get()};
+            REQUIRE(result);
+            REQUIRE(2 == result.unwrap()[0]);
+            REQUIRE(1 == result.unwrap()[1]);
+            auto failed {fractional.get()};
+            REQUIRE(!failed);
+            REQUIRE(ErrorCode::NON_INTEGRAL_SOLUTION == failed.error());
+        }
+    }
+
+    GIVEN("I have a service for big integer systems, with a zero precision.") {
+
+        SolveServiceOptions options {};
+        options.zeroPrecision = 1e-9;
+        SolveService<BigInt> service {options};
+
+        THEN("The solutions should be divided by the pivots, and fail if they are not integral.") {
+
+            auto integral {service.submit(Matrix<BigInt> {{{BigInt {2}, BigInt {1}, BigInt {5}}, {BigInt {3}, BigInt {2}, BigInt {8}}}})};
+            auto fractional {service.submit(Matrix<BigInt> {{{BigInt {2}, BigInt {4}, BigInt {1}}, {BigInt {3}, BigInt {1}, BigInt {2}}}})};
+            auto result {integral.get()};
+            REQUIRE(result);
+            REQUIRE(BigInt {2} == result.unwrap()[0]);
+            REQUIRE(BigInt {1} == result.unwrap()[1]);
+            auto failed {fractional.get()};
+            REQUIRE(!failed);
+            REQUIRE(ErrorCode::NON_INTEGRAL_SOLUTION == failed.error());
+        }
+    }
+}
@@ -0,0 +1,366 @@
+#define CATCH_CONFIG_MAIN
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/sparsematrix.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/math/errors.hpp>
+#include <numeric/math/sparse.hpp>
+#include <numeric/parallel/threadpool.hpp>
+
+#include <thesoup/types/types.hpp>
+
+using numeric::types::Matrix;
+using numeric::types::SparseLayout;
+using numeric::types::SparseMatrix;
+using numeric::types::Triplet;
+using numeric::types::Vector;
+using numeric::functions::SparseLUDecomposition;
+using numeric::functions::parallel_multiply;
+using numeric::functions::sparse_gauss_jordan;
+using numeric::parallel::ThreadPool;
+using thesoup::types::Result;
+using numeric::ErrorCode;
+
+bool isClose(const double& lhs, const double& rhs) {
+    return std::fabs(lhs - rhs) < 1e-9;
+}
+
+// A diagonally dominant banded matrix with a few random far off diagonal elements.
+SparseMatrix<double> randomSparse(const std::size_t& n, const unsigned int& seed, const SparseLayout& layout) {
+    std::mt19937 mt(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::uniform_int_distribution<std::size_t> index(0, n - 1);
+    std::vector<Triplet<double>> triplets {};
+    for (std::size_t i = 0; i < n; i++) {
+        triplets.push_back(Triplet<double> {i, i, 8.0 + dist(mt)});
+        if (i + 1 < n) {
+            triplets.push_back(Triplet<double> {i, i + 1, dist(mt)});
+            triplets.push_back(Triplet<double> {i + 1, i, dist(mt)});
+        }
+        triplets.push_back(Triplet<double> {i, index(mt), dist(mt)});
+    }
+    return SparseMatrix<double> {n, n, std::move(triplets), layout};
+}
+
+Vector<double> randomVector(const std::size_t& n, const unsigned int& seed) {
+    std::mt19937 mt(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    Vector<double> vec {n};
+    for (std::size_t i = 0; i < n; i++) {
+        vec[i] = dist(mt);
+    }
+    return vec;
+}
+
+SCENARIO("Sparse matrix construction and conversion.") {
+
+    GIVEN("I have a dense matrix with mostly zeros.") {
+
+        Matrix<double> dense {{
+            {0, 2, 0, 0},
+            {1, 0, 0, 3},
+            {0, 0, 0, 0}
+        }};
+
+        WHEN("I convert it to CSR and CSC and back.") {
+
+            SparseMatrix<double> csr {dense};
+            SparseMatrix<double> csc {dense, SparseLayout::CSC};
+
+            THEN("Only the non zero elements should be stored, and the dense copies should match.") {
+
+                REQUIRE(3 == csr.nonZeros());
+                REQUIRE(3 == csc.nonZeros());
+                REQUIRE(std::vector<std::size_t> {0, 1, 3, 3} == csr.get_offsets());
+                REQUIRE(std::vector<std::size_t> {1, 0, 3} == csr.get_indices());
+                REQUIRE(std::vector<std::size_t> {0, 1, 2, 2, 3} == csc.get_offsets());
+                REQUIRE(std::vector<std::size_t> {1, 0, 1} == csc.get_indices());
+                for (std::size_t i = 0; i < 3; i++) {
+                    for (std::size_t j = 0; j < 4; j++) {
+                        REQUIRE(dense[i][j] == csr.at(i, j));
+                        REQUIRE(dense[i][j] == csc.at(i, j));
+                        REQUIRE(dense[i][j] == csr.to_dense()[i][j]);
+                        REQUIRE(dense[i][j] == csc.to_dense()[i][j]);
+                    }
+                }
+            }
+        }
+
+        WHEN("I change the layout of a CSR matrix.") {
+
+            SparseMatrix<double> csr {dense};
+            SparseMatrix<double> csc {csr.with_layout(SparseLayout::CSC)};
+
+            THEN("It should be the same as converting the dense matrix directly.") {
+
+                REQUIRE(SparseLayout::CSC == csc.get_layout());
+                REQUIRE(SparseMatrix<double> {dense, SparseLayout::CSC}.get_offsets() == csc.get_offsets());
+                REQUIRE(SparseMatrix<double> {dense, SparseLayout::CSC}.get_indices() == csc.get_indices());
+                REQUIRE(SparseMatrix<double> {dense, SparseLayout::CSC}.get_values() == csc.get_values());
+            }
+        }
+
+        WHEN("I access an element out of range.") {
+
+            SparseMatrix<double> csr {dense};
+
+            THEN("An exception should be thrown.") {
+
+                REQUIRE_THROWS_AS(csr.at(3, 0), std::out_of_range);
+                REQUIRE_THROWS_AS(csr.at(0, 4), std::out_of_range);
+            }
+        }
+    }
+
+    GIVEN("I have unordered triplets with duplicates and cancelling elements.") {
+
+        std::vector<Triplet<double>> triplets {
+            {1, 1, 2.0},
+            {0, 2, 1.0},
+            {1, 1, 3.0},
+            {0, 0, 4.0},
+            {0, 2, -1.0}
+        };
+
+        WHEN("I build a sparse matrix from them.") {
+
+            SparseMatrix<double> csr {2, 3, triplets};
+
+            THEN("Duplicates should be summed, and zero sums dropped.") {
+
+                REQUIRE(2 == csr.nonZeros());
+                REQUIRE(4.0 == csr.at(0, 0));
+                REQUIRE(0.0 == csr.at(0, 2));
+                REQUIRE(5.0 == csr.at(1, 1));
+            }
+        }
+
+        WHEN("I add an element out of range.") {
+
+            triplets.push_back(Triplet<double> {2, 0, 1.0});
+
+            THEN("An exception should be thrown.") {
+
+                REQUIRE_THROWS_AS((SparseMatrix<double> {2, 3, triplets}), std::out_of_range);
+            }
+        }
+    }
+}
+
+SCENARIO("Sparse matrix vector product.") {
+
+    GIVEN("I have a random sparse matrix in both layouts, and a vector.") {
+
+        const std::size_t n {2000};
+        SparseMatrix<double> csr {randomSparse(n, 7, SparseLayout::CSR)};
+        SparseMatrix<double> csc {csr.with_layout(SparseLayout::CSC)};
+        Matrix<double> dense {csr.to_dense()};
+        Vector<double> x {randomVector(n, 11)};
+
+        WHEN("I multiply them serially and in parallel.") {
+
+            Vector<double> expected {dense * x};
+            ThreadPool pool {4};
+
+            THEN("Every product should match the dense product.") {
+
+                Vector<double> serialCsr {csr * x};
+                Vector<double> serialCsc {csc * x};
+                Vector<double> parallelCsr {parallel_multiply(csr, x, pool)};
+                Vector<double> parallelCsc {parallel_multiply(csc, x, pool)};
+                for (std::size_t i = 0; i < n; i++) {
+                    REQUIRE(isClose(expected[i], serialCsr[i]));
+                    REQUIRE(isClose(expected[i], serialCsc[i]));
+                    REQUIRE(isClose(expected[i], parallelCsr[i]));
+                    REQUIRE(isClose(expected[i], parallelCsc[i]));
+                }
+            }
+        }
+
+        WHEN("I multiply with a vector of the wrong dimension.") {
+
+            Vector<double> y {n + 1};
+            ThreadPool pool {2};
+
+            THEN("An exception should be thrown.") {
+
+                REQUIRE_THROWS_AS(csr * y, std::invalid_argument);
+                REQUIRE_THROWS_AS(parallel_multiply(csc, y, pool), std::invalid_argument);
+            }
+        }
+    }
+}
+
+SCENARIO("Sparse LU decomposition.") {
+
+    GIVEN("I have a non singular matrix with a zero leading element.") {
+
+        SparseMatrix<double> a {Matrix<double> {{
+            {0, 2, 1},
+            {1, 1, 1},
+            {2, 1, 3}
+        }}, SparseLayout::CSC};
+
+        WHEN("I factor it, and solve for a right hand side.") {
+
+            auto lu {SparseLUDecomposition<double>::factor(a)};
+            Vector<double> b {{7, 6, 13}};
+
+            THEN("The solution and the determinant should be correct.") {
+
+                REQUIRE(lu);
+                Result<Vector<double>, ErrorCode> x {lu.unwrap().solve(b)};
+                REQUIRE(x);
+                REQUIRE(isClose(1.0, x.unwrap()[0]));
+                REQUIRE(isClose(2.0, x.unwrap()[1]));
+                REQUIRE(isClose(3.0, x.unwrap()[2]));
+                REQUIRE(isClose(-3.0, lu.unwrap().determinant()));
+            }
+        }
+
+        WHEN("I try to solve for a right hand side of the wrong dimension.") {
+
+            auto lu {SparseLUDecomposition<double>::factor(a)};
+            Vector<double> b {{1, 2}};
+
+            THEN("An INCOMPATIBLE_VECTORS error should be returned.") {
+
+                REQUIRE(lu);
+                Result<Vector<double>, ErrorCode> x {lu.unwrap().solve(b)};
+                REQUIRE(!x);
+                REQUIRE(ErrorCode::INCOMPATIBLE_VECTORS == x.error());
+            }
+        }
+    }
+
+    GIVEN("I have a large random sparse matrix.") {
+
+        const std::size_t n {3000};
+        SparseMatrix<double> a {randomSparse(n, 3, SparseLayout::CSR)};
+        Vector<double> b {randomVector(n, 5)};
+
+        WHEN("I factor it and solve.") {
+
+            auto lu {SparseLUDecomposition<double>::factor(a)};
+
+            THEN("The residual should be tiny, and L*U should be P*A.") {
+
+                REQUIRE(lu);
+                Result<Vector<double>, ErrorCode> x {lu.unwrap().solve(b)};
+                REQUIRE(x);
+                Vector<double> residual {a * x.unwrap()};
+                for (std::size_t i = 0; i < n; i++) {
+                    REQUIRE(isClose(b[i], residual[i]));
+                }
+                const std::vector<std::size_t>& perm {lu.unwrap().get_row_permutation()};
+                for (std::size_t col = 0; col < n; col += 97) {
+                    Vector<double> unit {n};
+                    for (std::size_t i = 0; i < n; i++) {
+                        unit[i] = i == col? 1.0 : 0.0;
+                    }
+                    Vector<double> lu_col {lu.unwrap().get_l() * (lu.unwrap().get_u() * unit)};
+                    for (std::size_t i = 0; i < n; i++) {
+                        REQUIRE(isClose(a.at(perm[i], col), lu_col[i]));
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN("I have a singular and a non square matrix.") {
+
+        SparseMatrix<double> singular {Matrix<double> {{
+            {1, 2, 0},
+            {2, 4, 0},
+            {0, 0, 1}
+        }}};
+        SparseMatrix<double> nonSquare {Matrix<double> {{
+            {1, 2, 0},
+            {0, 4, 0}
+        }}};
+
+        WHEN("I try to factor them.") {
+
+            auto singularLu {SparseLUDecomposition<double>::factor(singular)};
+            auto nonSquareLu {SparseLUDecomposition<double>::factor(nonSquare)};
+
+            THEN("SINGULAR_MATRIX and NON_SQUARE_MATRIX errors should be returned.") {
+
+                REQUIRE(!singularLu);
+                REQUIRE(ErrorCode::SINGULAR_MATRIX == singularLu.error());
+                REQUIRE(!nonSquareLu);
+                REQUIRE(ErrorCode::NON_SQUARE_MATRIX == nonSquareLu.error());
+            }
+        }
+    }
+}
+
+SCENARIO("Sparse gauss jordan.") {
+
+    GIVEN("I have an over determined, consistent system.") {
+
+        SparseMatrix<double> a {Matrix<double> {{
+            {1, 0, 2},
+            {0, 3, 0},
+            {1, 3, 2},
+            {0, 0, 1}
+        }}};
+        Vector<double> b {{7, 6, 13, 3}};
+
+        WHEN("I solve it.") {
+
+            Result<Vector<double>, ErrorCode> x {sparse_gauss_jordan(a, b)};
+
+            THEN("The solution should be correct.") {
+
+                REQUIRE(x);
+                REQUIRE(isClose(1.0, x.unwrap()[0]));
+                REQUIRE(isClose(2.0, x.unwrap()[1]));
+                REQUIRE(isClose(3.0, x.unwrap()[2]));
+            }
+        }
+    }
+
+    GIVEN("I have inconsistent, free and under determined systems.") {
+
+        SparseMatrix<double> inconsistent {Matrix<double> {{
+            {1, 1},
+            {2, 2}
+        }}};
+        SparseMatrix<double> free {Matrix<double> {{
+            {1, 1, 0},
+            {2, 2, 0},
+            {0, 0, 1}
+        }}};
+        SparseMatrix<double> under {Matrix<double> {{
+            {1, 1, 0},
+            {0, 0, 1}
+        }}};
+
+        WHEN("I try to solve them.") {
+
+            Result<Vector<double>, ErrorCode> noSolutions {sparse_gauss_jordan(inconsistent, Vector<double> {{1, 3}})};
+            Result<Vector<double>, ErrorCode> infinite {sparse_gauss_jordan(free, Vector<double> {{1, 2, 3}})};
+            Result<Vector<double>, ErrorCode> underdetermined {sparse_gauss_jordan(under, Vector<double> {{1, 2}})};
+            Result<Vector<double>, ErrorCode> incompatible {sparse_gauss_jordan(free, Vector<double> {{1, 2}})};
+
+            THEN("The same error codes as gauss_jordan should be returned.") {
+
+                REQUIRE(!noSolutions);
+                REQUIRE(ErrorCode::NO_SOLUTIONS == noSolutions.error());
+                REQUIRE(!infinite);
+                REQUIRE(ErrorCode::INFINITE_SOLUTIONS == infinite.error());
+                REQUIRE(!underdetermined);
+                REQUIRE(ErrorCode::UNDERDETERMINED_SYSTEM == underdetermined.error());
+                REQUIRE(!incompatible);
+                REQUIRE(ErrorCode::INCOMPATIBLE_VECTORS == incompatible.error());
+            }
+        }
+    }
+}
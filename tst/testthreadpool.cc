@@ -0,0 +1,115 @@
+#define CATCH_CONFIG_MAIN
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/parallel/threadpool.hpp>
+
+using numeric::parallel::ThreadPool;
+
+SCENARIO("Thread pool.") {
+
+    GIVEN("I have a thread pool with 4 threads.") {
+
+        ThreadPool pool {4};
+
+        WHEN("I run a parallel for over a range, many times.") {
+
+            std::vector<int> hits(1000, 0);
+            std::atomic<std::size_t> chunks {0};
+            for (int repeat = 0; repeat < 50; repeat++) {
+                pool.parallel_for(0, hits.size(), [&](const std::size_t& begin, const std::size_t& end) {
+                    chunks++;
+                    for (std::size_t i = begin; i < end; i++) {
+                        hits[i]++;
+                    }
+                });
+            }
+
+            THEN("Every index should have been visited exactly once per run, in at most 4 chunks.") {
+
+                REQUIRE(4 == pool.get_num_threads());
+                for (const int& hit : hits) {
+                    REQUIRE(50 == hit);
+                }
+                REQUIRE(chunks.load() <= 200);
+            }
+        }
+
+        WHEN("I run a parallel for with a large grain.") {
+
+            std::atomic<std::size_t> chunks {0};
+            pool.parallel_for(10, 20, [&](const std::size_t&, const std::size_t&) {
+                chunks++;
+            }, 64);
+
+            THEN("It should run as a single chunk.") {
+
+                REQUIRE(1 == chunks.load());
+            }
+        }
+
+        WHEN("I run a parallel for with a grain of 0.") {
+
+            std::vector<int> hits(2, 0);
+            std::atomic<std::size_t> chunks {0};
+            pool.parallel_for(0, hits.size(), [&](const std::size_t& begin, const std::size_t& end) {
+                chunks++;
+                for (std::size_t i = begin; i < end; i++) {
+                    hits[i]++;
+                }
+            }, 0);
+
+            THEN("It should behave like a grain of 1.") {
+
+                REQUIRE(2 == chunks.load());
+                REQUIRE(1 == hits[0]);
+                REQUIRE(1 == hits[1]);
+            }
+        }
+
+        WHEN("A chunk throws.") {
+
+            THEN("The exception should be rethrown to the caller, and the pool should stay usable.") {
+
+                REQUIRE_THROWS_AS(
+                    pool.parallel_for(0, 100, [](const std::size_t& begin, const std::size_t&) {
+                        if (begin == 0) {
+                            throw std::runtime_error("Boom.");
+                        }
+                    }),
+                    std::runtime_error);
+
+                std::atomic<std::size_t> sum {0};
+                pool.parallel_for(0, 100, [&](const std::size_t& begin, const std::size_t& end) {
+                    sum += end - begin;
+                });
+                REQUIRE(100 == sum.load());
+            }
+        }
+    }
+
+    GIVEN("I have a single threaded pool.") {
+
+        ThreadPool pool {1};
+
+        WHEN("I run a parallel for.") {
+
+            std::size_t calls {0};
+            pool.parallel_for(0, 100, [&](const std::size_t& begin, const std::size_t& end) {
+                calls++;
+                REQUIRE(0 == begin);
+                REQUIRE(100 == end);
+            });
+
+            THEN("It should run inline, as one chunk.") {
+
+                REQUIRE(1 == pool.get_num_threads());
+                REQUIRE(1 == calls);
+            }
+        }
+    }
+}
@@ -4,6 +4,7 @@
 #include <exception>
 #include <vector>
 #include <iostream>
+#include <thread>
 
 #include <catch2/catch.hpp>
 #include <numeric/types/vector.hpp>
@@ -199,3 +200,108 @@ SCENARIO("Vector operations.") {
     }
 }
 
+SCENARIO("Vector mod cache.") {
+
+    GIVEN("I have a vector, and a const reference to it.") {
+
+        Vector<double> v1 {{3,4}};
+        const Vector<double>& ref {v1};
+        REQUIRE(25 == ref.mod());
+
+        WHEN("I modify it through the index operator.") {
+
+            v1[0] = 0;
+
+            THEN("The const mod should see the change.") {
+
+                REQUIRE(16 == ref.mod());
+            }
+        }
+
+        WHEN("I modify it through the unchecked accessors.") {
+
+            v1.atUnchecked(1) = 0;
+            REQUIRE(9 == ref.mod());
+            v1.data()[0] = 1;
+            REQUIRE(1 == ref.mod());
+            *v1.begin() = 2;
+
+            THEN("Every change should be seen.") {
+
+                REQUIRE(4 == ref.mod());
+            }
+        }
+
+        WHEN("I scale it, or assign to it.") {
+
+            v1.scale(2);
+            REQUIRE(100 == ref.mod());
+            Vector<double> other {{1,1}};
+            v1 = other + other;
+
+            THEN("Every change should be seen.") {
+
+                REQUIRE(8 == ref.mod());
+            }
+        }
+
+        WHEN("I write through a pointer I kept across a mod.") {
+
+            double* elems {v1.data()};
+            REQUIRE(25 == ref.mod());
+            elems[1] = 0;
+            v1.invalidate_mod();
+
+            THEN("Invalidating should make the mod see the change.") {
+
+                REQUIRE(9 == ref.mod());
+            }
+        }
+
+        WHEN("I move it.") {
+
+            Vector<double> moved {std::move(v1)};
+
+            THEN("The new vector should have the same mod.") {
+
+                REQUIRE(25 == moved.mod());
+            }
+        }
+    }
+
+    GIVEN("I have a large vector shared between threads.") {
+
+        std::vector<double> elems(10000);
+        for (std::size_t i = 0; i < elems.size(); i++) {
+            elems[i] = static_cast<double>(i % 7);
+        }
+        const Vector<double> shared {elems};
+        double expected {0.0};
+        for (const double& elem : elems) {
+            expected += elem*elem;
+        }
+
+        WHEN("Several threads compute the mod at the same time.") {
+
+            std::vector<double> results(4);
+            std::vector<std::thread> threads {};
+            for (std::size_t t = 0; t < results.size(); t++) {
+                threads.emplace_back([&shared, &results, t]() {
+                    for (int repeat = 0; repeat < 100; repeat++) {
+                        results[t] = shared.mod();
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+
+            THEN("They should all get the right value.") {
+
+                for (const double& result : results) {
+                    REQUIRE(expected == result);
+                }
+            }
+        }
+    }
+}
@@ -1,6 +1,7 @@
 #define CATCH_CONFIG_MAIN
 
 #include <algorithm>
+#include <cmath>
 #include <exception>
 #include <vector>
 #include <functional>
@@ -26,6 +27,7 @@ using numeric::functions::cosine_angle;
 using numeric::functions::is_normal_to_plane;
 using numeric::functions::cross;
 using numeric::functions::linear_independence_of_system;
+using numeric::functions::IncrementalBasis;
 
 SCENARIO("Testing linear dependence of vectors.") {
     
@@ -265,3 +267,98 @@ SCENARIO("Test linear independence of a set of vectors.") {
         }
     }
 }
+
+SCENARIO("Incremental basis.") {
+
+    GIVEN("I have an empty basis of 4D fraction vectors.") {
+
+        IncrementalBasis<Fraction> basis {4};
+        Vector<Fraction> v1 {{{1,1}, {2,1}, {0,1}, {1,1}}};
+        Vector<Fraction> v2 {{{0,1}, {1,1}, {1,1}, {0,1}}};
+        Vector<Fraction> v3 {{{2,1}, {1,1}, {3,1}, {1,1}}};
+        // 3*v1 - 1/2*v3
+        Vector<Fraction> dependent {{{2,1}, {11,2}, {-3,2}, {5,2}}};
+
+        WHEN("I insert vectors one at a time.") {
+
+            THEN("Independent ones should raise the rank, and dependent ones come with exact coefficients.") {
+
+                REQUIRE(0 == basis.rank());
+                REQUIRE(basis.insert(v1).unwrap());
+                REQUIRE(basis.insert(v2).unwrap());
+                REQUIRE(!basis.insert(Vector<Fraction> {{{2,1}, {4,1}, {0,1}, {2,1}}}).unwrap());
+                REQUIRE(std::vector<Fraction> {Fraction {2,1}, Fraction {0,1}} == basis.get_coefficients());
+                REQUIRE(basis.insert(v3).unwrap());
+                REQUIRE(basis.get_coefficients().empty());
+                REQUIRE(3 == basis.rank());
+
+                REQUIRE(!basis.is_independent(dependent).unwrap());
+                std::vector<Fraction> coefficients {basis.dependency(dependent).unwrap()};
+                REQUIRE(std::vector<Fraction> {Fraction {3,1}, Fraction {0,1}, Fraction {-1,2}} == coefficients);
+                REQUIRE(!basis.insert(dependent).unwrap());
+                REQUIRE(coefficients == basis.get_coefficients());
+                REQUIRE(3 == basis.rank());
+            }
+        }
+
+        WHEN("I use vectors of the wrong size.") {
+
+            Vector<Fraction> wrong {{{1,1}, {2,1}, {3,1}}};
+
+            THEN("I should get an error.") {
+
+                REQUIRE(ErrorCode::INCOMPATIBLE_VECTORS == basis.insert(wrong).error());
+                REQUIRE(ErrorCode::INCOMPATIBLE_VECTORS == basis.is_independent(wrong).error());
+                REQUIRE(ErrorCode::INCOMPATIBLE_VECTORS == basis.dependency(wrong).error());
+                REQUIRE(ErrorCode::NO_SOLUTIONS == basis.dependency(v1).error());
+            }
+        }
+    }
+
+    GIVEN("I have a stream of 6D double vectors, where every third one is a combination of earlier ones.") {
+
+        IncrementalBasis<double> basis {6, 1e-9};
+        std::vector<std::vector<double>> accepted {};
+        const std::vector<std::vector<double>> independent {
+            {1, 2, 0, -1, 3, 1}, {0, 1, 4, 2, -2, 1}, {5, 0, 1, 1, 0, -3}, {2, 2, 2, 0, 1, 7}, {-1, 3, 0, 0, 4, 2}, {1, 1, 1, 1, 1, 1}
+        };
+
+        WHEN("I insert them.") {
+
+            THEN("Only the independent ones should be added, and the coefficients should rebuild the dependent ones.") {
+
+                std::size_t next {0};
+                for (std::size_t step = 0; step < 9; step++) {
+                    std::vector<double> elems {};
+                    const bool combination {step % 3 == 2};
+                    if (combination) {
+                        elems.assign(6, 0.0);
+                        for (std::size_t j = 0; j < accepted.size(); j++) {
+                            for (std::size_t d = 0; d < 6; d++) {
+                                elems[d] += (static_cast<double>(j) - 1.5)*accepted[j][d];
+                            }
+                        }
+                    } else {
+                        elems = independent[next++];
+                    }
+
+                    Vector<double> vec {elems};
+                    REQUIRE(basis.insert(vec).unwrap() == !combination);
+                    if (combination) {
+                        const std::vector<double>& coefficients {basis.get_coefficients()};
+                        REQUIRE(accepted.size() == coefficients.size());
+                        for (std::size_t j = 0; j < accepted.size(); j++) {
+                            REQUIRE(std::fabs(coefficients[j] - (static_cast<double>(j) - 1.5)) < 1e-9);
+                        }
+                    } else {
+                        accepted.push_back(elems);
+                    }
+                    REQUIRE(accepted.size() == basis.rank());
+                }
+
+                REQUIRE(6 == basis.rank());
+                REQUIRE(!basis.is_independent(Vector<double> {{3, 1, 4, 1, 5, 9}}).unwrap());
+            }
+        }
+    }
+}
@@ -0,0 +1,305 @@
+#define CATCH_CONFIG_MAIN
+
+#include <exception>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <numeric/types/matrix.hpp>
+#include <numeric/types/matrixview.hpp>
+#include <numeric/types/vector.hpp>
+#include <numeric/math/rref.hpp>
+
+using numeric::types::ConstMatrixView;
+using numeric::types::Matrix;
+using numeric::types::MatrixView;
+using numeric::types::Vector;
+using numeric::functions::rref;
+
+template <typename T, typename M> bool isEqual(const M& matrix, const std::vector<std::vector<T>>& vecs) {
+    if (matrix.getRows() != vecs.size() || matrix.getCols() != vecs[0].size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < vecs.size(); i++) {
+        for (std::size_t j = 0; j < vecs[0].size(); j++) {
+            if (matrix.atUnchecked(i, j) != vecs[i][j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+SCENARIO("Matrix views share the storage of the matrix.") {
+
+    GIVEN("I have a 3x4 matrix.") {
+
+        Matrix<int> matrix {{
+            {1, 2, 3, 4},
+            {5, 6, 7, 8},
+            {9, 10, 11, 12}
+        }};
+
+        WHEN("I take views on it.") {
+
+            MatrixView<int> block {matrix.submatrix(1, 1, 2, 3)};
+            ConstMatrixView<int> transposed {matrix.transpose()};
+            MatrixView<int> column {matrix.column(2)};
+            ConstMatrixView<int> rows {matrix.rowRange(0, 2)};
+
+            THEN("They should see the elements of the matrix.") {
+
+                REQUIRE(isEqual<int>(block, {{6, 7, 8}, {10, 11, 12}}));
+                REQUIRE(isEqual<int>(transposed, {{1, 5, 9}, {2, 6, 10}, {3, 7, 11}, {4, 8, 12}}));
+                REQUIRE(isEqual<int>(column, {{3}, {7}, {11}}));
+                REQUIRE(isEqual<int>(rows, {{1, 2, 3, 4}, {5, 6, 7, 8}}));
+                REQUIRE(transposed.isTransposed());
+                REQUIRE_FALSE(block.isTransposed());
+            }
+
+            THEN("Writes through a view should show up in the matrix.") {
+
+                block.at(0, 0) = 60;
+                column.atUnchecked(2, 0) = 110;
+                REQUIRE(60 == matrix[1][1]);
+                REQUIRE(110 == matrix[2][2]);
+                REQUIRE(110 == block.at(1, 1));
+                REQUIRE(60 == transposed.at(1, 1));
+            }
+
+            THEN("Views of views should compose.") {
+
+                REQUIRE(isEqual<int>(matrix.transpose().submatrix(1, 1, 2, 2), {{6, 10}, {7, 11}}));
+                REQUIRE(isEqual<int>(block.transpose().column(1), {{10}, {11}, {12}}));
+                REQUIRE(isEqual<int>(matrix.transpose().transpose(), {{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}}));
+                REQUIRE(isEqual<int>(transposed.rowRange(2, 2).transpose(), {{3, 4}, {7, 8}, {11, 12}}));
+            }
+
+            THEN("Out of range views and elements should throw.") {
+
+                REQUIRE_THROWS_AS((matrix.submatrix(1, 1, 3, 1)), std::out_of_range);
+                REQUIRE_THROWS_AS((matrix.column(4)), std::out_of_range);
+                REQUIRE_THROWS_AS((transposed.rowRange(3, 2)), std::out_of_range);
+                REQUIRE_THROWS_AS((block.at(2, 0)), std::out_of_range);
+                REQUIRE_THROWS_AS((block.exchangeRows(0, 2)), std::out_of_range);
+            }
+        }
+
+        WHEN("I exchange rows of the matrix after taking a view.") {
+
+            ConstMatrixView<int> column {matrix.column(0)};
+            matrix.exchangeRows(0, 2);
+
+            THEN("The view should follow the rows.") {
+
+                REQUIRE(isEqual<int>(column, {{9}, {5}, {1}}));
+            }
+        }
+
+        WHEN("I do row operations on a block.") {
+
+            MatrixView<int> block {matrix.submatrix(0, 1, 3, 2)};
+            block.exchangeRows(0, 2);
+            block.linearCombRows(1, 2, 0, -1);
+            block.scaleRow(2, 10);
+
+            THEN("Only the elements in the block should change.") {
+
+                REQUIRE(isEqual<int>(matrix, {{1, 10, 11, 4}, {5, 2, 3, 8}, {9, 20, 30, 12}}));
+            }
+        }
+
+        WHEN("I do row operations on a transposed view.") {
+
+            MatrixView<int> transposed {matrix.transpose()};
+            transposed.exchangeRows(0, 3);
+            transposed.scaleRow(1, -1);
+
+            THEN("They should be column operations on the matrix.") {
+
+                REQUIRE(isEqual<int>(matrix, {{4, -2, 3, 1}, {8, -6, 7, 5}, {12, -10, 11, 9}}));
+            }
+        }
+    }
+}
+
+SCENARIO("Matrix views in expressions and products.") {
+
+    GIVEN("I have some matrices.") {
+
+        Matrix<int> lhs {{
+            {1, 2, 3},
+            {4, 5, 6}
+        }};
+        Matrix<int> rhs {{
+            {1, 0},
+            {0, 1},
+            {2, 2}
+        }};
+
+        WHEN("I use views in arithmetic.") {
+
+            Matrix<int> sum {lhs.view() + rhs.transpose()};
+            Matrix<int> scaled {2*lhs.submatrix(0, 1, 2, 2) - rhs.rowRange(0, 2)};
+            Matrix<int> copy {lhs.transpose()};
+
+            THEN("The results should be computed from the shared elements.") {
+
+                REQUIRE(isEqual<int>(sum, {{2, 2, 5}, {4, 6, 8}}));
+                REQUIRE(isEqual<int>(scaled, {{3, 6}, {10, 11}}));
+                REQUIRE(isEqual<int>(copy, {{1, 4}, {2, 5}, {3, 6}}));
+                REQUIRE_THROWS_AS(lhs.view() + rhs.view(), std::invalid_argument);
+            }
+        }
+
+        WHEN("I multiply views with matrices and vectors.") {
+
+            Vector<int> vec {{1, 1}};
+
+            THEN("The products should match the products of the copies.") {
+
+                REQUIRE(isEqual<int>(lhs*rhs.view(), {{7, 8}, {16, 17}}));
+                REQUIRE(isEqual<int>(rhs.transpose()*lhs.transpose(), {{7, 16}, {8, 17}}));
+                REQUIRE(isEqual<int>(lhs.column(0)*rhs.rowRange(2, 1), {{2, 2}, {8, 8}}));
+                Vector<int> product {lhs.transpose()*vec};
+                Vector<int> rowProduct {vec*lhs.submatrix(0, 1, 2, 2)};
+                REQUIRE(5 == product[0]);
+                REQUIRE(9 == product[2]);
+                REQUIRE(7 == rowProduct[0]);
+                REQUIRE(9 == rowProduct[1]);
+                REQUIRE_THROWS_AS(lhs.view()*lhs.view(), std::invalid_argument);
+            }
+        }
+
+        WHEN("I assign expressions to a view.") {
+
+            Matrix<int> square {{
+                {1, 2, 3},
+                {4, 5, 6},
+                {7, 8, 9}
+            }};
+            square.submatrix(0, 0, 2, 2) = rhs.rowRange(0, 2) + rhs.rowRange(1, 2);
+            lhs.column(2) = lhs.column(0);
+
+            THEN("The elements should be written into the matrix.") {
+
+                REQUIRE(isEqual<int>(square, {{1, 1, 3}, {2, 3, 6}, {7, 8, 9}}));
+                REQUIRE(isEqual<int>(lhs, {{1, 2, 1}, {4, 5, 4}}));
+                REQUIRE_THROWS_AS(lhs.column(0) = rhs.view(), std::invalid_argument);
+            }
+        }
+
+        WHEN("I assign the transpose of a square matrix to itself.") {
+
+            Matrix<int> square {{
+                {1, 2, 3},
+                {4, 5, 6},
+                {7, 8, 9}
+            }};
+            Matrix<int> other {{
+                {1, 2, 3},
+                {4, 5, 6},
+                {7, 8, 9}
+            }};
+            square = square.transpose();
+            other.view() = other.transpose() + other.view();
+
+            THEN("The aliasing should be detected.") {
+
+                REQUIRE(isEqual<int>(square, {{1, 4, 7}, {2, 5, 8}, {3, 6, 9}}));
+                REQUIRE(isEqual<int>(other, {{2, 6, 10}, {6, 10, 14}, {10, 14, 18}}));
+            }
+        }
+    }
+
+    GIVEN("I have larger double matrices.") {
+
+        std::mt19937 mt(7);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        const std::size_t n {80};
+        Matrix<double> a {n + 5, n + 3};
+        Matrix<double> b {n + 4, n + 2};
+        for (auto& row : a) {
+            for (auto& elem : row) {
+                elem = dist(mt);
+            }
+        }
+        for (auto& row : b) {
+            for (auto& elem : row) {
+                elem = dist(mt);
+            }
+        }
+
+        WHEN("I multiply blocks of them.") {
+
+            Matrix<double> viaViews {a.submatrix(3, 1, n, n)*b.submatrix(2, 2, n, n)};
+            Matrix<double> viaTranspose {a.submatrix(3, 1, n, n)*b.transpose().submatrix(2, 2, n, n)};
+            Matrix<double> blockA {a.submatrix(3, 1, n, n)};
+            Matrix<double> blockB {b.submatrix(2, 2, n, n)};
+            Matrix<double> blockBt {b.transpose().submatrix(2, 2, n, n)};
+            Matrix<double> expected {blockA*blockB};
+            Matrix<double> expectedTranspose {blockA*blockBt};
+
+            THEN("The products should match the products of the copies.") {
+
+                for (std::size_t i = 0; i < n; i++) {
+                    for (std::size_t j = 0; j < n; j++) {
+                        REQUIRE(expected[i][j] == Approx(viaViews[i][j]));
+                        REQUIRE(expectedTranspose[i][j] == Approx(viaTranspose[i][j]));
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("RREF on views.") {
+
+    GIVEN("I have a system embedded in a bigger matrix.") {
+
+        Matrix<double> matrix {{
+            {99, 99, 99, 99, 99},
+            {99, 0, 2, 1, 7},
+            {99, 1, 1, 1, 6},
+            {99, 2, 1, -1, 1},
+            {99, 99, 99, 99, 99}
+        }};
+
+        WHEN("I reduce the block of the system.") {
+
+            auto result {rref(matrix.submatrix(1, 1, 3, 4))};
+
+            THEN("The block should be in RREF, and the rest should be untouched.") {
+
+                REQUIRE(result);
+                REQUIRE(isEqual<double>(matrix.submatrix(1, 1, 3, 3), {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}));
+                REQUIRE(1.0 == Approx(matrix[1][4]));
+                REQUIRE(2.0 == Approx(matrix[2][4]));
+                REQUIRE(3.0 == Approx(matrix[3][4]));
+                for (std::size_t i = 0; i < 5; i++) {
+                    REQUIRE(99 == matrix[0][i]);
+                    REQUIRE(99 == matrix[4][i]);
+                    REQUIRE(99 == matrix[i][0]);
+                }
+            }
+        }
+
+        WHEN("I reduce a transposed view.") {
+
+            Matrix<double> singular {{
+                {1, 2, 3},
+                {2, 4, 6},
+                {1, 0, 1}
+            }};
+            auto result {rref(singular.transpose(), 1e-12)};
+
+            THEN("The columns of the matrix should have been reduced.") {
+
+                REQUIRE_FALSE(result);
+                REQUIRE(numeric::ErrorCode::FREE_COLUMNS_RREF == result.error());
+                REQUIRE(1.0 == Approx(singular[0][0]));
+                REQUIRE(0.0 == singular[0][2]);
+            }
+        }
+    }
+}